@@ -28,12 +28,12 @@ layout(location = 1) in flat uint fragDrawID;
 
 void main()
 {
-    Mesh mesh = Constants.Meshes.meshes[fragDrawID];
+    Material material = Constants.Materials.materials[Constants.Meshes.meshes[fragDrawID].materialIndex];
 
-    float alpha  = texture(sampler2D(Textures[mesh.material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV).a;
-          alpha *= mesh.material.albedoFactor.a;
+    float alpha  = texture(sampler2D(Textures[material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV).a;
+          alpha *= material.albedoFactor.a;
 
-    if (alpha < mesh.material.alphaCutOff)
+    if (alpha < material.alphaCutOff)
     {
         discard;
     }
@@ -27,15 +27,16 @@ layout(location = 1) out flat uint fragDrawID;
 
 void main()
 {
-    uint meshIndex = Constants.MeshIndices.indices[gl_DrawID];
-    Mesh mesh      = Constants.Meshes.meshes[meshIndex];
+    uint      meshIndex = Constants.MeshIndices.indices[gl_InstanceIndex];
+    Transform transform = Constants.Transforms.transforms[meshIndex];
+    Material  material  = Constants.Materials.materials[Constants.Meshes.meshes[meshIndex].materialIndex];
 
     vec3   position = Constants.Positions.positions[gl_VertexIndex];
     Vertex vertex   = Constants.Vertices.vertices[gl_VertexIndex];
 
-    vec4 fragPos = mesh.transform * vec4(position, 1.0f);
+    vec4 fragPos = transform.transform * vec4(position, 1.0f);
     gl_Position  = Constants.Scene.currentMatrices.jitteredProjection * Constants.Scene.currentMatrices.view * fragPos;
 
-    fragUV     = vertex.uv[mesh.material.albedoUVMapID];
+    fragUV     = vertex.uv[material.albedoUVMapID];
     fragDrawID = meshIndex;
 }
\ No newline at end of file
@@ -24,10 +24,10 @@
 
 void main()
 {
-    uint meshIndex = Constants.MeshIndices.indices[gl_DrawID];
-    Mesh mesh      = Constants.Meshes.meshes[meshIndex];
+    uint meshIndex = Constants.MeshIndices.indices[gl_InstanceIndex];
+    mat4 transform = Constants.Transforms.transforms[meshIndex].transform;
     vec3 position  = Constants.Positions.positions[gl_VertexIndex];
 
-    vec4 fragPos = mesh.transform * vec4(position, 1.0f);
+    vec4 fragPos = transform * vec4(position, 1.0f);
     gl_Position  = Constants.Scene.currentMatrices.jitteredProjection * Constants.Scene.currentMatrices.view * fragPos;
 }
\ No newline at end of file
@@ -32,22 +32,24 @@ layout(location = 4) in      mat3 fragTBNMatrix;
 layout(location = 7) in flat uint fragDrawID;
 
 layout(location = 0) out vec4 gAlbedoReflectance;
-layout(location = 1) out vec2 gNormal;
-layout(location = 2) out vec2 gRoughnessMetallic;
-layout(location = 3) out vec3 gEmmisive;
-layout(location = 4) out vec2 gMotionVectors;
+layout(location = 1) out uint gNormalRoughnessMetallic;
+layout(location = 2) out uint gEmmisive;
+layout(location = 3) out vec2 gMotionVectors;
 
 void main()
 {
-    Mesh mesh = Constants.CurrentMeshes.meshes[fragDrawID];
+    Material material = Constants.Materials.materials[Constants.Meshes.meshes[fragDrawID].materialIndex];
 
-    vec3 albedo  = texture(sampler2D(Textures[mesh.material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV[mesh.material.albedoUVMapID]).rgb;
-         albedo *= mesh.material.albedoFactor.rgb;
+    // Sample textures as sharp as at output resolution
+    float mipBias = log2(Constants.Scene.renderScale.x);
+
+    vec3 albedo  = texture(sampler2D(Textures[material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV[material.albedoUVMapID], mipBias).rgb;
+         albedo *= material.albedoFactor.rgb;
 
     gAlbedoReflectance.rgb = albedo.rgb;
-    gAlbedoReflectance.a   = IoRToReflectance(mesh.material.ior);
+    gAlbedoReflectance.a   = IoRToReflectance(material.ior);
 
-    vec3 normal = texture(sampler2D(Textures[mesh.material.normalID], Samplers[Constants.TextureSamplerIndex]), fragUV[mesh.material.normalUVMapID]).rgb;
+    vec3 normal = texture(sampler2D(Textures[material.normalID], Samplers[Constants.TextureSamplerIndex]), fragUV[material.normalUVMapID], mipBias).rgb;
          normal = GetNormalFromMap(normal, fragTBNMatrix);
 
     if (!gl_FrontFacing)
@@ -55,20 +57,17 @@ void main()
         normal = -normal;
     }
 
-    gNormal = PackNormal(normal);
-
-    vec3 aoRghMtl    = texture(sampler2D(Textures[mesh.material.aoRghMtlID], Samplers[Constants.TextureSamplerIndex]), fragUV[mesh.material.aoRghMtlUVMapID]).rgb;
-         aoRghMtl.g *= mesh.material.roughnessFactor;
-         aoRghMtl.b *= mesh.material.metallicFactor;
+    vec3 aoRghMtl    = texture(sampler2D(Textures[material.aoRghMtlID], Samplers[Constants.TextureSamplerIndex]), fragUV[material.aoRghMtlUVMapID], mipBias).rgb;
+         aoRghMtl.g *= material.roughnessFactor;
+         aoRghMtl.b *= material.metallicFactor;
 
-    gRoughnessMetallic.r = aoRghMtl.g;
-    gRoughnessMetallic.g = aoRghMtl.b;
+    gNormalRoughnessMetallic = PackNormalRoughnessMetallic(normal, aoRghMtl.g, aoRghMtl.b);
 
-    vec3 emmisive  = texture(sampler2D(Textures[mesh.material.emmisiveID], Samplers[Constants.TextureSamplerIndex]), fragUV[mesh.material.emmisiveUVMapID]).rgb;
-         emmisive *= mesh.material.emmisiveFactor;
-         emmisive *= mesh.material.emmisiveStrength;
+    vec3 emmisive  = texture(sampler2D(Textures[material.emmisiveID], Samplers[Constants.TextureSamplerIndex]), fragUV[material.emmisiveUVMapID], mipBias).rgb;
+         emmisive *= material.emmisiveFactor;
+         emmisive *= material.emmisiveStrength;
 
-    gEmmisive = emmisive;
+    gEmmisive = PackRGB9E5(emmisive);
 
     vec2 currentUV  = (fragCurrentPosition.xy  / fragCurrentPosition.w ) * 0.5f + 0.5f;
     vec2 previousUV = (fragPreviousPosition.xy / fragPreviousPosition.w) * 0.5f + 0.5f;
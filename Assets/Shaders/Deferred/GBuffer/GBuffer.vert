@@ -31,14 +31,14 @@ layout(location = 7) out flat uint fragDrawID;
 
 void main()
 {
-    uint meshIndex    = Constants.MeshIndices.indices[gl_DrawID];
-    Mesh currentMesh  = Constants.CurrentMeshes.meshes[meshIndex];
-    Mesh previousMesh = Constants.PreviousMeshes.meshes[meshIndex];
+    uint      meshIndex         = Constants.MeshIndices.indices[gl_InstanceIndex];
+    Transform currentTransform  = Constants.CurrentTransforms.transforms[meshIndex];
+    mat4      previousTransform = Constants.PreviousTransforms.transforms[meshIndex].transform;
 
     vec3   position = Constants.Positions.positions[gl_VertexIndex];
     Vertex vertex   = Constants.Vertices.vertices[gl_VertexIndex];
 
-    vec4 worldPosition       = currentMesh.transform                * vec4(position, 1.0f);
+    vec4 worldPosition       = currentTransform.transform           * vec4(position, 1.0f);
     vec4 currentViewPosition = Constants.Scene.currentMatrices.view * worldPosition;
 
     fragCurrentPosition = Constants.Scene.currentMatrices.projection         * currentViewPosition;
@@ -46,14 +46,14 @@ void main()
 
     fragPreviousPosition = Constants.Scene.previousMatrices.projection *
                            Constants.Scene.previousMatrices.view *
-                           previousMesh.transform * vec4(position, 1.0f);
+                           previousTransform * vec4(position, 1.0f);
 
     fragUV[0]  = vertex.uv[0];
     fragUV[1]  = vertex.uv[1];
     fragDrawID = meshIndex;
 
-    vec3 N = normalize(currentMesh.normalMatrix * vertex.normal);
-    vec3 T = normalize(currentMesh.transform * vec4(vertex.tangent.xyz, 0.0f)).xyz;
+    vec3 N = normalize(currentTransform.normalMatrix * vertex.normal);
+    vec3 T = normalize(currentTransform.transform * vec4(vertex.tangent.xyz, 0.0f)).xyz;
          T = normalize(T - dot(T, N) * N);
     vec3 B = normalize(cross(N, T)) * vertex.tangent.w;
 
@@ -23,7 +23,7 @@
 #include "PBR.glsl"
 #include "MegaSet.glsl"
 #include "Packing.glsl"
-#include "PointShadowMap.glsl"
+#include "ShadowAtlas.glsl"
 #include "Deferred/Lighting.h"
 
 layout(location = 0) in vec2 fragUV;
@@ -32,18 +32,20 @@ layout(location = 0) out vec3 outColor;
 
 void main()
 {
-    vec4  gAlbedo_Reflectance = texture(sampler2D(Textures[Constants.GAlbedoIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV);
+    // Only the render extent of the framebuffers is drawn to
+    vec2 uv = fragUV * Constants.Scene.renderScale;
+
+    vec4  gAlbedo_Reflectance = texture(sampler2D(Textures[Constants.GAlbedoIndex], Samplers[Constants.GBufferSamplerIndex]), uv);
     vec3  albedo              = gAlbedo_Reflectance.rgb;
     float reflectance         = gAlbedo_Reflectance.a;
 
-    vec4 gNormal = texture(sampler2D(Textures[Constants.GNormalIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV);
-    vec3 normal  = UnpackNormal(gNormal.rg);
-
-    vec4  gRghMtl   = texture(sampler2D(Textures[Constants.GRghMtlIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV);
-    float roughness = gRghMtl.r;
-    float metallic  = gRghMtl.g;
+    uint  gNormal_Rgh_Mtl = texture(usampler2D(UTextures[Constants.GNormalIndex], Samplers[Constants.GBufferSamplerIndex]), uv).r;
+    vec3  normal          = UnpackNormal(gNormal_Rgh_Mtl);
+    vec2  rghMtl          = UnpackRoughnessMetallic(gNormal_Rgh_Mtl);
+    float roughness       = rghMtl.r;
+    float metallic        = rghMtl.g;
 
-    float depth         = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV).r;
+    float depth         = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.GBufferSamplerIndex]), uv).r;
     vec3  worldPosition = GetWorldPosition(Constants.Scene.currentMatrices, fragUV, depth);
 
     vec3 toCamera  = normalize(Constants.Scene.cameraPosition - worldPosition);
@@ -56,7 +58,7 @@ void main()
         DirLight  light     = Constants.Scene.Sun.light;
         LightInfo lightInfo = GetLightInfo(light);
 
-        float shadow = texture(sampler2D(Textures[Constants.ShadowMapIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV).r;
+        float shadow = texture(sampler2D(Textures[Constants.ShadowMapIndex], Samplers[Constants.GBufferSamplerIndex]), uv).r;
 
         Lo += shadow * CalculateLight
         (
@@ -70,23 +72,6 @@ void main()
         );
     }
 
-    for (uint i = 0; i < Constants.Scene.PointLights.count; ++i)
-    {
-        PointLight light     = Constants.Scene.PointLights.lights[i];
-        LightInfo  lightInfo = GetLightInfo(light, worldPosition);
-
-        Lo += CalculateLight
-        (
-            lightInfo,
-            normal,
-            toCamera,
-            albedo,
-            roughness,
-            metallic,
-            reflectance
-        );
-    }
-
     for (uint i = 0; i < Constants.Scene.ShadowedPointLights.count; ++i)
     {
         ShadowedPointLight light     = Constants.Scene.ShadowedPointLights.lights[i];
@@ -94,10 +79,9 @@ void main()
 
         float shadow = CalculatePointShadow
         (
-            i,
             light,
             worldPosition,
-            CubemapArrays[Constants.PointShadowMapIndex],
+            Textures[Constants.ShadowAtlasIndex],
             Samplers[Constants.ShadowSamplerIndex]
         );
 
@@ -113,12 +97,20 @@ void main()
         );
     }
 
-    for (uint i = 0; i < Constants.Scene.SpotLights.count; ++i)
+    for (uint i = 0; i < Constants.Scene.ShadowedSpotLights.count; ++i)
     {
-        SpotLight light     = Constants.Scene.SpotLights.lights[i];
-        LightInfo lightInfo = GetLightInfo(light, worldPosition);
+        ShadowedSpotLight light     = Constants.Scene.ShadowedSpotLights.lights[i];
+        LightInfo         lightInfo = GetLightInfo(light, worldPosition);
+
+        float shadow = CalculateSpotShadow
+        (
+            light,
+            worldPosition,
+            Textures[Constants.ShadowAtlasIndex],
+            Samplers[Constants.ShadowSamplerIndex]
+        );
 
-        Lo += CalculateLight
+        Lo += shadow * CalculateLight
         (
             lightInfo,
             normal,
@@ -130,11 +122,45 @@ void main()
         );
     }
 
+    // Unshadowed point and spot lights, only the ones assigned to this fragment's cluster
+    {
+        float viewDepth    = -(Constants.Scene.currentMatrices.view * vec4(worldPosition, 1.0f)).z;
+        uint  clusterIndex = LightGrid_GetClusterIndex(fragUV, viewDepth, Constants.Scene.nearPlane, Constants.Scene.farPlane);
+        uint  lightCount   = Constants.LightGrid.clusters[clusterIndex].count;
+
+        for (uint i = 0; i < lightCount; ++i)
+        {
+            uint lightIndex = Constants.LightGrid.clusters[clusterIndex].indices[i];
+
+            LightInfo lightInfo;
+
+            if ((lightIndex & LIGHT_INDEX_SPOT_BIT) != 0)
+            {
+                lightInfo = GetLightInfo(Constants.Scene.SpotLights.lights[lightIndex & ~LIGHT_INDEX_SPOT_BIT], worldPosition);
+            }
+            else
+            {
+                lightInfo = GetLightInfo(Constants.Scene.PointLights.lights[lightIndex], worldPosition);
+            }
+
+            Lo += CalculateLight
+            (
+                lightInfo,
+                normal,
+                toCamera,
+                albedo,
+                roughness,
+                metallic,
+                reflectance
+            );
+        }
+    }
+
     vec3  irradiance       = texture(samplerCube(Cubemaps[Constants.IrradianceIndex], Samplers[Constants.IBLSamplerIndex]), normal).rgb;
     uint  maxReflectionLod = textureQueryLevels(samplerCube(Cubemaps[Constants.PreFilterIndex], Samplers[Constants.IBLSamplerIndex]));
     vec3  preFilter        = textureLod(samplerCube(Cubemaps[Constants.PreFilterIndex], Samplers[Constants.IBLSamplerIndex]), reflected, roughness * float(maxReflectionLod)).rgb;
     vec2  brdf             = texture(sampler2D(Textures[Constants.BRDFLUTIndex], Samplers[Constants.IBLSamplerIndex]), vec2(max(dot(normal, toCamera), 0.0f), roughness)).rg;
-    float ao               = texture(sampler2D(Textures[Constants.AOIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV).r;
+    float ao               = texture(sampler2D(Textures[Constants.AOIndex], Samplers[Constants.GBufferSamplerIndex]), uv).r;
 
     Lo += ao * CalculateAmbient
     (
@@ -149,7 +175,7 @@ void main()
         brdf
     );
 
-    vec3 emmisive = texture(sampler2D(Textures[Constants.GEmmisiveIndex], Samplers[Constants.GBufferSamplerIndex]), fragUV).rgb;
+    vec3 emmisive = UnpackRGB9E5(texture(usampler2D(UTextures[Constants.GEmmisiveIndex], Samplers[Constants.GBufferSamplerIndex]), uv).r);
 
     Lo += emmisive;
 
@@ -19,17 +19,15 @@
 #extension GL_GOOGLE_include_directive : enable
 #extension GL_EXT_buffer_reference2    : enable
 #extension GL_EXT_scalar_block_layout  : enable
-#extension GL_EXT_multiview            : enable
 
-#include "IBL/Converter.h"
+#include "Deferred/VisibilityBuffer/Layout.h"
 
-layout(location = 0) out vec3 worldPos;
+layout(location = 0) in flat uint fragMeshIndex;
+layout(location = 1) in flat uint fragFirstTriangle;
+
+layout(location = 0) out uvec2 outVisibility;
 
 void main()
 {
-    worldPos    = Constants.Vertices.positions[gl_VertexIndex];
-    gl_Position = Constants.Matrices.matrices[gl_ViewIndex] * vec4(worldPos, 1.0f);
-
-    // Trick to guarantee early depth test
-    gl_Position = gl_Position.xyww;
+    outVisibility = VisibilityBuffer_Pack(fragMeshIndex, fragFirstTriangle + gl_PrimitiveID);
 }
\ No newline at end of file
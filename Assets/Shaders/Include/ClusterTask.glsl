@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLUSTER_TASK_GLSL
+#define CLUSTER_TASK_GLSL
+
+#include "Occlusion.glsl"
+#include "DrawCall.glsl"
+#include "GPU/Mesh.h"
+#include "GPU/Scene.h"
+#include "GPU/Transform.h"
+#include "GPU/Vertex.h"
+#include "GPU/Cluster.h"
+
+// Visible clusters of one task workgroup, read by the mesh workgroups it launches
+struct ClusterTaskPayload
+{
+    uint firstIndex;
+    int  vertexOffset;
+    uint meshIndices[CLUSTER_TASK_WORKGROUP_SIZE];
+    uint clusterIndices[CLUSTER_TASK_WORKGROUP_SIZE];
+};
+
+taskPayloadSharedEXT ClusterTaskPayload ClusterTask_Payload;
+
+shared uint ClusterTask_VisibleCount;
+
+// Triangles drawn by one mesh workgroup, one half of a visible cluster
+struct ClusterMeshlet
+{
+    uint meshIndex;
+    uint firstIndex;
+    uint firstTriangle;
+    uint triangleCount;
+    int  vertexOffset;
+};
+
+// Grid x is the draw and grid y a chunk of its instance and cluster pairs, returns the mesh workgroups to launch
+uint ClusterTask_Cull
+(
+    SceneBuffer scene,
+    MeshBuffer meshes,
+    TransformBuffer transforms,
+    ClusterBuffer clusters,
+    DrawCallBuffer drawCalls,
+    MeshIndexBuffer meshIndices,
+    uvec2 viewportSize,
+    uint pointSamplerIndex,
+    uint hiZIndex,
+    bool testOcclusion,
+    bool cullBackFaces
+)
+{
+    uint drawIndex = gl_WorkGroupID.x;
+
+    // Grids are sized for the largest written draw, most workgroups have nothing to do
+    if (drawIndex >= drawCalls.count)
+    {
+        return 0;
+    }
+
+    DrawCall drawCall = drawCalls.drawCalls[drawIndex];
+
+    // Instances of a draw share their geometry, and so their clusters
+    uint         firstMeshIndex = meshIndices.indices[drawCall.firstInstance];
+    GeometryInfo clusterInfo    = meshes.meshes[firstMeshIndex].surfaceInfo.clusterInfo;
+
+    uint pairCount = drawCall.instanceCount * clusterInfo.count;
+    uint firstPair = gl_WorkGroupID.y * CLUSTER_TASK_WORKGROUP_SIZE;
+
+    if (firstPair >= pairCount)
+    {
+        return 0;
+    }
+
+    if (gl_LocalInvocationIndex == 0)
+    {
+        ClusterTask_VisibleCount = 0;
+
+        ClusterTask_Payload.firstIndex   = drawCall.firstIndex;
+        ClusterTask_Payload.vertexOffset = drawCall.vertexOffset;
+    }
+
+    memoryBarrierShared();
+    barrier();
+
+    uint pairIndex = firstPair + gl_LocalInvocationIndex;
+
+    if (pairIndex < pairCount)
+    {
+        uint instanceIndex = pairIndex / clusterInfo.count;
+        uint clusterIndex  = pairIndex % clusterInfo.count;
+
+        uint      meshIndex = meshIndices.indices[drawCall.firstInstance + instanceIndex];
+        Cluster   cluster   = clusters.clusters[clusterInfo.offset + clusterIndex];
+        Transform transform = transforms.transforms[meshIndex];
+
+        mat4 projectionView = scene.currentMatrices.projection * scene.currentMatrices.view;
+
+        bool isVisible = !cullBackFaces || !Cluster_IsBackFacing(cluster, transform.transform, transform.normalMatrix, scene.cameraPosition);
+
+        isVisible = isVisible && Occlusion_IsVisible
+        (
+            AABB_Transform(cluster.aabb, transform.transform),
+            projectionView,
+            testOcclusion,
+            viewportSize,
+            hiZIndex,
+            pointSamplerIndex
+        );
+
+        if (isVisible)
+        {
+            uint slot = atomicAdd(ClusterTask_VisibleCount, 1);
+
+            ClusterTask_Payload.meshIndices[slot]    = meshIndex;
+            ClusterTask_Payload.clusterIndices[slot] = clusterInfo.offset + clusterIndex;
+        }
+    }
+
+    memoryBarrierShared();
+    barrier();
+
+    return ClusterTask_VisibleCount * 2;
+}
+
+ClusterMeshlet ClusterTask_GetMeshlet(ClusterBuffer clusters)
+{
+    uint slot          = gl_WorkGroupID.x / 2;
+    uint triangleStart = (gl_WorkGroupID.x % 2) * CLUSTER_MESH_MAX_TRIANGLES;
+
+    Cluster cluster       = clusters.clusters[ClusterTask_Payload.clusterIndices[slot]];
+    uint    triangleCount = cluster.indexCount / 3;
+
+    ClusterMeshlet meshlet;
+
+    meshlet.meshIndex     = ClusterTask_Payload.meshIndices[slot];
+    meshlet.firstIndex    = ClusterTask_Payload.firstIndex + cluster.firstIndex + triangleStart * 3;
+    meshlet.firstTriangle = cluster.firstIndex / 3 + triangleStart;
+    meshlet.triangleCount = triangleCount > triangleStart ? min(triangleCount - triangleStart, CLUSTER_MESH_MAX_TRIANGLES) : 0;
+    meshlet.vertexOffset  = ClusterTask_Payload.vertexOffset;
+
+    return meshlet;
+}
+
+// Same vertex as gl_VertexIndex would be for this corner of an indexed draw
+uint ClusterTask_GetVertexIndex(ClusterMeshlet meshlet, IndexBuffer indices, uint triangle, uint corner)
+{
+    return uint(int(indices.indices[meshlet.firstIndex + triangle * 3 + corner]) + meshlet.vertexOffset);
+}
+
+#endif
\ No newline at end of file
@@ -48,6 +48,8 @@ const float RT_SHADOW_MAX_BIAS = 0.005f;
 // TAA Constants
 const float TAA_DEFAULT_HISTORY_BLEND_RATE = 0.1f;
 const float TAA_MIN_HISTORY_BLEND_RATE     = 0.015f;
+// Gaussian fit to Blackman-Harris, in pixels squared
+const float TAA_UPSAMPLE_FILTER_SHARPNESS  = 2.29f;
 
 // GTAO Constants
 const uint GTAO_SLICE_COUNT  = 3;
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CUBEMAP_GLSL
+#define CUBEMAP_GLSL
+
+// Returns the sampling direction of a texel on a cubemap face (+X, -X, +Y, -Y, +Z, -Z)
+vec3 GetCubemapDirection(uint face, vec2 uv)
+{
+    vec2 st = uv * 2.0f - 1.0f;
+
+    vec3 direction = vec3(0.0f);
+
+    switch (face)
+    {
+    case 0:
+        direction = vec3( 1.0f, -st.y, -st.x);
+        break;
+
+    case 1:
+        direction = vec3(-1.0f, -st.y,  st.x);
+        break;
+
+    case 2:
+        direction = vec3( st.x,  1.0f,  st.y);
+        break;
+
+    case 3:
+        direction = vec3( st.x, -1.0f, -st.y);
+        break;
+
+    case 4:
+        direction = vec3( st.x, -st.y,  1.0f);
+        break;
+
+    case 5:
+        direction = vec3(-st.x, -st.y, -1.0f);
+        break;
+    }
+
+    return normalize(direction);
+}
+
+#endif
\ No newline at end of file
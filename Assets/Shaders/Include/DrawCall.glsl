@@ -17,6 +17,8 @@
 #ifndef DRAW_CALL_GLSL
 #define DRAW_CALL_GLSL
 
+#include "GPU/DrawInstance.h"
+
 struct DrawCall
 {
     uint indexCount;
@@ -37,4 +39,15 @@ layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer Mes
     uint indices[];
 };
 
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer InstanceCountBuffer
+{
+    uint counts[];
+};
+
+// One bit per mesh, set if the mesh passed occlusion culling last frame
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer VisibilityBuffer
+{
+    uint bits[];
+};
+
 #endif
\ No newline at end of file
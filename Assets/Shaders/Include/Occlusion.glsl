@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OCCLUSION_GLSL
+#define OCCLUSION_GLSL
+
+#include "MegaSet.glsl"
+#include "Constants.glsl"
+#include "AABB.h"
+
+float Occlusion_SampleHiZ(uvec2 texel, uint level, uint hiZIndex, uint pointSamplerIndex)
+{
+    return texelFetch(sampler2D(Textures[hiZIndex], Samplers[pointSamplerIndex]), ivec2(texel), int(level)).r;
+}
+
+// Clip space frustum test of world space bounds, optionally followed by a depth pyramid test
+bool Occlusion_IsVisible
+(
+    AABB aabb,
+    mat4 projectionView,
+    bool testOcclusion,
+    uvec2 viewportSize,
+    uint hiZIndex,
+    uint pointSamplerIndex
+)
+{
+    vec3[8] corners = AABB_GetCorners(aabb);
+
+    // Outside counts per clip plane, left, right, bottom, top, near and far
+    uint outside[6] = {0u, 0u, 0u, 0u, 0u, 0u};
+
+    bool crossesNearPlane = false;
+
+    vec2  minUV    = vec2( FLOAT_MAX);
+    vec2  maxUV    = vec2(-FLOAT_MAX);
+    float maxDepth = 0.0f;
+
+    for (uint i = 0; i < 8; ++i)
+    {
+        vec4 clipPosition = projectionView * vec4(corners[i], 1.0f);
+
+        outside[0] += uint(clipPosition.x < -clipPosition.w);
+        outside[1] += uint(clipPosition.x >  clipPosition.w);
+        outside[2] += uint(clipPosition.y < -clipPosition.w);
+        outside[3] += uint(clipPosition.y >  clipPosition.w);
+        outside[4] += uint(clipPosition.z >  clipPosition.w);
+        outside[5] += uint(clipPosition.z <  0.0f);
+
+        if (clipPosition.w <= 0.0f || clipPosition.z > clipPosition.w)
+        {
+            crossesNearPlane = true;
+            continue;
+        }
+
+        vec3 ndc = clipPosition.xyz / clipPosition.w;
+        vec2 uv  = ndc.xy * 0.5f + 0.5f;
+
+        minUV    = min(minUV, uv);
+        maxUV    = max(maxUV, uv);
+        maxDepth = max(maxDepth, ndc.z);
+    }
+
+    for (uint i = 0; i < 6; ++i)
+    {
+        if (outside[i] == 8)
+        {
+            return false;
+        }
+    }
+
+    if (!testOcclusion || crossesNearPlane)
+    {
+        return true;
+    }
+
+    vec2 viewportSizeF = vec2(viewportSize);
+
+    // One texel of slack covers the sub-pixel jitter the depth pass was drawn with
+    uvec2 minTexel = uvec2(clamp(minUV * viewportSizeF - 1.0f, vec2(0.0f), viewportSizeF - 1.0f));
+    uvec2 maxTexel = uvec2(clamp(maxUV * viewportSizeF + 1.0f, vec2(0.0f), viewportSizeF - 1.0f));
+
+    // Smallest level where the bounds cover at most 2x2 pyramid texels
+    uint extent = max(maxTexel.x - minTexel.x, maxTexel.y - minTexel.y);
+    uint level  = extent == 0 ? 0 : uint(findMSB(extent));
+
+    if (level >= uint(textureQueryLevels(sampler2D(Textures[hiZIndex], Samplers[pointSamplerIndex]))))
+    {
+        return true;
+    }
+
+    uvec2 minHiZ = minTexel >> (level + 1);
+    uvec2 maxHiZ = maxTexel >> (level + 1);
+
+    float farthestDepth = min
+    (
+        min(Occlusion_SampleHiZ(uvec2(minHiZ.x, minHiZ.y), level, hiZIndex, pointSamplerIndex), Occlusion_SampleHiZ(uvec2(maxHiZ.x, minHiZ.y), level, hiZIndex, pointSamplerIndex)),
+        min(Occlusion_SampleHiZ(uvec2(minHiZ.x, maxHiZ.y), level, hiZIndex, pointSamplerIndex), Occlusion_SampleHiZ(uvec2(maxHiZ.x, maxHiZ.y), level, hiZIndex, pointSamplerIndex))
+    );
+
+    // Reverse-Z, the nearest point of the bounds has the largest depth
+    return maxDepth >= farthestDepth;
+}
+
+#endif
\ No newline at end of file
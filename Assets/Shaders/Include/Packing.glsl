@@ -68,4 +68,53 @@ uint UnpackUNormToU8(float value)
     return uint(round(value * 255.0f));
 }
 
+// 10 bits per octahedral normal component, 8 bit roughness and 4 bit metallic
+uint PackNormalRoughnessMetallic(vec3 normal, float roughness, float metallic)
+{
+    uvec2 octNormal = uvec2(round(PackNormal(normal) * 1023.0f));
+    uint  rgh       = uint(round(clamp(roughness, 0.0f, 1.0f) * 255.0f));
+    uint  mtl       = uint(round(clamp(metallic,  0.0f, 1.0f) * 15.0f));
+
+    return octNormal.x | (octNormal.y << 10) | (rgh << 20) | (mtl << 28);
+}
+
+vec3 UnpackNormal(uint value)
+{
+    return UnpackNormal(vec2(value & 0x3FFu, (value >> 10) & 0x3FFu) / 1023.0f);
+}
+
+vec2 UnpackRoughnessMetallic(uint value)
+{
+    return vec2(float((value >> 20) & 0xFFu) / 255.0f, float(value >> 28) / 15.0f);
+}
+
+// Shared exponent RGB, 9 bit mantissas and a 5 bit exponent (EXT_texture_shared_exponent)
+uint PackRGB9E5(vec3 color)
+{
+    const float SHARED_EXPONENT_MAX = 65408.0f;
+
+    color = clamp(color, 0.0f, SHARED_EXPONENT_MAX);
+
+    float maxChannel = max(color.r, max(color.g, color.b));
+    // Biased by 15, plus one so the largest mantissa stays below 512
+    float exponent   = max(-16.0f, floor(log2(max(maxChannel, 1e-10f)))) + 16.0f;
+
+    if (floor(maxChannel / exp2(exponent - 24.0f) + 0.5f) == 512.0f)
+    {
+        exponent += 1.0f;
+    }
+
+    uvec3 mantissa = uvec3(floor(color / exp2(exponent - 24.0f) + 0.5f));
+
+    return mantissa.r | (mantissa.g << 9) | (mantissa.b << 18) | (uint(exponent) << 27);
+}
+
+vec3 UnpackRGB9E5(uint value)
+{
+    uvec3 mantissa = uvec3(value, value >> 9, value >> 18) & 0x1FFu;
+    float exponent = float(value >> 27);
+
+    return vec3(mantissa) * exp2(exponent - 24.0f);
+}
+
 #endif
\ No newline at end of file
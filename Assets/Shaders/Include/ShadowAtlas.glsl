@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHADOW_ATLAS_GLSL
+#define SHADOW_ATLAS_GLSL
+
+#include "Constants.glsl"
+#include "Scene.h"
+
+mat4 GetShadowMatrix(SceneBuffer scene, uint lightIndex, uint faceIndex)
+{
+    if ((lightIndex & SHADOW_LIGHT_INDEX_SPOT_BIT) != 0)
+    {
+        return scene.ShadowedSpotLights.lights[lightIndex & ~SHADOW_LIGHT_INDEX_SPOT_BIT].matrix;
+    }
+
+    return scene.ShadowedPointLights.lights[lightIndex].matrices[faceIndex];
+}
+
+vec3 GetShadowLightPosition(SceneBuffer scene, uint lightIndex)
+{
+    if ((lightIndex & SHADOW_LIGHT_INDEX_SPOT_BIT) != 0)
+    {
+        return scene.ShadowedSpotLights.lights[lightIndex & ~SHADOW_LIGHT_INDEX_SPOT_BIT].position;
+    }
+
+    return scene.ShadowedPointLights.lights[lightIndex].position;
+}
+
+// Same face order as the point light matrices
+uint GetCubeFace(vec3 direction)
+{
+    vec3 absDirection = abs(direction);
+
+    if (absDirection.x >= absDirection.y && absDirection.x >= absDirection.z)
+    {
+        return direction.x > 0.0f ? 0u : 1u;
+    }
+
+    if (absDirection.y >= absDirection.z)
+    {
+        return direction.y > 0.0f ? 2u : 3u;
+    }
+
+    return direction.z > 0.0f ? 4u : 5u;
+}
+
+float SampleShadowAtlas
+(
+    vec4 atlasRect,
+    mat4 matrix,
+    vec3 fragPosition,
+    float currentDistance,
+    texture2D shadowAtlas,
+    sampler shadowSampler
+)
+{
+    vec4 clipPosition = matrix * vec4(fragPosition, 1.0f);
+
+    // Behind the light
+    if (clipPosition.w <= 0.0f)
+    {
+        return 1.0f;
+    }
+
+    vec2 tileUV = clipPosition.xy / clipPosition.w * 0.5f + 0.5f;
+
+    // Filtering must never reach into a neighbouring tile
+    vec2 halfTexel = vec2(0.5f / float(SHADOW_ATLAS_SIZE));
+    vec2 atlasUV   = clamp(atlasRect.xy + tileUV * atlasRect.zw, atlasRect.xy + halfTexel, atlasRect.xy + atlasRect.zw - halfTexel);
+
+    float shadow = texture
+    (
+        sampler2DShadow(shadowAtlas, shadowSampler),
+        vec3(atlasUV, currentDistance - POINT_SHADOW_BIAS)
+    );
+
+    return shadow;
+}
+
+float CalculatePointShadow
+(
+    ShadowedPointLight light,
+    vec3 fragPosition,
+    texture2D shadowAtlas,
+    sampler shadowSampler
+)
+{
+    vec3 fragToLight = fragPosition - light.position;
+    uint face        = GetCubeFace(fragToLight);
+
+    return SampleShadowAtlas
+    (
+        light.atlasRects[face],
+        light.matrices[face],
+        fragPosition,
+        length(fragToLight),
+        shadowAtlas,
+        shadowSampler
+    );
+}
+
+float CalculateSpotShadow
+(
+    ShadowedSpotLight light,
+    vec3 fragPosition,
+    texture2D shadowAtlas,
+    sampler shadowSampler
+)
+{
+    return SampleShadowAtlas
+    (
+        light.atlasRect,
+        light.matrix,
+        fragPosition,
+        length(fragPosition - light.position),
+        shadowAtlas,
+        shadowSampler
+    );
+}
+
+#endif
\ No newline at end of file
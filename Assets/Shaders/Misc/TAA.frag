@@ -42,28 +42,32 @@ layout(location = 1) out vec4 historyOutput;
 vec3 ClipTowardsAABBCenter(vec3 historyColor, vec3 currentColor, vec3 min, vec3 max);
 vec3 ToneMap(vec3 color);
 vec3 ReverseToneMap(vec3 color);
-vec3 SampleSceneColor(vec2 fragUV);
+vec2 ClampToRenderExtent(vec2 uv, vec2 texelSize);
 
 void main()
 {
     vec2 sceneColorSize = vec2(textureSize(sampler2D(Textures[Constants.CurrentColorIndex], Samplers[Constants.PointSamplerIndex]), 0));
     vec2 texelSize      = 1.0f / sceneColorSize;
+    vec2 historySize    = vec2(textureSize(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.PointSamplerIndex]), 0));
+
+    // The current frame only covers the render extent of its framebuffers, history is always at output resolution
+    vec2 currentUV = fragUV * Constants.Scene.renderScale;
 
     // https://advances.realtimerendering.com/s2014/index.html#_HIGH-QUALITY_TEMPORAL_SUPERSAMPLING, slide 27
 
     float offset = texelSize.x * 2.0f;
 
-    vec2 depthUVTopLeft     = fragUV + vec2(-offset,  offset);
-    vec2 depthUVTopRight    = fragUV + vec2( offset,  offset);
-    vec2 depthUVBottomLeft  = fragUV + vec2(-offset, -offset);
-    vec2 depthUVBottomRight = fragUV + vec2( offset, -offset);
+    vec2 depthUVTopLeft     = ClampToRenderExtent(currentUV + vec2(-offset,  offset), texelSize);
+    vec2 depthUVTopRight    = ClampToRenderExtent(currentUV + vec2( offset,  offset), texelSize);
+    vec2 depthUVBottomLeft  = ClampToRenderExtent(currentUV + vec2(-offset, -offset), texelSize);
+    vec2 depthUVBottomRight = ClampToRenderExtent(currentUV + vec2( offset, -offset), texelSize);
 
-    vec2 closestUV = fragUV;
+    vec2 closestUV = currentUV;
 
     float depthTopLeft  = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), depthUVTopLeft).r;
     float depthTopRight = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), depthUVTopRight).r;
 
-    float closestDepth = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), fragUV).r;
+    float closestDepth = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), currentUV).r;
 
     float depthBottomLeft  = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), depthUVBottomLeft).r;
     float depthBottomRight = texture(sampler2D(Textures[Constants.SceneDepthIndex], Samplers[Constants.PointSamplerIndex]), depthUVBottomRight).r;
@@ -97,7 +101,7 @@ void main()
     // Ignoring corners:      https://www.activision.com/cdn/research/Dynamic_Temporal_Antialiasing_and_Upsampling_in_Call_of_Duty_v4.pdf#page=68
 
     vec2 historyUV      = fragUV - closestMotionVector;
-    vec2 samplePosition = historyUV * sceneColorSize;
+    vec2 samplePosition = historyUV * historySize;
     vec2 texelCenter    = floor(samplePosition - 0.5f) + 0.5f;
 
     vec2 f   = samplePosition - texelCenter;
@@ -107,9 +111,9 @@ void main()
     vec2 w3  = f * f * (-0.5f + 0.5f * f);
     vec2 w12 = w1 + w2;
 
-    vec2 texelPosition0  = (texelCenter - 1.0f)       * texelSize;
-    vec2 texelPosition3  = (texelCenter + 2.0f)       * texelSize;
-    vec2 texelPosition12 = (texelCenter + (w2 / w12)) * texelSize;
+    vec2 texelPosition0  = (texelCenter - 1.0f)       / historySize;
+    vec2 texelPosition3  = (texelCenter + 2.0f)       / historySize;
+    vec2 texelPosition12 = (texelCenter + (w2 / w12)) / historySize;
 
     vec3 historyColor  = texture(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.LinearSamplerIndex]), vec2(texelPosition12.x, texelPosition0.y )).rgb * w12.x * w0.y;
          historyColor += texture(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.LinearSamplerIndex]), vec2(texelPosition0.x,  texelPosition12.y)).rgb * w0.x  * w12.y;
@@ -117,34 +121,66 @@ void main()
          historyColor += texture(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.LinearSamplerIndex]), vec2(texelPosition3.x,  texelPosition12.y)).rgb * w3.x  * w12.y;
          historyColor += texture(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.LinearSamplerIndex]), vec2(texelPosition12.x, texelPosition3.y )).rgb * w12.x * w3.y;
 
-    vec3 currentColor = texture(sampler2D(Textures[Constants.CurrentColorIndex], Samplers[Constants.PointSamplerIndex]), fragUV).rgb;
-    currentColor = ToneMap(currentColor);
-
     // YCoCg: https://advances.realtimerendering.com/s2014/index.html#_HIGH-QUALITY_TEMPORAL_SUPERSAMPLING, slide 33
     // Variance clipping: https://developer.download.nvidia.com/gameworks/events/GDC2016/msalvi_temporal_supersampling.pdf
-    vec3 sampleTopLeft      = SampleSceneColor(fragUV + vec2(-texelSize.x,  texelSize.y));
-    vec3 sampleTopMiddle    = SampleSceneColor(fragUV + vec2( 0.0f,         texelSize.y));
-    vec3 sampleTopRight     = SampleSceneColor(fragUV + vec2( texelSize.x,  texelSize.y));
-    vec3 sampleMiddleLeft   = SampleSceneColor(fragUV + vec2(-texelSize.x,  0.0f));
-    vec3 sampleMiddleMiddle = RGBToYCoCg(currentColor);
-    vec3 sampleMiddleRight  = SampleSceneColor(fragUV + vec2( texelSize.x,  0.0f));
-    vec3 sampleBottomLeft   = SampleSceneColor(fragUV + vec2(-texelSize.x, -texelSize.y));
-    vec3 sampleBottomMiddle = SampleSceneColor(fragUV + vec2( 0.0f,        -texelSize.y));
-    vec3 sampleBottomRight  = SampleSceneColor(fragUV + vec2( texelSize.x, -texelSize.y));
-
-    vec3 moment1 = sampleTopLeft + sampleTopMiddle + sampleTopRight + sampleMiddleLeft + sampleMiddleMiddle + sampleMiddleRight + sampleBottomLeft + sampleBottomMiddle + sampleBottomRight;
-    vec3 moment2 = (sampleTopLeft * sampleTopLeft) + (sampleTopMiddle * sampleTopMiddle) + (sampleTopRight * sampleTopRight) + (sampleMiddleLeft * sampleMiddleLeft) + (sampleMiddleMiddle * sampleMiddleMiddle) + (sampleMiddleRight * sampleMiddleRight) + (sampleBottomLeft * sampleBottomLeft) + (sampleBottomMiddle * sampleBottomMiddle) + (sampleBottomRight * sampleBottomRight);
+    vec2  renderPixel = currentUV * sceneColorSize;
+    ivec2 centerTexel = ivec2(renderPixel);
+    ivec2 maxTexel    = ivec2(Constants.Scene.renderSize) - 1;
+
+    // Sub-pixel offset the current frame was rendered with, in render pixels
+    vec2 jitter = 0.5f * (Constants.Scene.currentMatrices.jitteredProjection[2].xy - Constants.Scene.currentMatrices.projection[2].xy) * vec2(Constants.Scene.renderSize);
+
+    vec3  moment1            = vec3(0.0f);
+    vec3  moment2            = vec3(0.0f);
+    vec3  reconstructedColor = vec3(0.0f);
+    float totalWeight        = 0.0f;
+    float maxWeight          = 0.0f;
+
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            ivec2 texel = clamp(centerTexel + ivec2(x, y), ivec2(0), maxTexel);
+            vec3  color = ToneMap(texelFetch(sampler2D(Textures[Constants.CurrentColorIndex], Samplers[Constants.PointSamplerIndex]), texel, 0).rgb);
+            vec3  ycocg = RGBToYCoCg(color);
+
+            moment1 += ycocg;
+            moment2 += ycocg * ycocg;
+
+            // Distance from the output pixel to where this sample was actually shaded
+            vec2  offset = vec2(texel) + 0.5f - jitter - renderPixel;
+            float weight = exp(-TAA_UPSAMPLE_FILTER_SHARPNESS * dot(offset, offset));
+
+            reconstructedColor += color * weight;
+            totalWeight        += weight;
+            maxWeight           = max(maxWeight, weight);
+        }
+    }
+
+    vec3 currentColor;
+
+    if (Constants.CurrentMode == Mode_Upsample)
+    {
+        currentColor = reconstructedColor / totalWeight;
+    }
+    else
+    {
+        // Bilinear, so lower render scales still upsample smoothly
+        currentColor = texture(sampler2D(Textures[Constants.CurrentColorIndex], Samplers[Constants.LinearSamplerIndex]), currentUV).rgb;
+        currentColor = ToneMap(currentColor);
+        maxWeight    = 1.0f;
+    }
 
     vec3 mean         = moment1 / 9.0f;
     vec3 variance     = (moment2 / 9.0f) - (mean * mean);
     vec3 stdDeviation = sqrt(max(variance, vec3(0.0f)));
 
     historyColor = RGBToYCoCg(historyColor);
-    historyColor = ClipTowardsAABBCenter(historyColor, sampleMiddleMiddle, mean - stdDeviation, mean + stdDeviation);
+    historyColor = ClipTowardsAABBCenter(historyColor, RGBToYCoCg(currentColor), mean - stdDeviation, mean + stdDeviation);
     historyColor = YCoCgToRGB(historyColor);
 
     float historyConfidence = texture(sampler2D(Textures[Constants.HistoryBufferIndex], Samplers[Constants.PointSamplerIndex]), fragUV).a;
-    vec2  pixelMotionVector = abs(closestMotionVector) * sceneColorSize;
+    vec2  pixelMotionVector = abs(closestMotionVector) * historySize;
 
     if (pixelMotionVector.x < 0.01f && pixelMotionVector.y < 0.01f)
     {
@@ -156,6 +192,7 @@ void main()
 
     // https://hhoppe.com/supersample.pdf, section 4.1
     float currentColorFactor = clamp(1.0f / historyConfidence, TAA_MIN_HISTORY_BLEND_RATE, TAA_DEFAULT_HISTORY_BLEND_RATE);
+          currentColorFactor *= maxWeight; // Output pixels with no nearby sample this frame lean on history
     vec2  clampedHistoryUV   = saturate(historyUV);
 
     if (clampedHistoryUV.x != historyUV.x || clampedHistoryUV.y != historyUV.y)
@@ -200,9 +237,8 @@ vec3 ReverseToneMap(vec3 color)
     return color * rcp(1.0f - max3(color));
 }
 
-vec3 SampleSceneColor(vec2 fragUV)
+// Texels past the render extent are left over from larger frames
+vec2 ClampToRenderExtent(vec2 uv, vec2 texelSize)
 {
-    vec3 color = texture(sampler2D(Textures[Constants.CurrentColorIndex], Samplers[Constants.PointSamplerIndex]), fragUV).rgb;
-
-    return RGBToYCoCg(ToneMap(color));
+    return min(uv, Constants.Scene.renderScale - 0.5f * texelSize);
 }
\ No newline at end of file
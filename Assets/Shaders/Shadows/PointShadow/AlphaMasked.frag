@@ -28,18 +28,19 @@ layout(location = 0) out float lightDistance;
 
 #include "MegaSet.glsl"
 #include "Shadows/PointShadow/AlphaMasked.h"
+#include "ShadowAtlas.glsl"
 
 void main()
 {
-    Mesh mesh = Constants.Meshes.meshes[fragDrawID];
+    Material material = Constants.Materials.materials[Constants.Meshes.meshes[fragDrawID].materialIndex];
 
-    float alpha  = texture(sampler2D(Textures[mesh.material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV).a;
-          alpha *= mesh.material.albedoFactor.a;
+    float alpha  = texture(sampler2D(Textures[material.albedoID], Samplers[Constants.TextureSamplerIndex]), fragUV).a;
+          alpha *= material.albedoFactor.a;
 
-    if (alpha < mesh.material.alphaCutOff)
+    if (alpha < material.alphaCutOff)
     {
         discard;
     }
 
-    lightDistance = length(fragPosition - Constants.Scene.ShadowedPointLights.lights[Constants.LightIndex].position);
+    lightDistance = length(fragPosition - GetShadowLightPosition(Constants.Scene, Constants.LightIndex));
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 #extension GL_EXT_scalar_block_layout  : enable
 
 #include "Shadows/PointShadow/AlphaMasked.h"
+#include "ShadowAtlas.glsl"
 
 layout(location = 0) out      vec3 fragPosition;
 layout(location = 1) out      vec2 fragUV;
@@ -28,18 +29,19 @@ layout(location = 2) out flat uint fragDrawID;
 
 void main()
 {
-    uint meshIndex = Constants.MeshIndices.indices[gl_DrawID];
-    Mesh mesh      = Constants.Meshes.meshes[meshIndex];
+    uint      meshIndex = Constants.MeshIndices.indices[gl_InstanceIndex];
+    Transform transform = Constants.Transforms.transforms[meshIndex];
+    Material  material  = Constants.Materials.materials[Constants.Meshes.meshes[meshIndex].materialIndex];
 
     vec3   position = Constants.Positions.positions[gl_VertexIndex];
     Vertex vertex   = Constants.Vertices.vertices[gl_VertexIndex];
 
-    mat4 projectionView = Constants.Scene.ShadowedPointLights.lights[Constants.LightIndex].matrices[Constants.FaceIndex];
+    mat4 projectionView = GetShadowMatrix(Constants.Scene, Constants.LightIndex, Constants.FaceIndex);
 
-    vec4 fragPos = mesh.transform * vec4(position, 1.0f);
+    vec4 fragPos = transform.transform * vec4(position, 1.0f);
     gl_Position  = projectionView * fragPos;
     fragPosition = fragPos.xyz;
 
-    fragUV     = vertex.uv[mesh.material.albedoUVMapID];
+    fragUV     = vertex.uv[material.albedoUVMapID];
     fragDrawID = meshIndex;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#version 460
+
+#extension GL_GOOGLE_include_directive        : enable
+#extension GL_EXT_buffer_reference2           : enable
+#extension GL_EXT_scalar_block_layout         : enable
+#extension GL_ARB_shader_viewport_layer_array : enable
+
+#include "Shadows/PointShadow/AlphaMasked.h"
+#include "Culling/MultiViewLayout.h"
+#include "ShadowAtlas.glsl"
+
+layout(location = 0) out      vec3 fragPosition;
+layout(location = 1) out      vec2 fragUV;
+layout(location = 2) out flat uint fragDrawID;
+
+// Every face of the light is drawn by one instanced draw, the culling pass tags each instance with its face
+void main()
+{
+    uint instance  = Constants.MeshIndices.indices[gl_InstanceIndex];
+    uint meshIndex = instance & VIEW_MESH_INDEX_MASK;
+    uint face      = instance >> VIEW_TAG_SHIFT;
+
+    Transform transform = Constants.Transforms.transforms[meshIndex];
+    Material  material  = Constants.Materials.materials[Constants.Meshes.meshes[meshIndex].materialIndex];
+
+    vec3   position = Constants.Positions.positions[gl_VertexIndex];
+    Vertex vertex   = Constants.Vertices.vertices[gl_VertexIndex];
+
+    mat4 projectionView = GetShadowMatrix(Constants.Scene, Constants.LightIndex, face);
+
+    vec4 fragPos = transform.transform * vec4(position, 1.0f);
+    gl_Position  = projectionView * fragPos;
+    fragPosition = fragPos.xyz;
+
+    fragUV     = vertex.uv[material.albedoUVMapID];
+    fragDrawID = meshIndex;
+
+    gl_ViewportIndex = int(face);
+}
\ No newline at end of file
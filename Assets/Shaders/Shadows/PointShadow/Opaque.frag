@@ -25,8 +25,9 @@ layout(location = 0) in vec3 fragPosition;
 layout(location = 0) out float lightDistance;
 
 #include "Shadows/PointShadow/Opaque.h"
+#include "ShadowAtlas.glsl"
 
 void main()
 {
-    lightDistance = length(fragPosition - Constants.Scene.ShadowedPointLights.lights[Constants.LightIndex].position);
+    lightDistance = length(fragPosition - GetShadowLightPosition(Constants.Scene, Constants.LightIndex));
 }
\ No newline at end of file
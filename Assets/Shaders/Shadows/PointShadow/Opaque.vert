@@ -21,13 +21,14 @@
 #extension GL_EXT_scalar_block_layout  : enable
 
 #include "Shadows/PointShadow/Opaque.h"
+#include "ShadowAtlas.glsl"
 
 layout(location = 0) out vec3 fragPosition;
 
 // Note: Writing the shader in this way reduces register pressure a lot (for some reason)
 void main()
 {
-    vec4 fragPos = Constants.Meshes.meshes[Constants.MeshIndices.indices[gl_DrawID]].transform * vec4(Constants.Positions.positions[gl_VertexIndex], 1.0f);
+    vec4 fragPos = Constants.Transforms.transforms[Constants.MeshIndices.indices[gl_InstanceIndex]].transform * vec4(Constants.Positions.positions[gl_VertexIndex], 1.0f);
     fragPosition = fragPos.xyz;
-    gl_Position  = Constants.Scene.ShadowedPointLights.lights[Constants.LightIndex].matrices[Constants.FaceIndex] * fragPos;
+    gl_Position  = GetShadowMatrix(Constants.Scene, Constants.LightIndex, Constants.FaceIndex) * fragPos;
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#version 460
+
+#extension GL_GOOGLE_include_directive        : enable
+#extension GL_EXT_buffer_reference2           : enable
+#extension GL_EXT_scalar_block_layout         : enable
+#extension GL_ARB_shader_viewport_layer_array : enable
+
+#include "Shadows/PointShadow/Opaque.h"
+#include "Culling/MultiViewLayout.h"
+#include "ShadowAtlas.glsl"
+
+layout(location = 0) out vec3 fragPosition;
+
+// Every face of the light is drawn by one instanced draw, the culling pass tags each instance with its face
+void main()
+{
+    uint instance = Constants.MeshIndices.indices[gl_InstanceIndex];
+    uint face     = instance >> VIEW_TAG_SHIFT;
+
+    vec4 fragPos = Constants.Transforms.transforms[instance & VIEW_MESH_INDEX_MASK].transform * vec4(Constants.Positions.positions[gl_VertexIndex], 1.0f);
+    fragPosition = fragPos.xyz;
+    gl_Position  = GetShadowMatrix(Constants.Scene, Constants.LightIndex, face) * fragPos;
+
+    gl_ViewportIndex = int(face);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLUSTER_CULL_PUSH_CONSTANT
+#define CLUSTER_CULL_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "GPU/Scene.h"
+#include "GPU/Cluster.h"
+
+#ifndef __cplusplus
+#include "DrawCall.glsl"
+#endif
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::Cluster)
+
+// Cluster draws per bucket, clusters past this are dropped
+GLSL_CONSTANT(u32, MAX_CLUSTER_DRAW_COUNT, 1u << 17);
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
+    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer) Transforms;
+    GLSL_BUFFER_POINTER(ClusterBuffer)   Clusters;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)  DrawCalls;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer) MeshIndices;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)  CulledDrawCalls;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer) CulledMeshIndices;
+    // Optional, when set surviving clusters are also written here so they can be drawn on their own
+    GLSL_BUFFER_POINTER(DrawCallBuffer)  LateDrawCalls;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer) LateMeshIndices;
+
+    GLSL_UVEC2 ViewportSize;
+
+    u32 PointSamplerIndex;
+    u32 HiZIndex;
+    u32 TestOcclusion;
+    u32 CullBackFaces;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -29,17 +29,18 @@ GLSL_NAMESPACE_BEGIN(Renderer::Culling::Frustum)
 
 GLSL_PUSH_CONSTANT_BEGIN
 {
-    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
-    GLSL_BUFFER_POINTER(DrawCallBuffer)  DrawCalls;
-    GLSL_BUFFER_POINTER(DrawCallBuffer)  CulledOpaqueDrawCalls;
-    GLSL_BUFFER_POINTER(MeshIndexBuffer) CulledOpaqueMeshIndices;
-    GLSL_BUFFER_POINTER(DrawCallBuffer)  CulledOpaqueDoubleSidedDrawCalls;
-    GLSL_BUFFER_POINTER(MeshIndexBuffer) CulledOpaqueDoubleSidedMeshIndices;
-    GLSL_BUFFER_POINTER(DrawCallBuffer)  CulledAlphaMaskedDrawCalls;
-    GLSL_BUFFER_POINTER(MeshIndexBuffer) CulledAlphaMaskedMeshIndices;
-    GLSL_BUFFER_POINTER(DrawCallBuffer)  CulledAlphaMaskedDoubleSidedDrawCalls;
-    GLSL_BUFFER_POINTER(MeshIndexBuffer) CulledAlphaMaskedDoubleSidedMeshIndices;
-    GLSL_BUFFER_POINTER(FrustumBuffer)   Frustum;
+    GLSL_BUFFER_POINTER(MeshBuffer)          Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer)     Transforms;
+    GLSL_BUFFER_POINTER(AABBBuffer)          Bounds;
+    GLSL_BUFFER_POINTER(MaterialBuffer)      Materials;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)      DrawCalls;
+    GLSL_BUFFER_POINTER(DrawInstanceBuffer)  Instances;
+    GLSL_BUFFER_POINTER(InstanceCountBuffer) VisibleInstanceCounts;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledOpaqueMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledOpaqueDoubleSidedMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledAlphaMaskedMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledAlphaMaskedDoubleSidedMeshIndices;
+    GLSL_BUFFER_POINTER(FrustumBuffer)       Frustum;
 } GLSL_PUSH_CONSTANT_END;
 
 GLSL_NAMESPACE_END
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIZ_PUSH_CONSTANT
+#define HIZ_PUSH_CONSTANT
+
+#include "GLSL.h"
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::HiZ)
+
+// Mip N covers 2^(N + 1) x 2^(N + 1) depth texels
+GLSL_CONSTANT(u32, HIZ_MIP_LEVELS, 10);
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    u32 PointSamplerIndex;
+    u32 InputIndex;
+    u32 OutputIndex;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
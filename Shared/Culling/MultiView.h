@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MULTI_VIEW_CULL_PUSH_CONSTANT
+#define MULTI_VIEW_CULL_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "Culling/MultiViewLayout.h"
+
+#ifndef __cplusplus
+#include "DrawCall.glsl"
+#endif
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::MultiView)
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(TransformBuffer)     Transforms;
+    GLSL_BUFFER_POINTER(AABBBuffer)          Bounds;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)      DrawCalls;
+    GLSL_BUFFER_POINTER(DrawInstanceBuffer)  Instances;
+    GLSL_BUFFER_POINTER(InstanceCountBuffer) VisibleInstanceCounts;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledMeshIndices;
+    GLSL_BUFFER_POINTER(ViewFrustumBuffer)   Frustums;
+    GLSL_BUFFER_POINTER(ViewInfoBuffer)      Views;
+
+    u32 ViewCount;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
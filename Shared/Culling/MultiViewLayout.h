@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MULTI_VIEW_LAYOUT_H
+#define MULTI_VIEW_LAYOUT_H
+
+#include "GLSL.h"
+#include "GPU/Plane.h"
+
+#ifndef __cplusplus
+#include "DrawCall.glsl"
+#endif
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::MultiView)
+
+// One view per point shadow face and shadowed spot light
+GLSL_CONSTANT(u32, MAX_CULLING_VIEWS, 28);
+// Draw calls each view can hold per bucket, more than this falls back to culling views one at a time
+GLSL_CONSTANT(u32, MAX_VIEW_DRAW_CALLS, 4096);
+// Mesh indices of each view, same as the mesh count limit
+GLSL_CONSTANT(u32, MAX_VIEW_INSTANCES, 1u << 16);
+// Mesh indices fit in the low bits, the tag of the view that culled them goes in the high bits
+GLSL_CONSTANT(u32, VIEW_TAG_SHIFT, 16);
+GLSL_CONSTANT(u32, VIEW_MESH_INDEX_MASK, (1u << 16) - 1);
+
+GLSL_ENUM_CLASS_BEGIN(Bucket, u32)
+    GLSL_ENUM_CLASS_ENTRY(Bucket, u32, Opaque,                 0)
+    GLSL_ENUM_CLASS_ENTRY(Bucket, u32, OpaqueDoubleSided,      1)
+    GLSL_ENUM_CLASS_ENTRY(Bucket, u32, AlphaMasked,            2)
+    GLSL_ENUM_CLASS_ENTRY(Bucket, u32, AlphaMaskedDoubleSided, 3)
+GLSL_ENUM_CLASS_END
+
+GLSL_CONSTANT(u32, BUCKET_COUNT, 4);
+
+// Views of a group are contiguous and share the draws of its first view, instances are tagged with the view they are visible in
+struct ViewInfo
+{
+    u32 groupView;
+    u32 groupSize;
+    u32 tag;
+};
+
+#ifndef __cplusplus
+// Six planes per view
+layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer ViewFrustumBuffer
+{
+    Plane planes[];
+};
+
+layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer ViewInfoBuffer
+{
+    ViewInfo views[];
+};
+
+// Draw counts of every view and bucket, followed by their draw calls
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer ViewDrawCallBuffer
+{
+    uint     counts[MAX_CULLING_VIEWS * BUCKET_COUNT];
+    DrawCall drawCalls[];
+};
+#endif
+
+GLSL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OCCLUSION_CULL_PUSH_CONSTANT
+#define OCCLUSION_CULL_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "GPU/Scene.h"
+
+#ifndef __cplusplus
+#include "DrawCall.glsl"
+#endif
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::Occlusion)
+
+GLSL_ENUM_CLASS_BEGIN(Pass, u32)
+    GLSL_ENUM_CLASS_ENTRY(Pass, u32, Early, 0)
+    GLSL_ENUM_CLASS_ENTRY(Pass, u32, Late,  1)
+GLSL_ENUM_CLASS_END
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(SceneBuffer)         Scene;
+    GLSL_BUFFER_POINTER(MeshBuffer)          Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer)     Transforms;
+    GLSL_BUFFER_POINTER(AABBBuffer)          Bounds;
+    GLSL_BUFFER_POINTER(MaterialBuffer)      Materials;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)      DrawCalls;
+    GLSL_BUFFER_POINTER(DrawInstanceBuffer)  Instances;
+    GLSL_BUFFER_POINTER(InstanceCountBuffer) VisibleInstanceCounts;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledOpaqueMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledOpaqueDoubleSidedMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledAlphaMaskedMeshIndices;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)     CulledAlphaMaskedDoubleSidedMeshIndices;
+    GLSL_BUFFER_POINTER(VisibilityBuffer)    Visibility;
+
+    GLSL_UVEC2 ViewportSize;
+
+    u32 PointSamplerIndex;
+    u32 HiZIndex;
+
+    GLSL_ENUM_CLASS_NAME(Pass, u32) CurrentPass;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
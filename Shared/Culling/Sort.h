@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SORT_DRAWS_PUSH_CONSTANT
+#define SORT_DRAWS_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "Culling/MultiViewLayout.h"
+
+GLSL_NAMESPACE_BEGIN(Renderer::Culling::Sort)
+
+// Each workgroup sorts one list in shared memory, longer lists keep their compaction order
+GLSL_CONSTANT(u32, SORT_WORKGROUP_SIZE,   1024);
+GLSL_CONSTANT(u32, MAX_SORTED_DRAW_CALLS, 2048);
+// Instances tested per draw when finding its nearest depth
+GLSL_CONSTANT(u32, MAX_SORTED_INSTANCES, 32);
+
+#ifndef __cplusplus
+layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer SortCountBuffer
+{
+    uint counts[];
+};
+
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer SortDrawCallBuffer
+{
+    DrawCall drawCalls[];
+};
+#endif
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(SortCountBuffer)    Counts;
+    GLSL_BUFFER_POINTER(SortDrawCallBuffer) DrawCalls;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer)    MeshIndices;
+    GLSL_BUFFER_POINTER(TransformBuffer)    Transforms;
+    GLSL_BUFFER_POINTER(AABBBuffer)         Bounds;
+    GLSL_BUFFER_POINTER(ViewFrustumBuffer)  Frustums;
+
+    // Draw calls between the start of consecutive lists
+    u32 ListStride;
+    // Lists that share a view, the view of a list is its index divided by this
+    u32 ListsPerView;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
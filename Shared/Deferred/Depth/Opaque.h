@@ -21,6 +21,7 @@
 #include "GPU/Mesh.h"
 #include "GPU/Vertex.h"
 #include "GPU/Scene.h"
+#include "GPU/Cluster.h"
 
 #ifndef __cplusplus
 #include "DrawCall.glsl"
@@ -31,9 +32,21 @@ GLSL_NAMESPACE_BEGIN(Renderer::Depth::Opaque)
 GLSL_PUSH_CONSTANT_BEGIN
 {
     GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
-    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer) Transforms;
     GLSL_BUFFER_POINTER(MeshIndexBuffer) MeshIndices;
     GLSL_BUFFER_POINTER(PositionBuffer)  Positions;
+    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(DrawCallBuffer)  DrawCalls;
+    GLSL_BUFFER_POINTER(ClusterBuffer)   Clusters;
+    GLSL_BUFFER_POINTER(IndexBuffer)     Indices;
+
+    // Mesh shading only, task shaders cull every cluster of a draw
+    GLSL_UVEC2 ViewportSize;
+
+    u32 PointSamplerIndex;
+    u32 HiZIndex;
+    u32 TestOcclusion;
+    u32 CullBackFaces;
 } GLSL_PUSH_CONSTANT_END;
 
 GLSL_NAMESPACE_END
@@ -19,12 +19,14 @@
 
 #include "GLSL.h"
 #include "GPU/Scene.h"
+#include "GPU/LightGrid.h"
 
 GLSL_NAMESPACE_BEGIN(Renderer::Lighting)
 
 GLSL_PUSH_CONSTANT_BEGIN
 {
-    GLSL_BUFFER_POINTER(SceneBuffer) Scene;
+    GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
+    GLSL_BUFFER_POINTER(LightGridBuffer) LightGrid;
 
     u32 GBufferSamplerIndex;
     u32 IBLSamplerIndex;
@@ -32,7 +34,6 @@ GLSL_PUSH_CONSTANT_BEGIN
 
     u32 GAlbedoIndex;
     u32 GNormalIndex;
-    u32 GRghMtlIndex;
     u32 GEmmisiveIndex;
     u32 SceneDepthIndex;
 
@@ -41,7 +42,7 @@ GLSL_PUSH_CONSTANT_BEGIN
     u32 BRDFLUTIndex;
 
     u32 ShadowMapIndex;
-    u32 PointShadowMapIndex;
+    u32 ShadowAtlasIndex;
 
     u32 AOIndex;
 } GLSL_PUSH_CONSTANT_END;
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VISIBILITY_BUFFER_LAYOUT_H
+#define VISIBILITY_BUFFER_LAYOUT_H
+
+#include "GLSL.h"
+
+GLSL_NAMESPACE_BEGIN(Renderer::GBuffer::VisibilityBuffer)
+
+// Cleared mesh index, marks pixels no mesh covered
+GLSL_CONSTANT(u32, VISIBILITY_EMPTY, 0xFFFFFFFF);
+
+#ifndef __cplusplus
+// Mesh index in the first channel and triangle within the mesh in the second, so neither overflows into the other
+uvec2 VisibilityBuffer_Pack(uint meshIndex, uint triangleIndex)
+{
+    return uvec2(meshIndex, triangleIndex);
+}
+
+uint VisibilityBuffer_GetMeshIndex(uvec2 visibility)
+{
+    return visibility.x;
+}
+
+uint VisibilityBuffer_GetTriangleIndex(uvec2 visibility)
+{
+    return visibility.y;
+}
+#endif
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VISIBILITY_BUFFER_RASTER_PUSH_CONSTANT
+#define VISIBILITY_BUFFER_RASTER_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "GPU/Vertex.h"
+#include "GPU/Scene.h"
+#include "GPU/Cluster.h"
+#include "Deferred/VisibilityBuffer/Layout.h"
+
+#ifndef __cplusplus
+#include "DrawCall.glsl"
+#endif
+
+GLSL_NAMESPACE_BEGIN(Renderer::GBuffer::VisibilityBuffer)
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
+    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer) Transforms;
+    GLSL_BUFFER_POINTER(MeshIndexBuffer) MeshIndices;
+    GLSL_BUFFER_POINTER(PositionBuffer)  Positions;
+    // Indexed by gl_DrawID, cluster draws start partway into their mesh's indices
+    GLSL_BUFFER_POINTER(DrawCallBuffer)  DrawCalls;
+    GLSL_BUFFER_POINTER(ClusterBuffer)   Clusters;
+    GLSL_BUFFER_POINTER(IndexBuffer)     Indices;
+
+    // Mesh shading only, task shaders cull every cluster of a draw
+    GLSL_UVEC2 ViewportSize;
+
+    u32 PointSamplerIndex;
+    u32 HiZIndex;
+    u32 TestOcclusion;
+    u32 CullBackFaces;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VISIBILITY_BUFFER_RESOLVE_PUSH_CONSTANT
+#define VISIBILITY_BUFFER_RESOLVE_PUSH_CONSTANT
+
+#include "GLSL.h"
+#include "GPU/Mesh.h"
+#include "GPU/Vertex.h"
+#include "GPU/Scene.h"
+#include "Deferred/VisibilityBuffer/Layout.h"
+
+GLSL_NAMESPACE_BEGIN(Renderer::GBuffer::Resolve)
+
+GLSL_PUSH_CONSTANT_BEGIN
+{
+    GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
+    GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer) CurrentTransforms;
+    GLSL_BUFFER_POINTER(TransformBuffer) PreviousTransforms;
+    GLSL_BUFFER_POINTER(MaterialBuffer)  Materials;
+    GLSL_BUFFER_POINTER(IndexBuffer)     Indices;
+    GLSL_BUFFER_POINTER(PositionBuffer)  Positions;
+    GLSL_BUFFER_POINTER(VertexBuffer)    Vertices;
+
+    GLSL_UVEC2 ViewportSize;
+
+    u32 TextureSamplerIndex;
+    u32 PointSamplerIndex;
+    u32 VisibilityBufferIndex;
+    u32 OutAlbedoReflectanceIndex;
+    u32 OutNormalIndex;
+    u32 OutEmmisiveIndex;
+    u32 OutMotionVectorsIndex;
+} GLSL_PUSH_CONSTANT_END;
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
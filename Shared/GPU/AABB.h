@@ -31,6 +31,11 @@ struct AABB
 
 #include "Constants.glsl"
 
+layout(buffer_reference, scalar) readonly buffer AABBBuffer
+{
+    AABB aabbs[];
+};
+
 vec3[8] AABB_GetCorners(AABB aabb)
 {
     const vec3 corners[8] =
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLUSTER_GLSL
+#define CLUSTER_GLSL
+
+#include "GLSL.h"
+#include "AABB.h"
+
+GLSL_NAMESPACE_BEGIN(GPU)
+
+GLSL_CONSTANT(u32, CLUSTER_MAX_TRIANGLES, 64);
+
+// Mesh shading, each task workgroup culls this many instance and cluster pairs of one draw
+GLSL_CONSTANT(u32, CLUSTER_TASK_WORKGROUP_SIZE, 32);
+// Every cluster is split across two mesh workgroups, keeping their outputs under the minimum device limits
+GLSL_CONSTANT(u32, CLUSTER_MESH_MAX_TRIANGLES, CLUSTER_MAX_TRIANGLES / 2);
+
+// A run of consecutive triangles of a surface, bounds are in mesh space and indices are relative to the surface
+struct Cluster
+{
+    AABB      aabb;
+    GLSL_VEC3 coneAxis;
+    f32       coneCutoff;
+    u32       firstIndex;
+    u32       indexCount;
+};
+
+#ifndef __cplusplus
+
+layout(buffer_reference, scalar) readonly buffer ClusterBuffer
+{
+    Cluster clusters[];
+};
+
+// Normal cone test, true if every triangle faces away from the camera
+bool Cluster_IsBackFacing(Cluster cluster, mat4 transform, mat3 normalMatrix, vec3 cameraPosition)
+{
+    // Cutoffs of one and above mark clusters whose normals spread too far to ever be rejected
+    if (cluster.coneCutoff >= 1.0f)
+    {
+        return false;
+    }
+
+    vec3  center = (transform * vec4((cluster.aabb.min + cluster.aabb.max) * 0.5f, 1.0f)).xyz;
+    vec3  axis   = normalize(normalMatrix * cluster.coneAxis);
+    float scale  = max(max(length(transform[0].xyz), length(transform[1].xyz)), length(transform[2].xyz));
+    float radius = length(cluster.aabb.max - cluster.aabb.min) * 0.5f * scale;
+
+    vec3 cameraToCenter = center - cameraPosition;
+
+    return dot(cameraToCenter, axis) >= cluster.coneCutoff * length(cameraToCenter) + radius;
+}
+
+#endif
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAW_INSTANCE_GLSL
+#define DRAW_INSTANCE_GLSL
+
+#include "GLSL.h"
+
+GLSL_NAMESPACE_BEGIN(GPU)
+
+// One instance of an instanced draw, points back at the mesh and the draw call it belongs to
+struct DrawInstance
+{
+    u32 meshIndex;
+    u32 drawCallIndex;
+};
+
+#ifndef __cplusplus
+
+layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer DrawInstanceBuffer
+{
+    uint         count;
+    DrawInstance instances[];
+};
+
+#endif
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIGHT_GRID_GLSL
+#define LIGHT_GRID_GLSL
+
+#include "GLSL.h"
+
+GLSL_NAMESPACE_BEGIN(GPU)
+
+// Froxel grid, tiles are in screen UV space and slices are distributed exponentially between the near and far planes
+// The projection has no far plane, so the last slice also covers everything beyond it
+GLSL_CONSTANT(u32, LIGHT_GRID_SIZE_X, 16);
+GLSL_CONSTANT(u32, LIGHT_GRID_SIZE_Y, 9);
+GLSL_CONSTANT(u32, LIGHT_GRID_SIZE_Z, 24);
+
+GLSL_CONSTANT(u32, LIGHT_GRID_CLUSTER_COUNT, LIGHT_GRID_SIZE_X * LIGHT_GRID_SIZE_Y * LIGHT_GRID_SIZE_Z);
+
+GLSL_CONSTANT(u32, MAX_LIGHTS_PER_CLUSTER, 128);
+
+// Set on indices that refer to spot lights, everything else refers to unshadowed point lights
+GLSL_CONSTANT(u32, LIGHT_INDEX_SPOT_BIT, 1u << 31);
+
+struct LightCluster
+{
+    u32 count;
+    u32 indices[MAX_LIGHTS_PER_CLUSTER];
+};
+
+#ifndef __cplusplus
+
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer LightGridBuffer
+{
+    LightCluster clusters[];
+};
+
+// Clusters that had more lights than MAX_LIGHTS_PER_CLUSTER, read back on the CPU
+layout(buffer_reference, scalar, buffer_reference_align = 4) buffer LightGridOverflowBuffer
+{
+    uint overflowCount;
+};
+
+uint LightGrid_GetSlice(float viewDepth, float nearPlane, float farPlane)
+{
+    float slice = log(max(viewDepth, nearPlane) / nearPlane) / log(farPlane / nearPlane) * float(LIGHT_GRID_SIZE_Z);
+
+    // Clamp before converting, depths far past the far plane would not fit in a uint
+    return uint(min(slice, float(LIGHT_GRID_SIZE_Z - 1)));
+}
+
+float LightGrid_GetSliceDepth(uint slice, float nearPlane, float farPlane)
+{
+    return nearPlane * pow(farPlane / nearPlane, float(slice) / float(LIGHT_GRID_SIZE_Z));
+}
+
+uint LightGrid_GetClusterIndex(uvec3 cluster)
+{
+    return cluster.x + LIGHT_GRID_SIZE_X * (cluster.y + LIGHT_GRID_SIZE_Y * cluster.z);
+}
+
+uint LightGrid_GetClusterIndex(vec2 screenUV, float viewDepth, float nearPlane, float farPlane)
+{
+    uvec2 tile  = min(uvec2(screenUV * vec2(LIGHT_GRID_SIZE_X, LIGHT_GRID_SIZE_Y)), uvec2(LIGHT_GRID_SIZE_X - 1, LIGHT_GRID_SIZE_Y - 1));
+    uint  slice = LightGrid_GetSlice(viewDepth, nearPlane, farPlane);
+
+    return LightGrid_GetClusterIndex(uvec3(tile, slice));
+}
+
+#endif
+
+GLSL_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -28,15 +28,21 @@ GLSL_NAMESPACE_BEGIN(GPU)
 
 #ifdef __cplusplus
 
-constexpr u32 MAX_POINT_LIGHT_COUNT          = 16;
 constexpr u32 MAX_SHADOWED_POINT_LIGHT_COUNT = 4;
+constexpr u32 MAX_SHADOWED_SPOT_LIGHT_COUNT  = 4;
 
-constexpr u32 MAX_SPOT_LIGHT_COUNT = 16;
-
-constexpr glm::uvec2 POINT_SHADOW_DIMENSIONS = {512, 512};
+// Tiles are powers of two, sized by how large the light appears on screen
+constexpr u32 SHADOW_ATLAS_MIN_TILE_SIZE = 32;
+constexpr u32 SHADOW_ATLAS_MAX_TILE_SIZE = 512;
 
 #endif
 
+// Point light faces and spot lights all share one atlas
+GLSL_CONSTANT(u32, SHADOW_ATLAS_SIZE, 2048);
+
+// Set on shadow pass light indices that refer to shadowed spot lights
+GLSL_CONSTANT(u32, SHADOW_LIGHT_INDEX_SPOT_BIT, 1u << 31);
+
 struct DirLight
 {
     GLSL_VEC3 position;
@@ -62,13 +68,13 @@ struct ShadowedPointLight
           color(pointLight.color),
           intensity(pointLight.intensity),
           range(pointLight.range),
-          matrices()
+          matrices(),
+          atlasRects()
     {
         auto projection = Maths::ProjectionReverseZ
         (
             glm::radians(90.0f),
-            static_cast<f32>(GPU::POINT_SHADOW_DIMENSIONS.x) /
-            static_cast<f32>(GPU::POINT_SHADOW_DIMENSIONS.y),
+            1.0f,
             Renderer::NEAR_PLANE,
             Renderer::FAR_PLANE
         );
@@ -89,6 +95,7 @@ struct ShadowedPointLight
     GLSL_VEC3 intensity;
     f32       range;
     GLSL_MAT4 matrices[6];
+    GLSL_VEC4 atlasRects[6];
 };
 
 struct SpotLight
@@ -101,13 +108,55 @@ struct SpotLight
     f32       range;
 };
 
+struct ShadowedSpotLight
+{
+    #ifdef __cplusplus
+    ShadowedSpotLight() = default;
+
+    explicit ShadowedSpotLight(const SpotLight& spotLight)
+        : position(spotLight.position),
+          color(spotLight.color),
+          intensity(spotLight.intensity),
+          direction(spotLight.direction),
+          cutOff(spotLight.cutOff),
+          range(spotLight.range),
+          matrix(),
+          atlasRect()
+    {
+        // Very wide cones can't be covered by a single perspective projection
+        const auto projection = Maths::ProjectionReverseZ
+        (
+            std::min(2.0f * cutOff.y, glm::radians(170.0f)),
+            1.0f,
+            Renderer::NEAR_PLANE,
+            Renderer::FAR_PLANE
+        );
+
+        const auto forward = glm::normalize(direction);
+        const auto up      = glm::abs(forward.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+        matrix = projection * glm::lookAtRH(position, position + forward, up);
+    }
+    #endif
+
+    GLSL_VEC3 position;
+    GLSL_VEC3 color;
+    GLSL_VEC3 intensity;
+    GLSL_VEC3 direction;
+    GLSL_VEC2 cutOff;
+    f32       range;
+    GLSL_MAT4 matrix;
+    GLSL_VEC4 atlasRect;
+};
+
 #ifdef __cplusplus
 
 template<typename T>
 concept IsLightType = std::is_same_v<T, DirLight> ||
                       std::is_same_v<T, PointLight> ||
                       std::is_same_v<T, ShadowedPointLight> ||
-                      std::is_same_v<T, SpotLight>;
+                      std::is_same_v<T, SpotLight> ||
+                      std::is_same_v<T, ShadowedSpotLight>;
 
 #endif
 
@@ -139,6 +188,12 @@ layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer Spo
     SpotLight lights[];
 };
 
+layout(buffer_reference, scalar, buffer_reference_align = 4) readonly buffer ShadowedSpotLightBuffer
+{
+    uint              count;
+    ShadowedSpotLight lights[];
+};
+
 struct LightInfo
 {
     vec3 L;
@@ -211,6 +266,18 @@ LightInfo GetLightInfo(SpotLight light, vec3 fragPosition)
     return info;
 }
 
+LightInfo GetLightInfo(ShadowedSpotLight light, vec3 fragPosition)
+{
+    LightInfo info;
+
+    info.L            = normalize(light.position - fragPosition);
+    float attenuation = CalculateAttenuation(light.position, light.range, fragPosition);
+    float intensity   = CalculateSpotIntensity(info.L, light.direction, light.cutOff);
+    info.radiance     = light.color * light.intensity * attenuation * intensity;
+
+    return info;
+}
+
 #endif
 
 GLSL_NAMESPACE_END
@@ -58,6 +58,11 @@ struct Material
 
 #ifndef __cplusplus
 
+layout(buffer_reference, scalar) readonly buffer MaterialBuffer
+{
+    Material materials[];
+};
+
 bool Material_IsDoubleSided(u32 flags)
 {
     return (flags & MaterialFlags_DoubleSided) == MaterialFlags_DoubleSided;
@@ -19,18 +19,17 @@
 
 #include "GLSL.h"
 #include "Material.h"
+#include "Transform.h"
 #include "AABB.h"
 #include "Surface.h"
 
 GLSL_NAMESPACE_BEGIN(GPU)
 
+// Transforms, bounds and materials live in their own buffers, indexed by mesh index (materials by materialIndex)
 struct Mesh
 {
     SurfaceInfo surfaceInfo;
-    Material    material;
-    GLSL_MAT4   transform;
-    GLSL_MAT3   normalMatrix;
-    AABB        aabb;
+    u32         materialIndex;
 };
 
 #ifndef __cplusplus
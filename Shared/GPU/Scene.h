@@ -40,10 +40,15 @@ GLSL_SHADER_STORAGE_BUFFER(SceneBuffer, readonly)
     f32 nearPlane;
     f32 farPlane;
 
+    // Internal resolution, and its ratio to the framebuffer size for turning screen UVs into texture UVs
+    GLSL_UVEC2 renderSize;
+    GLSL_VEC2  renderScale;
+
     GLSL_BUFFER_POINTER(SunBuffer)                Sun;
     GLSL_BUFFER_POINTER(PointLightBuffer)         PointLights;
     GLSL_BUFFER_POINTER(ShadowedPointLightBuffer) ShadowedPointLights;
     GLSL_BUFFER_POINTER(SpotLightBuffer)          SpotLights;
+    GLSL_BUFFER_POINTER(ShadowedSpotLightBuffer)  ShadowedSpotLights;
 };
 
 #ifndef __cplusplus
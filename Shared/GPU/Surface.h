@@ -32,6 +32,7 @@ struct SurfaceInfo
     GeometryInfo indexInfo;
     GeometryInfo positionInfo;
     GeometryInfo vertexInfo;
+    GeometryInfo clusterInfo;
 };
 
 GLSL_NAMESPACE_END
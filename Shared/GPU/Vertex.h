@@ -19,6 +19,10 @@
 
 #include "GLSL.h"
 
+#ifdef __cplusplus
+#include "Cluster.h"
+#endif
+
 GLSL_NAMESPACE_BEGIN(GPU)
 
 struct Vertex
@@ -55,7 +59,8 @@ using Index    = u32;
 template<typename T>
 concept IsVertexType = std::is_same_v<T, Index   > ||
                        std::is_same_v<T, Position> ||
-                       std::is_same_v<T, Vertex  >  ;
+                       std::is_same_v<T, Vertex  > ||
+                       std::is_same_v<T, Cluster >  ;
 
 #endif
 
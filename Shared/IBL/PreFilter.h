@@ -19,19 +19,13 @@
 
 #include "GLSL.h"
 
-#ifndef __cplusplus
-#include "Shared.glsl"
-#endif
-
 GLSL_NAMESPACE_BEGIN(Renderer::IBL::PreFilter)
 
 GLSL_PUSH_CONSTANT_BEGIN
 {
-    GLSL_BUFFER_POINTER(VertexBuffer) Vertices;
-    GLSL_BUFFER_POINTER(MatrixBuffer) Matrices;
-
     u32 SamplerIndex;
     u32 EnvMapIndex;
+    u32 OutputIndex;
     f32 Roughness;
     u32 SampleCount;
 } GLSL_PUSH_CONSTANT_END;
@@ -18,17 +18,27 @@
 #define TAA_PUSH_CONSTANT
 
 #include "GLSL.h"
+#include "GPU/Scene.h"
 
 GLSL_NAMESPACE_BEGIN(Renderer::TAA)
 
+GLSL_ENUM_CLASS_BEGIN(Mode, u32)
+    GLSL_ENUM_CLASS_ENTRY(Mode, u32, Native,   0)
+    GLSL_ENUM_CLASS_ENTRY(Mode, u32, Upsample, 1)
+GLSL_ENUM_CLASS_END
+
 GLSL_PUSH_CONSTANT_BEGIN
 {
+    GLSL_BUFFER_POINTER(SceneBuffer) Scene;
+
     u32 PointSamplerIndex;
     u32 LinearSamplerIndex;
     u32 CurrentColorIndex;
     u32 HistoryBufferIndex;
     u32 VelocityIndex;
     u32 SceneDepthIndex;
+
+    GLSL_ENUM_CLASS_NAME(Mode, u32) CurrentMode;
 } GLSL_PUSH_CONSTANT_END;
 
 GLSL_NAMESPACE_END
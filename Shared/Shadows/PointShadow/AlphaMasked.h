@@ -32,6 +32,8 @@ GLSL_PUSH_CONSTANT_BEGIN
 {
     GLSL_BUFFER_POINTER(SceneBuffer)     Scene;
     GLSL_BUFFER_POINTER(MeshBuffer)      Meshes;
+    GLSL_BUFFER_POINTER(TransformBuffer) Transforms;
+    GLSL_BUFFER_POINTER(MaterialBuffer)  Materials;
     GLSL_BUFFER_POINTER(MeshIndexBuffer) MeshIndices;
     GLSL_BUFFER_POINTER(PositionBuffer)  Positions;
     GLSL_BUFFER_POINTER(VertexBuffer)    Vertices;
@@ -96,7 +96,7 @@ namespace Engine
 
                         JSON::CheckError(light.get<GPU::PointLight>(pointLight), "Failed to load point light!");
 
-                        pointLights.emplace_back(pointLight);
+                        AddPointLight(pointLight, Renderer::ContentOwner::Scene);
                     }
                 }
 
@@ -112,11 +112,14 @@ namespace Engine
 
                         JSON::CheckError(light.get<GPU::SpotLight>(spotLight), "Failed to load spot light!");
 
-                        spotLights.emplace_back(spotLight);
+                        AddSpotLight(spotLight, Renderer::ContentOwner::Scene);
                     }
                 }
             }
 
+            // Streaming cells
+            m_streamer.LoadCells(document);
+
             // Camera
             JSON::CheckError(document["Camera"]["FreeCamera"].get<Renderer::Objects::FreeCamera>(camera), "Failed to load free camera!");
 
@@ -198,6 +201,17 @@ namespace Engine
 
                     ImGui::Separator();
 
+                    if (const auto hit = bvh.QueryRay(camera.position, camera.front, std::numeric_limits<f32>::max()); hit.has_value())
+                    {
+                        ImGui::Text("Looking At | [%u] (%.2f)", hit->objectIndex, hit->distance);
+                    }
+                    else
+                    {
+                        ImGui::Text("Looking At | None");
+                    }
+
+                    ImGui::Separator();
+
                     usize i = 0;
 
                     for (auto iter = renderObjects.begin(); iter != renderObjects.end(); ++i)
@@ -210,9 +224,16 @@ namespace Engine
 
                             ImGui::Separator();
 
-                            ImGui::DragFloat3("Position", &iter->position[0], 1.0f,                      0.0f, 0.0f, "%.2f");
-                            ImGui::DragFloat3("Rotation", &iter->rotation[0], glm::radians(1.0f), 0.0f, 0.0f, "%.2f");
-                            ImGui::DragFloat3("Scale",    &iter->scale[0],    1.0f,                      0.0f, 0.0f, "%.2f");
+                            bool isDirty = false;
+
+                            isDirty |= ImGui::DragFloat3("Position", &iter->position[0], 1.0f,                      0.0f, 0.0f, "%.2f");
+                            isDirty |= ImGui::DragFloat3("Rotation", &iter->rotation[0], glm::radians(1.0f), 0.0f, 0.0f, "%.2f");
+                            isDirty |= ImGui::DragFloat3("Scale",    &iter->scale[0],    1.0f,                      0.0f, 0.0f, "%.2f");
+
+                            if (isDirty)
+                            {
+                                dirtyRenderObjects.emplace_back(i);
+                            }
 
                             if (ImGui::Button("Delete"))
                             {
@@ -250,6 +271,19 @@ namespace Engine
 
                 ImGui::Separator();
 
+                generator.ImGuiDisplay
+                (
+                    *this,
+                    context,
+                    modelManager,
+                    megaSet,
+                    deletionQueue
+                );
+
+                m_streamer.ImGuiDisplay();
+
+                ImGui::Separator();
+
                 if (ImGui::BeginMenu("Lights"))
                 {
                     if (ImGui::BeginMenu("Sun"))
@@ -364,6 +398,63 @@ namespace Engine
             
             ImGui::EndMainMenuBar();
         }
+
+        m_streamer.Update
+        (
+            *this,
+            context,
+            modelManager,
+            megaSet,
+            deletionQueue
+        );
+
+        if (haveRenderObjectsChanged)
+        {
+            bvh.Build(modelManager, renderObjects);
+        }
+        else
+        {
+            bvh.Refit(modelManager, renderObjects, dirtyRenderObjects);
+        }
+    }
+
+    void Scene::AddPointLight(const GPU::PointLight& light, Renderer::ContentOwner owner)
+    {
+        pointLights.emplace_back(light);
+        pointLightOwners.emplace_back(owner);
+    }
+
+    void Scene::AddSpotLight(const GPU::SpotLight& light, Renderer::ContentOwner owner)
+    {
+        spotLights.emplace_back(light);
+        spotLightOwners.emplace_back(owner);
+    }
+
+    void Scene::RemoveLights(Renderer::ContentOwner owner)
+    {
+        const auto Remove = [owner] <typename T> (std::vector<T>& lights, std::vector<Renderer::ContentOwner>& owners)
+        {
+            usize count = 0;
+
+            for (usize i = 0; i < lights.size(); ++i)
+            {
+                if (owners[i] == owner)
+                {
+                    continue;
+                }
+
+                lights[count] = lights[i];
+                owners[count] = owners[i];
+
+                ++count;
+            }
+
+            lights.resize(count);
+            owners.resize(count);
+        };
+
+        Remove(pointLights, pointLightOwners);
+        Remove(spotLights,  spotLightOwners);
     }
 
     void Scene::Destroy
@@ -18,10 +18,13 @@
 #define SCENE_H
 
 #include "Config.h"
+#include "SceneGenerator.h"
+#include "SceneStreamer.h"
 #include "Renderer/RenderObject.h"
 #include "Renderer/Objects/FreeCamera.h"
 #include "Renderer/IBL/IBLMaps.h"
 #include "Renderer/IBL/Generator.h"
+#include "Renderer/Culling/BVH.h"
 #include "Models/ModelManager.h"
 #include "Util/FrameCounter.h"
 #include "GPU/Lights.h"
@@ -64,6 +67,12 @@ namespace Engine
             Util::DeletionQueue& deletionQueue
         );
 
+        void AddPointLight(const GPU::PointLight& light, Renderer::ContentOwner owner);
+        void AddSpotLight(const GPU::SpotLight& light, Renderer::ContentOwner owner);
+
+        // Removes every light added by this owner, leaving the rest in their original order
+        void RemoveLights(Renderer::ContentOwner owner);
+
         std::vector<Renderer::RenderObject> renderObjects = {};
         GPU::DirLight                       sun           = {};
         std::vector<GPU::PointLight>        pointLights   = {};
@@ -71,13 +80,29 @@ namespace Engine
         Renderer::Objects::FreeCamera       camera        = {};
         Renderer::IBL::IBLMaps              iblMaps       = {};
 
+        // Parallel to the light lists, only change them through AddPointLight, AddSpotLight and RemoveLights
+        std::vector<Renderer::ContentOwner> pointLightOwners = {};
+        std::vector<Renderer::ContentOwner> spotLightOwners  = {};
+
         // This does not account for render object internal changes
         // Only addition/deletion of render objects will update this
         bool haveRenderObjectsChanged = false;
+
+        // Indices of render objects whose transforms were modified this frame
+        // Cleared by the renderer once the mesh buffer has been updated
+        std::vector<usize> dirtyRenderObjects = {};
+
+        // Rebuilt when render objects are added or removed, refit when they move
+        Renderer::Culling::BVH bvh = {};
+
+        // Stress test content, layered on top of the loaded scene
+        SceneGenerator generator = {};
     private:
         std::string            m_hdrMap;
         std::string            m_modelPath          = {};
         Renderer::RenderObject m_loadedRenderObject = {};
+
+        SceneStreamer m_streamer = {};
     };
 }
 
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SceneGenerator.h"
+
+#include <random>
+#include <numbers>
+
+#include "Scene.h"
+#include "Renderer/Buffers/MeshBuffer.h"
+#include "Util/Files.h"
+#include "Util/Log.h"
+#include "Externals/ImGui.h"
+
+namespace Engine
+{
+    namespace
+    {
+        std::vector<std::string> GetModelPaths(const std::string_view models)
+        {
+            std::vector<std::string> paths = {};
+
+            for (usize start = 0; start <= models.size();)
+            {
+                const usize end = std::min(models.find(',', start), models.size());
+
+                const auto path  = models.substr(start, end - start);
+                const auto first = path.find_first_not_of(' ');
+
+                if (first != std::string_view::npos)
+                {
+                    const auto trimmed = std::string(path.substr(first, path.find_last_not_of(' ') - first + 1));
+
+                    if (Util::Files::Exists(Util::Files::GetAssetPath("GFX/", trimmed)))
+                    {
+                        paths.emplace_back(trimmed);
+                    }
+                    else
+                    {
+                        Logger::Warning("Skipping missing model! [Path={}]\n", trimmed);
+                    }
+                }
+
+                start = end + 1;
+            }
+
+            return paths;
+        }
+    }
+
+    usize SceneGenerator::Generate
+    (
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue,
+        usize instanceCount
+    )
+    {
+        Clear(scene, context, modelManager, megaSet, deletionQueue);
+
+        m_hasGenerated = true;
+
+        const auto modelPaths = GetModelPaths(settings.models);
+
+        usize meshCount = 0;
+
+        for (const auto& renderObject : scene.renderObjects)
+        {
+            meshCount += modelManager.GetModel(renderObject.modelID).meshes.size();
+        }
+
+        // Fixed seed, so every run of the benchmark sees the same scene
+        std::mt19937_64 generator(settings.seed);
+
+        std::uniform_real_distribution<f32> position(-settings.radius, settings.radius);
+        std::uniform_real_distribution<f32> height(0.0f, settings.radius * 0.1f);
+        std::uniform_real_distribution<f32> angle(0.0f, 2.0f * std::numbers::pi_v<f32>);
+        std::uniform_real_distribution<f32> scale(0.5f, 2.0f);
+        std::uniform_real_distribution<f32> unit(0.0f, 1.0f);
+
+        usize generated = 0;
+
+        for (; generated < instanceCount && !modelPaths.empty(); ++generated)
+        {
+            Renderer::RenderObject renderObject = {};
+
+            renderObject.modelID = modelManager.AddModel(context.allocator, deletionQueue, modelPaths[generated % modelPaths.size()]);
+
+            const usize objectMeshCount = modelManager.GetModel(renderObject.modelID).meshes.size();
+
+            if (meshCount + objectMeshCount > Renderer::Buffers::MAX_MESH_COUNT)
+            {
+                renderObject.Destroy
+                (
+                    context.device,
+                    context.allocator,
+                    megaSet,
+                    modelManager,
+                    deletionQueue
+                );
+
+                Logger::Warning("Mesh buffer is full! [Generated={}] [Requested={}]\n", generated, instanceCount);
+
+                break;
+            }
+
+            meshCount += objectMeshCount;
+
+            renderObject.position = {position(generator), height(generator), position(generator)};
+            renderObject.rotation = {0.0f, angle(generator), 0.0f};
+            renderObject.scale    = glm::vec3(scale(generator));
+            renderObject.owner    = Renderer::ContentOwner::Generator;
+
+            scene.renderObjects.emplace_back(renderObject);
+        }
+
+        for (usize i = 0; i < settings.pointLightCount; ++i)
+        {
+            scene.AddPointLight(GPU::PointLight{
+                .position  = {position(generator), height(generator), position(generator)},
+                .color     = {unit(generator), unit(generator), unit(generator)},
+                .intensity = glm::vec3(1.0f + 9.0f * unit(generator)),
+                .range     = settings.radius * (0.05f + 0.15f * unit(generator))
+            }, Renderer::ContentOwner::Generator);
+        }
+
+        for (usize i = 0; i < settings.spotLightCount; ++i)
+        {
+            scene.AddSpotLight(GPU::SpotLight{
+                .position  = {position(generator), height(generator), position(generator)},
+                .color     = {unit(generator), unit(generator), unit(generator)},
+                .intensity = glm::vec3(10.0f + 70.0f * unit(generator)),
+                .direction = glm::normalize(glm::vec3(unit(generator) * 2.0f - 1.0f, -1.0f, unit(generator) * 2.0f - 1.0f)),
+                .cutOff    = glm::radians(glm::vec2(10.0f, 30.0f)),
+                .range     = settings.radius * (0.05f + 0.15f * unit(generator))
+            }, Renderer::ContentOwner::Generator);
+        }
+
+        scene.haveRenderObjectsChanged = true;
+
+        Logger::Info
+        (
+            "Generated scene! [Instances={}] [Meshes={}] [PointLights={}] [SpotLights={}]\n",
+            generated,
+            meshCount,
+            settings.pointLightCount,
+            settings.spotLightCount
+        );
+
+        return generated;
+    }
+
+    void SceneGenerator::Clear
+    (
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        if (!m_hasGenerated)
+        {
+            return;
+        }
+
+        for (auto iter = scene.renderObjects.begin(); iter != scene.renderObjects.end();)
+        {
+            if (iter->owner != Renderer::ContentOwner::Generator)
+            {
+                ++iter;
+                continue;
+            }
+
+            iter->Destroy
+            (
+                context.device,
+                context.allocator,
+                megaSet,
+                modelManager,
+                deletionQueue
+            );
+
+            iter = scene.renderObjects.erase(iter);
+        }
+
+        scene.RemoveLights(Renderer::ContentOwner::Generator);
+
+        scene.haveRenderObjectsChanged = true;
+
+        m_hasGenerated = false;
+    }
+
+    void SceneGenerator::ImGuiDisplay
+    (
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        if (ImGui::BeginMenu("Generator"))
+        {
+            ImGui::InputText("Models", &settings.models);
+
+            ImGui::DragScalar("Instances",    ImGuiDataType_U64, &settings.instanceCount,   10.0f);
+            ImGui::DragScalar("Point Lights", ImGuiDataType_U64, &settings.pointLightCount, 1.0f);
+            ImGui::DragScalar("Spot Lights",  ImGuiDataType_U64, &settings.spotLightCount,  1.0f);
+            ImGui::DragFloat( "Radius",       &settings.radius,                             1.0f, 1.0f, 0.0f, "%.1f");
+            ImGui::DragScalar("Seed",         ImGuiDataType_U64, &settings.seed,            1.0f);
+
+            ImGui::Separator();
+
+            if (ImGui::Button("Generate"))
+            {
+                Generate
+                (
+                    scene,
+                    context,
+                    modelManager,
+                    megaSet,
+                    deletionQueue,
+                    settings.instanceCount
+                );
+            }
+
+            ImGui::SameLine();
+
+            if (ImGui::Button("Clear"))
+            {
+                Clear
+                (
+                    scene,
+                    context,
+                    modelManager,
+                    megaSet,
+                    deletionQueue
+                );
+            }
+
+            ImGui::EndMenu();
+        }
+    }
+}
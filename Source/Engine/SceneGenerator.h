@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENE_GENERATOR_H
+#define SCENE_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "Vulkan/Context.h"
+#include "Vulkan/MegaSet.h"
+#include "Models/ModelManager.h"
+#include "Util/DeletionQueue.h"
+#include "Util/Types.h"
+
+namespace Engine
+{
+    class Scene;
+
+    // Fills a loaded scene with randomly placed instances of existing models and random lights
+    class SceneGenerator
+    {
+    public:
+        struct Settings
+        {
+            // Comma separated model paths, relative to the GFX folder
+            std::string models          = "DeccerCubes/SM_Deccer_Cubes_Textured.glb";
+            usize       instanceCount   = 1000;
+            usize       pointLightCount = 16;
+            usize       spotLightCount  = 16;
+            f32         radius          = 500.0f;
+            u64         seed            = 0;
+        };
+
+        // Replaces anything generated earlier, returns the number of instances that fit in the mesh buffer
+        usize Generate
+        (
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue,
+            usize instanceCount
+        );
+
+        // Removes generated objects and lights, leaving whatever the scene was loaded with
+        void Clear
+        (
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
+        void ImGuiDisplay
+        (
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
+        Settings settings = {};
+    private:
+        bool m_hasGenerated = false;
+    };
+}
+
+#endif
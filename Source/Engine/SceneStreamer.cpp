@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SceneStreamer.h"
+
+#include <algorithm>
+
+#include "Scene.h"
+#include "Renderer/Buffers/MeshBuffer.h"
+#include "GPU/Vertex.h"
+#include "Util/JSON.h"
+#include "Util/Log.h"
+#include "Externals/ImGui.h"
+
+namespace Engine
+{
+    constexpr usize MAX_CONCURRENT_CELL_LOADS = 4;
+
+    void SceneStreamer::LoadCells(simdjson::ondemand::document& document)
+    {
+        if (auto streaming = document["Streaming"].get_object(); streaming.error() != simdjson::NO_SUCH_FIELD)
+        {
+            JSON::CheckError(streaming, "Failed to load streaming settings!");
+
+            u64 budgetMiB = 0;
+
+            JSON::CheckError(streaming["LoadRadius"  ].get<f32>(m_loadRadius),   "Failed to load streaming load radius!"  );
+            JSON::CheckError(streaming["UnloadRadius"].get<f32>(m_unloadRadius), "Failed to load streaming unload radius!");
+            JSON::CheckError(streaming["Budget"      ].get<u64>(budgetMiB),      "Failed to load streaming budget!"       );
+
+            m_unloadRadius = std::max(m_unloadRadius, m_loadRadius);
+            m_budget       = budgetMiB * 1024 * 1024;
+        }
+
+        auto cells = document["Cells"].get_array();
+
+        if (cells.error() == simdjson::NO_SUCH_FIELD)
+        {
+            return;
+        }
+
+        JSON::CheckError(cells, "Failed to load cells!");
+
+        for (auto cellValue : cells)
+        {
+            Cell cell = {};
+
+            JSON::CheckError(cellValue["Center"].get<glm::vec3>(cell.center), "Failed to load cell center!");
+
+            auto objects = cellValue["RenderObjects"].get_array();
+
+            JSON::CheckError(objects, "Failed to load cell render objects!");
+
+            for (auto object : objects)
+            {
+                CellObject cellObject = {};
+
+                auto model = object["Model"].get_string();
+
+                JSON::CheckError(model, "Failed to load model path!");
+
+                cellObject.model = model.value();
+
+                JSON::CheckError(object["Position"].get<glm::vec3>(cellObject.position), "Failed to load position!");
+                JSON::CheckError(object["Rotation"].get<glm::vec3>(cellObject.rotation), "Failed to load rotation!");
+                JSON::CheckError(object["Scale"   ].get<glm::vec3>(cellObject.scale   ), "Failed to load scale!"   );
+
+                cellObject.rotation = glm::radians(cellObject.rotation);
+
+                cell.objects.emplace_back(cellObject);
+            }
+
+            if (auto lights = cellValue["PointLights"].get_array(); lights.error() != simdjson::NO_SUCH_FIELD)
+            {
+                JSON::CheckError(lights, "Failed to load cell point lights!");
+
+                for (auto light : lights)
+                {
+                    GPU::PointLight pointLight = {};
+
+                    JSON::CheckError(light.get<GPU::PointLight>(pointLight), "Failed to load point light!");
+
+                    cell.pointLights.emplace_back(pointLight);
+                }
+            }
+
+            if (auto lights = cellValue["SpotLights"].get_array(); lights.error() != simdjson::NO_SUCH_FIELD)
+            {
+                JSON::CheckError(lights, "Failed to load cell spot lights!");
+
+                for (auto light : lights)
+                {
+                    GPU::SpotLight spotLight = {};
+
+                    JSON::CheckError(light.get<GPU::SpotLight>(spotLight), "Failed to load spot light!");
+
+                    cell.spotLights.emplace_back(spotLight);
+                }
+            }
+
+            m_cells.emplace_back(std::move(cell));
+        }
+
+        Logger::Info("Loaded streaming cells! [Count={}]\n", m_cells.size());
+    }
+
+    void SceneStreamer::Update
+    (
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        if (m_cells.empty())
+        {
+            return;
+        }
+
+        const auto Distance = [&scene] (const Cell& cell)
+        {
+            return glm::distance(cell.center, scene.camera.position);
+        };
+
+        bool hasChanged = false;
+
+        // Parsing happens on worker threads, creating the objects afterwards only costs the GPU upload
+        for (u32 i = 0; i < m_cells.size(); ++i)
+        {
+            if (m_cells[i].state != CellState::Loading)
+            {
+                continue;
+            }
+
+            bool isReady = true;
+
+            for (const auto& object : m_cells[i].objects)
+            {
+                if (!modelManager.IsModelReady(object.model))
+                {
+                    // The model may have been resident when the load started and unloaded since, prefetching again is a no-op otherwise
+                    modelManager.PrefetchModel(object.model);
+
+                    isReady = false;
+                }
+            }
+
+            if (isReady)
+            {
+                hasChanged |= Instantiate(i, scene, context, modelManager, megaSet, deletionQueue);
+            }
+        }
+
+        // Cells between the two radii keep whatever state they are in
+        for (u32 i = 0; i < m_cells.size(); ++i)
+        {
+            if (m_cells[i].state == CellState::Loaded && Distance(m_cells[i]) > m_unloadRadius)
+            {
+                Unload(i, scene, context, modelManager, megaSet, deletionQueue);
+
+                hasChanged = true;
+            }
+        }
+
+        // Over budget, drop the farthest cells first
+        while (GetResidentSize() > m_budget)
+        {
+            std::optional<u32> farthest = std::nullopt;
+
+            for (u32 i = 0; i < m_cells.size(); ++i)
+            {
+                if (m_cells[i].state == CellState::Loaded && (!farthest.has_value() || Distance(m_cells[i]) > Distance(m_cells[*farthest])))
+                {
+                    farthest = i;
+                }
+            }
+
+            if (!farthest.has_value())
+            {
+                break;
+            }
+
+            Unload(*farthest, scene, context, modelManager, megaSet, deletionQueue);
+
+            hasChanged = true;
+        }
+
+        std::vector<u32> candidates = {};
+        usize            loading    = 0;
+
+        for (u32 i = 0; i < m_cells.size(); ++i)
+        {
+            if (m_cells[i].state == CellState::Loading)
+            {
+                ++loading;
+            }
+            else if (m_cells[i].state == CellState::Unloaded && Distance(m_cells[i]) < m_loadRadius)
+            {
+                candidates.emplace_back(i);
+            }
+        }
+
+        std::ranges::sort(candidates, [&] (u32 lhs, u32 rhs)
+        {
+            return Distance(m_cells[lhs]) < Distance(m_cells[rhs]);
+        });
+
+        usize meshCount = candidates.empty() ? 0 : GetResidentMeshCount(scene, modelManager);
+
+        for (const auto i : candidates)
+        {
+            if (loading >= MAX_CONCURRENT_CELL_LOADS)
+            {
+                break;
+            }
+
+            auto& cell = m_cells[i];
+
+            // A cell's size is only known after its first load, so unknown cells only start while there is room left
+            const usize residentSize = GetResidentSize();
+
+            if (cell.size == 0 ? residentSize >= m_budget : residentSize + cell.size > m_budget)
+            {
+                continue;
+            }
+
+            // Unknown mesh counts are checked again once the cell is instantiated
+            if (meshCount + cell.meshCount > Renderer::Buffers::MAX_MESH_COUNT)
+            {
+                continue;
+            }
+
+            meshCount += cell.meshCount;
+
+            for (const auto& object : cell.objects)
+            {
+                modelManager.PrefetchModel(object.model);
+            }
+
+            cell.state = CellState::Loading;
+
+            ++loading;
+        }
+
+        if (hasChanged)
+        {
+            RebuildLights(scene);
+        }
+    }
+
+    bool SceneStreamer::Instantiate
+    (
+        u32 cellIndex,
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        auto& cell = m_cells[cellIndex];
+
+        // Counted before this cell's own reservations are dropped by leaving the loading state
+        const usize residentMeshCount = GetResidentMeshCount(scene, modelManager) - cell.meshCount;
+        const usize residentSize      = GetResidentSize() - cell.size;
+
+        std::vector<Renderer::RenderObject> renderObjects = {};
+        std::vector<Models::ModelID>        modelIDs      = {};
+
+        cell.meshCount = 0;
+
+        for (const auto& object : cell.objects)
+        {
+            Renderer::RenderObject renderObject = {};
+
+            renderObject.modelID  = modelManager.AddModel(context.allocator, deletionQueue, object.model);
+            renderObject.position = object.position;
+            renderObject.rotation = object.rotation;
+            renderObject.scale    = object.scale;
+            renderObject.owner    = Renderer::ContentOwner::Streamer;
+            renderObject.cell     = cellIndex;
+
+            cell.meshCount += modelManager.GetModel(renderObject.modelID).meshes.size();
+
+            renderObjects.emplace_back(renderObject);
+            modelIDs.emplace_back(renderObject.modelID);
+        }
+
+        std::ranges::sort(modelIDs);
+        modelIDs.erase(std::ranges::unique(modelIDs).begin(), modelIDs.end());
+
+        // Shared models are counted once per cell, which errs on the side of staying under budget
+        cell.size = 0;
+
+        for (const auto modelID : modelIDs)
+        {
+            for (const auto& mesh : modelManager.GetModel(modelID).meshes)
+            {
+                cell.size += mesh.surfaceInfo.indexInfo.count    * sizeof(GPU::Index);
+                cell.size += mesh.surfaceInfo.positionInfo.count * sizeof(GPU::Position);
+                cell.size += mesh.surfaceInfo.vertexInfo.count   * sizeof(GPU::Vertex);
+                cell.size += mesh.surfaceInfo.clusterInfo.count  * sizeof(GPU::Cluster);
+            }
+        }
+
+        const bool fitsMeshBuffer = residentMeshCount + cell.meshCount <= Renderer::Buffers::MAX_MESH_COUNT;
+        const bool fitsBudget     = residentSize + cell.size <= m_budget;
+
+        if (!fitsMeshBuffer || !fitsBudget)
+        {
+            for (auto& renderObject : renderObjects)
+            {
+                renderObject.Destroy
+                (
+                    context.device,
+                    context.allocator,
+                    megaSet,
+                    modelManager,
+                    deletionQueue
+                );
+            }
+
+            if (!fitsMeshBuffer)
+            {
+                Logger::Warning("Mesh buffer is full, skipping cell! [Cell={}] [Meshes={}]\n", cellIndex, cell.meshCount);
+            }
+
+            cell.state = CellState::Unloaded;
+
+            return false;
+        }
+
+        scene.renderObjects.insert(scene.renderObjects.end(), renderObjects.begin(), renderObjects.end());
+
+        cell.state = CellState::Loaded;
+
+        scene.haveRenderObjectsChanged = true;
+
+        return true;
+    }
+
+    void SceneStreamer::Unload
+    (
+        u32 cellIndex,
+        Scene& scene,
+        const Vk::Context& context,
+        Models::ModelManager& modelManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        for (auto iter = scene.renderObjects.begin(); iter != scene.renderObjects.end();)
+        {
+            if (iter->owner != Renderer::ContentOwner::Streamer || iter->cell != cellIndex)
+            {
+                ++iter;
+                continue;
+            }
+
+            iter->Destroy
+            (
+                context.device,
+                context.allocator,
+                megaSet,
+                modelManager,
+                deletionQueue
+            );
+
+            iter = scene.renderObjects.erase(iter);
+        }
+
+        m_cells[cellIndex].state = CellState::Unloaded;
+
+        scene.haveRenderObjectsChanged = true;
+    }
+
+    void SceneStreamer::RebuildLights(Scene& scene)
+    {
+        scene.RemoveLights(Renderer::ContentOwner::Streamer);
+
+        for (const auto& cell : m_cells)
+        {
+            if (cell.state != CellState::Loaded)
+            {
+                continue;
+            }
+
+            for (const auto& light : cell.pointLights)
+            {
+                scene.AddPointLight(light, Renderer::ContentOwner::Streamer);
+            }
+
+            for (const auto& light : cell.spotLights)
+            {
+                scene.AddSpotLight(light, Renderer::ContentOwner::Streamer);
+            }
+        }
+    }
+
+    usize SceneStreamer::GetResidentSize() const
+    {
+        usize size = 0;
+
+        for (const auto& cell : m_cells)
+        {
+            if (cell.state != CellState::Unloaded)
+            {
+                size += cell.size;
+            }
+        }
+
+        return size;
+    }
+
+    usize SceneStreamer::GetResidentMeshCount(const Scene& scene, const Models::ModelManager& modelManager) const
+    {
+        usize meshCount = 0;
+
+        for (const auto& renderObject : scene.renderObjects)
+        {
+            meshCount += modelManager.GetModel(renderObject.modelID).meshes.size();
+        }
+
+        for (const auto& cell : m_cells)
+        {
+            if (cell.state == CellState::Loading)
+            {
+                meshCount += cell.meshCount;
+            }
+        }
+
+        return meshCount;
+    }
+
+    void SceneStreamer::ImGuiDisplay()
+    {
+        if (m_cells.empty())
+        {
+            return;
+        }
+
+        if (ImGui::BeginMenu("Streaming"))
+        {
+            ImGui::DragFloat("Load Radius",   &m_loadRadius,   1.0f, 0.0f, 0.0f, "%.1f");
+            ImGui::DragFloat("Unload Radius", &m_unloadRadius, 1.0f, 0.0f, 0.0f, "%.1f");
+
+            m_unloadRadius = std::max(m_unloadRadius, m_loadRadius);
+
+            ImGui::Separator();
+
+            ImGui::Text("Resident | %.2f MiB", static_cast<f64>(GetResidentSize()) / (1024.0 * 1024.0));
+            ImGui::Text("Budget   | %.2f MiB", static_cast<f64>(m_budget)          / (1024.0 * 1024.0));
+
+            for (usize i = 0; i < m_cells.size(); ++i)
+            {
+                ImGui::Separator();
+
+                const auto& cell = m_cells[i];
+
+                const char* state = cell.state == CellState::Loaded  ? "Loaded"  :
+                                    cell.state == CellState::Loading ? "Loading" :
+                                                                       "Unloaded";
+
+                ImGui::Text("[%llu] %s | %llu objects | %.2f MiB", i, state, cell.objects.size(), static_cast<f64>(cell.size) / (1024.0 * 1024.0));
+            }
+
+            ImGui::EndMenu();
+        }
+    }
+}
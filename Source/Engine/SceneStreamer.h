@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENE_STREAMER_H
+#define SCENE_STREAMER_H
+
+#include <string>
+#include <vector>
+
+#include "Vulkan/Context.h"
+#include "Vulkan/MegaSet.h"
+#include "Models/ModelManager.h"
+#include "Util/DeletionQueue.h"
+#include "Util/Types.h"
+#include "Externals/GLM.h"
+#include "Externals/SIMDJSON.h"
+#include "GPU/Lights.h"
+
+namespace Engine
+{
+    class Scene;
+
+    // Loads and unloads spatial cells of a scene as the camera moves
+    class SceneStreamer
+    {
+    public:
+        // Reads the optional "Streaming" and "Cells" entries of a scene file
+        void LoadCells(simdjson::ondemand::document& document);
+
+        void Update
+        (
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
+        void ImGuiDisplay();
+    private:
+        enum class CellState : u8
+        {
+            Unloaded,
+            Loading,
+            Loaded
+        };
+
+        struct CellObject
+        {
+            std::string model    = {};
+            glm::vec3   position = {};
+            glm::vec3   rotation = {};
+            glm::vec3   scale    = {1.0f, 1.0f, 1.0f};
+        };
+
+        struct Cell
+        {
+            glm::vec3                    center      = {};
+            std::vector<CellObject>      objects     = {};
+            std::vector<GPU::PointLight> pointLights = {};
+            std::vector<GPU::SpotLight>  spotLights  = {};
+            CellState                    state       = CellState::Unloaded;
+            usize                        size        = 0;
+            usize                        meshCount   = 0;
+        };
+
+        // Backs out and leaves the cell unloaded if its meshes do not fit in the mesh buffer
+        [[nodiscard]] bool Instantiate
+        (
+            u32 cellIndex,
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
+        void Unload
+        (
+            u32 cellIndex,
+            Scene& scene,
+            const Vk::Context& context,
+            Models::ModelManager& modelManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
+        void RebuildLights(Scene& scene);
+
+        // Geometry size of loaded and loading cells, a cell's size is only known after its first load
+        [[nodiscard]] usize GetResidentSize() const;
+        // Meshes already in the scene plus those reserved by loading cells with a known mesh count
+        [[nodiscard]] usize GetResidentMeshCount(const Scene& scene, const Models::ModelManager& modelManager) const;
+
+        std::vector<Cell> m_cells = {};
+
+        // Cells start loading inside the inner radius and are dropped outside the outer one
+        f32   m_loadRadius   = 150.0f;
+        f32   m_unloadRadius = 200.0f;
+        usize m_budget       = 512ull * 1024 * 1024;
+    };
+}
+
+#endif
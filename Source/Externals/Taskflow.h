@@ -18,5 +18,6 @@
 #define EXTERNALS_TASKFLOW_H
 
 #include "taskflow/taskflow/taskflow.hpp"
+#include "taskflow/taskflow/algorithm/for_each.hpp"
 
 #endif
@@ -42,10 +42,38 @@ namespace Models
         Vk::TextureManager& textureManager,
         Util::DeletionQueue& deletionQueue,
         const std::string_view path
+    )
+        : Model(allocator, geometryBuffer, textureManager, deletionQueue, path, LoadAsset(path))
+    {
+    }
+
+    Model::Model
+    (
+        VmaAllocator allocator,
+        Vk::GeometryBuffer& geometryBuffer,
+        Vk::TextureManager& textureManager,
+        Util::DeletionQueue& deletionQueue,
+        const std::string_view path,
+        const fastgltf::Asset& asset
     )
         : name(Util::Files::GetNameWithoutExtension(path))
     {
-        Logger::Info("Loading model! [Name={}]\n", name);
+        const std::string assetDirectory = Util::Files::GetDirectory(Util::Files::GetAssetPath(MODEL_ASSETS_DIR, path));
+
+        ProcessScenes
+        (
+            allocator,
+            geometryBuffer,
+            textureManager,
+            deletionQueue,
+            assetDirectory,
+            asset
+        );
+    }
+
+    fastgltf::Asset Model::LoadAsset(const std::string_view path)
+    {
+        Logger::Info("Loading model! [Name={}]\n", Util::Files::GetNameWithoutExtension(path));
 
         const std::string assetPath      = Util::Files::GetAssetPath(MODEL_ASSETS_DIR, path);
         const std::string assetDirectory = Util::Files::GetDirectory(assetPath);
@@ -98,15 +126,7 @@ namespace Models
         }
         #endif
 
-        ProcessScenes
-        (
-            allocator,
-            geometryBuffer,
-            textureManager,
-            deletionQueue,
-            assetDirectory,
-            asset.get()
-        );
+        return std::move(asset.get());
     }
 
     void Model::Destroy
@@ -235,6 +255,10 @@ namespace Models
             GPU::SurfaceInfo surfaceInfo = {};
             GPU::AABB        aabb        = {};
 
+            // Host copies, clusters are built from these
+            std::vector<GPU::Index>    indices   = {};
+            std::vector<GPU::Position> positions = {};
+
             // Indices
             {
                 if (!primitive.indicesAccessor.has_value())
@@ -262,6 +286,8 @@ namespace Models
 
                 surfaceInfo.indexInfo = info;
 
+                indices.resize(indicesAccessor.count);
+
                 // Assume indices are u32s
                 switch (indicesAccessor.componentType)
                 {
@@ -269,7 +295,7 @@ namespace Models
                 {
                     fastgltf::iterateAccessorWithIndex<s8>(asset, indicesAccessor, [&] (s8 index, usize i)
                     {
-                        writePointer[i] = static_cast<GPU::Index>(static_cast<u8>(index));
+                        indices[i] = static_cast<GPU::Index>(static_cast<u8>(index));
                     });
                     break;
                 }
@@ -278,7 +304,7 @@ namespace Models
                 {
                     fastgltf::iterateAccessorWithIndex<u8>(asset, indicesAccessor, [&] (u8 index, usize i)
                     {
-                        writePointer[i] = static_cast<GPU::Index>(index);
+                        indices[i] = static_cast<GPU::Index>(index);
                     });
                     break;
                 }
@@ -287,7 +313,7 @@ namespace Models
                 {
                     fastgltf::iterateAccessorWithIndex<s16>(asset, indicesAccessor, [&] (s16 index, usize i)
                     {
-                        writePointer[i] = static_cast<GPU::Index>(index);
+                        indices[i] = static_cast<GPU::Index>(index);
                     });
                     break;
                 }
@@ -296,14 +322,14 @@ namespace Models
                 {
                     fastgltf::iterateAccessorWithIndex<u16>(asset, indicesAccessor, [&] (u16 index, usize i)
                     {
-                        writePointer[i] = static_cast<GPU::Index>(index);
+                        indices[i] = static_cast<GPU::Index>(index);
                     });
                     break;
                 }
 
                 case fastgltf::ComponentType::UnsignedInt:
                 {
-                    fastgltf::copyFromAccessor<GPU::Index>(asset, indicesAccessor, writePointer);
+                    fastgltf::copyFromAccessor<GPU::Index>(asset, indicesAccessor, indices.data());
                     break;
                 }
 
@@ -314,6 +340,8 @@ namespace Models
                         static_cast<std::underlying_type_t<fastgltf::ComponentType>>(indicesAccessor.componentType)
                     );
                 }
+
+                std::memcpy(writePointer, indices.data(), indices.size() * sizeof(GPU::Index));
             }
 
             // Positions
@@ -338,15 +366,37 @@ namespace Models
                 aabb.min = glm::vec3(std::numeric_limits<f32>::max());
                 aabb.max = glm::vec3(std::numeric_limits<f32>::lowest());
 
+                positions.resize(positionAccessor.count);
+
                 fastgltf::iterateAccessorWithIndex<glm::vec3>(asset, positionAccessor, [&] (const GPU::Position& position, usize index)
                 {
                     aabb.min = glm::min(aabb.min, position);
                     aabb.max = glm::max(aabb.max, position);
 
                     writePointer[index] = position;
+                    positions[index]    = position;
                 });
             }
 
+            // Clusters
+            {
+                const auto clusters = BuildClusters(indices, positions);
+
+                if (!clusters.empty())
+                {
+                    const auto [writePointer, info] = geometryBuffer.clusterBuffer.Allocate
+                    (
+                        allocator,
+                        clusters.size(),
+                        deletionQueue
+                    );
+
+                    surfaceInfo.clusterInfo = info;
+
+                    std::memcpy(writePointer, clusters.data(), clusters.size() * sizeof(GPU::Cluster));
+                }
+            }
+
             // Vertices
             {
                 const auto& normalAccessor = GetAccessor
@@ -521,6 +571,84 @@ namespace Models
         }
     }
 
+    std::vector<GPU::Cluster> Model::BuildClusters
+    (
+        const std::span<const GPU::Index> indices,
+        const std::span<const GPU::Position> positions
+    )
+    {
+        constexpr usize CLUSTER_MAX_INDICES = GPU::CLUSTER_MAX_TRIANGLES * 3;
+
+        std::vector<GPU::Cluster> clusters = {};
+        clusters.reserve((indices.size() + CLUSTER_MAX_INDICES - 1) / CLUSTER_MAX_INDICES);
+
+        for (usize firstIndex = 0; firstIndex + 3 <= indices.size(); firstIndex += CLUSTER_MAX_INDICES)
+        {
+            const usize indexCount = std::min(CLUSTER_MAX_INDICES, (indices.size() - firstIndex) / 3 * 3);
+
+            auto cluster = GPU::Cluster
+            {
+                .aabb       = {
+                    .min = glm::vec3(std::numeric_limits<f32>::max()),
+                    .max = glm::vec3(std::numeric_limits<f32>::lowest())
+                },
+                .coneAxis   = glm::vec3(0.0f),
+                .coneCutoff = 1.0f,
+                .firstIndex = static_cast<u32>(firstIndex),
+                .indexCount = static_cast<u32>(indexCount)
+            };
+
+            std::array<glm::vec3, GPU::CLUSTER_MAX_TRIANGLES> normals     = {};
+            usize                                             normalCount = 0;
+
+            for (usize i = firstIndex; i < firstIndex + indexCount; i += 3)
+            {
+                const auto& p0 = positions[indices[i + 0]];
+                const auto& p1 = positions[indices[i + 1]];
+                const auto& p2 = positions[indices[i + 2]];
+
+                cluster.aabb.min = glm::min(glm::min(cluster.aabb.min, p0), glm::min(p1, p2));
+                cluster.aabb.max = glm::max(glm::max(cluster.aabb.max, p0), glm::max(p1, p2));
+
+                const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                const f32       area   = glm::length(normal);
+
+                // Degenerate triangles do not constrain the cone
+                if (area > 0.0f)
+                {
+                    normals[normalCount] = normal / area;
+                    cluster.coneAxis    += normals[normalCount];
+
+                    ++normalCount;
+                }
+            }
+
+            const f32 axisLength = glm::length(cluster.coneAxis);
+
+            if (normalCount > 0 && axisLength > 0.0f)
+            {
+                cluster.coneAxis /= axisLength;
+
+                f32 minDot = 1.0f;
+
+                for (usize i = 0; i < normalCount; ++i)
+                {
+                    minDot = std::min(minDot, glm::dot(normals[i], cluster.coneAxis));
+                }
+
+                // Wide cones almost never reject anything, leave them at the cutoff that disables the test
+                if (minDot > 0.1f)
+                {
+                    cluster.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+                }
+            }
+
+            clusters.emplace_back(cluster);
+        }
+
+        return clusters;
+    }
+
     glm::mat4 Model::GetTransformMatrix(const fastgltf::Node& node, const glm::mat4& base)
     {
         return std::visit(Util::Visitor {
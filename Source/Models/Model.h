@@ -17,6 +17,7 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include <span>
 #include <vector>
 #include <string_view>
 
@@ -40,6 +41,20 @@ namespace Models
             const std::string_view path
         );
 
+        // For assets that were already parsed by LoadAsset
+        Model
+        (
+            VmaAllocator allocator,
+            Vk::GeometryBuffer& geometryBuffer,
+            Vk::TextureManager& textureManager,
+            Util::DeletionQueue& deletionQueue,
+            const std::string_view path,
+            const fastgltf::Asset& asset
+        );
+
+        // Reads and parses the glTF file, safe to call from any thread
+        [[nodiscard]] static fastgltf::Asset LoadAsset(const std::string_view path);
+
         void Destroy
         (
             VkDevice device,
@@ -87,6 +102,13 @@ namespace Models
             const glm::mat4& nodeMatrix
         );
 
+        // Splits a surface into runs of consecutive triangles with bounds and a normal cone
+        [[nodiscard]] static std::vector<GPU::Cluster> BuildClusters
+        (
+            const std::span<const GPU::Index> indices,
+            const std::span<const GPU::Position> positions
+        );
+
         [[nodiscard]] static glm::mat4 GetTransformMatrix(const fastgltf::Node& node, const glm::mat4& base = glm::identity<glm::mat4>());
 
         [[nodiscard]] static const fastgltf::Accessor& GetAccessor
@@ -18,6 +18,7 @@
 
 #include "Vulkan/DebugUtils.h"
 #include "Util/Log.h"
+#include "Util/Parallel.h"
 
 namespace Models
 {
@@ -41,6 +42,24 @@ namespace Models
         {
             ++iter->second.referenceCount;
         }
+        else if (auto prefetched = m_prefetchedModels.find(id); prefetched != m_prefetchedModels.end())
+        {
+            const auto asset = prefetched->second.get();
+
+            m_prefetchedModels.erase(prefetched);
+
+            m_modelMap.emplace(id, ModelInfo{
+                .model = Model(
+                    allocator,
+                    geometryBuffer,
+                    textureManager,
+                    deletionQueue,
+                    path,
+                    asset
+                ),
+                .referenceCount = 1
+            });
+        }
         else
         {
             m_modelMap.emplace(id, ModelInfo{
@@ -58,6 +77,35 @@ namespace Models
         return id;
     }
 
+    void ModelManager::PrefetchModel(const std::string_view path)
+    {
+        const Models::ModelID id = std::hash<std::string_view>()(path);
+
+        if (m_modelMap.contains(id) || m_prefetchedModels.contains(id))
+        {
+            return;
+        }
+
+        m_prefetchedModels.emplace(id, Util::GetExecutor().async([path = std::string(path)] ()
+        {
+            return Model::LoadAsset(path);
+        }));
+    }
+
+    bool ModelManager::IsModelReady(const std::string_view path) const
+    {
+        const Models::ModelID id = std::hash<std::string_view>()(path);
+
+        if (m_modelMap.contains(id))
+        {
+            return true;
+        }
+
+        const auto iter = m_prefetchedModels.find(id);
+
+        return iter != m_prefetchedModels.end() && iter->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
     void ModelManager::DestroyModel
     (
         ModelID id,
@@ -163,6 +211,7 @@ namespace Models
                                 ImGui::Text("Indices   | %u/%u", mesh.surfaceInfo.indexInfo.offset,    mesh.surfaceInfo.indexInfo.count);
                                 ImGui::Text("Positions | %u/%u", mesh.surfaceInfo.positionInfo.offset, mesh.surfaceInfo.positionInfo.count);
                                 ImGui::Text("Vertices  | %u/%u", mesh.surfaceInfo.vertexInfo.offset,   mesh.surfaceInfo.vertexInfo.count);
+                                ImGui::Text("Clusters  | %u/%u", mesh.surfaceInfo.clusterInfo.offset,  mesh.surfaceInfo.clusterInfo.count);
 
                                 ImGui::Separator();
                                 ImGui::Text("Texture Name              | UV Map ID | ID");
@@ -232,6 +281,9 @@ namespace Models
 
     void ModelManager::Destroy(VkDevice device, VmaAllocator allocator)
     {
+        // Waits for any parse still in flight
+        m_prefetchedModels.clear();
+
         geometryBuffer.Destroy(allocator);
         textureManager.Destroy(device, allocator);
     }
@@ -17,6 +17,8 @@
 #ifndef MODEL_MANAGER_H
 #define MODEL_MANAGER_H
 
+#include <future>
+
 #include "Model.h"
 #include "Vulkan/TextureManager.h"
 #include "Vulkan/GeometryBuffer.h"
@@ -41,6 +43,12 @@ namespace Models
             const std::string_view path
         );
 
+        // Parses the file on a worker thread, a later AddModel with the same path skips the parse
+        void PrefetchModel(const std::string_view path);
+
+        // True once AddModel for this path will not block on file IO
+        [[nodiscard]] bool IsModelReady(const std::string_view path) const;
+
         void DestroyModel
         (
             ModelID id,
@@ -73,6 +81,8 @@ namespace Models
         };
 
         ankerl::unordered_dense::map<Models::ModelID, ModelManager::ModelInfo> m_modelMap;
+
+        ankerl::unordered_dense::map<Models::ModelID, std::future<fastgltf::Asset>> m_prefetchedModels;
     };
 }
 
@@ -230,7 +230,8 @@ namespace Renderer::AO::VBGTAO
             framebufferManager,
             megaSet,
             textureManager,
-            sceneDepthID
+            sceneDepthID,
+            sceneBuffer.renderExtent
         );
 
         Occlusion
@@ -250,7 +251,8 @@ namespace Renderer::AO::VBGTAO
             cmdBuffer,
             framebufferManager,
             megaSet,
-            textureManager
+            textureManager,
+            sceneBuffer.renderExtent
         );
 
         Vk::EndLabel(cmdBuffer);
@@ -262,7 +264,8 @@ namespace Renderer::AO::VBGTAO
         const Vk::FramebufferManager& framebufferManager,
         const Vk::MegaSet& megaSet,
         const Vk::TextureManager& textureManager,
-        const std::string_view sceneDepthID
+        const std::string_view sceneDepthID,
+        VkExtent2D renderExtent
     )
     {
         Vk::BeginLabel(cmdBuffer, "DepthPreFilter", glm::vec4(0.6098f, 0.2143f, 0.4529f, 1.0f));
@@ -314,8 +317,8 @@ namespace Renderer::AO::VBGTAO
         vkCmdDispatch
         (
             cmdBuffer.handle,
-            (depthMipChain.image.width  + 16 - 1) / 16,
-            (depthMipChain.image.height + 16 - 1) / 16,
+            (renderExtent.width  + 16 - 1) / 16,
+            (renderExtent.height + 16 - 1) / 16,
             1
         );
 
@@ -426,8 +429,8 @@ namespace Renderer::AO::VBGTAO
         vkCmdDispatch
         (
             cmdBuffer.handle,
-            (noisyAO.image.width  + 8 - 1) / 8,
-            (noisyAO.image.height + 8 - 1) / 8,
+            (sceneBuffer.renderExtent.width  + 8 - 1) / 8,
+            (sceneBuffer.renderExtent.height + 8 - 1) / 8,
             1
         );
 
@@ -476,7 +479,8 @@ namespace Renderer::AO::VBGTAO
         const Vk::CommandBuffer& cmdBuffer,
         const Vk::FramebufferManager& framebufferManager,
         const Vk::MegaSet& megaSet,
-        const Vk::TextureManager& textureManager
+        const Vk::TextureManager& textureManager,
+        VkExtent2D renderExtent
     )
     {
         Vk::BeginLabel(cmdBuffer, "Denoise", glm::vec4(0.2098f, 0.2143f, 0.7859f, 1.0f));
@@ -526,8 +530,8 @@ namespace Renderer::AO::VBGTAO
         vkCmdDispatch
         (
             cmdBuffer.handle,
-            (occlusion.image.width  + 8 - 1) / 8,
-            (occlusion.image.height + 8 - 1) / 8,
+            (renderExtent.width  + 8 - 1) / 8,
+            (renderExtent.height + 8 - 1) / 8,
             1
         );
 
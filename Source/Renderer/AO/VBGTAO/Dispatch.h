@@ -62,7 +62,8 @@ namespace Renderer::AO::VBGTAO
             const Vk::FramebufferManager& framebufferManager,
             const Vk::MegaSet& megaSet,
             const Vk::TextureManager& textureManager,
-            const std::string_view sceneDepthID
+            const std::string_view sceneDepthID,
+            VkExtent2D renderExtent
         );
 
         void Occlusion
@@ -82,7 +83,8 @@ namespace Renderer::AO::VBGTAO
             const Vk::CommandBuffer& cmdBuffer,
             const Vk::FramebufferManager& framebufferManager,
             const Vk::MegaSet& megaSet,
-            const Vk::TextureManager& textureManager
+            const Vk::TextureManager& textureManager,
+            VkExtent2D renderExtent
         );
 
         DepthPreFilter::Pipeline m_depthPreFilterPipeline;
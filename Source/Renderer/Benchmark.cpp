@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+
+#include "Util/Log.h"
+#include "Externals/ImGui.h"
+
+namespace Renderer
+{
+    constexpr std::array<usize, 6> BENCHMARK_STEPS = {1, 10, 100, 1'000, 10'000, 100'000};
+
+    constexpr usize WARMUP_FRAMES = 8;
+    constexpr usize SAMPLE_FRAMES = 64;
+
+    constexpr std::array<const char*, Benchmark::STAGE_COUNT> STAGE_NAMES =
+    {
+        "Scene Update   ",
+        "Mesh Buffer    ",
+        "Draw Calls     ",
+        "Bottom Level AS",
+        "Top Level AS   ",
+        "Culling (CPU)  ",
+        "Frame          "
+    };
+
+    void Benchmark::Record(Stage stage, f64 milliseconds)
+    {
+        m_frameTimings[static_cast<usize>(stage)] += milliseconds;
+    }
+
+    std::optional<usize> Benchmark::BeginFrame()
+    {
+        if (!m_isRunning || m_stepFrame != 0)
+        {
+            return std::nullopt;
+        }
+
+        m_stepResult = Result{.requestedCount = BENCHMARK_STEPS[m_step]};
+
+        return m_stepResult.requestedCount;
+    }
+
+    void Benchmark::SetGeneratedCount(usize instanceCount)
+    {
+        m_stepResult.instanceCount = instanceCount;
+    }
+
+    void Benchmark::EndFrame(usize meshCount)
+    {
+        m_lastTimings  = m_frameTimings;
+        m_frameTimings = {};
+
+        if (!m_isRunning)
+        {
+            return;
+        }
+
+        // Scene regeneration and the BLAS builds all land on the first frame of a step
+        if (m_stepFrame == 0)
+        {
+            m_stepResult.rebuildTimings = m_lastTimings;
+        }
+        else if (m_stepFrame > WARMUP_FRAMES)
+        {
+            for (usize i = 0; i < STAGE_COUNT; ++i)
+            {
+                m_stepResult.timings[i] += m_lastTimings[i] / static_cast<f64>(SAMPLE_FRAMES);
+            }
+        }
+
+        m_stepResult.meshCount = meshCount;
+
+        if (++m_stepFrame <= WARMUP_FRAMES + SAMPLE_FRAMES)
+        {
+            return;
+        }
+
+        LogResult(m_stepResult);
+        m_results.emplace_back(m_stepResult);
+
+        m_stepFrame = 0;
+        ++m_step;
+
+        // Anything larger would only hit the same mesh buffer limit again
+        const bool isCapped = m_stepResult.instanceCount < m_stepResult.requestedCount;
+
+        if (isCapped || m_step == BENCHMARK_STEPS.size())
+        {
+            m_isRunning = false;
+
+            Logger::Info("Benchmark finished! [Steps={}] [Capped={}]\n", m_results.size(), isCapped);
+        }
+    }
+
+    void Benchmark::LogResult(const Result& result) const
+    {
+        const auto At = [] (const Timings& timings, Stage stage)
+        {
+            return timings[static_cast<usize>(stage)];
+        };
+
+        Logger::Info
+        (
+            "Benchmark step! [Instances={}/{}] [Meshes={}] [Rebuild={:.3f}ms] [BLAS={:.3f}ms] [Scene={:.3f}ms] [MeshBuffer={:.3f}ms] [DrawCalls={:.3f}ms] [TLAS={:.3f}ms] [Culling={:.3f}ms] [Frame={:.3f}ms]\n",
+            result.instanceCount,
+            result.requestedCount,
+            result.meshCount,
+            At(result.rebuildTimings, Stage::Frame),
+            At(result.rebuildTimings, Stage::BottomLevelAS),
+            At(result.timings,        Stage::SceneUpdate),
+            At(result.timings,        Stage::MeshBuffer),
+            At(result.timings,        Stage::DrawCalls),
+            At(result.timings,        Stage::TopLevelAS),
+            At(result.timings,        Stage::Culling),
+            At(result.timings,        Stage::Frame)
+        );
+    }
+
+    void Benchmark::ImGuiDisplay()
+    {
+        if (ImGui::BeginMainMenuBar())
+        {
+            if (ImGui::BeginMenu("Benchmark"))
+            {
+                for (usize i = 0; i < STAGE_COUNT; ++i)
+                {
+                    ImGui::Text("%s | %.4f ms", STAGE_NAMES[i], m_lastTimings[i]);
+                }
+
+                ImGui::Separator();
+
+                if (m_isRunning)
+                {
+                    ImGui::Text("Step      | %llu / %llu", m_step + 1, BENCHMARK_STEPS.size());
+                    ImGui::Text("Instances | %llu", BENCHMARK_STEPS[m_step]);
+
+                    if (ImGui::Button("Stop"))
+                    {
+                        m_isRunning = false;
+                    }
+                }
+                else if (ImGui::Button("Run Scaling Benchmark"))
+                {
+                    m_isRunning = true;
+                    m_step      = 0;
+                    m_stepFrame = 0;
+
+                    m_results.clear();
+
+                    Logger::Info("Starting benchmark! [Steps={}]\n", BENCHMARK_STEPS.size());
+                }
+
+                for (const auto& result : m_results)
+                {
+                    ImGui::Separator();
+
+                    if (ImGui::TreeNode(fmt::format("{} Instances", result.requestedCount).c_str()))
+                    {
+                        ImGui::Text("Generated       | %llu", result.instanceCount);
+                        ImGui::Text("Meshes          | %llu", result.meshCount);
+                        ImGui::Text("Rebuild Frame   | %.4f ms", result.rebuildTimings[static_cast<usize>(Stage::Frame)]);
+                        ImGui::Text("Rebuild BLAS    | %.4f ms", result.rebuildTimings[static_cast<usize>(Stage::BottomLevelAS)]);
+
+                        ImGui::Separator();
+
+                        for (usize i = 0; i < STAGE_COUNT; ++i)
+                        {
+                            ImGui::Text("%s | %.4f ms", STAGE_NAMES[i], result.timings[i]);
+                        }
+
+                        ImGui::TreePop();
+                    }
+                }
+
+                ImGui::EndMenu();
+            }
+
+            ImGui::EndMainMenuBar();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDERER_BENCHMARK_H
+#define RENDERER_BENCHMARK_H
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include "Util/Types.h"
+#include "Util/Scope.h"
+
+namespace Renderer
+{
+    // CPU timings per renderer subsystem, plus a sweep over generated scene sizes
+    class Benchmark
+    {
+    public:
+        enum class Stage : u8
+        {
+            SceneUpdate,
+            MeshBuffer,
+            DrawCalls,
+            BottomLevelAS,
+            TopLevelAS,
+            Culling,
+            Frame
+        };
+
+        static constexpr usize STAGE_COUNT = static_cast<usize>(Stage::Frame) + 1;
+
+        // Adds the time until the end of the scope to the given stage
+        [[nodiscard]] auto Measure(Stage stage)
+        {
+            return Util::MakeScopeGuard([this, stage, start = Clock::now()] ()
+            {
+                Record(stage, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+            });
+        }
+
+        void Record(Stage stage, f64 milliseconds);
+
+        // Returns the instance count the scene needs to be regenerated with, when a new step begins
+        [[nodiscard]] std::optional<usize> BeginFrame();
+        void SetGeneratedCount(usize instanceCount);
+        void EndFrame(usize meshCount);
+
+        void ImGuiDisplay();
+    private:
+        using Clock   = std::chrono::steady_clock;
+        using Timings = std::array<f64, STAGE_COUNT>;
+
+        struct Result
+        {
+            usize   requestedCount = 0;
+            usize   instanceCount  = 0;
+            usize   meshCount      = 0;
+            Timings rebuildTimings = {};
+            Timings timings        = {};
+        };
+
+        void LogResult(const Result& result) const;
+
+        Timings m_frameTimings = {};
+        Timings m_lastTimings  = {};
+
+        bool   m_isRunning  = false;
+        usize  m_step       = 0;
+        usize  m_stepFrame  = 0;
+        Result m_stepResult = {};
+
+        std::vector<Result> m_results = {};
+    };
+}
+
+#endif
@@ -16,14 +16,37 @@
 
 #include "DrawCallBuffer.h"
 
+#include <algorithm>
+
 #include "Util/Log.h"
+#include "Util/Hash.h"
 #include "Vulkan/DebugUtils.h"
-#include "Renderer/Buffers/MeshBuffer.h"
+#include "Externals/UnorderedDense.h"
 
 namespace Renderer::Buffers
 {
-    DrawCallBuffer::DrawCallBuffer(VkDevice device, VmaAllocator allocator, Type type)
-        : type(type)
+    namespace
+    {
+        struct DrawKey
+        {
+            Models::ModelID modelID   = 0;
+            usize           meshIndex = 0;
+
+            bool operator==(const DrawKey& other) const = default;
+        };
+
+        struct DrawKeyHash
+        {
+            usize operator()(const DrawKey& key) const noexcept
+            {
+                return Util::HashCombine(Util::HashCombine(0, key.modelID), key.meshIndex);
+            }
+        };
+    }
+
+    DrawCallBuffer::DrawCallBuffer(VkDevice device, VmaAllocator allocator, Type type, u32 capacity)
+        : type(type),
+          capacity(capacity)
     {
         switch (type)
         {
@@ -31,19 +54,29 @@ namespace Renderer::Buffers
             drawCallBuffer = Vk::Buffer
             (
                 allocator,
-                sizeof(u32) + MAX_MESH_COUNT * sizeof(VkDrawIndexedIndirectCommand),
+                sizeof(u32) + capacity * sizeof(VkDrawIndexedIndirectCommand),
                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
                 VMA_MEMORY_USAGE_AUTO
             );
+
+            instanceBuffer = Vk::Buffer
+            (
+                allocator,
+                sizeof(u32) + capacity * sizeof(GPU::DrawInstance),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+                VMA_MEMORY_USAGE_AUTO
+            );
             break;
 
         case Type::GPUOnly:
             drawCallBuffer = Vk::Buffer
             (
                 allocator,
-                sizeof(u32) + MAX_MESH_COUNT * sizeof(VkDrawIndexedIndirectCommand),
+                sizeof(u32) + capacity * sizeof(VkDrawIndexedIndirectCommand),
                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 0,
@@ -53,13 +86,35 @@ namespace Renderer::Buffers
             meshIndexBuffer = Vk::Buffer
             (
                 allocator,
-                MAX_MESH_COUNT * sizeof(u32),
+                capacity * sizeof(u32),
                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 0,
                 VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
             );
             break;
+
+        case Type::CPUCulled:
+            drawCallBuffer = Vk::Buffer
+            (
+                allocator,
+                sizeof(u32) + capacity * sizeof(VkDrawIndexedIndirectCommand),
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+                VMA_MEMORY_USAGE_AUTO
+            );
+
+            meshIndexBuffer = Vk::Buffer
+            (
+                allocator,
+                capacity * sizeof(u32),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+                VMA_MEMORY_USAGE_AUTO
+            );
+            break;
         }
 
         drawCallBuffer.GetDeviceAddress(device);
@@ -68,6 +123,11 @@ namespace Renderer::Buffers
         {
             meshIndexBuffer->GetDeviceAddress(device);
         }
+
+        if (instanceBuffer.has_value())
+        {
+            instanceBuffer->GetDeviceAddress(device);
+        }
     }
 
     void DrawCallBuffer::WriteDrawCalls
@@ -82,28 +142,73 @@ namespace Renderer::Buffers
             Logger::Error("{}\n", "Draw calls can't be written!");
         }
 
-        std::vector<VkDrawIndexedIndirectCommand> drawCalls = {};
+        // Meshes shared between render objects are merged into a single instanced draw
+        ankerl::unordered_dense::map<DrawKey, u32, DrawKeyHash> drawCallIndices  = {};
+        std::vector<u32>                                        meshDrawCalls    = {};
+        std::vector<u32>                                        drawCallClusters = {};
+
+        drawCalls.clear();
 
         for (const auto& renderObject : renderObjects)
         {
-            for (const auto& mesh : modelManager.GetModel(renderObject.modelID).meshes)
+            const auto& meshes = modelManager.GetModel(renderObject.modelID).meshes;
+
+            for (usize i = 0; i < meshes.size(); ++i)
             {
-                drawCalls.emplace_back(VkDrawIndexedIndirectCommand{
-                    .indexCount    = mesh.surfaceInfo.indexInfo.count,
-                    .instanceCount = 1,
-                    .firstIndex    = mesh.surfaceInfo.indexInfo.offset,
-                    .vertexOffset  = static_cast<s32>(mesh.surfaceInfo.vertexInfo.offset),
-                    .firstInstance = 0
-                });
+                const auto [iter, inserted] = drawCallIndices.try_emplace(DrawKey{renderObject.modelID, i}, static_cast<u32>(drawCalls.size()));
+
+                if (inserted)
+                {
+                    drawCalls.emplace_back(VkDrawIndexedIndirectCommand{
+                        .indexCount    = meshes[i].surfaceInfo.indexInfo.count,
+                        .instanceCount = 0,
+                        .firstIndex    = meshes[i].surfaceInfo.indexInfo.offset,
+                        .vertexOffset  = static_cast<s32>(meshes[i].surfaceInfo.vertexInfo.offset),
+                        .firstInstance = 0
+                    });
+
+                    drawCallClusters.emplace_back(meshes[i].surfaceInfo.clusterInfo.count);
+                }
+
+                ++drawCalls[iter->second].instanceCount;
+                meshDrawCalls.emplace_back(iter->second);
             }
         }
 
+        writtenMaxClusterCount = 0;
+
+        u32 firstInstance = 0;
+
+        for (usize i = 0; i < drawCalls.size(); ++i)
+        {
+            drawCalls[i].firstInstance = firstInstance;
+            firstInstance             += drawCalls[i].instanceCount;
+
+            writtenMaxClusterCount = std::max(writtenMaxClusterCount, drawCalls[i].instanceCount * drawCallClusters[i]);
+        }
+
+        // Scatter meshes into their draw call's instance range, keeping mesh order within each draw
+        std::vector<u32> instanceCursors(drawCalls.size(), 0);
+
+        instances.resize(meshDrawCalls.size());
+
+        for (usize meshIndex = 0; meshIndex < meshDrawCalls.size(); ++meshIndex)
+        {
+            const u32 drawCallIndex = meshDrawCalls[meshIndex];
+
+            instances[drawCalls[drawCallIndex].firstInstance + instanceCursors[drawCallIndex]++] = GPU::DrawInstance{
+                .meshIndex     = static_cast<u32>(meshIndex),
+                .drawCallIndex = drawCallIndex
+            };
+        }
+
         if (drawCalls.size() > MAX_MESH_COUNT)
         {
             Logger::Error("Too many draw calls! [Count={}]\n", drawCalls.size());
         }
 
-        writtenDrawCount = drawCalls.size();
+        writtenDrawCount     = drawCalls.size();
+        writtenInstanceCount = instances.size();
 
         std::memcpy
         (
@@ -143,6 +248,34 @@ namespace Renderer::Buffers
                 );
             }
         }
+
+        std::memcpy
+        (
+            instanceBuffer->allocationInfo.pMappedData,
+            &writtenInstanceCount,
+            sizeof(u32)
+        );
+
+        if (!instances.empty())
+        {
+            std::memcpy
+            (
+                static_cast<u8*>(instanceBuffer->allocationInfo.pMappedData) + sizeof(u32),
+                instances.data(),
+                instances.size() * sizeof(GPU::DrawInstance)
+            );
+        }
+
+        if (!(instanceBuffer->memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        {
+            Vk::CheckResult(vmaFlushAllocation(
+                allocator,
+                instanceBuffer->allocation,
+                0,
+                sizeof(u32) + instances.size() * sizeof(GPU::DrawInstance)),
+                "Failed to flush allocation!"
+            );
+        }
     }
 
     bool DrawCallBuffer::IsCPUWritable() const
@@ -158,5 +291,10 @@ namespace Renderer::Buffers
         {
             meshIndexBuffer->Destroy(allocator);
         }
+
+        if (instanceBuffer.has_value())
+        {
+            instanceBuffer->Destroy(allocator);
+        }
     }
 }
@@ -21,6 +21,8 @@
 #include "Vulkan/Buffer.h"
 #include "Renderer/RenderObject.h"
 #include "Models/ModelManager.h"
+#include "MeshBuffer.h"
+#include "GPU/DrawInstance.h"
 
 namespace Renderer::Buffers
 {
@@ -30,11 +32,12 @@ namespace Renderer::Buffers
         enum class Type
         {
             CPUToGPU,
-            GPUOnly
+            GPUOnly,
+            CPUCulled
         };
 
         DrawCallBuffer() = default;
-        DrawCallBuffer(VkDevice device, VmaAllocator allocator, Type type);
+        DrawCallBuffer(VkDevice device, VmaAllocator allocator, Type type, u32 capacity = MAX_MESH_COUNT);
 
         void WriteDrawCalls
         (
@@ -45,14 +48,24 @@ namespace Renderer::Buffers
 
         void Destroy(VmaAllocator allocator);
 
-        Type type = Type::CPUToGPU;
+        Type type     = Type::CPUToGPU;
+        u32  capacity = 0;
 
-        u32 writtenDrawCount = 0;
+        u32 writtenDrawCount     = 0;
+        u32 writtenInstanceCount = 0;
+        // Largest instance x cluster count of any single draw, sizes mesh shading task grids
+        u32 writtenMaxClusterCount = 0;
 
         Vk::Buffer drawCallBuffer = {};
 
         // CPU To GPU draw call buffers do not need a mesh index buffer
         std::optional<Vk::Buffer> meshIndexBuffer = std::nullopt;
+        // Only CPU To GPU draw call buffers carry the instance list
+        std::optional<Vk::Buffer> instanceBuffer = std::nullopt;
+
+        // Host copies of the written draw calls and instances, read by CPU culling
+        std::vector<VkDrawIndexedIndirectCommand> drawCalls = {};
+        std::vector<GPU::DrawInstance>            instances = {};
     private:
         [[nodiscard]] bool IsCPUWritable() const;
     };
@@ -19,17 +19,24 @@
 #include "MeshBuffer.h"
 #include "Util/Log.h"
 #include "Vulkan/DebugUtils.h"
+#include "Culling/MultiViewLayout.h"
+#include "Culling/Cluster.h"
 
 namespace Renderer::Buffers
 {
     IndirectBuffer::IndirectBuffer(VkDevice device, VmaAllocator allocator)
-        : frustumCulledBuffers(device, allocator)
+        : frustumCulledBuffers(device, allocator),
+          lateCulledBuffers(device, allocator),
+          clusterCulledBuffers(device, allocator, DrawCallBuffer::Type::GPUOnly, Culling::Cluster::MAX_CLUSTER_DRAW_COUNT),
+          lateClusterCulledBuffers(device, allocator, DrawCallBuffer::Type::GPUOnly, Culling::Cluster::MAX_CLUSTER_DRAW_COUNT),
+          viewCulledBuffers(device, allocator)
     {
         for (usize i = 0; i < writtenDrawCallBuffers.size(); ++i)
         {
             writtenDrawCallBuffers[i] = DrawCallBuffer(device, allocator, DrawCallBuffer::Type::CPUToGPU);
 
-            Vk::SetDebugName(device, writtenDrawCallBuffers[i].drawCallBuffer.handle, fmt::format("IndirectBuffer/DrawCallBuffer/DrawCalls/{}", i));
+            Vk::SetDebugName(device, writtenDrawCallBuffers[i].drawCallBuffer.handle,  fmt::format("IndirectBuffer/DrawCallBuffer/DrawCalls/{}", i));
+            Vk::SetDebugName(device, writtenDrawCallBuffers[i].instanceBuffer->handle, fmt::format("IndirectBuffer/DrawCallBuffer/Instances/{}", i));
         }
 
         Vk::SetDebugName(device, frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,                   "IndirectBuffer/DrawCallBuffer/FrustumCulled/Opaque/DrawCalls");
@@ -40,14 +47,121 @@ namespace Renderer::Buffers
         Vk::SetDebugName(device, frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->handle,            "IndirectBuffer/DrawCallBuffer/FrustumCulled/AlphaMasked/MeshIndices");
         Vk::SetDebugName(device, frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,   "IndirectBuffer/DrawCallBuffer/FrustumCulled/AlphaMasked/DoubleSided/DrawCalls");
         Vk::SetDebugName(device, frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->handle, "IndirectBuffer/DrawCallBuffer/FrustumCulled/AlphaMasked/DoubleSided/MeshIndices");
+        Vk::SetDebugName(device, frustumCulledBuffers.visibleInstanceCountBuffer->handle,                   "IndirectBuffer/DrawCallBuffer/FrustumCulled/VisibleInstanceCounts");
+
+        Vk::SetDebugName(device, lateCulledBuffers.opaqueBuffer.drawCallBuffer.handle,                 "IndirectBuffer/DrawCallBuffer/LateCulled/Opaque/DrawCalls");
+        Vk::SetDebugName(device, lateCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,      "IndirectBuffer/DrawCallBuffer/LateCulled/Opaque/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, lateCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,            "IndirectBuffer/DrawCallBuffer/LateCulled/AlphaMasked/DrawCalls");
+        Vk::SetDebugName(device, lateCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle, "IndirectBuffer/DrawCallBuffer/LateCulled/AlphaMasked/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, lateCulledBuffers.visibleInstanceCountBuffer->handle,                 "IndirectBuffer/DrawCallBuffer/LateCulled/EarlyInstanceCounts");
+
+        Vk::SetDebugName(device, clusterCulledBuffers.opaqueBuffer.drawCallBuffer.handle,                   "IndirectBuffer/DrawCallBuffer/ClusterCulled/Opaque/DrawCalls");
+        Vk::SetDebugName(device, clusterCulledBuffers.opaqueBuffer.meshIndexBuffer->handle,                 "IndirectBuffer/DrawCallBuffer/ClusterCulled/Opaque/MeshIndices");
+        Vk::SetDebugName(device, clusterCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,        "IndirectBuffer/DrawCallBuffer/ClusterCulled/Opaque/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, clusterCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->handle,      "IndirectBuffer/DrawCallBuffer/ClusterCulled/Opaque/DoubleSided/MeshIndices");
+        Vk::SetDebugName(device, clusterCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,              "IndirectBuffer/DrawCallBuffer/ClusterCulled/AlphaMasked/DrawCalls");
+        Vk::SetDebugName(device, clusterCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->handle,            "IndirectBuffer/DrawCallBuffer/ClusterCulled/AlphaMasked/MeshIndices");
+        Vk::SetDebugName(device, clusterCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,   "IndirectBuffer/DrawCallBuffer/ClusterCulled/AlphaMasked/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, clusterCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->handle, "IndirectBuffer/DrawCallBuffer/ClusterCulled/AlphaMasked/DoubleSided/MeshIndices");
+
+        Vk::SetDebugName(device, lateClusterCulledBuffers.opaqueBuffer.drawCallBuffer.handle,                   "IndirectBuffer/DrawCallBuffer/LateClusterCulled/Opaque/DrawCalls");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.opaqueBuffer.meshIndexBuffer->handle,                 "IndirectBuffer/DrawCallBuffer/LateClusterCulled/Opaque/MeshIndices");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,        "IndirectBuffer/DrawCallBuffer/LateClusterCulled/Opaque/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->handle,      "IndirectBuffer/DrawCallBuffer/LateClusterCulled/Opaque/DoubleSided/MeshIndices");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,              "IndirectBuffer/DrawCallBuffer/LateClusterCulled/AlphaMasked/DrawCalls");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->handle,            "IndirectBuffer/DrawCallBuffer/LateClusterCulled/AlphaMasked/MeshIndices");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,   "IndirectBuffer/DrawCallBuffer/LateClusterCulled/AlphaMasked/DoubleSided/DrawCalls");
+        Vk::SetDebugName(device, lateClusterCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->handle, "IndirectBuffer/DrawCallBuffer/LateClusterCulled/AlphaMasked/DoubleSided/MeshIndices");
+
+        Vk::SetDebugName(device, viewCulledBuffers.drawCallBuffer.handle,             "IndirectBuffer/DrawCallBuffer/ViewCulled/DrawCalls");
+        Vk::SetDebugName(device, viewCulledBuffers.meshIndexBuffer.handle,            "IndirectBuffer/DrawCallBuffer/ViewCulled/MeshIndices");
+        Vk::SetDebugName(device, viewCulledBuffers.visibleInstanceCountBuffer.handle, "IndirectBuffer/DrawCallBuffer/ViewCulled/VisibleInstanceCounts");
+    }
+
+    IndirectBuffer::CulledBuffers::CulledBuffers
+    (
+        VkDevice device,
+        VmaAllocator allocator,
+        DrawCallBuffer::Type type,
+        u32 capacity
+    )
+        : opaqueBuffer(device, allocator, type, capacity),
+          opaqueDoubleSidedBuffer(device, allocator, type, capacity),
+          alphaMaskedBuffer(device, allocator, type, capacity),
+          alphaMaskedDoubleSidedBuffer(device, allocator, type, capacity)
+    {
+        if (type != DrawCallBuffer::Type::GPUOnly)
+        {
+            return;
+        }
+
+        visibleInstanceCountBuffer = Vk::Buffer
+        (
+            allocator,
+            capacity * sizeof(u32),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        visibleInstanceCountBuffer->GetDeviceAddress(device);
+    }
+
+    IndirectBuffer::ViewCulledBuffers::ViewCulledBuffers(VkDevice device, VmaAllocator allocator)
+    {
+        using namespace Culling::MultiView;
+
+        static_assert(MAX_VIEW_INSTANCES == MAX_MESH_COUNT, "Every view must be able to hold every mesh!");
+
+        drawCallBuffer = Vk::Buffer
+        (
+            allocator,
+            GetDrawCallOffset(MAX_CULLING_VIEWS, 0),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        meshIndexBuffer = Vk::Buffer
+        (
+            allocator,
+            static_cast<VkDeviceSize>(MAX_CULLING_VIEWS) * MAX_VIEW_INSTANCES * sizeof(u32),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        visibleInstanceCountBuffer = Vk::Buffer
+        (
+            allocator,
+            static_cast<VkDeviceSize>(MAX_CULLING_VIEWS) * MAX_VIEW_DRAW_CALLS * sizeof(u32),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        drawCallBuffer.GetDeviceAddress(device);
+        meshIndexBuffer.GetDeviceAddress(device);
+        visibleInstanceCountBuffer.GetDeviceAddress(device);
+    }
+
+    VkDeviceSize IndirectBuffer::ViewCulledBuffers::GetCountOffset(u32 view, u32 bucket) const
+    {
+        return (view * Culling::MultiView::BUCKET_COUNT + bucket) * sizeof(u32);
     }
 
-    IndirectBuffer::CulledBuffers::CulledBuffers(VkDevice device, VmaAllocator allocator)
-        : opaqueBuffer(device, allocator, DrawCallBuffer::Type::GPUOnly),
-          opaqueDoubleSidedBuffer(device, allocator, DrawCallBuffer::Type::GPUOnly),
-          alphaMaskedBuffer(device, allocator, DrawCallBuffer::Type::GPUOnly),
-          alphaMaskedDoubleSidedBuffer(device, allocator, DrawCallBuffer::Type::GPUOnly)
+    VkDeviceSize IndirectBuffer::ViewCulledBuffers::GetDrawCallOffset(u32 view, u32 bucket) const
     {
+        using namespace Culling::MultiView;
+
+        const VkDeviceSize countsSize  = MAX_CULLING_VIEWS * BUCKET_COUNT * sizeof(u32);
+        const VkDeviceSize bucketIndex = view * BUCKET_COUNT + bucket;
+
+        return countsSize + bucketIndex * MAX_VIEW_DRAW_CALLS * sizeof(VkDrawIndexedIndirectCommand);
     }
 
     void IndirectBuffer::WriteDrawCalls
@@ -55,10 +169,23 @@ namespace Renderer::Buffers
         usize FIF,
         VmaAllocator allocator,
         const Models::ModelManager& modelManager,
-        const std::span<const Renderer::RenderObject> renderObjects
+        const std::span<const Renderer::RenderObject> renderObjects,
+        bool haveRenderObjectsChanged
     )
     {
+        if (haveRenderObjectsChanged)
+        {
+            m_pendingWrites = writtenDrawCallBuffers.size();
+        }
+
+        if (m_pendingWrites == 0)
+        {
+            return;
+        }
+
         writtenDrawCallBuffers[FIF].WriteDrawCalls(allocator, modelManager, renderObjects);
+
+        --m_pendingWrites;
     }
 
     void IndirectBuffer::CulledBuffers::Destroy(VmaAllocator allocator)
@@ -67,6 +194,18 @@ namespace Renderer::Buffers
         opaqueDoubleSidedBuffer.Destroy(allocator);
         alphaMaskedBuffer.Destroy(allocator);
         alphaMaskedDoubleSidedBuffer.Destroy(allocator);
+
+        if (visibleInstanceCountBuffer.has_value())
+        {
+            visibleInstanceCountBuffer->Destroy(allocator);
+        }
+    }
+
+    void IndirectBuffer::ViewCulledBuffers::Destroy(VmaAllocator allocator)
+    {
+        drawCallBuffer.Destroy(allocator);
+        meshIndexBuffer.Destroy(allocator);
+        visibleInstanceCountBuffer.Destroy(allocator);
     }
 
     void IndirectBuffer::Destroy(VmaAllocator allocator)
@@ -77,5 +216,9 @@ namespace Renderer::Buffers
         }
 
         frustumCulledBuffers.Destroy(allocator);
+        lateCulledBuffers.Destroy(allocator);
+        clusterCulledBuffers.Destroy(allocator);
+        lateClusterCulledBuffers.Destroy(allocator);
+        viewCulledBuffers.Destroy(allocator);
     }
 }
\ No newline at end of file
@@ -36,7 +36,8 @@ namespace Renderer::Buffers
             usize FIF,
             VmaAllocator allocator,
             const Models::ModelManager& modelManager,
-            const std::span<const Renderer::RenderObject> renderObjects
+            const std::span<const Renderer::RenderObject> renderObjects,
+            bool haveRenderObjectsChanged
         );
 
         void Destroy(VmaAllocator allocator);
@@ -45,7 +46,14 @@ namespace Renderer::Buffers
 
         struct CulledBuffers
         {
-            CulledBuffers(VkDevice device, VmaAllocator allocator);
+            CulledBuffers() = default;
+            CulledBuffers
+            (
+                VkDevice device,
+                VmaAllocator allocator,
+                DrawCallBuffer::Type type = DrawCallBuffer::Type::GPUOnly,
+                u32 capacity = MAX_MESH_COUNT
+            );
 
             void Destroy(VmaAllocator allocator);
 
@@ -53,7 +61,41 @@ namespace Renderer::Buffers
             DrawCallBuffer opaqueDoubleSidedBuffer;
             DrawCallBuffer alphaMaskedBuffer;
             DrawCallBuffer alphaMaskedDoubleSidedBuffer;
+
+            // Visible instance count per written draw call, only needed when culling on the GPU
+            std::optional<Vk::Buffer> visibleInstanceCountBuffer = std::nullopt;
         } frustumCulledBuffers;
+
+        // Draws added by the late occlusion pass. These index into the frustum culled mesh indices,
+        // and the instance count buffer holds the early pass counts they were appended after
+        CulledBuffers lateCulledBuffers;
+
+        // One draw per visible cluster, each with its own mesh index. The late pass appends to
+        // the cluster culled buckets and writes the same clusters to the late ones
+        CulledBuffers clusterCulledBuffers;
+        CulledBuffers lateClusterCulledBuffers;
+
+        // Draws for several views culled in one dispatch, laid out per view and bucket
+        struct ViewCulledBuffers
+        {
+            ViewCulledBuffers() = default;
+            ViewCulledBuffers(VkDevice device, VmaAllocator allocator);
+
+            [[nodiscard]] VkDeviceSize GetCountOffset(u32 view, u32 bucket) const;
+            [[nodiscard]] VkDeviceSize GetDrawCallOffset(u32 view, u32 bucket) const;
+
+            void Destroy(VmaAllocator allocator);
+
+            // Draw counts of every view and bucket, then their draw calls
+            Vk::Buffer drawCallBuffer;
+            // Mesh indices of every view, offset by the compacted draw calls
+            Vk::Buffer meshIndexBuffer;
+            // Visible instance count per view and written draw call, views are written draw count apart
+            Vk::Buffer visibleInstanceCountBuffer;
+        } viewCulledBuffers;
+    private:
+        // Draw calls only change with the render object list, each frame in flight still needs its own copy
+        usize m_pendingWrites = Vk::FRAMES_IN_FLIGHT;
     };
 }
 
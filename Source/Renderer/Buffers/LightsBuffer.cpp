@@ -16,44 +16,42 @@
 
 #include "LightsBuffer.h"
 
-#include "Util/Concept.h"
 #include "Vulkan/DebugUtils.h"
 #include "Util/Log.h"
 
 namespace Renderer::Buffers
 {
-    struct GPULights
-    {
-        GPU::DirLight           sun                                                      = {};
-        u32                     pointLightCount                                          = 0;
-        GPU::PointLight         pointLights[GPU::MAX_POINT_LIGHT_COUNT]                  = {};
-        u32                     shadowedPointLightCount                                  = 0;
-        GPU::ShadowedPointLight shadowedPointLights[GPU::MAX_SHADOWED_POINT_LIGHT_COUNT] = {};
-        u32                     spotLightCount                                           = 0;
-        GPU::SpotLight          spotLights[GPU::MAX_SPOT_LIGHT_COUNT]                    = {};
-    };
+    // Initial capacity for each of the unshadowed light lists, buffers grow past this on demand
+    constexpr usize INITIAL_LIGHT_CAPACITY = 64;
+    // Lights that already own a shadow slot are favoured, so lights of similar importance don't swap slots every frame
+    constexpr f32 SHADOW_SLOT_HYSTERESIS = 1.25f;
+    // Frames a tile's requested size has to stay different before the tile is resized
+    constexpr u32 SHADOW_TILE_HYSTERESIS_FRAMES = 30;
 
     LightsBuffer::LightsBuffer(VkDevice device, VmaAllocator allocator)
     {
+        const auto layout = GetLayout
+        (
+            INITIAL_LIGHT_CAPACITY,
+            GPU::MAX_SHADOWED_POINT_LIGHT_COUNT,
+            INITIAL_LIGHT_CAPACITY,
+            GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT
+        );
+
         for (usize i = 0; i < buffers.size(); ++i)
         {
-            buffers[i] = Vk::Buffer
-            (
-                allocator,
-                sizeof(GPULights),
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
-                VMA_MEMORY_USAGE_AUTO
-            );
+            CreateBuffer(i, device, allocator, layout.size);
+
+            m_layouts[i] = GetLayout(0, 0, 0, 0);
 
             constexpr u32 ZERO = 0;
 
             const auto pMappedData = static_cast<u8*>(buffers[i].allocationInfo.pMappedData);
 
-            std::memcpy(pMappedData + GetPointLightOffset(),         &ZERO, sizeof(u32));
-            std::memcpy(pMappedData + GetShadowedPointLightOffset(), &ZERO, sizeof(u32));
-            std::memcpy(pMappedData + GetSpotLightOffset(),          &ZERO, sizeof(u32));
+            std::memcpy(pMappedData + m_layouts[i].pointLights,         &ZERO, sizeof(u32));
+            std::memcpy(pMappedData + m_layouts[i].shadowedPointLights, &ZERO, sizeof(u32));
+            std::memcpy(pMappedData + m_layouts[i].spotLights,          &ZERO, sizeof(u32));
+            std::memcpy(pMappedData + m_layouts[i].shadowedSpotLights,  &ZERO, sizeof(u32));
 
             if (!(buffers[i].memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
             {
@@ -65,46 +63,58 @@ namespace Renderer::Buffers
                     "Failed to flush allocation!"
                 );
             }
-
-            buffers[i].GetDeviceAddress(device);
-
-            Vk::SetDebugName(device, buffers[i].handle, fmt::format("LightBuffer/{}", i));
         }
     }
 
     void LightsBuffer::WriteLights
     (
         usize FIF,
+        VkDevice device,
         VmaAllocator allocator,
+        const CameraInfo& camera,
         const GPU::DirLight& inSun,
         const std::span<const GPU::PointLight> inPointLights,
         const std::span<const GPU::SpotLight> inSpotLights
     )
     {
-        WriteSunLight(FIF, inSun);
+        sun = inSun;
+
+        AssignShadowSlots(camera, inPointLights, m_pointShadowSlots, shadowedPointLights, pointLights);
+        AssignShadowSlots(camera, inSpotLights,  m_spotShadowSlots,  shadowedSpotLights,  spotLights);
+
+        AllocateShadowAtlas(camera);
 
-        spotLights = WriteLights(FIF, inSpotLights);
+        const auto layout = GetLayout
+        (
+            pointLights.size(),
+            shadowedPointLights.size(),
+            spotLights.size(),
+            shadowedSpotLights.size()
+        );
 
-        // Point Lights
+        // This frame's previous use of the buffer has already finished, so it can be replaced right away
+        if (layout.size > buffers[FIF].size)
         {
-            std::vector<GPU::ShadowedPointLight> inShadowedPointLights;
+            const VkDeviceSize newSize = std::max(layout.size, 2 * buffers[FIF].size);
 
-            inShadowedPointLights.resize(std::min<usize>(inPointLights.size(), GPU::MAX_SHADOWED_POINT_LIGHT_COUNT));
+            buffers[FIF].Destroy(allocator);
 
-            for (usize i = 0; i < inShadowedPointLights.size(); ++i)
-            {
-                inShadowedPointLights[i] = GPU::ShadowedPointLight(inPointLights[i]);
-            }
+            CreateBuffer(FIF, device, allocator, newSize);
+        }
 
-            const auto uploadedPointLights = (inPointLights.size() <= inShadowedPointLights.size()) ?
-                                             std::span<GPU::PointLight>{} :
-                                             std::span(inPointLights.begin() + inShadowedPointLights.size(), inPointLights.end());
+        m_layouts[FIF] = layout;
 
-            const std::span<const GPU::ShadowedPointLight> uploadedShadowedPointLights = inShadowedPointLights;
+        std::memcpy
+        (
+            static_cast<u8*>(buffers[FIF].allocationInfo.pMappedData) + layout.sun,
+            &sun,
+            sizeof(GPU::DirLight)
+        );
 
-            pointLights         = WriteLights(FIF, uploadedPointLights);
-            shadowedPointLights = WriteLights(FIF, uploadedShadowedPointLights);
-        }
+        WriteLights<GPU::PointLight>(FIF, layout.pointLights, pointLights);
+        WriteLights<GPU::ShadowedPointLight>(FIF, layout.shadowedPointLights, shadowedPointLights);
+        WriteLights<GPU::SpotLight>(FIF, layout.spotLights, spotLights);
+        WriteLights<GPU::ShadowedSpotLight>(FIF, layout.shadowedSpotLights, shadowedSpotLights);
 
         if (!(buffers[FIF].memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
         {
@@ -112,59 +122,268 @@ namespace Renderer::Buffers
                 allocator,
                 buffers[FIF].allocation,
                 0,
-                buffers[FIF].size),
+                layout.size),
                 "Failed to flush allocation!"
             );
         }
     }
 
-    void LightsBuffer::WriteSunLight(usize FIF, const GPU::DirLight& inSun)
+    template <typename T, typename S, usize N>
+    void LightsBuffer::AssignShadowSlots
+    (
+        const CameraInfo& camera,
+        const std::span<const T> inLights,
+        std::array<std::optional<usize>, N>& shadowSlots,
+        std::vector<S>& shadowedLights,
+        std::vector<T>& unshadowedLights
+    )
     {
-        sun = inSun;
+        std::vector<std::pair<f32, usize>> ranking = {};
+        ranking.reserve(inLights.size());
 
-        const auto offset  = GetSunOffset();
-        const auto pointer = static_cast<u8*>(buffers[FIF].allocationInfo.pMappedData) + offset;
+        std::vector<bool> isSlotted(inLights.size(), false);
 
-        std::memcpy
+        for (const auto& slot : shadowSlots)
+        {
+            if (slot.has_value() && *slot < inLights.size())
+            {
+                isSlotted[*slot] = true;
+            }
+        }
+
+        for (usize i = 0; i < inLights.size(); ++i)
+        {
+            f32 importance = GetShadowImportance(inLights[i], camera);
+
+            if (isSlotted[i])
+            {
+                importance *= SHADOW_SLOT_HYSTERESIS;
+            }
+
+            ranking.emplace_back(importance, i);
+        }
+
+        const usize shadowedCount = std::min<usize>(ranking.size(), N);
+
+        std::partial_sort
         (
-            pointer,
-            &sun,
-            sizeof(GPU::DirLight)
+            ranking.begin(),
+            ranking.begin() + static_cast<std::ptrdiff_t>(shadowedCount),
+            ranking.end(),
+            [] (const auto& lhs, const auto& rhs)
+            {
+                return lhs.first > rhs.first;
+            }
         );
+
+        std::vector<bool> isSelected(inLights.size(), false);
+
+        for (usize i = 0; i < shadowedCount; ++i)
+        {
+            isSelected[ranking[i].second] = true;
+        }
+
+        // Selected lights keep their slot, the rest are handed out to the newly selected lights
+        std::array<std::optional<usize>, N> slots = {};
+
+        for (usize slot = 0; slot < shadowedCount; ++slot)
+        {
+            const auto& lightIndex = shadowSlots[slot];
+
+            if (lightIndex.has_value() && *lightIndex < inLights.size() && isSelected[*lightIndex])
+            {
+                slots[slot]             = lightIndex;
+                isSelected[*lightIndex] = false;
+            }
+        }
+
+        for (usize i = 0, slot = 0; i < shadowedCount; ++i)
+        {
+            const usize lightIndex = ranking[i].second;
+
+            if (!isSelected[lightIndex])
+            {
+                continue;
+            }
+
+            while (slots[slot].has_value())
+            {
+                ++slot;
+            }
+
+            slots[slot] = lightIndex;
+        }
+
+        shadowSlots = slots;
+
+        // Matrices only depend on the light's view, so they are only rebuilt for lights that moved or changed slots
+        const usize previousCount = shadowedLights.size();
+
+        shadowedLights.resize(shadowedCount);
+
+        std::vector<bool> isShadowed(inLights.size(), false);
+
+        for (usize slot = 0; slot < shadowedCount; ++slot)
+        {
+            const auto& light = inLights[*shadowSlots[slot]];
+            auto&       dst   = shadowedLights[slot];
+
+            isShadowed[*shadowSlots[slot]] = true;
+
+            if (slot < previousCount && HasSameView(dst, light))
+            {
+                dst.color     = light.color;
+                dst.intensity = light.intensity;
+                dst.range     = light.range;
+
+                continue;
+            }
+
+            dst = S(light);
+        }
+
+        unshadowedLights.clear();
+
+        for (usize i = 0; i < inLights.size(); ++i)
+        {
+            if (!isShadowed[i])
+            {
+                unshadowedLights.emplace_back(inLights[i]);
+            }
+        }
+    }
+
+    void LightsBuffer::AllocateShadowAtlas(const CameraInfo& camera)
+    {
+        std::vector<u32> tileSizes = {};
+        tileSizes.reserve(6 * shadowedPointLights.size() + shadowedSpotLights.size());
+
+        for (usize i = 0; i < shadowedPointLights.size(); ++i)
+        {
+            const u32 requestedSize = GetShadowTileSize(shadowedPointLights[i], camera);
+
+            tileSizes.insert(tileSizes.end(), 6, UpdateTileSize(m_pointTileStates[i], *m_pointShadowSlots[i], requestedSize));
+        }
+
+        for (usize i = 0; i < shadowedSpotLights.size(); ++i)
+        {
+            const u32 requestedSize = GetShadowTileSize(shadowedSpotLights[i], camera);
+
+            tileSizes.emplace_back(UpdateTileSize(m_spotTileStates[i], *m_spotShadowSlots[i], requestedSize));
+        }
+
+        const auto tiles = m_shadowAtlas.Allocate(tileSizes);
+
+        for (usize i = 0; i < shadowedPointLights.size(); ++i)
+        {
+            for (usize face = 0; face < 6; ++face)
+            {
+                shadowedPointLights[i].atlasRects[face] = ShadowAtlas::GetRect(tiles[6 * i + face]);
+            }
+        }
+
+        for (usize i = 0; i < shadowedSpotLights.size(); ++i)
+        {
+            shadowedSpotLights[i].atlasRect = ShadowAtlas::GetRect(tiles[6 * shadowedPointLights.size() + i]);
+        }
+    }
+
+    u64 LightsBuffer::GetShadowAtlasGeneration() const
+    {
+        return m_shadowAtlas.GetGeneration();
+    }
+
+    bool LightsBuffer::IsVisible(const glm::vec3& position, f32 range, const CameraInfo& camera)
+    {
+        // Only the side planes, the projection has no far plane
+        for (usize i = 0; i < 4; ++i)
+        {
+            const auto& plane = camera.frustum.planes[i];
+
+            if (glm::dot(plane.normal, position) + plane.distance < -range)
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     template <typename T> requires GPU::IsLightType<T>
-    std::vector<T> LightsBuffer::WriteLights(usize FIF, const std::span<const T> lights)
+    f32 LightsBuffer::GetShadowImportance(const T& light, const CameraInfo& camera)
     {
-        VkDeviceSize offset        = 0;
-        u32          maxLightCount = 0;
+        if (!IsVisible(light.position, light.range, camera))
+        {
+            return 0.0f;
+        }
+
+        const f32 luminance = glm::dot(light.color * light.intensity, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+        const f32 distance  = glm::distance(light.position, camera.position);
+
+        // Roughly the light's share of the screen, lights around the camera get their full weight
+        return luminance * light.range / std::max(distance, light.range);
+    }
 
-        if constexpr (std::is_same_v<T, GPU::PointLight>)
+    template <typename T> requires GPU::IsLightType<T>
+    u32 LightsBuffer::GetShadowTileSize(const T& light, const CameraInfo& camera)
+    {
+        if (!IsVisible(light.position, light.range, camera))
         {
-            offset        = GetPointLightOffset();
-            maxLightCount = GPU::MAX_POINT_LIGHT_COUNT;
+            return GPU::SHADOW_ATLAS_MIN_TILE_SIZE;
         }
-        else if constexpr (std::is_same_v<T, GPU::ShadowedPointLight>)
+
+        // Projected radius of the light's range, lights around the camera cover the whole screen
+        const f32 distance      = glm::distance(light.position, camera.position);
+        const f32 projectedSize = camera.projectionScale * light.range / std::max(distance, light.range);
+        const u32 requestedSize = std::bit_ceil(static_cast<u32>(std::max(projectedSize, 1.0f)));
+
+        return std::clamp(requestedSize, GPU::SHADOW_ATLAS_MIN_TILE_SIZE, GPU::SHADOW_ATLAS_MAX_TILE_SIZE);
+    }
+
+    u32 LightsBuffer::UpdateTileSize(TileState& state, usize owner, u32 requestedSize)
+    {
+        // A light that just took over the slot starts at its own size
+        if (state.owner != owner)
         {
-            offset        = GetShadowedPointLightOffset();
-            maxLightCount = GPU::MAX_SHADOWED_POINT_LIGHT_COUNT;
+            state = TileState{
+                .owner         = owner,
+                .size          = requestedSize,
+                .pendingFrames = 0
+            };
+
+            return state.size;
         }
-        else if constexpr (std::is_same_v<T, GPU::SpotLight>)
+
+        if (requestedSize == state.size)
         {
-            offset        = GetSpotLightOffset();
-            maxLightCount = GPU::MAX_SPOT_LIGHT_COUNT;
+            state.pendingFrames = 0;
         }
-        else if constexpr (Util::AlwaysTrue<T>)
+        // Growing by more than one step is a visible loss of detail, everything else waits to see if it sticks
+        else if (requestedSize > 2 * state.size || ++state.pendingFrames >= SHADOW_TILE_HYSTERESIS_FRAMES)
         {
-            static_assert(Util::AlwaysFalse<T>, "Invalid light type!");
+            state.size          = requestedSize;
+            state.pendingFrames = 0;
         }
 
-        const VkDeviceSize requiredSize   = lights.size_bytes();
-        const VkDeviceSize maxAllowedSize = maxLightCount * sizeof(T);
+        return state.size;
+    }
 
-        const VkDeviceSize size  = std::min(requiredSize, maxAllowedSize);
-        const u32          count = size / sizeof(T);
+    bool LightsBuffer::HasSameView(const GPU::ShadowedPointLight& shadowedLight, const GPU::PointLight& light)
+    {
+        return shadowedLight.position == light.position;
+    }
 
+    bool LightsBuffer::HasSameView(const GPU::ShadowedSpotLight& shadowedLight, const GPU::SpotLight& light)
+    {
+        return shadowedLight.position  == light.position  &&
+               shadowedLight.direction == light.direction &&
+               shadowedLight.cutOff    == light.cutOff;
+    }
+
+    template <typename T> requires GPU::IsLightType<T>
+    void LightsBuffer::WriteLights(usize FIF, VkDeviceSize offset, const std::span<const T> lights)
+    {
+        const u32  count   = static_cast<u32>(lights.size());
         const auto pointer = static_cast<u8*>(buffers[FIF].allocationInfo.pMappedData) + offset;
 
         std::memcpy
@@ -174,39 +393,77 @@ namespace Renderer::Buffers
             sizeof(u32)
         );
 
-        if (size != 0 && !lights.empty())
+        if (!lights.empty())
         {
             std::memcpy
             (
                 pointer + sizeof(u32),
                 lights.data(),
-                size
+                lights.size_bytes()
             );
         }
+    }
+
+    LightsBuffer::Layout LightsBuffer::GetLayout
+    (
+        usize pointLightCount,
+        usize shadowedPointLightCount,
+        usize spotLightCount,
+        usize shadowedSpotLightCount
+    )
+    {
+        Layout layout = {};
 
-        return lights.empty() ?
-               std::vector<T>{} :
-               std::vector<T>(lights.begin(), lights.begin() + count);
+        layout.sun                 = 0;
+        layout.pointLights         = layout.sun                 + sizeof(GPU::DirLight);
+        layout.shadowedPointLights = layout.pointLights         + sizeof(u32) + pointLightCount         * sizeof(GPU::PointLight);
+        layout.spotLights          = layout.shadowedPointLights + sizeof(u32) + shadowedPointLightCount * sizeof(GPU::ShadowedPointLight);
+        layout.shadowedSpotLights  = layout.spotLights          + sizeof(u32) + spotLightCount          * sizeof(GPU::SpotLight);
+        layout.size                = layout.shadowedSpotLights  + sizeof(u32) + shadowedSpotLightCount  * sizeof(GPU::ShadowedSpotLight);
+
+        return layout;
+    }
+
+    void LightsBuffer::CreateBuffer(usize FIF, VkDevice device, VmaAllocator allocator, VkDeviceSize size)
+    {
+        buffers[FIF] = Vk::Buffer
+        (
+            allocator,
+            size,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            VMA_MEMORY_USAGE_AUTO
+        );
+
+        buffers[FIF].GetDeviceAddress(device);
+
+        Vk::SetDebugName(device, buffers[FIF].handle, fmt::format("LightBuffer/{}", FIF));
+    }
+
+    VkDeviceSize LightsBuffer::GetSunOffset(usize FIF) const
+    {
+        return m_layouts[FIF].sun;
     }
 
-    VkDeviceSize LightsBuffer::GetSunOffset()
+    VkDeviceSize LightsBuffer::GetPointLightOffset(usize FIF) const
     {
-        return offsetof(GPULights, sun);
+        return m_layouts[FIF].pointLights;
     }
 
-    VkDeviceSize LightsBuffer::GetPointLightOffset()
+    VkDeviceSize LightsBuffer::GetShadowedPointLightOffset(usize FIF) const
     {
-        return offsetof(GPULights, pointLightCount);
+        return m_layouts[FIF].shadowedPointLights;
     }
 
-    VkDeviceSize LightsBuffer::GetShadowedPointLightOffset()
+    VkDeviceSize LightsBuffer::GetSpotLightOffset(usize FIF) const
     {
-        return offsetof(GPULights, shadowedPointLightCount);
+        return m_layouts[FIF].spotLights;
     }
 
-    VkDeviceSize LightsBuffer::GetSpotLightOffset()
+    VkDeviceSize LightsBuffer::GetShadowedSpotLightOffset(usize FIF) const
     {
-        return offsetof(GPULights, spotLightCount);
+        return m_layouts[FIF].shadowedSpotLights;
     }
 
     void LightsBuffer::Destroy(VmaAllocator allocator)
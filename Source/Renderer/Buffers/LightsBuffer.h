@@ -20,27 +20,43 @@
 #include "Vulkan/Buffer.h"
 #include "Vulkan/Constants.h"
 #include "GPU/Lights.h"
+#include "GPU/Plane.h"
+#include "ShadowAtlas.h"
 
 namespace Renderer::Buffers
 {
     class LightsBuffer
     {
     public:
+        // What shadow slots and atlas tiles are prioritised for
+        struct CameraInfo
+        {
+            glm::vec3          position;
+            GPU::FrustumBuffer frustum;
+            // Pixels covered by one unit at a distance of one unit
+            f32                projectionScale;
+        };
+
         LightsBuffer(VkDevice device, VmaAllocator allocator);
 
         void WriteLights
         (
             usize FIF,
+            VkDevice device,
             VmaAllocator allocator,
+            const CameraInfo& camera,
             const GPU::DirLight& inSun,
             const std::span<const GPU::PointLight> inPointLights,
             const std::span<const GPU::SpotLight> inSpotLights
         );
 
-        [[nodiscard]] static VkDeviceSize GetSunOffset();
-        [[nodiscard]] static VkDeviceSize GetPointLightOffset();
-        [[nodiscard]] static VkDeviceSize GetShadowedPointLightOffset();
-        [[nodiscard]] static VkDeviceSize GetSpotLightOffset();
+        [[nodiscard]] VkDeviceSize GetSunOffset(usize FIF) const;
+        [[nodiscard]] VkDeviceSize GetPointLightOffset(usize FIF) const;
+        [[nodiscard]] VkDeviceSize GetShadowedPointLightOffset(usize FIF) const;
+        [[nodiscard]] VkDeviceSize GetSpotLightOffset(usize FIF) const;
+        [[nodiscard]] VkDeviceSize GetShadowedSpotLightOffset(usize FIF) const;
+
+        [[nodiscard]] u64 GetShadowAtlasGeneration() const;
 
         void Destroy(VmaAllocator allocator);
 
@@ -50,11 +66,77 @@ namespace Renderer::Buffers
         std::vector<GPU::PointLight>         pointLights;
         std::vector<GPU::ShadowedPointLight> shadowedPointLights;
         std::vector<GPU::SpotLight>          spotLights;
+        std::vector<GPU::ShadowedSpotLight>  shadowedSpotLights;
     private:
-        void WriteSunLight(usize FIF, const GPU::DirLight& inSun);
+        // Lights are packed back to back, each list is prefixed with its count
+        struct Layout
+        {
+            VkDeviceSize sun                 = 0;
+            VkDeviceSize pointLights         = 0;
+            VkDeviceSize shadowedPointLights = 0;
+            VkDeviceSize spotLights          = 0;
+            VkDeviceSize shadowedSpotLights  = 0;
+            VkDeviceSize size                = 0;
+        };
+
+        // Tile size a shadow slot holds, changes are delayed so ordinary camera motion doesn't repack the atlas
+        struct TileState
+        {
+            std::optional<usize> owner         = std::nullopt;
+            u32                  size          = 0;
+            u32                  pendingFrames = 0;
+        };
+
+        // Picks which lights get shadow maps, lights keep their slot for as long as they stay selected
+        template <typename T, typename S, usize N>
+        static void AssignShadowSlots
+        (
+            const CameraInfo& camera,
+            const std::span<const T> inLights,
+            std::array<std::optional<usize>, N>& shadowSlots,
+            std::vector<S>& shadowedLights,
+            std::vector<T>& unshadowedLights
+        );
+
+        // Gives every point light face and spot light a tile sized by how large the light is on screen
+        void AllocateShadowAtlas(const CameraInfo& camera);
+
+        [[nodiscard]] static bool IsVisible(const glm::vec3& position, f32 range, const CameraInfo& camera);
+
+        template <typename T> requires GPU::IsLightType<T>
+        [[nodiscard]] static f32 GetShadowImportance(const T& light, const CameraInfo& camera);
+
+        template <typename T> requires GPU::IsLightType<T>
+        [[nodiscard]] static u32 GetShadowTileSize(const T& light, const CameraInfo& camera);
+
+        [[nodiscard]] static u32 UpdateTileSize(TileState& state, usize owner, u32 requestedSize);
+
+        [[nodiscard]] static bool HasSameView(const GPU::ShadowedPointLight& shadowedLight, const GPU::PointLight& light);
+        [[nodiscard]] static bool HasSameView(const GPU::ShadowedSpotLight& shadowedLight, const GPU::SpotLight& light);
+
+        [[nodiscard]] static Layout GetLayout
+        (
+            usize pointLightCount,
+            usize shadowedPointLightCount,
+            usize spotLightCount,
+            usize shadowedSpotLightCount
+        );
+
+        void CreateBuffer(usize FIF, VkDevice device, VmaAllocator allocator, VkDeviceSize size);
 
         template <typename T> requires GPU::IsLightType<T>
-        [[nodiscard]] std::vector<T> WriteLights(usize FIF, const std::span<const T> lights);
+        void WriteLights(usize FIF, VkDeviceSize offset, const std::span<const T> lights);
+
+        std::array<Layout, Vk::FRAMES_IN_FLIGHT> m_layouts = {};
+
+        // Index into the scene's lights for each shadow slot
+        std::array<std::optional<usize>, GPU::MAX_SHADOWED_POINT_LIGHT_COUNT> m_pointShadowSlots = {};
+        std::array<std::optional<usize>, GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT>  m_spotShadowSlots  = {};
+
+        std::array<TileState, GPU::MAX_SHADOWED_POINT_LIGHT_COUNT> m_pointTileStates = {};
+        std::array<TileState, GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT>  m_spotTileStates  = {};
+
+        ShadowAtlas m_shadowAtlas = {};
     };
 }
 
@@ -16,30 +16,49 @@
 
 #include "MeshBuffer.h"
 
+#include <numeric>
+#include <algorithm>
+
 #include "Vulkan/DebugUtils.h"
 #include "Util/Maths.h"
 #include "Util/Log.h"
-#include "GPU/Mesh.h"
+#include "Util/Hash.h"
+#include "Util/Parallel.h"
 
 namespace Renderer::Buffers
 {
+    constexpr usize TRANSFORM_BATCH_SIZE = 64;
+
     MeshBuffer::MeshBuffer(VkDevice device, VmaAllocator allocator)
     {
-        for (usize i = 0; i < m_buffers.size(); ++i)
+        const auto CreateStream = [device, allocator] (VkDeviceSize size, const std::string_view name)
         {
-            m_buffers[i] = Vk::Buffer
+            auto buffer = Vk::Buffer
             (
                 allocator,
-                MAX_MESH_COUNT * sizeof(GPU::Mesh),
+                size,
                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
                 VMA_MEMORY_USAGE_AUTO
             );
 
-            m_buffers[i].GetDeviceAddress(device);
+            buffer.GetDeviceAddress(device);
+
+            Vk::SetDebugName(device, buffer.handle, name);
+
+            return buffer;
+        };
 
-            Vk::SetDebugName(device, m_buffers[i].handle, fmt::format("MeshBuffer/{}", i));
+        for (usize i = 0; i < m_streams.size(); ++i)
+        {
+            m_streams[i] = Streams
+            {
+                .meshes     = CreateStream(MAX_MESH_COUNT * sizeof(GPU::Mesh),      fmt::format("MeshBuffer/Meshes/{}",     i)),
+                .transforms = CreateStream(MAX_MESH_COUNT * sizeof(GPU::Transform), fmt::format("MeshBuffer/Transforms/{}", i)),
+                .bounds     = CreateStream(MAX_MESH_COUNT * sizeof(GPU::AABB),      fmt::format("MeshBuffer/Bounds/{}",     i)),
+                .materials  = CreateStream(MAX_MESH_COUNT * sizeof(GPU::Material),  fmt::format("MeshBuffer/Materials/{}",  i))
+            };
         }
     }
 
@@ -48,74 +67,289 @@ namespace Renderer::Buffers
         usize frameIndex,
         VmaAllocator allocator,
         const Models::ModelManager& modelManager,
-        const std::vector<Renderer::RenderObject>& renderObjects
+        const std::span<const Renderer::RenderObject> renderObjects,
+        const std::span<const usize> dirtyRenderObjects,
+        bool haveRenderObjectsChanged
     )
     {
-        std::vector<GPU::Mesh> meshes = {};
+        if (haveRenderObjectsChanged)
+        {
+            m_meshes.clear();
+            m_transforms.clear();
+            m_bounds.clear();
+            m_materials.clear();
+            m_meshNormalMatrices.clear();
+            m_renderObjectRanges.clear();
+            m_materialIndices.clear();
+
+            for (const auto& renderObject : renderObjects)
+            {
+                const usize meshCount = modelManager.GetModel(renderObject.modelID).meshes.size();
+
+                m_renderObjectRanges.emplace_back(RenderObjectRange{
+                    .firstMesh     = m_meshes.size(),
+                    .meshCount     = meshCount,
+                    .pendingWrites = 0
+                });
+
+                m_meshes.resize(m_meshes.size() + meshCount);
+                m_transforms.resize(m_transforms.size() + meshCount);
+                m_bounds.resize(m_bounds.size() + meshCount);
+                m_meshNormalMatrices.resize(m_meshNormalMatrices.size() + meshCount);
+
+                EncodeRenderObject(modelManager, renderObject, m_renderObjectRanges.back().firstMesh);
+            }
 
-        for (const auto& renderObject : renderObjects)
+            m_updatedObjects.resize(renderObjects.size());
+            std::iota(m_updatedObjects.begin(), m_updatedObjects.end(), 0);
+
+            // Every buffer in the ring needs the new layout
+            m_pendingFullWrites = m_streams.size();
+        }
+        else
         {
-            const auto globalTransform = Maths::TransformMatrix
+            m_updatedObjects.assign(dirtyRenderObjects.begin(), dirtyRenderObjects.end());
+
+            std::ranges::sort(m_updatedObjects);
+            m_updatedObjects.erase(std::ranges::unique(m_updatedObjects).begin(), m_updatedObjects.end());
+
+            for (const auto index : m_updatedObjects)
+            {
+                m_renderObjectRanges[index].pendingWrites = m_streams.size();
+            }
+        }
+
+        EncodeTransforms(modelManager, renderObjects);
+
+        const auto& streams = GetCurrentStreams(frameIndex);
+
+        const auto WriteRange = [allocator] <typename T> (const Vk::Buffer& buffer, const std::vector<T>& data, usize first, usize count)
+        {
+            const VkDeviceSize offset = first * sizeof(T);
+            const VkDeviceSize size   = count * sizeof(T);
+
+            if (size == 0)
+            {
+                return;
+            }
+
+            std::memcpy
             (
-                renderObject.position,
-                renderObject.rotation,
-                renderObject.scale
+                static_cast<u8*>(buffer.allocationInfo.pMappedData) + offset,
+                data.data() + first,
+                size
             );
 
-            for (const auto& mesh : modelManager.GetModel(renderObject.modelID).meshes)
+            if (!(buffer.memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
             {
-                const auto transform    = globalTransform * mesh.transform;
-                const auto normalMatrix = Maths::NormalMatrix(transform);
-
-                meshes.emplace_back
-                (
-                    mesh.surfaceInfo,
-                    mesh.material.Convert(modelManager.textureManager),
-                    transform,
-                    normalMatrix,
-                    mesh.aabb
+                Vk::CheckResult(vmaFlushAllocation(
+                    allocator,
+                    buffer.allocation,
+                    offset,
+                    size),
+                    "Failed to flush allocation!"
                 );
             }
+        };
+
+        const bool isFullWrite = m_pendingFullWrites > 0;
+
+        if (isFullWrite)
+        {
+            WriteRange(streams.meshes,     m_meshes,     0, m_meshes.size());
+            WriteRange(streams.transforms, m_transforms, 0, m_transforms.size());
+            WriteRange(streams.bounds,     m_bounds,     0, m_bounds.size());
+            WriteRange(streams.materials,  m_materials,  0, m_materials.size());
+
+            --m_pendingFullWrites;
         }
 
-        const auto& buffer = GetCurrentBuffer(frameIndex);
+        for (auto& range : m_renderObjectRanges)
+        {
+            if (range.pendingWrites == 0)
+            {
+                continue;
+            }
 
-        const VkDeviceSize meshCopySize =  meshes.size() * sizeof(GPU::Mesh);
+            if (!isFullWrite)
+            {
+                WriteRange(streams.transforms, m_transforms, range.firstMesh, range.meshCount);
+            }
 
-        std::memcpy
-        (
-            buffer.allocationInfo.pMappedData,
-            meshes.data(),
-            meshCopySize
-        );
+            --range.pendingWrites;
+        }
+    }
 
-        if (!(buffer.memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+    void MeshBuffer::EncodeRenderObject
+    (
+        const Models::ModelManager& modelManager,
+        const Renderer::RenderObject& renderObject,
+        usize firstMesh
+    )
+    {
+        for (usize i = firstMesh; const auto& mesh : modelManager.GetModel(renderObject.modelID).meshes)
         {
-            Vk::CheckResult(vmaFlushAllocation(
-                allocator,
-                buffer.allocation,
-                0,
-                meshCopySize),
-                "Failed to flush allocation!"
-            );
+            m_meshes[i] = GPU::Mesh
+            {
+                .surfaceInfo   = mesh.surfaceInfo,
+                .materialIndex = GetMaterialIndex(mesh.material.Convert(modelManager.textureManager))
+            };
+
+            m_bounds[i]             = mesh.aabb;
+            m_meshNormalMatrices[i] = Maths::NormalMatrix(mesh.transform);
+
+            ++i;
+        }
+    }
+
+    void MeshBuffer::EncodeTransforms
+    (
+        const Models::ModelManager& modelManager,
+        const std::span<const Renderer::RenderObject> renderObjects
+    )
+    {
+        const usize objectCount = m_updatedObjects.size();
+
+        m_objectBatch.Resize(objectCount);
+        m_objectTransforms.resize(objectCount);
+        m_objectNormalMatrices.resize(objectCount);
+
+        for (usize i = 0; i < objectCount; ++i)
+        {
+            const auto& renderObject = renderObjects[m_updatedObjects[i]];
+
+            m_objectBatch.Set(i, renderObject.position, renderObject.rotation, renderObject.scale);
+        }
+
+        Maths::TransformMatrices(m_objectBatch, m_objectTransforms.data(), m_objectNormalMatrices.data());
+
+        // Cofactor matrices compose like the transforms do, so no per-mesh inverse is needed
+        Util::ParallelFor(objectCount, TRANSFORM_BATCH_SIZE, [&] (usize begin, usize end)
+        {
+            for (usize i = begin; i < end; ++i)
+            {
+                const auto& range  = m_renderObjectRanges[m_updatedObjects[i]];
+                const auto& meshes = modelManager.GetModel(renderObjects[m_updatedObjects[i]].modelID).meshes;
+
+                for (usize j = 0; j < range.meshCount; ++j)
+                {
+                    const usize meshIndex = range.firstMesh + j;
+
+                    m_transforms[meshIndex] = GPU::Transform
+                    {
+                        .transform    = m_objectTransforms[i] * meshes[j].transform,
+                        .normalMatrix = m_objectNormalMatrices[i] * m_meshNormalMatrices[meshIndex]
+                    };
+                }
+            }
+        });
+    }
+
+    u32 MeshBuffer::GetMaterialIndex(const GPU::Material& material)
+    {
+        const auto [iter, inserted] = m_materialIndices.try_emplace(material, static_cast<u32>(m_materials.size()));
+
+        if (inserted)
+        {
+            m_materials.emplace_back(material);
         }
+
+        return iter->second;
+    }
+
+    usize MeshBuffer::MaterialHash::operator()(const GPU::Material& material) const noexcept
+    {
+        usize hash = 0;
+
+        hash = Util::HashCombine(hash, material.albedoID);
+        hash = Util::HashCombine(hash, material.normalID);
+        hash = Util::HashCombine(hash, material.aoRghMtlID);
+        hash = Util::HashCombine(hash, material.emmisiveID);
+
+        hash = Util::HashCombine(hash, material.albedoUVMapID);
+        hash = Util::HashCombine(hash, material.normalUVMapID);
+        hash = Util::HashCombine(hash, material.aoRghMtlUVMapID);
+        hash = Util::HashCombine(hash, material.emmisiveUVMapID);
+
+        for (glm::length_t i = 0; i < glm::vec4::length(); ++i)
+        {
+            hash = Util::HashCombine(hash, material.albedoFactor[i]);
+        }
+
+        hash = Util::HashCombine(hash, material.roughnessFactor);
+        hash = Util::HashCombine(hash, material.metallicFactor);
+
+        for (glm::length_t i = 0; i < glm::vec3::length(); ++i)
+        {
+            hash = Util::HashCombine(hash, material.emmisiveFactor[i]);
+        }
+
+        hash = Util::HashCombine(hash, material.emmisiveStrength);
+        hash = Util::HashCombine(hash, material.alphaCutOff);
+        hash = Util::HashCombine(hash, material.ior);
+        hash = Util::HashCombine(hash, static_cast<u32>(material.flags));
+
+        return hash;
+    }
+
+    bool MeshBuffer::MaterialEqual::operator()(const GPU::Material& lhs, const GPU::Material& rhs) const noexcept
+    {
+        return lhs.albedoID         == rhs.albedoID         &&
+               lhs.normalID         == rhs.normalID         &&
+               lhs.aoRghMtlID       == rhs.aoRghMtlID       &&
+               lhs.emmisiveID       == rhs.emmisiveID       &&
+               lhs.albedoUVMapID    == rhs.albedoUVMapID    &&
+               lhs.normalUVMapID    == rhs.normalUVMapID    &&
+               lhs.aoRghMtlUVMapID  == rhs.aoRghMtlUVMapID  &&
+               lhs.emmisiveUVMapID  == rhs.emmisiveUVMapID  &&
+               lhs.albedoFactor     == rhs.albedoFactor     &&
+               lhs.roughnessFactor  == rhs.roughnessFactor  &&
+               lhs.metallicFactor   == rhs.metallicFactor   &&
+               lhs.emmisiveFactor   == rhs.emmisiveFactor   &&
+               lhs.emmisiveStrength == rhs.emmisiveStrength &&
+               lhs.alphaCutOff      == rhs.alphaCutOff      &&
+               lhs.ior              == rhs.ior              &&
+               lhs.flags            == rhs.flags;
+    }
+
+    const MeshBuffer::Streams& MeshBuffer::GetCurrentStreams(usize frameIndex) const
+    {
+        return m_streams[frameIndex % m_streams.size()];
+    }
+
+    const MeshBuffer::Streams& MeshBuffer::GetPreviousStreams(usize frameIndex) const
+    {
+        return m_streams[(frameIndex + m_streams.size() - 1) % m_streams.size()];
+    }
+
+    std::span<const GPU::Mesh> MeshBuffer::GetMeshes() const
+    {
+        return m_meshes;
+    }
+
+    std::span<const GPU::Transform> MeshBuffer::GetTransforms() const
+    {
+        return m_transforms;
     }
 
-    const Vk::Buffer& MeshBuffer::GetCurrentBuffer(usize frameIndex) const
+    std::span<const GPU::AABB> MeshBuffer::GetBounds() const
     {
-        return m_buffers[frameIndex % m_buffers.size()];
+        return m_bounds;
     }
 
-    const Vk::Buffer& MeshBuffer::GetPreviousBuffer(usize frameIndex) const
+    std::span<const GPU::Material> MeshBuffer::GetMaterials() const
     {
-        return m_buffers[(frameIndex + m_buffers.size() - 1) % m_buffers.size()];
+        return m_materials;
     }
 
     void MeshBuffer::Destroy(VmaAllocator allocator)
     {
-        for (auto& buffer : m_buffers)
+        for (auto& [meshes, transforms, bounds, materials] : m_streams)
         {
-            buffer.Destroy(allocator);
+            meshes.Destroy(allocator);
+            transforms.Destroy(allocator);
+            bounds.Destroy(allocator);
+            materials.Destroy(allocator);
         }
     }
 }
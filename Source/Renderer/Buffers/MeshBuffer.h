@@ -18,13 +18,17 @@
 #define FORWARD_MESH_BUFFER_H
 
 #include <array>
+#include <span>
 #include <vulkan/vulkan.h>
 
 #include "Renderer/RenderObject.h"
 #include "Util/Types.h"
+#include "Util/Maths.h"
 #include "Vulkan/Buffer.h"
 #include "Vulkan/Constants.h"
 #include "Models/ModelManager.h"
+#include "GPU/Mesh.h"
+#include "Externals/UnorderedDense.h"
 
 namespace Renderer::Buffers
 {
@@ -40,15 +44,85 @@ namespace Renderer::Buffers
             usize frameIndex,
             VmaAllocator allocator,
             const Models::ModelManager& modelManager,
-            const std::vector<Renderer::RenderObject>& renderObjects
+            const std::span<const Renderer::RenderObject> renderObjects,
+            const std::span<const usize> dirtyRenderObjects,
+            bool haveRenderObjectsChanged
         );
 
-        const Vk::Buffer& GetCurrentBuffer(usize frameIndex)  const;
-        const Vk::Buffer& GetPreviousBuffer(usize frameIndex) const;
+        // Per-mesh data is split by access pattern, so vertex and culling shaders only fetch what they use
+        struct Streams
+        {
+            Vk::Buffer meshes;
+            Vk::Buffer transforms;
+            Vk::Buffer bounds;
+            Vk::Buffer materials;
+        };
+
+        const Streams& GetCurrentStreams(usize frameIndex)  const;
+        const Streams& GetPreviousStreams(usize frameIndex) const;
+
+        // Host side copies of the current streams
+        [[nodiscard]] std::span<const GPU::Mesh>      GetMeshes()     const;
+        [[nodiscard]] std::span<const GPU::Transform> GetTransforms() const;
+        [[nodiscard]] std::span<const GPU::AABB>      GetBounds()     const;
+        [[nodiscard]] std::span<const GPU::Material>  GetMaterials()  const;
 
         void Destroy(VmaAllocator allocator);
     private:
-        std::array<Vk::Buffer, Vk::FRAMES_IN_FLIGHT + 1> m_buffers;
+        struct MaterialHash
+        {
+            usize operator()(const GPU::Material& material) const noexcept;
+        };
+
+        struct MaterialEqual
+        {
+            bool operator()(const GPU::Material& lhs, const GPU::Material& rhs) const noexcept;
+        };
+
+        struct RenderObjectRange
+        {
+            usize firstMesh     = 0;
+            usize meshCount     = 0;
+            usize pendingWrites = 0;
+        };
+
+        void EncodeRenderObject
+        (
+            const Models::ModelManager& modelManager,
+            const Renderer::RenderObject& renderObject,
+            usize firstMesh
+        );
+
+        // Rebuilds the transforms of every render object in m_updatedObjects
+        void EncodeTransforms
+        (
+            const Models::ModelManager& modelManager,
+            const std::span<const Renderer::RenderObject> renderObjects
+        );
+
+        [[nodiscard]] u32 GetMaterialIndex(const GPU::Material& material);
+
+        std::array<Streams, Vk::FRAMES_IN_FLIGHT + 1> m_streams;
+
+        // CPU mirror of the GPU scene, only dirty ranges are re-encoded and copied
+        std::vector<GPU::Mesh>         m_meshes             = {};
+        std::vector<GPU::Transform>    m_transforms         = {};
+        std::vector<GPU::AABB>         m_bounds             = {};
+        std::vector<GPU::Material>     m_materials          = {};
+        std::vector<RenderObjectRange> m_renderObjectRanges = {};
+
+        ankerl::unordered_dense::map<GPU::Material, u32, MaterialHash, MaterialEqual> m_materialIndices = {};
+
+        // Model space cofactors, combined with the per object ones from the batch
+        std::vector<glm::mat3> m_meshNormalMatrices = {};
+
+        // Scratch for the batched per object transforms
+        std::vector<usize>     m_updatedObjects       = {};
+        Maths::TransformBatch  m_objectBatch          = {};
+        std::vector<glm::mat4> m_objectTransforms     = {};
+        std::vector<glm::mat3> m_objectNormalMatrices = {};
+
+        usize m_pendingFullWrites = 0;
     };
 }
 
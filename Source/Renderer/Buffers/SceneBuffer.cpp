@@ -48,20 +48,15 @@ namespace Renderer::Buffers
     (
         usize FIF,
         usize frameIndex,
+        VkDevice device,
         VmaAllocator allocator,
         VkExtent2D extent,
+        VkExtent2D renderExtent,
         const Engine::Scene& scene
     )
     {
-        lightsBuffer.WriteLights
-        (
-            FIF,
-            allocator,
-            scene.sun,
-            scene.pointLights,
-            scene.spotLights
-        );
-        
+        this->renderExtent = renderExtent;
+
         gpuScene.previousMatrices = gpuScene.currentMatrices;
 
         const auto projection = Maths::InfiniteProjectionReverseZ
@@ -74,7 +69,7 @@ namespace Renderer::Buffers
 
         auto jitter = Renderer::JITTER_SAMPLES[frameIndex % JITTER_SAMPLE_COUNT];
         jitter     -= glm::vec2(0.5f);
-        jitter     /= glm::vec2(extent.width, extent.height);
+        jitter     /= glm::vec2(renderExtent.width, renderExtent.height);
 
         auto jitteredProjection = projection;
 
@@ -95,13 +90,31 @@ namespace Renderer::Buffers
         gpuScene.cameraPosition = scene.camera.position;
         gpuScene.nearPlane      = Renderer::NEAR_PLANE;
         gpuScene.farPlane       = Renderer::FAR_PLANE; // There isn't actually a far plane right now lol
+        gpuScene.renderSize     = {renderExtent.width, renderExtent.height};
+        gpuScene.renderScale    = glm::vec2(renderExtent.width, renderExtent.height) / glm::vec2(extent.width, extent.height);
+
+        lightsBuffer.WriteLights
+        (
+            FIF,
+            device,
+            allocator,
+            LightsBuffer::CameraInfo{
+                .position        = scene.camera.position,
+                .frustum         = GPU::FrustumBuffer(projection * view),
+                .projectionScale = 0.5f * static_cast<f32>(extent.height) * std::abs(projection[1][1])
+            },
+            scene.sun,
+            scene.pointLights,
+            scene.spotLights
+        );
 
         const auto lightsBufferAddress = lightsBuffer.buffers[FIF].deviceAddress;
 
-        gpuScene.Sun                 = lightsBufferAddress + lightsBuffer.GetSunOffset();
-        gpuScene.PointLights         = lightsBufferAddress + lightsBuffer.GetPointLightOffset();
-        gpuScene.ShadowedPointLights = lightsBufferAddress + lightsBuffer.GetShadowedPointLightOffset();
-        gpuScene.SpotLights          = lightsBufferAddress + lightsBuffer.GetSpotLightOffset();
+        gpuScene.Sun                 = lightsBufferAddress + lightsBuffer.GetSunOffset(FIF);
+        gpuScene.PointLights         = lightsBufferAddress + lightsBuffer.GetPointLightOffset(FIF);
+        gpuScene.ShadowedPointLights = lightsBufferAddress + lightsBuffer.GetShadowedPointLightOffset(FIF);
+        gpuScene.SpotLights          = lightsBufferAddress + lightsBuffer.GetSpotLightOffset(FIF);
+        gpuScene.ShadowedSpotLights  = lightsBufferAddress + lightsBuffer.GetShadowedSpotLightOffset(FIF);
         
         std::memcpy
         (
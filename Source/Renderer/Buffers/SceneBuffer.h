@@ -34,8 +34,10 @@ namespace Renderer::Buffers
         (
             usize FIF,
             usize frameIndex,
+            VkDevice device,
             VmaAllocator allocator,
             VkExtent2D extent,
+            VkExtent2D renderExtent,
             const Engine::Scene& scene
         );
 
@@ -43,6 +45,9 @@ namespace Renderer::Buffers
 
         GPU::SceneBuffer gpuScene = {};
 
+        // Sub-rectangle of the full size framebuffers that internal resolution passes draw into
+        VkExtent2D renderExtent = {};
+
         Buffers::LightsBuffer lightsBuffer;
 
         std::array<Vk::Buffer, Vk::FRAMES_IN_FLIGHT> buffers;
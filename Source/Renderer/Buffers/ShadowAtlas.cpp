@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShadowAtlas.h"
+
+namespace Renderer::Buffers
+{
+    // Every tile is a multiple of the smallest one, which is the unit the atlas is packed in
+    constexpr u64 ATLAS_CAPACITY = (GPU::SHADOW_ATLAS_SIZE / GPU::SHADOW_ATLAS_MIN_TILE_SIZE) *
+                                   (GPU::SHADOW_ATLAS_SIZE / GPU::SHADOW_ATLAS_MIN_TILE_SIZE);
+
+    static_assert
+    (
+        6 * GPU::MAX_SHADOWED_POINT_LIGHT_COUNT + GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT <= ATLAS_CAPACITY,
+        "Shadow atlas can't hold every shadowed light at the minimum tile size!"
+    );
+
+    std::span<const ShadowAtlas::Tile> ShadowAtlas::Allocate(const std::span<const u32> tileSizes)
+    {
+        if (std::ranges::equal(tileSizes, m_tileSizes))
+        {
+            return m_tiles;
+        }
+
+        if (!Update(tileSizes))
+        {
+            Repack(tileSizes);
+        }
+
+        m_tileSizes.assign(tileSizes.begin(), tileSizes.end());
+
+        return m_tiles;
+    }
+
+    bool ShadowAtlas::Update(const std::span<const u32> tileSizes)
+    {
+        // One entry per smallest tile, in Morton order so every aligned tile is a contiguous run
+        std::vector<bool> isUsed(ATLAS_CAPACITY, false);
+
+        std::vector<Tile>  tiles   = m_tiles;
+        std::vector<usize> changed = {};
+
+        tiles.resize(tileSizes.size());
+
+        for (usize i = 0; i < tileSizes.size(); ++i)
+        {
+            if (i >= m_tileSizes.size() || tileSizes[i] != m_tileSizes[i])
+            {
+                changed.emplace_back(i);
+
+                continue;
+            }
+
+            const u64 first = EncodeMorton(tiles[i].offset / GPU::SHADOW_ATLAS_MIN_TILE_SIZE);
+
+            std::fill_n(isUsed.begin() + static_cast<std::ptrdiff_t>(first), GetArea(tiles[i].size), true);
+        }
+
+        std::ranges::stable_sort(changed, [&tileSizes] (usize lhs, usize rhs)
+        {
+            return tileSizes[lhs] > tileSizes[rhs];
+        });
+
+        for (const usize index : changed)
+        {
+            const u64 area = GetArea(tileSizes[index]);
+
+            std::optional<u64> cursor = std::nullopt;
+
+            for (u64 candidate = 0; candidate < ATLAS_CAPACITY; candidate += area)
+            {
+                const auto first = isUsed.begin() + static_cast<std::ptrdiff_t>(candidate);
+
+                if (std::none_of(first, first + static_cast<std::ptrdiff_t>(area), std::identity{}))
+                {
+                    cursor = candidate;
+
+                    break;
+                }
+            }
+
+            if (!cursor.has_value())
+            {
+                return false;
+            }
+
+            std::fill_n(isUsed.begin() + static_cast<std::ptrdiff_t>(*cursor), area, true);
+
+            tiles[index] = Tile{
+                .offset = DecodeMorton(*cursor) * GPU::SHADOW_ATLAS_MIN_TILE_SIZE,
+                .size   = tileSizes[index]
+            };
+        }
+
+        m_tiles = std::move(tiles);
+
+        return true;
+    }
+
+    void ShadowAtlas::Repack(const std::span<const u32> tileSizes)
+    {
+        ++m_generation;
+
+        std::vector<u32> sizes(tileSizes.begin(), tileSizes.end());
+
+        u64 area = 0;
+
+        for (const u32 size : sizes)
+        {
+            area += GetArea(size);
+        }
+
+        while (area > ATLAS_CAPACITY)
+        {
+            const auto largest = std::ranges::max_element(sizes);
+
+            area     -= GetArea(*largest) - GetArea(*largest / 2);
+            *largest /= 2;
+        }
+
+        // Largest first, so every tile starts on a multiple of its own area along the Morton curve and nothing overlaps
+        std::vector<usize> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        std::ranges::stable_sort(order, [&sizes] (usize lhs, usize rhs)
+        {
+            return sizes[lhs] > sizes[rhs];
+        });
+
+        m_tiles.assign(sizes.size(), Tile{});
+
+        u64 cursor = 0;
+
+        for (const usize index : order)
+        {
+            m_tiles[index] = Tile{
+                .offset = DecodeMorton(cursor) * GPU::SHADOW_ATLAS_MIN_TILE_SIZE,
+                .size   = sizes[index]
+            };
+
+            cursor += GetArea(sizes[index]);
+        }
+    }
+
+    u64 ShadowAtlas::GetGeneration() const
+    {
+        return m_generation;
+    }
+
+    glm::vec4 ShadowAtlas::GetRect(const Tile& tile)
+    {
+        return glm::vec4(glm::vec2(tile.offset), glm::vec2(static_cast<f32>(tile.size))) / static_cast<f32>(GPU::SHADOW_ATLAS_SIZE);
+    }
+
+    u64 ShadowAtlas::GetArea(u32 tileSize)
+    {
+        const u64 units = std::max(tileSize / GPU::SHADOW_ATLAS_MIN_TILE_SIZE, 1u);
+
+        return units * units;
+    }
+
+    u64 ShadowAtlas::EncodeMorton(const glm::uvec2& position)
+    {
+        u64 code = 0;
+
+        for (u32 bit = 0; bit < 32; ++bit)
+        {
+            code |= static_cast<u64>((position.x >> bit) & 1) << (2 * bit);
+            code |= static_cast<u64>((position.y >> bit) & 1) << (2 * bit + 1);
+        }
+
+        return code;
+    }
+
+    glm::uvec2 ShadowAtlas::DecodeMorton(u64 code)
+    {
+        glm::uvec2 position = {0, 0};
+
+        for (u32 bit = 0; bit < 32; ++bit)
+        {
+            position.x |= static_cast<u32>((code >> (2 * bit))     & 1) << bit;
+            position.y |= static_cast<u32>((code >> (2 * bit + 1)) & 1) << bit;
+        }
+
+        return position;
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHADOW_ATLAS_H
+#define SHADOW_ATLAS_H
+
+#include "Util/Types.h"
+#include "GPU/Lights.h"
+
+namespace Renderer::Buffers
+{
+    class ShadowAtlas
+    {
+    public:
+        struct Tile
+        {
+            glm::uvec2 offset = {0, 0};
+            u32        size   = 0;
+        };
+
+        // Tiles whose size is unchanged stay in place and the rest go into the free space around them.
+        // Only when that fails is everything repacked, the largest tiles are shrunk first if they don't all fit
+        [[nodiscard]] std::span<const Tile> Allocate(const std::span<const u32> tileSizes);
+
+        // Bumped on every full repack, tiles cached against an older generation may have been drawn over
+        [[nodiscard]] u64 GetGeneration() const;
+
+        // Offset and extent of the tile in atlas UV space
+        [[nodiscard]] static glm::vec4 GetRect(const Tile& tile);
+    private:
+        [[nodiscard]] bool Update(const std::span<const u32> tileSizes);
+        void Repack(const std::span<const u32> tileSizes);
+
+        [[nodiscard]] static u64 GetArea(u32 tileSize);
+        [[nodiscard]] static u64 EncodeMorton(const glm::uvec2& position);
+        [[nodiscard]] static glm::uvec2 DecodeMorton(u64 code);
+
+        // Requested sizes of the current tiles, which may have been shrunk to fit
+        std::vector<u32>  m_tileSizes  = {};
+        std::vector<Tile> m_tiles      = {};
+        u64               m_generation = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BVH.h"
+
+#include <algorithm>
+#include <bit>
+#include <queue>
+
+#include "Util/Maths.h"
+
+namespace Renderer::Culling
+{
+    namespace
+    {
+        GPU::AABB Union(const GPU::AABB& lhs, const GPU::AABB& rhs)
+        {
+            return GPU::AABB
+            {
+                .min = glm::min(lhs.min, rhs.min),
+                .max = glm::max(lhs.max, rhs.max)
+            };
+        }
+
+        GPU::AABB TransformAABB(const GPU::AABB& aabb, const glm::mat4& transform)
+        {
+            const glm::vec3 center = (aabb.max + aabb.min) * 0.5f;
+            const glm::vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+            const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+            const glm::vec3 worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x +
+                                          glm::abs(glm::vec3(transform[1])) * extent.y +
+                                          glm::abs(glm::vec3(transform[2])) * extent.z;
+
+            return GPU::AABB
+            {
+                .min = worldCenter - worldExtent,
+                .max = worldCenter + worldExtent
+            };
+        }
+
+        bool IsOutside(const GPU::Plane& plane, const GPU::AABB& aabb)
+        {
+            const glm::vec3 center = (aabb.max + aabb.min) * 0.5f;
+            const glm::vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+            const f32 signedDistance = glm::dot(plane.normal, center) + plane.distance;
+            const f32 radius         = glm::dot(glm::abs(plane.normal), extent);
+
+            return signedDistance + radius < 0.0f;
+        }
+
+        bool IsOutside(const GPU::FrustumBuffer& frustum, const GPU::AABB& aabb)
+        {
+            return std::ranges::any_of(frustum.planes, [&aabb] (const GPU::Plane& plane)
+            {
+                return IsOutside(plane, aabb);
+            });
+        }
+
+        bool Intersects(const GPU::AABB& aabb, const glm::vec3& center, f32 radius)
+        {
+            const glm::vec3 closest = glm::clamp(center, aabb.min, aabb.max);
+            const glm::vec3 delta   = closest - center;
+
+            return glm::dot(delta, delta) <= radius * radius;
+        }
+
+        // Returns the entry distance, or a negative value on a miss
+        f32 Intersects(const GPU::AABB& aabb, const glm::vec3& origin, const glm::vec3& inverseDirection, f32 maxDistance)
+        {
+            const glm::vec3 t0 = (aabb.min - origin) * inverseDirection;
+            const glm::vec3 t1 = (aabb.max - origin) * inverseDirection;
+
+            const glm::vec3 tMin = glm::min(t0, t1);
+            const glm::vec3 tMax = glm::max(t0, t1);
+
+            const f32 entry = std::max({tMin.x, tMin.y, tMin.z, 0.0f});
+            const f32 exit  = std::min({tMax.x, tMax.y, tMax.z, maxDistance});
+
+            return entry <= exit ? entry : -1.0f;
+        }
+    }
+
+    void BVH::Build
+    (
+        const Models::ModelManager& modelManager,
+        const std::span<const Renderer::RenderObject> renderObjects
+    )
+    {
+        m_nodes.clear();
+        m_objects.resize(renderObjects.size());
+        m_objectBounds.resize(renderObjects.size());
+        m_centroids.resize(renderObjects.size());
+        m_objectLeaves.assign(renderObjects.size(), INVALID_NODE);
+
+        for (usize i = 0; i < renderObjects.size(); ++i)
+        {
+            m_objects[i]      = static_cast<u32>(i);
+            m_objectBounds[i] = ComputeObjectBounds(modelManager, renderObjects[i]);
+            m_centroids[i]    = (m_objectBounds[i].min + m_objectBounds[i].max) * 0.5f;
+        }
+
+        if (renderObjects.empty())
+        {
+            return;
+        }
+
+        // A binary tree with at least one object per leaf never needs more than this
+        m_nodes.reserve(2 * renderObjects.size());
+
+        BuildRecursive(0, static_cast<u32>(renderObjects.size()), INVALID_NODE);
+    }
+
+    u32 BVH::BuildRecursive(u32 first, u32 count, u32 parent)
+    {
+        const u32 nodeIndex = static_cast<u32>(m_nodes.size());
+
+        auto& node  = m_nodes.emplace_back();
+        node.parent = parent;
+
+        GPU::AABB bounds         = m_objectBounds[m_objects[first]];
+        GPU::AABB centroidBounds = {.min = m_centroids[m_objects[first]], .max = m_centroids[m_objects[first]]};
+
+        for (u32 i = first + 1; i < first + count; ++i)
+        {
+            bounds         = Union(bounds, m_objectBounds[m_objects[i]]);
+            centroidBounds = Union(centroidBounds, GPU::AABB{.min = m_centroids[m_objects[i]], .max = m_centroids[m_objects[i]]});
+        }
+
+        node.bounds = bounds;
+
+        if (count <= MAX_LEAF_SIZE)
+        {
+            node.offset = first;
+            node.count  = count;
+
+            for (u32 i = first; i < first + count; ++i)
+            {
+                m_objectLeaves[m_objects[i]] = nodeIndex;
+            }
+
+            return nodeIndex;
+        }
+
+        // Median split along the axis with the widest centroid spread
+        const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+        const usize     axis   = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+        const u32 leftCount = count / 2;
+
+        std::nth_element
+        (
+            m_objects.begin() + first,
+            m_objects.begin() + first + leftCount,
+            m_objects.begin() + first + count,
+            [this, axis] (u32 lhs, u32 rhs)
+            {
+                return m_centroids[lhs][axis] < m_centroids[rhs][axis];
+            }
+        );
+
+        BuildRecursive(first, leftCount, nodeIndex);
+
+        const u32 rightChild = BuildRecursive(first + leftCount, count - leftCount, nodeIndex);
+
+        // Emplacing children may have reallocated the node array
+        m_nodes[nodeIndex].offset = rightChild;
+        m_nodes[nodeIndex].count  = 0;
+
+        return nodeIndex;
+    }
+
+    void BVH::Refit
+    (
+        const Models::ModelManager& modelManager,
+        const std::span<const Renderer::RenderObject> renderObjects,
+        const std::span<const usize> dirtyObjects
+    )
+    {
+        if (dirtyObjects.empty())
+        {
+            return;
+        }
+
+        // Children always have larger indices than their parents, so popping the largest index first
+        // refits every ancestor exactly once and only after all of its dirty descendants
+        std::priority_queue<u32> dirtyNodes = {};
+
+        for (const usize objectIndex : dirtyObjects)
+        {
+            if (objectIndex >= m_objectBounds.size())
+            {
+                continue;
+            }
+
+            m_objectBounds[objectIndex] = ComputeObjectBounds(modelManager, renderObjects[objectIndex]);
+            m_centroids[objectIndex]    = (m_objectBounds[objectIndex].min + m_objectBounds[objectIndex].max) * 0.5f;
+
+            dirtyNodes.push(m_objectLeaves[objectIndex]);
+        }
+
+        u32 lastNode = INVALID_NODE;
+
+        while (!dirtyNodes.empty())
+        {
+            const u32 nodeIndex = dirtyNodes.top();
+            dirtyNodes.pop();
+
+            if (nodeIndex == lastNode)
+            {
+                continue;
+            }
+
+            lastNode = nodeIndex;
+
+            RefitNode(nodeIndex);
+
+            if (m_nodes[nodeIndex].parent != INVALID_NODE)
+            {
+                dirtyNodes.push(m_nodes[nodeIndex].parent);
+            }
+        }
+    }
+
+    void BVH::RefitNode(u32 nodeIndex)
+    {
+        auto& node = m_nodes[nodeIndex];
+
+        if (node.count > 0)
+        {
+            GPU::AABB bounds = m_objectBounds[m_objects[node.offset]];
+
+            for (u32 i = node.offset + 1; i < node.offset + node.count; ++i)
+            {
+                bounds = Union(bounds, m_objectBounds[m_objects[i]]);
+            }
+
+            node.bounds = bounds;
+        }
+        else
+        {
+            node.bounds = Union(m_nodes[nodeIndex + 1].bounds, m_nodes[node.offset].bounds);
+        }
+    }
+
+    void BVH::QueryFrustum(const GPU::FrustumBuffer& frustum, std::vector<u32>& objects) const
+    {
+        QueryFrustums(std::span(&frustum, 1), std::span(&objects, 1));
+    }
+
+    void BVH::QueryFrustums
+    (
+        const std::span<const GPU::FrustumBuffer> frustums,
+        const std::span<std::vector<u32>> objects
+    ) const
+    {
+        for (auto& list : objects)
+        {
+            list.clear();
+        }
+
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        for (usize batch = 0; batch < frustums.size(); batch += MAX_BATCHED_FRUSTUMS)
+        {
+            const usize batchSize = std::min(frustums.size() - batch, MAX_BATCHED_FRUSTUMS);
+
+            // Each node carries the set of frustums that may still overlap it
+            std::vector<std::pair<u32, u32>> stack = {};
+            stack.emplace_back(0, batchSize == 32 ? ~0u : (1u << batchSize) - 1);
+
+            while (!stack.empty())
+            {
+                const auto [nodeIndex, parentMask] = stack.back();
+                stack.pop_back();
+
+                const auto& node = m_nodes[nodeIndex];
+
+                u32 mask = 0;
+
+                for (u32 bits = parentMask; bits != 0; bits &= bits - 1)
+                {
+                    const u32 frustumIndex = std::countr_zero(bits);
+
+                    if (!IsOutside(frustums[batch + frustumIndex], node.bounds))
+                    {
+                        mask |= 1u << frustumIndex;
+                    }
+                }
+
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                if (node.count == 0)
+                {
+                    stack.emplace_back(node.offset,   mask);
+                    stack.emplace_back(nodeIndex + 1, mask);
+
+                    continue;
+                }
+
+                for (u32 i = node.offset; i < node.offset + node.count; ++i)
+                {
+                    const u32 objectIndex = m_objects[i];
+
+                    for (u32 bits = mask; bits != 0; bits &= bits - 1)
+                    {
+                        const u32 frustumIndex = std::countr_zero(bits);
+
+                        if (!IsOutside(frustums[batch + frustumIndex], m_objectBounds[objectIndex]))
+                        {
+                            objects[batch + frustumIndex].emplace_back(objectIndex);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void BVH::QuerySphere(const glm::vec3& center, f32 radius, std::vector<u32>& objects) const
+    {
+        objects.clear();
+
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        std::vector<u32> stack = {0};
+
+        while (!stack.empty())
+        {
+            const u32 nodeIndex = stack.back();
+            stack.pop_back();
+
+            const auto& node = m_nodes[nodeIndex];
+
+            if (!Intersects(node.bounds, center, radius))
+            {
+                continue;
+            }
+
+            if (node.count == 0)
+            {
+                stack.emplace_back(node.offset);
+                stack.emplace_back(nodeIndex + 1);
+
+                continue;
+            }
+
+            for (u32 i = node.offset; i < node.offset + node.count; ++i)
+            {
+                if (Intersects(m_objectBounds[m_objects[i]], center, radius))
+                {
+                    objects.emplace_back(m_objects[i]);
+                }
+            }
+        }
+    }
+
+    std::optional<BVH::RayHit> BVH::QueryRay(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance) const
+    {
+        if (m_nodes.empty())
+        {
+            return std::nullopt;
+        }
+
+        const glm::vec3 inverseDirection = 1.0f / direction;
+
+        std::optional<RayHit> closestHit = std::nullopt;
+
+        std::vector<u32> stack = {0};
+
+        while (!stack.empty())
+        {
+            const u32 nodeIndex = stack.back();
+            stack.pop_back();
+
+            const auto& node = m_nodes[nodeIndex];
+
+            const f32 closestDistance = closestHit.has_value() ? closestHit->distance : maxDistance;
+
+            if (Intersects(node.bounds, origin, inverseDirection, closestDistance) < 0.0f)
+            {
+                continue;
+            }
+
+            if (node.count == 0)
+            {
+                stack.emplace_back(node.offset);
+                stack.emplace_back(nodeIndex + 1);
+
+                continue;
+            }
+
+            for (u32 i = node.offset; i < node.offset + node.count; ++i)
+            {
+                const f32 currentClosest = closestHit.has_value() ? closestHit->distance : maxDistance;
+                const f32 distance       = Intersects(m_objectBounds[m_objects[i]], origin, inverseDirection, currentClosest);
+
+                if (distance >= 0.0f)
+                {
+                    closestHit = RayHit{.objectIndex = m_objects[i], .distance = distance};
+                }
+            }
+        }
+
+        return closestHit;
+    }
+
+    GPU::AABB BVH::ComputeObjectBounds
+    (
+        const Models::ModelManager& modelManager,
+        const Renderer::RenderObject& renderObject
+    )
+    {
+        const auto globalTransform = Maths::TransformMatrix
+        (
+            renderObject.position,
+            renderObject.rotation,
+            renderObject.scale
+        );
+
+        const auto& meshes = modelManager.GetModel(renderObject.modelID).meshes;
+
+        if (meshes.empty())
+        {
+            const glm::vec3 position = glm::vec3(globalTransform[3]);
+
+            return GPU::AABB{.min = position, .max = position};
+        }
+
+        GPU::AABB bounds = TransformAABB(meshes.front().aabb, globalTransform * meshes.front().transform);
+
+        for (usize i = 1; i < meshes.size(); ++i)
+        {
+            bounds = Union(bounds, TransformAABB(meshes[i].aabb, globalTransform * meshes[i].transform));
+        }
+
+        return bounds;
+    }
+
+    const GPU::AABB& BVH::GetObjectBounds(usize objectIndex) const
+    {
+        return m_objectBounds[objectIndex];
+    }
+
+    usize BVH::GetObjectCount() const
+    {
+        return m_objectBounds.size();
+    }
+
+    usize BVH::GetNodeCount() const
+    {
+        return m_nodes.size();
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENE_BVH_H
+#define SCENE_BVH_H
+
+#include <vector>
+#include <span>
+#include <optional>
+#include <limits>
+
+#include "Util/Types.h"
+#include "Renderer/RenderObject.h"
+#include "Models/ModelManager.h"
+#include "Externals/GLM.h"
+#include "GPU/AABB.h"
+#include "GPU/Plane.h"
+
+namespace Renderer::Culling
+{
+    // Bounding volume hierarchy over the world space bounds of render objects
+    class BVH
+    {
+    public:
+        struct RayHit
+        {
+            u32 objectIndex = 0;
+            f32 distance    = 0.0f;
+        };
+
+        // Frustums handled by a single batched traversal
+        static constexpr usize MAX_BATCHED_FRUSTUMS = 32;
+
+        void Build
+        (
+            const Models::ModelManager& modelManager,
+            const std::span<const Renderer::RenderObject> renderObjects
+        );
+
+        // Only updates the bounds of dirty objects and their ancestors, the topology is left untouched
+        void Refit
+        (
+            const Models::ModelManager& modelManager,
+            const std::span<const Renderer::RenderObject> renderObjects,
+            const std::span<const usize> dirtyObjects
+        );
+
+        void QueryFrustum(const GPU::FrustumBuffer& frustum, std::vector<u32>& objects) const;
+
+        void QueryFrustums
+        (
+            const std::span<const GPU::FrustumBuffer> frustums,
+            const std::span<std::vector<u32>> objects
+        ) const;
+
+        void QuerySphere(const glm::vec3& center, f32 radius, std::vector<u32>& objects) const;
+
+        // Returns the closest object whose bounds are hit by the ray
+        [[nodiscard]] std::optional<RayHit> QueryRay(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance) const;
+
+        [[nodiscard]] const GPU::AABB& GetObjectBounds(usize objectIndex) const;
+        [[nodiscard]] usize GetObjectCount() const;
+        [[nodiscard]] usize GetNodeCount() const;
+    private:
+        static constexpr u32 INVALID_NODE  = std::numeric_limits<u32>::max();
+        static constexpr u32 MAX_LEAF_SIZE = 4;
+
+        struct Node
+        {
+            GPU::AABB bounds = {};
+            // Right child for interior nodes, first object for leaves, the left child always follows its parent
+            u32       offset = 0;
+            // Zero for interior nodes
+            u32       count  = 0;
+            u32       parent = INVALID_NODE;
+        };
+
+        u32 BuildRecursive(u32 first, u32 count, u32 parent);
+
+        void RefitNode(u32 nodeIndex);
+
+        [[nodiscard]] static GPU::AABB ComputeObjectBounds
+        (
+            const Models::ModelManager& modelManager,
+            const Renderer::RenderObject& renderObject
+        );
+
+        std::vector<Node>      m_nodes        = {};
+        std::vector<u32>       m_objects      = {};
+        std::vector<GPU::AABB> m_objectBounds = {};
+        std::vector<glm::vec3> m_centroids    = {};
+        std::vector<u32>       m_objectLeaves = {};
+    };
+}
+
+#endif
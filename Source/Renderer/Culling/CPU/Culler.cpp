@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Culler.h"
+
+#include <immintrin.h>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <algorithm>
+#include <span>
+
+#include "Util/Log.h"
+#include "Util/Parallel.h"
+#include "Vulkan/DebugUtils.h"
+
+namespace Renderer::Culling::CPU
+{
+    constexpr usize SIMD_WIDTH            = 8;
+    constexpr usize BOUNDS_BATCH_SIZE     = 512;
+    constexpr usize VISIBILITY_BATCH_SIZE = 64;
+    constexpr usize DRAW_CALL_BATCH_SIZE  = 128;
+    constexpr u32   MIN_VIEW_CAPACITY     = 256;
+
+    const Buffers::IndirectBuffer::CulledBuffers& Culler::Cull
+    (
+        usize FIF,
+        usize frameIndex,
+        VkDevice device,
+        VmaAllocator allocator,
+        const glm::mat4& projectionView,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::DrawCallBuffer& drawCallBuffer,
+        bool sortDraws
+    )
+    {
+        const auto& culledBuffers = AcquireView
+        (
+            FIF,
+            frameIndex,
+            device,
+            allocator,
+            std::max<u32>(drawCallBuffer.instances.size(), 1)
+        );
+
+        // Transforms only change once per frame, so every view shares the same world bounds
+        if (m_boundsFrameIndex != frameIndex)
+        {
+            ComputeWorldBounds(meshBuffer);
+
+            m_boundsFrameIndex = frameIndex;
+        }
+
+        const auto frustum = GPU::FrustumBuffer(projectionView);
+
+        TestVisibility(frustum);
+
+        WriteBuckets
+        (
+            allocator,
+            frustum.planes[4],
+            meshBuffer,
+            drawCallBuffer,
+            culledBuffers,
+            sortDraws
+        );
+
+        return culledBuffers;
+    }
+
+    void Culler::ComputeWorldBounds(const Buffers::MeshBuffer& meshBuffer)
+    {
+        const auto transforms = meshBuffer.GetTransforms();
+        const auto bounds     = meshBuffer.GetBounds();
+
+        m_meshCount = bounds.size();
+
+        const usize paddedCount = (m_meshCount + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+        // Padding is zero sized and sits at the origin, its visibility bits are never read
+        m_centerX.assign(paddedCount, 0.0f);
+        m_centerY.assign(paddedCount, 0.0f);
+        m_centerZ.assign(paddedCount, 0.0f);
+        m_extentX.assign(paddedCount, 0.0f);
+        m_extentY.assign(paddedCount, 0.0f);
+        m_extentZ.assign(paddedCount, 0.0f);
+
+        Util::ParallelFor(m_meshCount, BOUNDS_BATCH_SIZE, [&] (usize begin, usize end)
+        {
+            for (usize i = begin; i < end; ++i)
+            {
+                const glm::mat4& transform = transforms[i].transform;
+
+                const glm::vec3 center = (bounds[i].max + bounds[i].min) * 0.5f;
+                const glm::vec3 extent = (bounds[i].max - bounds[i].min) * 0.5f;
+
+                const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+                const glm::vec3 worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x +
+                                              glm::abs(glm::vec3(transform[1])) * extent.y +
+                                              glm::abs(glm::vec3(transform[2])) * extent.z;
+
+                m_centerX[i] = worldCenter.x;
+                m_centerY[i] = worldCenter.y;
+                m_centerZ[i] = worldCenter.z;
+                m_extentX[i] = worldExtent.x;
+                m_extentY[i] = worldExtent.y;
+                m_extentZ[i] = worldExtent.z;
+            }
+        });
+    }
+
+    void Culler::TestVisibility(const GPU::FrustumBuffer& frustum)
+    {
+        const usize groupCount = m_centerX.size() / SIMD_WIDTH;
+
+        m_visibility.resize(groupCount);
+
+        Util::ParallelFor(groupCount, VISIBILITY_BATCH_SIZE, [&] (usize begin, usize end)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+
+            for (usize group = begin; group < end; ++group)
+            {
+                const usize i = group * SIMD_WIDTH;
+
+                const __m256 centerX = _mm256_loadu_ps(m_centerX.data() + i);
+                const __m256 centerY = _mm256_loadu_ps(m_centerY.data() + i);
+                const __m256 centerZ = _mm256_loadu_ps(m_centerZ.data() + i);
+                const __m256 extentX = _mm256_loadu_ps(m_extentX.data() + i);
+                const __m256 extentY = _mm256_loadu_ps(m_extentY.data() + i);
+                const __m256 extentZ = _mm256_loadu_ps(m_extentZ.data() + i);
+
+                __m256 outside = zero;
+
+                for (const auto& plane : frustum.planes)
+                {
+                    const __m256 normalX  = _mm256_set1_ps(plane.normal.x);
+                    const __m256 normalY  = _mm256_set1_ps(plane.normal.y);
+                    const __m256 normalZ  = _mm256_set1_ps(plane.normal.z);
+                    const __m256 distance = _mm256_set1_ps(plane.distance);
+
+                    const __m256 absNormalX = _mm256_set1_ps(std::abs(plane.normal.x));
+                    const __m256 absNormalY = _mm256_set1_ps(std::abs(plane.normal.y));
+                    const __m256 absNormalZ = _mm256_set1_ps(std::abs(plane.normal.z));
+
+                    // Signed distance of the box center
+                    __m256 signedDistance = _mm256_mul_ps(normalX, centerX);
+                    signedDistance        = _mm256_add_ps(signedDistance, _mm256_mul_ps(normalY, centerY));
+                    signedDistance        = _mm256_add_ps(signedDistance, _mm256_mul_ps(normalZ, centerZ));
+                    signedDistance        = _mm256_add_ps(signedDistance, distance);
+
+                    // Projected half size of the box onto the plane normal
+                    __m256 radius = _mm256_mul_ps(absNormalX, extentX);
+                    radius        = _mm256_add_ps(radius, _mm256_mul_ps(absNormalY, extentY));
+                    radius        = _mm256_add_ps(radius, _mm256_mul_ps(absNormalZ, extentZ));
+
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(signedDistance, radius), zero, _CMP_LT_OQ));
+                }
+
+                m_visibility[group] = static_cast<u8>(~_mm256_movemask_ps(outside) & 0xFF);
+            }
+        });
+    }
+
+    void Culler::WriteBuckets
+    (
+        VmaAllocator allocator,
+        const GPU::Plane& nearPlane,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::DrawCallBuffer& drawCallBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers,
+        bool sortDraws
+    )
+    {
+        const auto meshes    = meshBuffer.GetMeshes();
+        const auto materials = meshBuffer.GetMaterials();
+
+        const std::array<const Buffers::DrawCallBuffer*, 4> buckets =
+        {
+            &culledBuffers.opaqueBuffer,
+            &culledBuffers.opaqueDoubleSidedBuffer,
+            &culledBuffers.alphaMaskedBuffer,
+            &culledBuffers.alphaMaskedDoubleSidedBuffer
+        };
+
+        std::array<std::atomic<u32>, 4> drawCounts = {};
+
+        for (auto& bucketDraws : m_bucketDraws)
+        {
+            bucketDraws.resize(drawCallBuffer.drawCalls.size());
+        }
+
+        const auto IsVisible = [this] (u32 meshIndex)
+        {
+            return meshIndex < m_meshCount && (m_visibility[meshIndex / SIMD_WIDTH] >> (meshIndex % SIMD_WIDTH)) & 1u;
+        };
+
+        // Distance from the near plane to the closest point of the mesh's world bounds
+        const auto GetDepth = [this, &nearPlane] (u32 meshIndex)
+        {
+            return nearPlane.normal.x * m_centerX[meshIndex] +
+                   nearPlane.normal.y * m_centerY[meshIndex] +
+                   nearPlane.normal.z * m_centerZ[meshIndex] +
+                   nearPlane.distance -
+                   std::abs(nearPlane.normal.x) * m_extentX[meshIndex] -
+                   std::abs(nearPlane.normal.y) * m_extentY[meshIndex] -
+                   std::abs(nearPlane.normal.z) * m_extentZ[meshIndex];
+        };
+
+        Util::ParallelFor(drawCallBuffer.drawCalls.size(), DRAW_CALL_BATCH_SIZE, [&] (usize begin, usize end)
+        {
+            for (usize i = begin; i < end; ++i)
+            {
+                const auto& drawCall = drawCallBuffer.drawCalls[i];
+
+                // Every instance of a draw shares the same mesh, and so the same material
+                const u32   firstMesh = drawCallBuffer.instances[drawCall.firstInstance].meshIndex;
+                const auto& material  = materials[meshes[firstMesh].materialIndex];
+
+                const bool isDoubleSided = (material.flags & GPU::MaterialFlags::DoubleSided) == GPU::MaterialFlags::DoubleSided;
+                const bool isAlphaMasked = (material.flags & GPU::MaterialFlags::AlphaMasked) == GPU::MaterialFlags::AlphaMasked;
+
+                const usize bucketIndex = (isAlphaMasked ? 2 : 0) + (isDoubleSided ? 1 : 0);
+                const auto& bucket      = *buckets[bucketIndex];
+
+                auto* meshIndices = static_cast<u32*>(bucket.meshIndexBuffer->allocationInfo.pMappedData);
+
+                u32 visibleCount = 0;
+                f32 depth        = std::numeric_limits<f32>::max();
+
+                for (u32 j = 0; j < drawCall.instanceCount; ++j)
+                {
+                    const u32 meshIndex = drawCallBuffer.instances[drawCall.firstInstance + j].meshIndex;
+
+                    if (IsVisible(meshIndex))
+                    {
+                        meshIndices[drawCall.firstInstance + visibleCount++] = meshIndex;
+
+                        depth = std::min(depth, GetDepth(meshIndex));
+                    }
+                }
+
+                if (visibleCount == 0)
+                {
+                    continue;
+                }
+
+                const u32 drawIndex = drawCounts[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+
+                m_bucketDraws[bucketIndex][drawIndex] = SortedDraw{
+                    .depth    = depth,
+                    .drawCall = VkDrawIndexedIndirectCommand{
+                        .indexCount    = drawCall.indexCount,
+                        .instanceCount = visibleCount,
+                        .firstIndex    = drawCall.firstIndex,
+                        .vertexOffset  = drawCall.vertexOffset,
+                        .firstInstance = drawCall.firstInstance
+                    }
+                };
+            }
+        });
+
+        for (usize i = 0; i < buckets.size(); ++i)
+        {
+            const u32 drawCount = drawCounts[i].load(std::memory_order_relaxed);
+
+            const auto bucketDraws = std::span(m_bucketDraws[i]).first(drawCount);
+
+            // Front to back, firstInstance is unique per draw and keeps the order stable between frames
+            if (sortDraws)
+            {
+                std::sort(bucketDraws.begin(), bucketDraws.end(), [] (const SortedDraw& lhs, const SortedDraw& rhs)
+                {
+                    return std::tie(lhs.depth, lhs.drawCall.firstInstance) < std::tie(rhs.depth, rhs.drawCall.firstInstance);
+                });
+            }
+
+            auto* drawCalls = reinterpret_cast<VkDrawIndexedIndirectCommand*>(static_cast<u8*>(buckets[i]->drawCallBuffer.allocationInfo.pMappedData) + sizeof(u32));
+
+            for (u32 j = 0; j < drawCount; ++j)
+            {
+                drawCalls[j] = bucketDraws[j].drawCall;
+            }
+
+            std::memcpy(buckets[i]->drawCallBuffer.allocationInfo.pMappedData, &drawCount, sizeof(u32));
+
+            if (!(buckets[i]->drawCallBuffer.memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+            {
+                Vk::CheckResult(vmaFlushAllocation(
+                    allocator,
+                    buckets[i]->drawCallBuffer.allocation,
+                    0,
+                    sizeof(u32) + drawCount * sizeof(VkDrawIndexedIndirectCommand)),
+                    "Failed to flush allocation!"
+                );
+            }
+
+            if (!(buckets[i]->meshIndexBuffer->memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+            {
+                Vk::CheckResult(vmaFlushAllocation(
+                    allocator,
+                    buckets[i]->meshIndexBuffer->allocation,
+                    0,
+                    drawCallBuffer.instances.size() * sizeof(u32)),
+                    "Failed to flush allocation!"
+                );
+            }
+        }
+    }
+
+    const Buffers::IndirectBuffer::CulledBuffers& Culler::AcquireView
+    (
+        usize FIF,
+        usize frameIndex,
+        VkDevice device,
+        VmaAllocator allocator,
+        u32 requiredCapacity
+    )
+    {
+        auto& viewSet = m_viewSets[FIF];
+
+        // The previous frame using this slot has finished on the GPU by now
+        if (viewSet.frameIndex != frameIndex)
+        {
+            viewSet.frameIndex = frameIndex;
+            viewSet.usedViews  = 0;
+        }
+
+        const usize viewIndex = viewSet.usedViews++;
+
+        if (viewIndex < viewSet.views.size() && viewSet.views[viewIndex].opaqueBuffer.capacity >= requiredCapacity)
+        {
+            return viewSet.views[viewIndex];
+        }
+
+        const u32 capacity = std::bit_ceil(std::max(requiredCapacity, MIN_VIEW_CAPACITY));
+
+        if (viewIndex < viewSet.views.size())
+        {
+            viewSet.views[viewIndex].Destroy(allocator);
+        }
+        else
+        {
+            viewSet.views.emplace_back();
+        }
+
+        auto& view = viewSet.views[viewIndex];
+        view       = Buffers::IndirectBuffer::CulledBuffers(device, allocator, Buffers::DrawCallBuffer::Type::CPUCulled, capacity);
+
+        const auto prefix = fmt::format("Culling/CPU/{}/View{}", FIF, viewIndex);
+
+        Vk::SetDebugName(device, view.opaqueBuffer.drawCallBuffer.handle,                   fmt::format("{}/Opaque/DrawCalls", prefix));
+        Vk::SetDebugName(device, view.opaqueBuffer.meshIndexBuffer->handle,                 fmt::format("{}/Opaque/MeshIndices", prefix));
+        Vk::SetDebugName(device, view.opaqueDoubleSidedBuffer.drawCallBuffer.handle,        fmt::format("{}/Opaque/DoubleSided/DrawCalls", prefix));
+        Vk::SetDebugName(device, view.opaqueDoubleSidedBuffer.meshIndexBuffer->handle,      fmt::format("{}/Opaque/DoubleSided/MeshIndices", prefix));
+        Vk::SetDebugName(device, view.alphaMaskedBuffer.drawCallBuffer.handle,              fmt::format("{}/AlphaMasked/DrawCalls", prefix));
+        Vk::SetDebugName(device, view.alphaMaskedBuffer.meshIndexBuffer->handle,            fmt::format("{}/AlphaMasked/MeshIndices", prefix));
+        Vk::SetDebugName(device, view.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,   fmt::format("{}/AlphaMasked/DoubleSided/DrawCalls", prefix));
+        Vk::SetDebugName(device, view.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->handle, fmt::format("{}/AlphaMasked/DoubleSided/MeshIndices", prefix));
+
+        return view;
+    }
+
+    usize Culler::GetThreadCount() const
+    {
+        return Util::GetExecutor().num_workers();
+    }
+
+    void Culler::Destroy(VmaAllocator allocator)
+    {
+        for (auto& viewSet : m_viewSets)
+        {
+            for (auto& view : viewSet.views)
+            {
+                view.Destroy(allocator);
+            }
+
+            viewSet.views.clear();
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_CULLER_H
+#define CPU_CULLER_H
+
+#include <vector>
+#include <deque>
+#include <array>
+#include <limits>
+
+#include "Util/Types.h"
+#include "Vulkan/Constants.h"
+#include "Renderer/Buffers/IndirectBuffer.h"
+#include "Renderer/Buffers/MeshBuffer.h"
+#include "Externals/GLM.h"
+#include "GPU/Plane.h"
+
+namespace Renderer::Culling::CPU
+{
+    class Culler
+    {
+    public:
+        void Destroy(VmaAllocator allocator);
+
+        // Every call within a frame writes into its own set of host visible buckets
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& Cull
+        (
+            usize FIF,
+            usize frameIndex,
+            VkDevice device,
+            VmaAllocator allocator,
+            const glm::mat4& projectionView,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::DrawCallBuffer& drawCallBuffer,
+            bool sortDraws
+        );
+
+        [[nodiscard]] usize GetThreadCount() const;
+    private:
+        void ComputeWorldBounds(const Buffers::MeshBuffer& meshBuffer);
+        void TestVisibility(const GPU::FrustumBuffer& frustum);
+
+        void WriteBuckets
+        (
+            VmaAllocator allocator,
+            const GPU::Plane& nearPlane,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::DrawCallBuffer& drawCallBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers,
+            bool sortDraws
+        );
+
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& AcquireView
+        (
+            usize FIF,
+            usize frameIndex,
+            VkDevice device,
+            VmaAllocator allocator,
+            u32 requiredCapacity
+        );
+
+        // World space bounds in SoA form, padded to a multiple of 8
+        std::vector<f32> m_centerX = {};
+        std::vector<f32> m_centerY = {};
+        std::vector<f32> m_centerZ = {};
+        std::vector<f32> m_extentX = {};
+        std::vector<f32> m_extentY = {};
+        std::vector<f32> m_extentZ = {};
+
+        // One bit per mesh, one byte per group of 8
+        std::vector<u8> m_visibility = {};
+
+        struct SortedDraw
+        {
+            f32                          depth;
+            VkDrawIndexedIndirectCommand drawCall;
+        };
+
+        // Draws are gathered here first, so they can be sorted before being written to the buckets
+        std::array<std::vector<SortedDraw>, 4> m_bucketDraws = {};
+
+        usize m_meshCount        = 0;
+        usize m_boundsFrameIndex = std::numeric_limits<usize>::max();
+
+        struct ViewSet
+        {
+            // Deque, so handing out a new view never moves the earlier ones
+            std::deque<Buffers::IndirectBuffer::CulledBuffers> views      = {};
+            usize                                              usedViews  = 0;
+            usize                                              frameIndex = std::numeric_limits<usize>::max();
+        };
+
+        std::array<ViewSet, Vk::FRAMES_IN_FLIGHT> m_viewSets = {};
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Pipeline.h"
+#include "Vulkan/PipelineBuilder.h"
+#include "Vulkan/DebugUtils.h"
+#include "Culling/Cluster.h"
+
+namespace Renderer::Culling::Cluster
+{
+    Pipeline::Pipeline
+    (
+        const Vk::Context& context,
+        Vk::MegaSet& megaSet,
+        Vk::TextureManager& textureManager
+    )
+    {
+        std::tie(handle, layout, bindPoint) = Vk::PipelineBuilder(context)
+            .SetPipelineType(VK_PIPELINE_BIND_POINT_COMPUTE)
+            .AttachShader("Culling/Cluster.comp", VK_SHADER_STAGE_COMPUTE_BIT)
+            .AddPushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(Cluster::Constants))
+            .AddDescriptorLayout(megaSet.descriptorLayout)
+            .Build();
+
+        pointSamplerID = textureManager.AddSampler
+        (
+            megaSet,
+            context.device,
+            VkSamplerCreateInfo{
+                .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+                .pNext                   = nullptr,
+                .flags                   = 0,
+                .magFilter               = VK_FILTER_NEAREST,
+                .minFilter               = VK_FILTER_NEAREST,
+                .mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+                .addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                .addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                .addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                .mipLodBias              = 0.0f,
+                .anisotropyEnable        = VK_FALSE,
+                .maxAnisotropy           = 0.0f,
+                .compareEnable           = VK_FALSE,
+                .compareOp               = VK_COMPARE_OP_ALWAYS,
+                .minLod                  = 0.0f,
+                .maxLod                  = VK_LOD_CLAMP_NONE,
+                .borderColor             = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+                .unnormalizedCoordinates = VK_FALSE
+            }
+        );
+
+        megaSet.Update(context.device);
+
+        Vk::SetDebugName(context.device, handle, "Culling/Cluster/Pipeline");
+        Vk::SetDebugName(context.device, layout, "Culling/Cluster/Pipeline/Layout");
+    }
+}
@@ -16,20 +16,201 @@
 
 #include "Dispatch.h"
 
+#include <span>
+#include <chrono>
+#include <algorithm>
+
 #include "Vulkan/DebugUtils.h"
+#include "Vulkan/Util.h"
+#include "Externals/ImGui.h"
 #include "Culling/Frustum.h"
+#include "Culling/Compact.h"
+#include "Culling/Sort.h"
+#include "Culling/HiZ.h"
+#include "Culling/Occlusion.h"
+#include "Culling/MultiView.h"
+#include "Culling/MultiViewCompact.h"
+#include "Culling/Cluster.h"
+#include "Util/Align.h"
+#include "Util/Log.h"
+#include "GPU/Lights.h"
 
 namespace Renderer::Culling
 {
     constexpr auto CULLING_WORKGROUP_SIZE = 64;
 
-    Dispatch::Dispatch(const Vk::Context& context)
+    // Both occlusion and cluster passes, the depth pyramid and every shadow atlas view, two timestamps each
+    constexpr u32 MAX_CULLING_TIMESTAMPS = 2 * (5 + 6 * GPU::MAX_SHADOWED_POINT_LIGHT_COUNT + GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT);
+
+    // Keys and indices of every sorted draw call, see Culling/Sort.comp
+    constexpr u32 SORT_SHARED_MEMORY_SIZE = Sort::MAX_SORTED_DRAW_CALLS * (sizeof(glm::uvec2) + sizeof(u32));
+
+    Dispatch::Dispatch
+    (
+        const Vk::Context& context,
+        Vk::FramebufferManager& framebufferManager,
+        Vk::MegaSet& megaSet,
+        Vk::TextureManager& textureManager
+    )
         : m_frustumPipeline(context),
-          m_frustumBuffer(context.device, context.allocator)
+          m_compactPipeline(context),
+          m_hiZPipeline(context, megaSet, textureManager),
+          m_occlusionPipeline(context, megaSet, textureManager),
+          m_multiViewPipeline(context),
+          m_multiViewCompactPipeline(context),
+          m_clusterPipeline(context, megaSet, textureManager),
+          m_frustumBuffer(context.device, context.allocator),
+          m_device(context.device),
+          m_allocator(context.allocator),
+          m_timestampPeriod(context.physicalDeviceLimits.timestampPeriod)
     {
+        m_isMeshShadingSupported = context.isMeshShaderSupported;
+        m_maxTaskWorkGroupTotal  = context.physicalDeviceMeshShaderProperties.maxTaskWorkGroupTotalCount;
+
+        std::ranges::copy(context.physicalDeviceMeshShaderProperties.maxTaskWorkGroupCount, m_maxTaskWorkGroupCount.begin());
+
+        const auto& limits = context.physicalDeviceLimits;
+
+        if (limits.maxComputeWorkGroupInvocations >= Sort::SORT_WORKGROUP_SIZE &&
+            limits.maxComputeWorkGroupSize[0]     >= Sort::SORT_WORKGROUP_SIZE &&
+            limits.maxComputeSharedMemorySize     >= SORT_SHARED_MEMORY_SIZE)
+        {
+            m_sortPipeline.emplace(context);
+        }
+        else
+        {
+            Logger::Warning
+            (
+                "GPU draw sorting disabled! [MaxInvocations={}] [MaxSharedMemory={}]\n",
+                limits.maxComputeWorkGroupInvocations,
+                limits.maxComputeSharedMemorySize
+            );
+        }
+
+        const VkQueryPoolCreateInfo queryPoolInfo =
+        {
+            .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .pNext              = nullptr,
+            .flags              = 0,
+            .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount         = MAX_CULLING_TIMESTAMPS,
+            .pipelineStatistics = 0
+        };
+
+        for (usize i = 0; i < m_queryPools.size(); ++i)
+        {
+            Vk::CheckResult(vkCreateQueryPool(
+                context.device,
+                &queryPoolInfo,
+                nullptr,
+                &m_queryPools[i]),
+                "Failed to create query pool!"
+            );
+
+            Vk::SetDebugName(context.device, m_queryPools[i], fmt::format("Culling/TimestampQueryPool/{}", i));
+
+            m_frameIndices[i] = std::numeric_limits<usize>::max();
+        }
+
+        m_visibilityBuffer = Vk::Buffer
+        (
+            context.allocator,
+            Buffers::MAX_MESH_COUNT / 32 * sizeof(u32),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        m_visibilityBuffer.GetDeviceAddress(context.device);
+
+        Vk::SetDebugName(context.device, m_visibilityBuffer.handle, "Culling/VisibilityBuffer");
+
+        m_viewFrustumBuffer = Vk::Buffer
+        (
+            context.allocator,
+            MultiView::MAX_CULLING_VIEWS * sizeof(GPU::FrustumBuffer),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        m_viewFrustumBuffer.GetDeviceAddress(context.device);
+
+        Vk::SetDebugName(context.device, m_viewFrustumBuffer.handle, "Culling/ViewFrustumBuffer");
+
+        m_viewInfoBuffer = Vk::Buffer
+        (
+            context.allocator,
+            MultiView::MAX_CULLING_VIEWS * sizeof(MultiView::ViewInfo),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        m_viewInfoBuffer.GetDeviceAddress(context.device);
+
+        Vk::SetDebugName(context.device, m_viewInfoBuffer.handle, "Culling/ViewInfoBuffer");
+
+        framebufferManager.AddFramebuffer
+        (
+            "Culling/HiZ",
+            Vk::FramebufferType::ColorR_SFloat32,
+            Vk::FramebufferImageType::Single2D,
+            Vk::FramebufferUsage::Sampled | Vk::FramebufferUsage::Storage,
+            [] (const VkExtent2D& extent) -> Vk::FramebufferSize
+            {
+                // Every level halves exactly, so a texel always maps to a power of two block of depth texels
+                constexpr usize ALIGNMENT = 1u << (HiZ::HIZ_MIP_LEVELS - 1);
+
+                return
+                {
+                    .width       = static_cast<u32>(Util::Align((extent.width  + 1) / 2, ALIGNMENT)),
+                    .height      = static_cast<u32>(Util::Align((extent.height + 1) / 2, ALIGNMENT)),
+                    .mipLevels   = HiZ::HIZ_MIP_LEVELS,
+                    .arrayLayers = 1
+                };
+            },
+            {
+                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            }
+        );
+
+        framebufferManager.AddFramebufferView
+        (
+            "Culling/HiZ",
+            "Culling/HiZView",
+            Vk::FramebufferImageType::Single2D,
+            Vk::FramebufferViewSize{
+                .baseMipLevel   = 0,
+                .levelCount     = HiZ::HIZ_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount     = 1
+            }
+        );
+
+        for (u32 i = 0; i < HiZ::HIZ_MIP_LEVELS; ++i)
+        {
+            framebufferManager.AddFramebufferView
+            (
+                "Culling/HiZ",
+                fmt::format("Culling/HiZView/Mip{}", i),
+                Vk::FramebufferImageType::Single2D,
+                Vk::FramebufferViewSize{
+                    .baseMipLevel   = i,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                }
+            );
+        }
     }
 
-    void Dispatch::Frustum
+    const Buffers::IndirectBuffer::CulledBuffers& Dispatch::Frustum
     (
         usize FIF,
         usize frameIndex,
@@ -41,34 +222,66 @@ namespace Renderer::Culling
     {
         Vk::BeginLabel(cmdBuffer, "Frustum Culling", glm::vec4(0.6196f, 0.5588f, 0.8588f, 1.0f));
 
-        if (!NeedsDispatch(FIF, cmdBuffer, indirectBuffer))
+        BeginFrame(FIF, frameIndex, cmdBuffer);
+
+        if (m_backend == Backend::CPU)
         {
+            const auto start = std::chrono::steady_clock::now();
+
+            m_culledBuffers = &m_cpuCuller.Cull
+            (
+                FIF,
+                frameIndex,
+                m_device,
+                m_allocator,
+                projectionView,
+                meshBuffer,
+                indirectBuffer.writtenDrawCallBuffers[FIF],
+                m_sortDraws
+            );
+
+            m_cpuTimeThisFrame += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
             Vk::EndLabel(cmdBuffer);
 
-            return;
+            return *m_culledBuffers;
+        }
+
+        m_culledBuffers = &indirectBuffer.frustumCulledBuffers;
+
+        if (!NeedsDispatch(FIF, cmdBuffer, indirectBuffer, indirectBuffer.frustumCulledBuffers))
+        {
+            Vk::EndLabel(cmdBuffer);
+
+            return *m_culledBuffers;
         }
 
+        WriteTimestamp(FIF, cmdBuffer);
+
+        m_frustumBuffer.Load(cmdBuffer, projectionView);
+
         PreDispatch
         (
             FIF,
-            projectionView,
             cmdBuffer,
-            indirectBuffer
+            indirectBuffer,
+            indirectBuffer.frustumCulledBuffers
         );
 
         m_frustumPipeline.Bind(cmdBuffer);
 
         const auto constants = Frustum::Constants
         {
-            .Meshes                                  = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
+            .Meshes                                  = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+            .Transforms                              = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+            .Bounds                                  = meshBuffer.GetCurrentStreams(frameIndex).bounds.deviceAddress,
+            .Materials                               = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
             .DrawCalls                               = indirectBuffer.writtenDrawCallBuffers[FIF].drawCallBuffer.deviceAddress,
-            .CulledOpaqueDrawCalls                   = indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.deviceAddress,
+            .Instances                               = indirectBuffer.writtenDrawCallBuffers[FIF].instanceBuffer->deviceAddress,
+            .VisibleInstanceCounts                   = indirectBuffer.frustumCulledBuffers.visibleInstanceCountBuffer->deviceAddress,
             .CulledOpaqueMeshIndices                 = indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
-            .CulledOpaqueDoubleSidedDrawCalls        = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.deviceAddress,
             .CulledOpaqueDoubleSidedMeshIndices      = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
-            .CulledAlphaMaskedDrawCalls              = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.deviceAddress,
             .CulledAlphaMaskedMeshIndices            = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
-            .CulledAlphaMaskedDoubleSidedDrawCalls   = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.deviceAddress,
             .CulledAlphaMaskedDoubleSidedMeshIndices = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
             .Frustum                                 = m_frustumBuffer.buffer.deviceAddress
         };
@@ -82,126 +295,1237 @@ namespace Renderer::Culling
 
         Execute(FIF, cmdBuffer, indirectBuffer);
 
-        PostDispatch(FIF, cmdBuffer, indirectBuffer);
+        CompactDraws
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            meshBuffer,
+            indirectBuffer,
+            indirectBuffer.frustumCulledBuffers,
+            0
+        );
+
+        SortDraws
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            meshBuffer,
+            indirectBuffer,
+            indirectBuffer.frustumCulledBuffers
+        );
+
+        PostDispatch(FIF, cmdBuffer, indirectBuffer, indirectBuffer.frustumCulledBuffers);
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+
+        return *m_culledBuffers;
+    }
+
+    const Buffers::IndirectBuffer::CulledBuffers& Dispatch::Occlusion
+    (
+        Occlusion::Pass pass,
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Vk::TextureManager& textureManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    )
+    {
+        const bool isEarlyPass = pass == Occlusion::Pass::Early;
+
+        Vk::BeginLabel
+        (
+            cmdBuffer,
+            isEarlyPass ? "Early Occlusion Culling" : "Late Occlusion Culling",
+            glm::vec4(0.6196f, 0.4588f, 0.8588f, 1.0f)
+        );
+
+        BeginFrame(FIF, frameIndex, cmdBuffer);
+
+        // The late pass appends to the frustum culled buckets, so they end up holding everything visible this frame
+        m_culledBuffers = &indirectBuffer.frustumCulledBuffers;
+
+        const auto& culledBuffers = isEarlyPass ? indirectBuffer.frustumCulledBuffers : indirectBuffer.lateCulledBuffers;
+
+        if (!NeedsDispatch(FIF, cmdBuffer, indirectBuffer, culledBuffers))
+        {
+            Vk::EndLabel(cmdBuffer);
+
+            return culledBuffers;
+        }
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        // Only the near plane is used, to order the compacted draws
+        if (IsSortEnabled())
+        {
+            m_frustumBuffer.Load(cmdBuffer, sceneBuffer.gpuScene.currentMatrices.projection * sceneBuffer.gpuScene.currentMatrices.view);
+        }
+
+        if (isEarlyPass)
+        {
+            PreDispatch
+            (
+                FIF,
+                cmdBuffer,
+                indirectBuffer,
+                indirectBuffer.frustumCulledBuffers
+            );
+
+            PreEarlyDispatch(cmdBuffer);
+        }
+        else
+        {
+            PreLateDispatch(FIF, cmdBuffer, indirectBuffer);
+        }
+
+        m_occlusionPipeline.Bind(cmdBuffer);
+
+        const std::array descriptorSets = {megaSet.descriptorSet};
+        m_occlusionPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+        const auto constants = Occlusion::Constants
+        {
+            .Scene                                   = sceneBuffer.buffers[FIF].deviceAddress,
+            .Meshes                                  = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+            .Transforms                              = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+            .Bounds                                  = meshBuffer.GetCurrentStreams(frameIndex).bounds.deviceAddress,
+            .Materials                               = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+            .DrawCalls                               = indirectBuffer.writtenDrawCallBuffers[FIF].drawCallBuffer.deviceAddress,
+            .Instances                               = indirectBuffer.writtenDrawCallBuffers[FIF].instanceBuffer->deviceAddress,
+            .VisibleInstanceCounts                   = indirectBuffer.frustumCulledBuffers.visibleInstanceCountBuffer->deviceAddress,
+            .CulledOpaqueMeshIndices                 = indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
+            .CulledOpaqueDoubleSidedMeshIndices      = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+            .CulledAlphaMaskedMeshIndices            = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
+            .CulledAlphaMaskedDoubleSidedMeshIndices = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+            .Visibility                              = m_visibilityBuffer.deviceAddress,
+            .ViewportSize                            = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+            .PointSamplerIndex                       = textureManager.GetSampler(m_occlusionPipeline.pointSamplerID).descriptorID,
+            .HiZIndex                                = framebufferManager.GetFramebufferView("Culling/HiZView").sampledImageID,
+            .CurrentPass                             = pass
+        };
+
+        m_occlusionPipeline.PushConstants
+        (
+            cmdBuffer,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            constants
+        );
+
+        Execute(FIF, cmdBuffer, indirectBuffer);
+
+        CompactDraws
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            meshBuffer,
+            indirectBuffer,
+            indirectBuffer.frustumCulledBuffers,
+            0
+        );
+
+        if (!isEarlyPass)
+        {
+            CompactDraws
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                meshBuffer,
+                indirectBuffer,
+                indirectBuffer.lateCulledBuffers,
+                indirectBuffer.lateCulledBuffers.visibleInstanceCountBuffer->deviceAddress
+            );
+        }
+
+        SortDraws
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            meshBuffer,
+            indirectBuffer,
+            indirectBuffer.frustumCulledBuffers
+        );
+
+        if (!isEarlyPass)
+        {
+            SortDraws
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                meshBuffer,
+                indirectBuffer,
+                indirectBuffer.lateCulledBuffers
+            );
+        }
+
+        PostDispatch(FIF, cmdBuffer, indirectBuffer, indirectBuffer.frustumCulledBuffers);
+
+        if (!isEarlyPass)
+        {
+            PostDispatch(FIF, cmdBuffer, indirectBuffer, indirectBuffer.lateCulledBuffers);
+        }
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+
+        return culledBuffers;
+    }
+
+    const Buffers::IndirectBuffer::CulledBuffers& Dispatch::Clusters
+    (
+        Occlusion::Pass pass,
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Vk::TextureManager& textureManager,
+        const Vk::GeometryBuffer& geometryBuffer,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+    )
+    {
+        const bool isEarlyPass = pass == Occlusion::Pass::Early;
+
+        Vk::BeginLabel
+        (
+            cmdBuffer,
+            isEarlyPass ? "Early Cluster Culling" : "Late Cluster Culling",
+            glm::vec4(0.7196f, 0.4588f, 0.8588f, 1.0f)
+        );
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        PreClusterDispatch(pass, cmdBuffer, indirectBuffer, drawCalls, meshIndices);
+
+        // Compacted draws never outnumber the written ones
+        const u32 drawCallCount = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+
+        if (drawCallCount != 0)
+        {
+            m_clusterPipeline.Bind(cmdBuffer);
+
+            const std::array descriptorSets = {megaSet.descriptorSet};
+            m_clusterPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            // Double sided buckets can not reject back facing clusters
+            constexpr std::array CULL_BACK_FACES = {true, false, true, false};
+
+            for (usize i = 0; i < CULL_BACK_FACES.size(); ++i)
+            {
+                const auto& clusterBuffer     = *GetBuckets(indirectBuffer.clusterCulledBuffers)[i];
+                const auto& lateClusterBuffer = *GetBuckets(indirectBuffer.lateClusterCulledBuffers)[i];
+
+                const auto constants = Cluster::Constants
+                {
+                    .Scene             = sceneBuffer.buffers[FIF].deviceAddress,
+                    .Meshes            = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                    .Transforms        = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .Clusters          = geometryBuffer.GetClusterBuffer().deviceAddress,
+                    .DrawCalls         = GetBuckets(drawCalls)[i]->drawCallBuffer.deviceAddress,
+                    .MeshIndices       = GetBuckets(meshIndices)[i]->meshIndexBuffer->deviceAddress,
+                    .CulledDrawCalls   = clusterBuffer.drawCallBuffer.deviceAddress,
+                    .CulledMeshIndices = clusterBuffer.meshIndexBuffer->deviceAddress,
+                    .LateDrawCalls     = isEarlyPass ? 0 : lateClusterBuffer.drawCallBuffer.deviceAddress,
+                    .LateMeshIndices   = isEarlyPass ? 0 : lateClusterBuffer.meshIndexBuffer->deviceAddress,
+                    .ViewportSize      = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+                    .PointSamplerIndex = textureManager.GetSampler(m_clusterPipeline.pointSamplerID).descriptorID,
+                    .HiZIndex          = framebufferManager.GetFramebufferView("Culling/HiZView").sampledImageID,
+                    .TestOcclusion     = isEarlyPass ? 0u : 1u,
+                    .CullBackFaces     = CULL_BACK_FACES[i] ? 1u : 0u
+                };
+
+                m_clusterPipeline.PushConstants
+                (
+                    cmdBuffer,
+                    VK_SHADER_STAGE_COMPUTE_BIT,
+                    constants
+                );
+
+                vkCmdDispatch
+                (
+                    cmdBuffer.handle,
+                    drawCallCount,
+                    1,
+                    1
+                );
+            }
+        }
+
+        PostClusterDispatch(pass, cmdBuffer, indirectBuffer, drawCalls, meshIndices);
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+
+        m_culledBuffers = &indirectBuffer.clusterCulledBuffers;
+
+        return isEarlyPass ? indirectBuffer.clusterCulledBuffers : indirectBuffer.lateClusterCulledBuffers;
+    }
+
+    bool Dispatch::MultiView
+    (
+        usize FIF,
+        usize frameIndex,
+        const std::span<const glm::mat4> projectionViews,
+        const std::span<const MultiView::ViewInfo> viewInfos,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    )
+    {
+        const u32 drawCallCount = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const u32 viewCount     = static_cast<u32>(projectionViews.size());
+
+        if (viewInfos.size() != projectionViews.size())
+        {
+            Logger::Error("View info count does not match view count! [ViewInfos={}] [Views={}]\n", viewInfos.size(), projectionViews.size());
+        }
+
+        if (m_backend != Backend::GPU || !m_multiViewCulling)
+        {
+            return false;
+        }
+
+        if (viewCount == 0 || viewCount > MultiView::MAX_CULLING_VIEWS || drawCallCount > MultiView::MAX_VIEW_DRAW_CALLS)
+        {
+            return false;
+        }
+
+        Vk::BeginLabel(cmdBuffer, "Multi-View Culling", glm::vec4(0.6196f, 0.5588f, 0.7588f, 1.0f));
+
+        BeginFrame(FIF, frameIndex, cmdBuffer);
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        PreMultiViewDispatch(FIF, viewCount, cmdBuffer, indirectBuffer);
+
+        std::vector<GPU::FrustumBuffer> frustums = {};
+        frustums.reserve(viewCount);
+
+        for (const auto& projectionView : projectionViews)
+        {
+            frustums.emplace_back(projectionView);
+        }
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            m_viewFrustumBuffer.handle,
+            0,
+            frustums.size() * sizeof(GPU::FrustumBuffer),
+            frustums.data()
+        );
+
+        m_viewFrustumBuffer.Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = frustums.size() * sizeof(GPU::FrustumBuffer)
+            }
+        );
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            m_viewInfoBuffer.handle,
+            0,
+            viewInfos.size() * sizeof(MultiView::ViewInfo),
+            viewInfos.data()
+        );
+
+        m_viewInfoBuffer.Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = viewInfos.size() * sizeof(MultiView::ViewInfo)
+            }
+        );
+
+        const auto& viewCulledBuffers = indirectBuffer.viewCulledBuffers;
+
+        if (drawCallCount != 0)
+        {
+            m_multiViewPipeline.Bind(cmdBuffer);
+
+            const auto cullConstants = MultiView::Constants
+            {
+                .Transforms            = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                .Bounds                = meshBuffer.GetCurrentStreams(frameIndex).bounds.deviceAddress,
+                .DrawCalls             = indirectBuffer.writtenDrawCallBuffers[FIF].drawCallBuffer.deviceAddress,
+                .Instances             = indirectBuffer.writtenDrawCallBuffers[FIF].instanceBuffer->deviceAddress,
+                .VisibleInstanceCounts = viewCulledBuffers.visibleInstanceCountBuffer.deviceAddress,
+                .CulledMeshIndices     = viewCulledBuffers.meshIndexBuffer.deviceAddress,
+                .Frustums              = m_viewFrustumBuffer.deviceAddress,
+                .Views                 = m_viewInfoBuffer.deviceAddress,
+                .ViewCount             = viewCount
+            };
+
+            m_multiViewPipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                cullConstants
+            );
+
+            Execute(FIF, cmdBuffer, indirectBuffer);
+
+            viewCulledBuffers.visibleInstanceCountBuffer.Barrier
+            (
+                cmdBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = viewCount * drawCallCount * sizeof(u32)
+                }
+            );
+
+            m_multiViewCompactPipeline.Bind(cmdBuffer);
+
+            const auto compactConstants = MultiViewCompact::Constants
+            {
+                .Meshes                = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                .Materials             = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                .DrawCalls             = indirectBuffer.writtenDrawCallBuffers[FIF].drawCallBuffer.deviceAddress,
+                .Instances             = indirectBuffer.writtenDrawCallBuffers[FIF].instanceBuffer->deviceAddress,
+                .VisibleInstanceCounts = viewCulledBuffers.visibleInstanceCountBuffer.deviceAddress,
+                .CulledDrawCalls       = viewCulledBuffers.drawCallBuffer.deviceAddress,
+                .Views                 = m_viewInfoBuffer.deviceAddress
+            };
+
+            m_multiViewCompactPipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                compactConstants
+            );
+
+            vkCmdDispatch
+            (
+                cmdBuffer.handle,
+                GetWorkGroupCount(drawCallCount),
+                viewCount,
+                1
+            );
+
+            if (IsSortEnabled())
+            {
+                m_barrierWriter
+                .WriteBufferBarrier(
+                    viewCulledBuffers.drawCallBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = viewCulledBuffers.GetDrawCallOffset(viewCount, 0)
+                    }
+                )
+                .WriteBufferBarrier(
+                    viewCulledBuffers.meshIndexBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = viewCount * MultiView::MAX_VIEW_INSTANCES * sizeof(u32)
+                    }
+                )
+                .Execute(cmdBuffer);
+
+                m_sortPipeline->Bind(cmdBuffer);
+
+                // Every view and bucket is its own list, MAX_VIEW_DRAW_CALLS apart
+                const auto sortConstants = Sort::Constants
+                {
+                    .Counts       = viewCulledBuffers.drawCallBuffer.deviceAddress,
+                    .DrawCalls    = viewCulledBuffers.drawCallBuffer.deviceAddress + viewCulledBuffers.GetDrawCallOffset(0, 0),
+                    .MeshIndices  = viewCulledBuffers.meshIndexBuffer.deviceAddress,
+                    .Transforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .Bounds       = meshBuffer.GetCurrentStreams(frameIndex).bounds.deviceAddress,
+                    .Frustums     = m_viewFrustumBuffer.deviceAddress,
+                    .ListStride   = MultiView::MAX_VIEW_DRAW_CALLS,
+                    .ListsPerView = MultiView::BUCKET_COUNT
+                };
+
+                m_sortPipeline->PushConstants
+                (
+                    cmdBuffer,
+                    VK_SHADER_STAGE_COMPUTE_BIT,
+                    sortConstants
+                );
+
+                vkCmdDispatch
+                (
+                    cmdBuffer.handle,
+                    viewCount * MultiView::BUCKET_COUNT,
+                    1,
+                    1
+                );
+            }
+        }
+
+        PostMultiViewDispatch(viewCount, cmdBuffer, indirectBuffer);
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+
+        return true;
+    }
+
+    void Dispatch::BuildHiZ
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Vk::TextureManager& textureManager,
+        const std::string_view sceneDepthID
+    )
+    {
+        Vk::BeginLabel(cmdBuffer, "HiZ Generation", glm::vec4(0.4196f, 0.3588f, 0.7588f, 1.0f));
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        const auto& hiZ = framebufferManager.GetFramebuffer("Culling/HiZ");
+
+        hiZ.image.Barrier
+        (
+            cmdBuffer,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = hiZ.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = hiZ.image.arrayLayers
+            }
+        );
+
+        m_hiZPipeline.Bind(cmdBuffer);
+
+        const std::array descriptorSets = {megaSet.descriptorSet};
+        m_hiZPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+        for (u32 mip = 0; mip < hiZ.image.mipLevels; ++mip)
+        {
+            const auto& inputView = mip == 0 ?
+                                    framebufferManager.GetFramebufferView(sceneDepthID) :
+                                    framebufferManager.GetFramebufferView(fmt::format("Culling/HiZView/Mip{}", mip - 1));
+
+            const auto constants = HiZ::Constants
+            {
+                .PointSamplerIndex = textureManager.GetSampler(m_hiZPipeline.pointSamplerID).descriptorID,
+                .InputIndex        = inputView.sampledImageID,
+                .OutputIndex       = framebufferManager.GetFramebufferView(fmt::format("Culling/HiZView/Mip{}", mip)).storageImageID
+            };
+
+            m_hiZPipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                constants
+            );
+
+            vkCmdDispatch
+            (
+                cmdBuffer.handle,
+                (std::max(hiZ.image.width  >> mip, 1u) + 8 - 1) / 8,
+                (std::max(hiZ.image.height >> mip, 1u) + 8 - 1) / 8,
+                1
+            );
+
+            // The next level reads this one
+            hiZ.image.Barrier
+            (
+                cmdBuffer,
+                Vk::ImageBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                    .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .baseMipLevel   = mip,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = hiZ.image.arrayLayers
+                }
+            );
+        }
+
+        WriteTimestamp(FIF, cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+    }
+
+    bool Dispatch::IsOcclusionCullingEnabled() const
+    {
+        return m_backend == Backend::GPU && m_occlusionCulling;
+    }
+
+    bool Dispatch::IsClusterCullingEnabled() const
+    {
+        return m_backend == Backend::GPU && m_clusterCulling;
+    }
+
+    bool Dispatch::IsMeshShadingEnabled() const
+    {
+        return m_backend == Backend::GPU && m_meshShading && m_isMeshShadingSupported;
+    }
+
+    bool Dispatch::IsSortEnabled() const
+    {
+        return m_sortDraws && m_sortPipeline.has_value();
+    }
+
+    void Dispatch::DrawMeshTasks
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    ) const
+    {
+        const auto& writtenDrawCalls = indirectBuffer.writtenDrawCallBuffers[FIF];
+
+        // One workgroup column per written draw, culled buckets never hold more. Tall enough for the largest draw
+        const u32 drawCount  = std::min(writtenDrawCalls.writtenDrawCount, m_maxTaskWorkGroupCount[0]);
+        const u32 chunkCount = std::min
+        ({
+            (writtenDrawCalls.writtenMaxClusterCount + GPU::CLUSTER_TASK_WORKGROUP_SIZE - 1) / GPU::CLUSTER_TASK_WORKGROUP_SIZE,
+            m_maxTaskWorkGroupCount[1],
+            drawCount == 0 ? 0 : m_maxTaskWorkGroupTotal / drawCount
+        });
+
+        if (drawCount == 0 || chunkCount == 0)
+        {
+            return;
+        }
+
+        vkCmdDrawMeshTasksEXT
+        (
+            cmdBuffer.handle,
+            drawCount,
+            chunkCount,
+            1
+        );
+    }
+
+    void Dispatch::PreMeshShading
+    (
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+    ) const
+    {
+        Vk::BarrierWriter barrierWriter = {};
+
+        // Culling made its writes visible to the draw stages, chain them on to the task shaders
+        for (usize i = 0; i < 4; ++i)
+        {
+            barrierWriter
+            .WriteBufferBarrier(
+                GetBuckets(drawCalls)[i]->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            )
+            .WriteBufferBarrier(
+                *GetBuckets(meshIndices)[i]->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            );
+        }
+
+        barrierWriter.Execute(cmdBuffer);
+    }
+
+    void Dispatch::PostMeshShading
+    (
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+    ) const
+    {
+        Vk::BarrierWriter barrierWriter = {};
+
+        // Later culling passes only wait on the draw stages before rewriting the buckets, chain these reads onto them
+        for (usize i = 0; i < 4; ++i)
+        {
+            barrierWriter
+            .WriteBufferBarrier(
+                GetBuckets(drawCalls)[i]->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_NONE,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            )
+            .WriteBufferBarrier(
+                *GetBuckets(meshIndices)[i]->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_NONE,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            );
+        }
+
+        barrierWriter.Execute(cmdBuffer);
+    }
+
+    f64 Dispatch::GetCPUTime() const
+    {
+        return m_backend == Backend::CPU ? m_cpuTime : 0.0;
+    }
+
+    const Buffers::IndirectBuffer::CulledBuffers& Dispatch::GetCulledBuffers() const
+    {
+        return *m_culledBuffers;
+    }
+
+    void Dispatch::BeginFrame
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer
+    )
+    {
+        if (m_frameIndices[FIF] == frameIndex)
+        {
+            return;
+        }
+
+        // This slot's previous frame has already been waited on, so its timestamps are available
+        if (m_queryCounts[FIF] > 0)
+        {
+            std::array<u64, MAX_CULLING_TIMESTAMPS> timestamps = {};
+
+            const VkResult result = vkGetQueryPoolResults
+            (
+                m_device,
+                m_queryPools[FIF],
+                0,
+                m_queryCounts[FIF],
+                m_queryCounts[FIF] * sizeof(u64),
+                timestamps.data(),
+                sizeof(u64),
+                VK_QUERY_RESULT_64_BIT
+            );
+
+            if (result == VK_SUCCESS)
+            {
+                u64 ticks = 0;
+
+                for (u32 i = 0; i + 1 < m_queryCounts[FIF]; i += 2)
+                {
+                    ticks += timestamps[i + 1] - timestamps[i];
+                }
+
+                m_gpuTime = static_cast<f64>(ticks) * m_timestampPeriod / 1e6;
+            }
+        }
+
+        if (m_frameIndices[FIF] != std::numeric_limits<usize>::max())
+        {
+            m_cpuTime = m_cpuTimeThisFrame;
+        }
+
+        vkCmdResetQueryPool
+        (
+            cmdBuffer.handle,
+            m_queryPools[FIF],
+            0,
+            MAX_CULLING_TIMESTAMPS
+        );
+
+        m_frameIndices[FIF] = frameIndex;
+        m_queryCounts[FIF]  = 0;
+        m_cpuTimeThisFrame  = 0.0;
+    }
+
+    void Dispatch::WriteTimestamp(usize FIF, const Vk::CommandBuffer& cmdBuffer)
+    {
+        if (m_queryCounts[FIF] >= MAX_CULLING_TIMESTAMPS)
+        {
+            return;
+        }
+
+        vkCmdWriteTimestamp2
+        (
+            cmdBuffer.handle,
+            VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            m_queryPools[FIF],
+            m_queryCounts[FIF]++
+        );
+    }
+
+    void Dispatch::ImGuiDisplay()
+    {
+        if (ImGui::BeginMainMenuBar())
+        {
+            if (ImGui::BeginMenu("Culling"))
+            {
+                constexpr std::array BACKEND_NAMES = {"GPU", "CPU"};
+
+                s32 backend = static_cast<s32>(m_backend);
+
+                if (ImGui::Combo("Backend", &backend, BACKEND_NAMES.data(), static_cast<s32>(BACKEND_NAMES.size())))
+                {
+                    m_backend = static_cast<Backend>(backend);
+                }
+
+                ImGui::Checkbox("Occlusion Culling", &m_occlusionCulling);
+                ImGui::Checkbox("Multi-View Culling", &m_multiViewCulling);
+                ImGui::Checkbox("Cluster Culling", &m_clusterCulling);
+
+                ImGui::BeginDisabled(!m_isMeshShadingSupported);
+                ImGui::Checkbox("Mesh Shading", &m_meshShading);
+                ImGui::EndDisabled();
+
+                ImGui::Checkbox("Sort Draws", &m_sortDraws);
+
+                ImGui::Separator();
+
+                ImGui::Text("GPU Time     | %.4f ms", m_backend == Backend::GPU ? m_gpuTime : 0.0);
+                ImGui::Text("CPU Time     | %.4f ms", m_backend == Backend::CPU ? m_cpuTime : 0.0);
+                ImGui::Text("CPU Threads  | %llu", m_cpuCuller.GetThreadCount());
+
+                ImGui::EndMenu();
+            }
+
+            ImGui::EndMainMenuBar();
+        }
+    }
+
+    bool Dispatch::NeedsDispatch
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
+    )
+    {
+        const u32 drawCallCount = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+
+        if (drawCallCount != 0)
+        {
+            return true;
+        }
+
+        m_barrierWriter
+        .WriteBufferBarrier(
+            culledBuffers.opaqueBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .Execute(cmdBuffer);
+
+        constexpr u32 ZERO = 0;
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            culledBuffers.opaqueBuffer.drawCallBuffer.handle,
+            0,
+            sizeof(u32),
+            &ZERO
+        );
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+            0,
+            sizeof(u32),
+            &ZERO
+        );
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+            0,
+            sizeof(u32),
+            &ZERO
+        );
+
+        vkCmdUpdateBuffer
+        (
+            cmdBuffer.handle,
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+            0,
+            sizeof(u32),
+            &ZERO
+        );
+
+        m_barrierWriter
+        .WriteBufferBarrier(
+            culledBuffers.opaqueBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .Execute(cmdBuffer);
 
-        Vk::EndLabel(cmdBuffer);
+        return false;
     }
 
-    bool Dispatch::NeedsDispatch
+    void Dispatch::PreDispatch
     (
         usize FIF,
         const Vk::CommandBuffer& cmdBuffer,
-        const Buffers::IndirectBuffer& indirectBuffer
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
     )
     {
-        const u32 drawCallCount = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
-
-        if (drawCallCount != 0)
-        {
-            return true;
-        }
+        const u32 drawCallCount               = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const u32 instanceCount               = indirectBuffer.writtenDrawCallBuffers[FIF].writtenInstanceCount;
+        const VkDeviceSize drawCallsSize      = sizeof(u32) + drawCallCount * sizeof(VkDrawIndexedIndirectCommand);
+        const VkDeviceSize meshIndicesSize    = instanceCount * sizeof(u32);
+        const VkDeviceSize instanceCountsSize = drawCallCount * sizeof(u32);
 
         m_barrierWriter
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer,
+            culledBuffers.opaqueBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = sizeof(u32)
+                .size           = drawCallsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.opaqueBuffer.meshIndexBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = meshIndicesSize
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = sizeof(u32)
+                .size           = drawCallsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = meshIndicesSize
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = sizeof(u32)
+                .size           = drawCallsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.alphaMaskedBuffer.meshIndexBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = meshIndicesSize
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = drawCallsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = meshIndicesSize
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT,
                 .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                 .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = sizeof(u32)
+                .size           = instanceCountsSize
             }
         )
         .Execute(cmdBuffer);
 
-        constexpr u32 ZERO = 0;
-
-        vkCmdUpdateBuffer
+        vkCmdFillBuffer
         (
             cmdBuffer.handle,
-            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
+            culledBuffers.opaqueBuffer.drawCallBuffer.handle,
             0,
             sizeof(u32),
-            &ZERO
+            0
         );
 
-        vkCmdUpdateBuffer
+        vkCmdFillBuffer
         (
             cmdBuffer.handle,
-            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
             0,
             sizeof(u32),
-            &ZERO
+            0
         );
 
-        vkCmdUpdateBuffer
+        vkCmdFillBuffer
         (
             cmdBuffer.handle,
-            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
             0,
             sizeof(u32),
-            &ZERO
+            0
         );
 
-        vkCmdUpdateBuffer
+        vkCmdFillBuffer
         (
             cmdBuffer.handle,
-            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
             0,
             sizeof(u32),
-            &ZERO
+            0
+        );
+
+        vkCmdFillBuffer
+        (
+            cmdBuffer.handle,
+            culledBuffers.visibleInstanceCountBuffer->handle,
+            0,
+            instanceCountsSize,
+            0
         );
 
         m_barrierWriter
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer,
+            culledBuffers.opaqueBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -209,12 +1533,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -222,12 +1546,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -235,45 +1559,427 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = sizeof(u32)
+            }
+        )
+        .WriteBufferBarrier(
+            *culledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = instanceCountsSize
+            }
+        )
+        .Execute(cmdBuffer);
+    }
+
+    void Dispatch::PreEarlyDispatch(const Vk::CommandBuffer& cmdBuffer)
+    {
+        // Nothing has been seen yet, so the first frame draws everything in the late pass
+        if (!m_hasVisibility)
+        {
+            vkCmdFillBuffer
+            (
+                cmdBuffer.handle,
+                m_visibilityBuffer.handle,
+                0,
+                VK_WHOLE_SIZE,
+                0
+            );
+
+            m_hasVisibility = true;
+        }
+
+        m_visibilityBuffer.Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        );
+    }
+
+    void Dispatch::PreLateDispatch
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    )
+    {
+        const auto& frustumCulledBuffers = indirectBuffer.frustumCulledBuffers;
+        const auto& lateCulledBuffers    = indirectBuffer.lateCulledBuffers;
+
+        const u32 drawCallCount               = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const u32 instanceCount               = indirectBuffer.writtenDrawCallBuffers[FIF].writtenInstanceCount;
+        const VkDeviceSize drawCallsSize      = sizeof(u32) + drawCallCount * sizeof(VkDrawIndexedIndirectCommand);
+        const VkDeviceSize meshIndicesSize    = instanceCount * sizeof(u32);
+        const VkDeviceSize instanceCountsSize = drawCallCount * sizeof(u32);
+
+        const std::array drawCallBuffers =
+        {
+            &frustumCulledBuffers.opaqueBuffer,
+            &frustumCulledBuffers.opaqueDoubleSidedBuffer,
+            &frustumCulledBuffers.alphaMaskedBuffer,
+            &frustumCulledBuffers.alphaMaskedDoubleSidedBuffer,
+            &lateCulledBuffers.opaqueBuffer,
+            &lateCulledBuffers.opaqueDoubleSidedBuffer,
+            &lateCulledBuffers.alphaMaskedBuffer,
+            &lateCulledBuffers.alphaMaskedDoubleSidedBuffer
+        };
+
+        // The early draws have consumed these, both bucket sets get rebuilt
+        for (const auto* buffer : drawCallBuffers)
+        {
+            m_barrierWriter.WriteBufferBarrier(
+                buffer->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = drawCallsSize
+                }
+            );
+        }
+
+        // Newly visible meshes are appended after the early ones
+        for (usize i = 0; i < 4; ++i)
+        {
+            m_barrierWriter.WriteBufferBarrier(
+                *drawCallBuffers[i]->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = meshIndicesSize
+                }
+            );
+        }
+
+        m_barrierWriter
+        .WriteBufferBarrier(
+            *frustumCulledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = instanceCountsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *lateCulledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = instanceCountsSize
+            }
+        )
+        .WriteBufferBarrier(
+            m_visibilityBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        )
+        .Execute(cmdBuffer);
+
+        for (const auto* buffer : drawCallBuffers)
+        {
+            vkCmdFillBuffer
+            (
+                cmdBuffer.handle,
+                buffer->drawCallBuffer.handle,
+                0,
+                sizeof(u32),
+                0
+            );
+        }
+
+        // Snapshot of the early counts, late draws start where these end
+        const VkBufferCopy copyRegion =
+        {
+            .srcOffset = 0,
+            .dstOffset = 0,
+            .size      = instanceCountsSize
+        };
+
+        vkCmdCopyBuffer
+        (
+            cmdBuffer.handle,
+            frustumCulledBuffers.visibleInstanceCountBuffer->handle,
+            lateCulledBuffers.visibleInstanceCountBuffer->handle,
+            1,
+            &copyRegion
+        );
+
+        for (const auto* buffer : drawCallBuffers)
+        {
+            m_barrierWriter.WriteBufferBarrier(
+                buffer->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = sizeof(u32)
+                }
+            );
+        }
+
+        m_barrierWriter
+        .WriteBufferBarrier(
+            *frustumCulledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = instanceCountsSize
+            }
+        )
+        .WriteBufferBarrier(
+            *lateCulledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = instanceCountsSize
+            }
+        )
+        .Execute(cmdBuffer);
+    }
+
+    void Dispatch::Execute
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    )
+    {
+        vkCmdDispatch
+        (
+            cmdBuffer.handle,
+            GetWorkGroupCount(indirectBuffer.writtenDrawCallBuffers[FIF].writtenInstanceCount),
+            1,
+            1
+        );
+    }
+
+    void Dispatch::CompactDraws
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers,
+        VkDeviceAddress earlyInstanceCounts
+    )
+    {
+        m_barrierWriter
+        .WriteBufferBarrier(
+            *indirectBuffer.frustumCulledBuffers.visibleInstanceCountBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = sizeof(u32)
+                .size           = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount * sizeof(u32)
             }
         )
         .Execute(cmdBuffer);
 
-        return false;
+        m_compactPipeline.Bind(cmdBuffer);
+
+        const auto constants = Compact::Constants
+        {
+            .Meshes                                = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+            .Materials                             = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+            .DrawCalls                             = indirectBuffer.writtenDrawCallBuffers[FIF].drawCallBuffer.deviceAddress,
+            .Instances                             = indirectBuffer.writtenDrawCallBuffers[FIF].instanceBuffer->deviceAddress,
+            .VisibleInstanceCounts                 = indirectBuffer.frustumCulledBuffers.visibleInstanceCountBuffer->deviceAddress,
+            .CulledOpaqueDrawCalls                 = culledBuffers.opaqueBuffer.drawCallBuffer.deviceAddress,
+            .CulledOpaqueDoubleSidedDrawCalls      = culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.deviceAddress,
+            .CulledAlphaMaskedDrawCalls            = culledBuffers.alphaMaskedBuffer.drawCallBuffer.deviceAddress,
+            .CulledAlphaMaskedDoubleSidedDrawCalls = culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.deviceAddress,
+            .EarlyInstanceCounts                   = earlyInstanceCounts
+        };
+
+        m_compactPipeline.PushConstants
+        (
+            cmdBuffer,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            constants
+        );
+
+        vkCmdDispatch
+        (
+            cmdBuffer.handle,
+            GetWorkGroupCount(indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount),
+            1,
+            1
+        );
     }
 
-    void Dispatch::PreDispatch
+    void Dispatch::SortDraws
     (
         usize FIF,
-        const glm::mat4& projectionView,
+        usize frameIndex,
         const Vk::CommandBuffer& cmdBuffer,
-        const Buffers::IndirectBuffer& indirectBuffer
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
     )
     {
-        m_frustumBuffer.Load(cmdBuffer, projectionView);
+        if (!IsSortEnabled())
+        {
+            return;
+        }
+
+        const u32 drawCallCount            = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const u32 instanceCount            = indirectBuffer.writtenDrawCallBuffers[FIF].writtenInstanceCount;
+        const VkDeviceSize drawCallsSize   = sizeof(u32) + drawCallCount * sizeof(VkDrawIndexedIndirectCommand);
+        const VkDeviceSize meshIndicesSize = instanceCount * sizeof(u32);
+
+        const auto buckets = GetBuckets(culledBuffers);
+
+        for (const auto* bucket : buckets)
+        {
+            m_barrierWriter
+            .WriteBufferBarrier(
+                bucket->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = drawCallsSize
+                }
+            )
+            .WriteBufferBarrier(
+                *bucket->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = meshIndicesSize
+                }
+            );
+        }
+
+        m_barrierWriter.Execute(cmdBuffer);
+
+        m_sortPipeline->Bind(cmdBuffer);
+
+        for (const auto* bucket : buckets)
+        {
+            const auto constants = Sort::Constants
+            {
+                .Counts       = bucket->drawCallBuffer.deviceAddress,
+                .DrawCalls    = bucket->drawCallBuffer.deviceAddress + sizeof(u32),
+                .MeshIndices  = bucket->meshIndexBuffer->deviceAddress,
+                .Transforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                .Bounds       = meshBuffer.GetCurrentStreams(frameIndex).bounds.deviceAddress,
+                .Frustums     = m_frustumBuffer.buffer.deviceAddress,
+                .ListStride   = 0,
+                .ListsPerView = 1
+            };
+
+            m_sortPipeline->PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                constants
+            );
+
+            vkCmdDispatch(cmdBuffer.handle, 1, 1, 1);
+        }
+    }
 
+    void Dispatch::PostDispatch
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
+    )
+    {
         const u32 drawCallCount            = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const u32 instanceCount            = indirectBuffer.writtenDrawCallBuffers[FIF].writtenInstanceCount;
         const VkDeviceSize drawCallsSize   = sizeof(u32) + drawCallCount * sizeof(VkDrawIndexedIndirectCommand);
-        const VkDeviceSize meshIndicesSize = drawCallCount * sizeof(u32);
+        const VkDeviceSize meshIndicesSize = instanceCount * sizeof(u32);
 
         m_barrierWriter
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer,
+            culledBuffers.opaqueBuffer.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -281,12 +1987,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer,
+            *culledBuffers.opaqueBuffer.meshIndexBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -294,12 +2000,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -307,12 +2013,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer,
+            *culledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -320,12 +2026,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -333,12 +2039,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer,
+            *culledBuffers.alphaMaskedBuffer.meshIndexBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -346,12 +2052,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -359,12 +2065,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer,
+            *culledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -374,67 +2080,257 @@ namespace Renderer::Culling
         .Execute(cmdBuffer);
     }
 
-    void Dispatch::Execute
+    void Dispatch::PreClusterDispatch
     (
-        usize FIF,
+        Occlusion::Pass pass,
         const Vk::CommandBuffer& cmdBuffer,
-        const Buffers::IndirectBuffer& indirectBuffer
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices
     )
     {
-        vkCmdDispatch
-        (
-            cmdBuffer.handle,
-            GetWorkGroupCount(FIF, indirectBuffer),
-            1,
-            1
-        );
+        const bool isEarlyPass = pass == Occlusion::Pass::Early;
+
+        // The early pass starts the cluster buckets, the late pass appends to them and starts its own
+        const auto& resetBuffers = isEarlyPass ? indirectBuffer.clusterCulledBuffers : indirectBuffer.lateClusterCulledBuffers;
+
+        const std::array outputBuffers =
+        {
+            &indirectBuffer.clusterCulledBuffers,
+            &indirectBuffer.lateClusterCulledBuffers
+        };
+
+        for (const auto* culledBuffers : std::span(outputBuffers.data(), isEarlyPass ? 1 : 2))
+        {
+            for (const auto* buffer : GetBuckets(*culledBuffers))
+            {
+                m_barrierWriter
+                .WriteBufferBarrier(
+                    buffer->drawCallBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = VK_WHOLE_SIZE
+                    }
+                )
+                .WriteBufferBarrier(
+                    *buffer->meshIndexBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = VK_WHOLE_SIZE
+                    }
+                );
+            }
+        }
+
+        // The mesh buckets were just compacted
+        for (usize i = 0; i < 4; ++i)
+        {
+            m_barrierWriter
+            .WriteBufferBarrier(
+                GetBuckets(drawCalls)[i]->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            )
+            .WriteBufferBarrier(
+                *GetBuckets(meshIndices)[i]->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            );
+        }
+
+        m_barrierWriter.Execute(cmdBuffer);
+
+        for (const auto* buffer : GetBuckets(resetBuffers))
+        {
+            vkCmdFillBuffer
+            (
+                cmdBuffer.handle,
+                buffer->drawCallBuffer.handle,
+                0,
+                sizeof(u32),
+                0
+            );
+
+            m_barrierWriter.WriteBufferBarrier(
+                buffer->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = sizeof(u32)
+                }
+            );
+        }
+
+        m_barrierWriter.Execute(cmdBuffer);
     }
 
-    void Dispatch::PostDispatch
+    void Dispatch::PostClusterDispatch
+    (
+        Occlusion::Pass pass,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+    )
+    {
+        const std::array outputBuffers =
+        {
+            &indirectBuffer.clusterCulledBuffers,
+            &indirectBuffer.lateClusterCulledBuffers
+        };
+
+        for (const auto* culledBuffers : std::span(outputBuffers.data(), pass == Occlusion::Pass::Early ? 1 : 2))
+        {
+            for (const auto* buffer : GetBuckets(*culledBuffers))
+            {
+                m_barrierWriter
+                .WriteBufferBarrier(
+                    buffer->drawCallBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = VK_WHOLE_SIZE
+                    }
+                )
+                .WriteBufferBarrier(
+                    *buffer->meshIndexBuffer,
+                    Vk::BufferBarrier{
+                        .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                        .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                        .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                        .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                        .offset         = 0,
+                        .size           = VK_WHOLE_SIZE
+                    }
+                );
+            }
+        }
+
+        // Later culling passes only wait on the draw stages before rewriting the mesh buckets, chain these reads onto them
+        for (usize i = 0; i < 4; ++i)
+        {
+            m_barrierWriter
+            .WriteBufferBarrier(
+                GetBuckets(drawCalls)[i]->drawCallBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_NONE,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            )
+            .WriteBufferBarrier(
+                *GetBuckets(meshIndices)[i]->meshIndexBuffer,
+                Vk::BufferBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_NONE,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .offset         = 0,
+                    .size           = VK_WHOLE_SIZE
+                }
+            );
+        }
+
+        m_barrierWriter.Execute(cmdBuffer);
+    }
+
+    void Dispatch::PreMultiViewDispatch
     (
         usize FIF,
+        u32 viewCount,
         const Vk::CommandBuffer& cmdBuffer,
         const Buffers::IndirectBuffer& indirectBuffer
     )
     {
-        const u32 drawCallCount            = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
-        const VkDeviceSize drawCallsSize   = sizeof(u32) + drawCallCount * sizeof(VkDrawIndexedIndirectCommand);
-        const VkDeviceSize meshIndicesSize = drawCallCount * sizeof(u32);
+        const auto& viewCulledBuffers = indirectBuffer.viewCulledBuffers;
+
+        const u32 drawCallCount               = indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount;
+        const VkDeviceSize countsSize         = viewCulledBuffers.GetCountOffset(viewCount, 0);
+        const VkDeviceSize drawCallsSize      = viewCulledBuffers.GetDrawCallOffset(viewCount, 0);
+        const VkDeviceSize meshIndicesSize    = viewCount * MultiView::MAX_VIEW_INSTANCES * sizeof(u32);
+        const VkDeviceSize instanceCountsSize = viewCount * drawCallCount * sizeof(u32);
 
         m_barrierWriter
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer,
+            m_viewFrustumBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = drawCallsSize
+                .size           = viewCount * sizeof(GPU::FrustumBuffer)
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer,
+            m_viewInfoBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = meshIndicesSize
+                .size           = viewCount * sizeof(MultiView::ViewInfo)
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer,
+            viewCulledBuffers.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -442,12 +2338,12 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer,
+            viewCulledBuffers.meshIndexBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
@@ -455,46 +2351,97 @@ namespace Renderer::Culling
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer,
+            viewCulledBuffers.visibleInstanceCountBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = drawCallsSize
+                .size           = VK_WHOLE_SIZE
             }
         )
+        .Execute(cmdBuffer);
+
+        // Every view and bucket count is reset at once
+        vkCmdFillBuffer
+        (
+            cmdBuffer.handle,
+            viewCulledBuffers.drawCallBuffer.handle,
+            0,
+            countsSize,
+            0
+        );
+
+        if (instanceCountsSize != 0)
+        {
+            vkCmdFillBuffer
+            (
+                cmdBuffer.handle,
+                viewCulledBuffers.visibleInstanceCountBuffer.handle,
+                0,
+                instanceCountsSize,
+                0
+            );
+        }
+
+        m_barrierWriter
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer,
+            viewCulledBuffers.drawCallBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = meshIndicesSize
+                .size           = countsSize
             }
         )
         .WriteBufferBarrier(
-            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer,
+            viewCulledBuffers.visibleInstanceCountBuffer,
             Vk::BufferBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        )
+        .Execute(cmdBuffer);
+    }
+
+    void Dispatch::PostMultiViewDispatch
+    (
+        u32 viewCount,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer
+    )
+    {
+        const auto& viewCulledBuffers = indirectBuffer.viewCulledBuffers;
+
+        m_barrierWriter
+        .WriteBufferBarrier(
+            viewCulledBuffers.drawCallBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
                 .dstStageMask   = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
                 .dstAccessMask  = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = drawCallsSize
+                .size           = viewCulledBuffers.GetDrawCallOffset(viewCount, 0)
             }
         )
         .WriteBufferBarrier(
-            *indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer,
+            viewCulledBuffers.meshIndexBuffer,
             Vk::BufferBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
@@ -503,20 +2450,53 @@ namespace Renderer::Culling
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .offset         = 0,
-                .size           = meshIndicesSize
+                .size           = viewCount * MultiView::MAX_VIEW_INSTANCES * sizeof(u32)
             }
         )
         .Execute(cmdBuffer);
     }
 
-    u32 Dispatch::GetWorkGroupCount(usize FIF, const Buffers::IndirectBuffer& indirectBuffer)
+    std::array<const Buffers::DrawCallBuffer*, 4> Dispatch::GetBuckets(const Buffers::IndirectBuffer::CulledBuffers& culledBuffers)
+    {
+        return
+        {
+            &culledBuffers.opaqueBuffer,
+            &culledBuffers.opaqueDoubleSidedBuffer,
+            &culledBuffers.alphaMaskedBuffer,
+            &culledBuffers.alphaMaskedDoubleSidedBuffer
+        };
+    }
+
+    u32 Dispatch::GetWorkGroupCount(u32 invocationCount)
     {
-        return (indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount + CULLING_WORKGROUP_SIZE - 1) / CULLING_WORKGROUP_SIZE;
+        return (invocationCount + CULLING_WORKGROUP_SIZE - 1) / CULLING_WORKGROUP_SIZE;
     }
 
     void Dispatch::Destroy(VkDevice device, VmaAllocator allocator)
     {
+        for (const auto queryPool : m_queryPools)
+        {
+            vkDestroyQueryPool(device, queryPool, nullptr);
+        }
+
+        m_cpuCuller.Destroy(allocator);
+
+        m_visibilityBuffer.Destroy(allocator);
+        m_viewFrustumBuffer.Destroy(allocator);
+        m_viewInfoBuffer.Destroy(allocator);
+
         m_frustumBuffer.Destroy(allocator);
         m_frustumPipeline.Destroy(device);
+        m_compactPipeline.Destroy(device);
+        m_hiZPipeline.Destroy(device);
+        m_occlusionPipeline.Destroy(device);
+        m_multiViewPipeline.Destroy(device);
+        m_multiViewCompactPipeline.Destroy(device);
+        m_clusterPipeline.Destroy(device);
+
+        if (m_sortPipeline.has_value())
+        {
+            m_sortPipeline->Destroy(device);
+        }
     }
 }
\ No newline at end of file
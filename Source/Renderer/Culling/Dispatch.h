@@ -17,22 +17,48 @@
 #ifndef CULLING_DISPATCH_H
 #define CULLING_DISPATCH_H
 
+#include <optional>
+
 #include "FrustumBuffer.h"
 #include "Frustum/Pipeline.h"
+#include "Compact/Pipeline.h"
+#include "Sort/Pipeline.h"
+#include "HiZ/Pipeline.h"
+#include "Occlusion/Pipeline.h"
+#include "MultiView/Pipeline.h"
+#include "MultiViewCompact/Pipeline.h"
+#include "Cluster/Pipeline.h"
+#include "CPU/Culler.h"
 #include "Renderer/Buffers/SceneBuffer.h"
 #include "Renderer/Buffers/IndirectBuffer.h"
 #include "Renderer/Buffers/MeshBuffer.h"
+#include "Vulkan/FramebufferManager.h"
+#include "Vulkan/GeometryBuffer.h"
+#include "Culling/Occlusion.h"
+#include "Culling/MultiViewLayout.h"
 
 namespace Renderer::Culling
 {
+    enum class Backend : u8
+    {
+        GPU,
+        CPU
+    };
+
     class Dispatch
     {
     public:
-        explicit Dispatch(const Vk::Context& context);
+        Dispatch
+        (
+            const Vk::Context& context,
+            Vk::FramebufferManager& framebufferManager,
+            Vk::MegaSet& megaSet,
+            Vk::TextureManager& textureManager
+        );
 
         void Destroy(VkDevice device, VmaAllocator allocator);
 
-        void Frustum
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& Frustum
         (
             usize FIF,
             usize frameIndex,
@@ -41,18 +67,129 @@ namespace Renderer::Culling
             const Buffers::MeshBuffer& meshBuffer,
             const Buffers::IndirectBuffer& indirectBuffer
         );
+
+        // Early draws last frame's visible meshes, late draws the meshes that pass the depth pyramid but were not drawn early
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& Occlusion
+        (
+            Occlusion::Pass pass,
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Vk::TextureManager& textureManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer
+        );
+
+        // Expands visible mesh draws into one draw per visible cluster. The late pass also tests the depth pyramid,
+        // and appends to the early pass's clusters while returning only its own
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& Clusters
+        (
+            Occlusion::Pass pass,
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Vk::TextureManager& textureManager,
+            const Vk::GeometryBuffer& geometryBuffer,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+        );
+
+        // Culls every view in a single dispatch, returns false if the caller has to cull them one by one
+        [[nodiscard]] bool MultiView
+        (
+            usize FIF,
+            usize frameIndex,
+            const std::span<const glm::mat4> projectionViews,
+            const std::span<const MultiView::ViewInfo> viewInfos,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer
+        );
+
+        // Scene depth must be readable by compute shaders
+        void BuildHiZ
+        (
+            usize FIF,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Vk::TextureManager& textureManager,
+            const std::string_view sceneDepthID
+        );
+
+        // Task shaders cull clusters as they are drawn, in place of Clusters()
+        void DrawMeshTasks
+        (
+            usize FIF,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer
+        ) const;
+
+        // Moves culled buckets between the draw stages and the task shaders reading them, outside of rendering
+        void PreMeshShading
+        (
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+        ) const;
+
+        void PostMeshShading
+        (
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+        ) const;
+
+        [[nodiscard]] bool IsOcclusionCullingEnabled() const;
+        [[nodiscard]] bool IsClusterCullingEnabled() const;
+        [[nodiscard]] bool IsMeshShadingEnabled() const;
+
+        // Buckets written by the most recent call to Frustum(), Occlusion() or Clusters()
+        [[nodiscard]] const Buffers::IndirectBuffer::CulledBuffers& GetCulledBuffers() const;
+
+        // Host time spent culling last frame, zero on the GPU backend
+        [[nodiscard]] f64 GetCPUTime() const;
+
+        void ImGuiDisplay();
     private:
+        void BeginFrame
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer
+        );
+
+        void WriteTimestamp(usize FIF, const Vk::CommandBuffer& cmdBuffer);
+
         bool NeedsDispatch
         (
             usize FIF,
             const Vk::CommandBuffer& cmdBuffer,
-            const Buffers::IndirectBuffer& indirectBuffer
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
         );
 
         void PreDispatch
         (
             usize FIF,
-            const glm::mat4& projectionView,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
+        );
+
+        void PreEarlyDispatch(const Vk::CommandBuffer& cmdBuffer);
+
+        void PreLateDispatch
+        (
+            usize FIF,
             const Vk::CommandBuffer& cmdBuffer,
             const Buffers::IndirectBuffer& indirectBuffer
         );
@@ -64,17 +201,123 @@ namespace Renderer::Culling
             const Buffers::IndirectBuffer& indirectBuffer
         );
 
+        void CompactDraws
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers,
+            VkDeviceAddress earlyInstanceCounts
+        );
+
+        // Orders every bucket by nearest depth from the near plane of m_frustumBuffer
+        void SortDraws
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
+        );
+
         void PostDispatch
         (
             usize FIF,
             const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& culledBuffers
+        );
+
+        void PreClusterDispatch
+        (
+            Occlusion::Pass pass,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+        );
+
+        void PostClusterDispatch
+        (
+            Occlusion::Pass pass,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices
+        );
+
+        void PreMultiViewDispatch
+        (
+            usize FIF,
+            u32 viewCount,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer
+        );
+
+        void PostMultiViewDispatch
+        (
+            u32 viewCount,
+            const Vk::CommandBuffer& cmdBuffer,
             const Buffers::IndirectBuffer& indirectBuffer
         );
 
-        static u32 GetWorkGroupCount(usize FIF, const Buffers::IndirectBuffer& indirectBuffer);
+        [[nodiscard]] bool IsSortEnabled() const;
+
+        [[nodiscard]] static std::array<const Buffers::DrawCallBuffer*, 4> GetBuckets(const Buffers::IndirectBuffer::CulledBuffers& culledBuffers);
+
+        static u32 GetWorkGroupCount(u32 invocationCount);
+
+        Frustum::Pipeline          m_frustumPipeline;
+        Compact::Pipeline          m_compactPipeline;
+        HiZ::Pipeline              m_hiZPipeline;
+        Occlusion::Pipeline        m_occlusionPipeline;
+        MultiView::Pipeline        m_multiViewPipeline;
+        MultiViewCompact::Pipeline m_multiViewCompactPipeline;
+        Cluster::Pipeline          m_clusterPipeline;
+        Culling::FrustumBuffer     m_frustumBuffer;
+
+        // Only created when the device can fit a whole sort workgroup and its shared arrays
+        std::optional<Sort::Pipeline> m_sortPipeline = std::nullopt;
+
+        // Planes and groups of every view culled by MultiView()
+        Vk::Buffer m_viewFrustumBuffer = {};
+        Vk::Buffer m_viewInfoBuffer    = {};
+        bool       m_multiViewCulling  = true;
+
+        // One bit per mesh, persists between frames
+        Vk::Buffer m_visibilityBuffer = {};
+        bool       m_hasVisibility    = false;
+        bool       m_occlusionCulling = true;
+
+        bool m_clusterCulling = true;
+
+        bool               m_meshShading            = true;
+        bool               m_isMeshShadingSupported = false;
+        std::array<u32, 3> m_maxTaskWorkGroupCount  = {};
+        u32                m_maxTaskWorkGroupTotal  = 0;
+
+        // Front to back within each bucket, for early-Z and stable frame to frame ordering
+        bool m_sortDraws = true;
+
+        Backend     m_backend   = Backend::GPU;
+        CPU::Culler m_cpuCuller;
+
+        const Buffers::IndirectBuffer::CulledBuffers* m_culledBuffers = nullptr;
+
+        VkDevice     m_device    = VK_NULL_HANDLE;
+        VmaAllocator m_allocator = VK_NULL_HANDLE;
 
-        Frustum::Pipeline      m_frustumPipeline;
-        Culling::FrustumBuffer m_frustumBuffer;
+        // Per frame culling cost, for comparing backends
+        std::array<VkQueryPool, Vk::FRAMES_IN_FLIGHT> m_queryPools       = {};
+        std::array<u32, Vk::FRAMES_IN_FLIGHT>         m_queryCounts      = {};
+        std::array<usize, Vk::FRAMES_IN_FLIGHT>       m_frameIndices     = {};
+        f32                                           m_timestampPeriod  = 0.0f;
+        f64                                           m_gpuTime          = 0.0;
+        f64                                           m_cpuTime          = 0.0;
+        f64                                           m_cpuTimeThisFrame = 0.0;
 
         Vk::BarrierWriter m_barrierWriter = {};
     };
@@ -14,17 +14,18 @@
  * limitations under the License.
  */
 
-#ifndef IBL_SHARED_GLSL
-#define IBL_SHARED_GLSL
+#ifndef SORT_DRAWS_PIPELINE_H
+#define SORT_DRAWS_PIPELINE_H
 
-layout(buffer_reference, scalar) readonly buffer VertexBuffer
-{
-    vec3 positions[];
-};
+#include "Vulkan/Pipeline.h"
 
-layout(buffer_reference, scalar) readonly buffer MatrixBuffer
+namespace Renderer::Culling::Sort
 {
-    mat4 matrices[];
-};
+    class Pipeline : public Vk::Pipeline
+    {
+    public:
+        explicit Pipeline(const Vk::Context& context);
+    };
+}
 
-#endif
\ No newline at end of file
+#endif
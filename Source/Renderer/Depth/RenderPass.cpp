@@ -34,12 +34,21 @@ namespace Renderer::Depth
         : m_opaquePipeline(context, formatHelper),
           m_alphaMaskedPipeline(context, formatHelper, megaSet, textureManager)
     {
+        if (context.isMeshShaderSupported)
+        {
+            m_meshOpaquePipeline.emplace(context, formatHelper, megaSet, textureManager);
+            m_meshAlphaMaskedPipeline.emplace(context, formatHelper, megaSet, textureManager);
+        }
+
+        // Sampled by the graphics and async compute queues at the same time, so no per-frame copy or ownership transfer
+        const auto queueFamilies = context.queueFamilies.GetUniqueFamilies();
+
         framebufferManager.AddFramebuffer
         (
             "SceneDepth",
             Vk::FramebufferType::Depth,
             Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | Vk::FramebufferUsage::TransferSource,
+            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
             [] (const VkExtent2D& extent) -> Vk::FramebufferSize
             {
                 return
@@ -54,30 +63,8 @@ namespace Renderer::Depth
                 .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
                 .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
                 .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            }
-        );
-
-        framebufferManager.AddFramebuffer
-        (
-            "SceneDepthAsyncCompute",
-            Vk::FramebufferType::Depth,
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Sampled | Vk::FramebufferUsage::TransferDestination,
-            [] (const VkExtent2D& extent) -> Vk::FramebufferSize
-            {
-                return
-                {
-                    .width       = extent.width,
-                    .height      = extent.height,
-                    .mipLevels   = 1,
-                    .arrayLayers = 1
-                };
             },
-            {
-                .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            }
+            queueFamilies.values()
         );
 
         framebufferManager.AddFramebufferView
@@ -92,19 +79,6 @@ namespace Renderer::Depth
                 .layerCount     = 1
             }
         );
-
-        framebufferManager.AddFramebufferView
-        (
-            "SceneDepthAsyncCompute",
-            "SceneDepthAsyncComputeView",
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferViewSize{
-                .baseMipLevel   = 0,
-                .levelCount     = 1,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            }
-        );
     }
 
     void RenderPass::Render
@@ -126,16 +100,221 @@ namespace Renderer::Depth
         const auto& currentMatrices = sceneBuffer.gpuScene.currentMatrices;
         const auto  projectionView  = currentMatrices.projection * currentMatrices.view;
 
-        culling.Frustum
+        if (!culling.IsOcclusionCullingEnabled())
+        {
+            const auto& culledBuffers = culling.Frustum
+            (
+                FIF,
+                frameIndex,
+                projectionView,
+                cmdBuffer,
+                meshBuffer,
+                indirectBuffer
+            );
+
+            // Task shaders cull clusters themselves
+            const bool isClusterCulled = culling.IsClusterCullingEnabled() && !culling.IsMeshShadingEnabled();
+
+            const auto& drawBuffers = !isClusterCulled ? culledBuffers : culling.Clusters
+            (
+                Culling::Occlusion::Pass::Early,
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager.textureManager,
+                modelManager.geometryBuffer,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culledBuffers,
+                culledBuffers
+            );
+
+            RenderMeshes
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culling,
+                drawBuffers,
+                drawBuffers,
+                VK_ATTACHMENT_LOAD_OP_CLEAR,
+                false
+            );
+
+            Vk::EndLabel(cmdBuffer);
+
+            return;
+        }
+
+        const auto& earlyBuffers = culling.Occlusion
         (
+            Culling::Occlusion::Pass::Early,
             FIF,
             frameIndex,
-            projectionView,
             cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager.textureManager,
+            sceneBuffer,
             meshBuffer,
             indirectBuffer
         );
 
+        const bool isClusterCulled = culling.IsClusterCullingEnabled() && !culling.IsMeshShadingEnabled();
+
+        const auto& earlyDrawBuffers = !isClusterCulled ? earlyBuffers : culling.Clusters
+        (
+            Culling::Occlusion::Pass::Early,
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager.textureManager,
+            modelManager.geometryBuffer,
+            sceneBuffer,
+            meshBuffer,
+            indirectBuffer,
+            earlyBuffers,
+            earlyBuffers
+        );
+
+        RenderMeshes
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager,
+            sceneBuffer,
+            meshBuffer,
+            indirectBuffer,
+            culling,
+            earlyDrawBuffers,
+            earlyDrawBuffers,
+            VK_ATTACHMENT_LOAD_OP_CLEAR,
+            false
+        );
+
+        const auto& depthAttachment = framebufferManager.GetFramebuffer("SceneDepth");
+
+        depthAttachment.image.Barrier
+        (
+            cmdBuffer,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                .srcAccessMask  = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = depthAttachment.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = depthAttachment.image.arrayLayers
+            }
+        );
+
+        culling.BuildHiZ
+        (
+            FIF,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager.textureManager,
+            "SceneDepthView"
+        );
+
+        const auto& lateBuffers = culling.Occlusion
+        (
+            Culling::Occlusion::Pass::Late,
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager.textureManager,
+            sceneBuffer,
+            meshBuffer,
+            indirectBuffer
+        );
+
+        const auto& lateDrawBuffers = !isClusterCulled ? lateBuffers : culling.Clusters
+        (
+            Culling::Occlusion::Pass::Late,
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager.textureManager,
+            modelManager.geometryBuffer,
+            sceneBuffer,
+            meshBuffer,
+            indirectBuffer,
+            lateBuffers,
+            earlyBuffers
+        );
+
+        // Late mesh draws index into the same mesh indices, after the early ones. Cluster draws carry their own
+        RenderMeshes
+        (
+            FIF,
+            frameIndex,
+            cmdBuffer,
+            framebufferManager,
+            megaSet,
+            modelManager,
+            sceneBuffer,
+            meshBuffer,
+            indirectBuffer,
+            culling,
+            lateDrawBuffers,
+            isClusterCulled ? lateDrawBuffers : earlyBuffers,
+            VK_ATTACHMENT_LOAD_OP_LOAD,
+            true
+        );
+
+        Vk::EndLabel(cmdBuffer);
+    }
+
+    void RenderPass::RenderMeshes
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        Culling::Dispatch& culling,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices,
+        VkAttachmentLoadOp loadOp,
+        bool testOcclusion
+    )
+    {
+        const bool isMeshShaded = culling.IsMeshShadingEnabled();
+
+        if (isMeshShaded)
+        {
+            culling.PreMeshShading(cmdBuffer, drawCalls, meshIndices);
+        }
+
         const auto& depthAttachmentView = framebufferManager.GetFramebufferView("SceneDepthView");
         const auto& depthAttachment     = framebufferManager.GetFramebuffer(depthAttachmentView.framebuffer);
 
@@ -143,7 +322,7 @@ namespace Renderer::Depth
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
                 .dstStageMask   = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
                 .dstAccessMask  = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
@@ -167,7 +346,7 @@ namespace Renderer::Depth
             .resolveMode        = VK_RESOLVE_MODE_NONE,
             .resolveImageView   = VK_NULL_HANDLE,
             .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .loadOp             = loadOp,
             .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
             .clearValue         = {.depthStencil = {0.0f, 0x0}}
         };
@@ -177,6 +356,7 @@ namespace Renderer::Depth
             .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
             .pNext                = nullptr,
             .flags                = 0,
+            // Full image, so the clear leaves far depth outside the render extent for the depth pyramid
             .renderArea           = {
                 .offset = {0, 0},
                 .extent = {depthAttachment.image.width, depthAttachment.image.height}
@@ -195,8 +375,8 @@ namespace Renderer::Depth
         {
             .x        = 0.0f,
             .y        = 0.0f,
-            .width    = static_cast<f32>(depthAttachment.image.width),
-            .height   = static_cast<f32>(depthAttachment.image.height),
+            .width    = static_cast<f32>(sceneBuffer.renderExtent.width),
+            .height   = static_cast<f32>(sceneBuffer.renderExtent.height),
             .minDepth = 0.0f,
             .maxDepth = 1.0f
         };
@@ -206,11 +386,37 @@ namespace Renderer::Depth
         const VkRect2D scissor =
         {
             .offset = {0, 0},
-            .extent = {depthAttachment.image.width, depthAttachment.image.height}
+            .extent = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height}
         };
 
         vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
 
+        if (isMeshShaded)
+        {
+            RenderMeshTasks
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culling,
+                drawCalls,
+                meshIndices,
+                testOcclusion
+            );
+
+            vkCmdEndRendering(cmdBuffer.handle);
+
+            culling.PostMeshShading(cmdBuffer, drawCalls, meshIndices);
+
+            return;
+        }
+
         modelManager.geometryBuffer.Bind(cmdBuffer);
 
         // Opaque
@@ -228,8 +434,8 @@ namespace Renderer::Depth
                 const auto constants = Opaque::Constants
                 {
                     .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
-                    .Meshes      = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .MeshIndices = indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
+                    .Transforms  = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .MeshIndices = meshIndices.opaqueBuffer.meshIndexBuffer->deviceAddress,
                     .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress
                 };
 
@@ -237,17 +443,17 @@ namespace Renderer::Depth
                 (
                    cmdBuffer,
                    VK_SHADER_STAGE_VERTEX_BIT,
-                   constants
+                    constants
                 );
 
                 vkCmdDrawIndexedIndirectCount
                 (
                     cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
+                    drawCalls.opaqueBuffer.drawCallBuffer.handle,
                     sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
+                    drawCalls.opaqueBuffer.drawCallBuffer.handle,
                     0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
+                    drawCalls.opaqueBuffer.capacity,
                     sizeof(VkDrawIndexedIndirectCommand)
                 );
 
@@ -263,8 +469,8 @@ namespace Renderer::Depth
                 const auto constants = Opaque::Constants
                 {
                     .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
-                    .Meshes      = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .MeshIndices = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+                    .Transforms  = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .MeshIndices = meshIndices.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
                     .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress
                 };
 
@@ -272,17 +478,17 @@ namespace Renderer::Depth
                 (
                    cmdBuffer,
                    VK_SHADER_STAGE_VERTEX_BIT,
-                   constants
+                    constants
                 );
 
                 vkCmdDrawIndexedIndirectCount
                 (
                     cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+                    drawCalls.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
                     sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+                    drawCalls.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
                     0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
+                    drawCalls.opaqueDoubleSidedBuffer.capacity,
                     sizeof(VkDrawIndexedIndirectCommand)
                 );
 
@@ -310,8 +516,10 @@ namespace Renderer::Depth
                 const auto constants = AlphaMasked::Constants
                 {
                     .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .Meshes              = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
+                    .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                    .Transforms          = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                    .MeshIndices         = meshIndices.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
                     .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
                     .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
                     .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_alphaMaskedPipeline.textureSamplerID).descriptorID
@@ -321,17 +529,17 @@ namespace Renderer::Depth
                 (
                    cmdBuffer,
                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                   constants
+                    constants
                 );
 
                 vkCmdDrawIndexedIndirectCount
                 (
                     cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+                    drawCalls.alphaMaskedBuffer.drawCallBuffer.handle,
                     sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+                    drawCalls.alphaMaskedBuffer.drawCallBuffer.handle,
                     0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
+                    drawCalls.alphaMaskedBuffer.capacity,
                     sizeof(VkDrawIndexedIndirectCommand)
                 );
 
@@ -347,8 +555,10 @@ namespace Renderer::Depth
                 const auto constants = AlphaMasked::Constants
                 {
                     .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .Meshes              = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+                    .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                    .Transforms          = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                    .MeshIndices         = meshIndices.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
                     .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
                     .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
                     .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_alphaMaskedPipeline.textureSamplerID).descriptorID
@@ -358,17 +568,17 @@ namespace Renderer::Depth
                 (
                    cmdBuffer,
                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                   constants
+                    constants
                 );
 
                 vkCmdDrawIndexedIndirectCount
                 (
                     cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+                    drawCalls.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
                     sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+                    drawCalls.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
                     0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
+                    drawCalls.alphaMaskedDoubleSidedBuffer.capacity,
                     sizeof(VkDrawIndexedIndirectCommand)
                 );
 
@@ -379,13 +589,163 @@ namespace Renderer::Depth
         }
 
         vkCmdEndRendering(cmdBuffer.handle);
+    }
 
-        Vk::EndLabel(cmdBuffer);
+    void RenderPass::RenderMeshTasks
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Culling::Dispatch& culling,
+        const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+        const Buffers::IndirectBuffer::CulledBuffers& meshIndices,
+        bool testOcclusion
+    )
+    {
+        const std::array descriptorSets = {megaSet.descriptorSet};
+
+        const auto& streams  = meshBuffer.GetCurrentStreams(frameIndex);
+        const auto  hiZIndex = framebufferManager.GetFramebufferView("Culling/HiZView").sampledImageID;
+
+        // Opaque
+        {
+            Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
+
+            m_meshOpaquePipeline->Bind(cmdBuffer);
+            m_meshOpaquePipeline->BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            const std::array buckets =
+            {
+                std::pair{&drawCalls.opaqueBuffer,            &meshIndices.opaqueBuffer},
+                std::pair{&drawCalls.opaqueDoubleSidedBuffer, &meshIndices.opaqueDoubleSidedBuffer}
+            };
+
+            for (usize i = 0; i < buckets.size(); ++i)
+            {
+                const bool isDoubleSided = i == 1;
+
+                Vk::BeginLabel
+                (
+                    cmdBuffer,
+                    isDoubleSided ? "Double Sided" : "Single Sided",
+                    isDoubleSided ? glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f) : glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f)
+                );
+
+                vkCmdSetCullMode(cmdBuffer.handle, isDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT);
+
+                const auto constants = Opaque::Constants
+                {
+                    .Scene             = sceneBuffer.buffers[FIF].deviceAddress,
+                    .Transforms        = streams.transforms.deviceAddress,
+                    .MeshIndices       = buckets[i].second->meshIndexBuffer->deviceAddress,
+                    .Positions         = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                    .Meshes            = streams.meshes.deviceAddress,
+                    .DrawCalls         = buckets[i].first->drawCallBuffer.deviceAddress,
+                    .Clusters          = modelManager.geometryBuffer.GetClusterBuffer().deviceAddress,
+                    .Indices           = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress,
+                    .ViewportSize      = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+                    .PointSamplerIndex = modelManager.textureManager.GetSampler(m_meshOpaquePipeline->pointSamplerID).descriptorID,
+                    .HiZIndex          = hiZIndex,
+                    .TestOcclusion     = testOcclusion ? 1u : 0u,
+                    .CullBackFaces     = isDoubleSided ? 0u : 1u
+                };
+
+                m_meshOpaquePipeline->PushConstants
+                (
+                    cmdBuffer,
+                    VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                    constants
+                );
+
+                culling.DrawMeshTasks(FIF, cmdBuffer, indirectBuffer);
+
+                Vk::EndLabel(cmdBuffer);
+            }
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        // Alpha Masked
+        {
+            Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
+
+            m_meshAlphaMaskedPipeline->Bind(cmdBuffer);
+            m_meshAlphaMaskedPipeline->BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            const std::array buckets =
+            {
+                std::pair{&drawCalls.alphaMaskedBuffer,            &meshIndices.alphaMaskedBuffer},
+                std::pair{&drawCalls.alphaMaskedDoubleSidedBuffer, &meshIndices.alphaMaskedDoubleSidedBuffer}
+            };
+
+            for (usize i = 0; i < buckets.size(); ++i)
+            {
+                const bool isDoubleSided = i == 1;
+
+                Vk::BeginLabel
+                (
+                    cmdBuffer,
+                    isDoubleSided ? "Double Sided" : "Single Sided",
+                    isDoubleSided ? glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f) : glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f)
+                );
+
+                vkCmdSetCullMode(cmdBuffer.handle, isDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT);
+
+                const auto constants = AlphaMasked::Constants
+                {
+                    .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                    .Meshes              = streams.meshes.deviceAddress,
+                    .Transforms          = streams.transforms.deviceAddress,
+                    .Materials           = streams.materials.deviceAddress,
+                    .MeshIndices         = buckets[i].second->meshIndexBuffer->deviceAddress,
+                    .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                    .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                    .DrawCalls           = buckets[i].first->drawCallBuffer.deviceAddress,
+                    .Clusters            = modelManager.geometryBuffer.GetClusterBuffer().deviceAddress,
+                    .Indices             = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress,
+                    .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_meshAlphaMaskedPipeline->textureSamplerID).descriptorID,
+                    .ViewportSize        = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+                    .PointSamplerIndex   = modelManager.textureManager.GetSampler(m_meshAlphaMaskedPipeline->pointSamplerID).descriptorID,
+                    .HiZIndex            = hiZIndex,
+                    .TestOcclusion       = testOcclusion ? 1u : 0u,
+                    .CullBackFaces       = isDoubleSided ? 0u : 1u
+                };
+
+                m_meshAlphaMaskedPipeline->PushConstants
+                (
+                    cmdBuffer,
+                    VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                    constants
+                );
+
+                culling.DrawMeshTasks(FIF, cmdBuffer, indirectBuffer);
+
+                Vk::EndLabel(cmdBuffer);
+            }
+
+            Vk::EndLabel(cmdBuffer);
+        }
     }
 
     void RenderPass::Destroy(VkDevice device)
     {
         m_opaquePipeline.Destroy(device);
         m_alphaMaskedPipeline.Destroy(device);
+
+        if (m_meshOpaquePipeline.has_value())
+        {
+            m_meshOpaquePipeline->Destroy(device);
+        }
+
+        if (m_meshAlphaMaskedPipeline.has_value())
+        {
+            m_meshAlphaMaskedPipeline->Destroy(device);
+        }
     }
 }
@@ -19,6 +19,8 @@
 
 #include "Opaque/Pipeline.h"
 #include "AlphaMasked/Pipeline.h"
+#include "MeshOpaque/Pipeline.h"
+#include "MeshAlphaMasked/Pipeline.h"
 #include "Vulkan/GeometryBuffer.h"
 #include "Vulkan/FramebufferManager.h"
 #include "Renderer/Buffers/IndirectBuffer.h"
@@ -56,8 +58,47 @@ namespace Renderer::Depth
             Culling::Dispatch& culling
         );
     private:
+        void RenderMeshes
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            Culling::Dispatch& culling,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices,
+            VkAttachmentLoadOp loadOp,
+            bool testOcclusion
+        );
+
+        void RenderMeshTasks
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Culling::Dispatch& culling,
+            const Buffers::IndirectBuffer::CulledBuffers& drawCalls,
+            const Buffers::IndirectBuffer::CulledBuffers& meshIndices,
+            bool testOcclusion
+        );
+
         Opaque::Pipeline      m_opaquePipeline;
         AlphaMasked::Pipeline m_alphaMaskedPipeline;
+
+        // Only created on devices with mesh shaders
+        std::optional<MeshOpaque::Pipeline>      m_meshOpaquePipeline      = std::nullopt;
+        std::optional<MeshAlphaMasked::Pipeline> m_meshAlphaMaskedPipeline = std::nullopt;
     };
 }
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Util/Log.h"
+#include "Vulkan/DebugUtils.h"
+#include "Vulkan/Util.h"
+#include "Externals/ImGui.h"
+
+namespace Renderer
+{
+    constexpr f32 MIN_RENDER_SCALE = 0.25f;
+    constexpr f32 MAX_RENDER_SCALE = 1.0f;
+
+    // Frame times this close to the target leave the scale alone, stops it from oscillating
+    constexpr f32 FRAME_TIME_DEADBAND = 0.05f;
+    // Fraction of the estimated scale change applied per frame, the timings are a few frames old
+    constexpr f32 SCALE_RESPONSE = 0.25f;
+
+    DynamicResolution::DynamicResolution(const Vk::Context& context)
+        : m_device(context.device),
+          m_timestampPeriod(context.physicalDeviceLimits.timestampPeriod)
+    {
+        const VkQueryPoolCreateInfo queryPoolInfo =
+        {
+            .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .pNext              = nullptr,
+            .flags              = 0,
+            .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount         = 2,
+            .pipelineStatistics = 0
+        };
+
+        for (usize i = 0; i < m_queryPools.size(); ++i)
+        {
+            Vk::CheckResult(vkCreateQueryPool(
+                context.device,
+                &queryPoolInfo,
+                nullptr,
+                &m_queryPools[i]),
+                "Failed to create query pool!"
+            );
+
+            Vk::SetDebugName(context.device, m_queryPools[i], fmt::format("DynamicResolution/TimestampQueryPool/{}", i));
+        }
+    }
+
+    void DynamicResolution::BeginFrame(usize FIF, const Vk::CommandBuffer& cmdBuffer)
+    {
+        // This slot's previous frame has already been waited on, so its timestamps are available
+        if (m_hasTimestamps[FIF])
+        {
+            std::array<u64, 2> timestamps = {};
+
+            const VkResult result = vkGetQueryPoolResults
+            (
+                m_device,
+                m_queryPools[FIF],
+                0,
+                timestamps.size(),
+                timestamps.size() * sizeof(u64),
+                timestamps.data(),
+                sizeof(u64),
+                VK_QUERY_RESULT_64_BIT
+            );
+
+            if (result == VK_SUCCESS)
+            {
+                m_gpuTime = static_cast<f64>(timestamps[1] - timestamps[0]) * m_timestampPeriod / 1e6;
+
+                UpdateScale();
+            }
+        }
+
+        vkCmdResetQueryPool(cmdBuffer.handle, m_queryPools[FIF], 0, 2);
+        vkCmdWriteTimestamp2(cmdBuffer.handle, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[FIF], 0);
+    }
+
+    void DynamicResolution::EndFrame(usize FIF, const Vk::CommandBuffer& cmdBuffer)
+    {
+        vkCmdWriteTimestamp2(cmdBuffer.handle, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[FIF], 1);
+
+        m_hasTimestamps[FIF] = true;
+    }
+
+    void DynamicResolution::UpdateScale()
+    {
+        if (!m_isEnabled || m_gpuTime <= 0.0)
+        {
+            return;
+        }
+
+        const f32 ratio = m_targetFrameTime / static_cast<f32>(m_gpuTime);
+
+        if (std::abs(1.0f - ratio) < FRAME_TIME_DEADBAND)
+        {
+            return;
+        }
+
+        // Most of the frame is per-pixel work, which scales with the square of the render scale
+        const f32 targetScale = m_scale * std::sqrt(ratio);
+
+        m_scale = std::clamp(std::lerp(m_scale, targetScale, SCALE_RESPONSE), m_minScale, m_maxScale);
+    }
+
+    VkExtent2D DynamicResolution::GetRenderExtent(VkExtent2D extent, f32 baseScale) const
+    {
+        const f32 scale = baseScale * m_scale;
+
+        return
+        {
+            .width  = std::max(static_cast<u32>(static_cast<f32>(extent.width)  * scale), 1u),
+            .height = std::max(static_cast<u32>(static_cast<f32>(extent.height) * scale), 1u)
+        };
+    }
+
+    void DynamicResolution::ImGuiDisplay()
+    {
+        if (ImGui::BeginMainMenuBar())
+        {
+            if (ImGui::BeginMenu("Dynamic Resolution"))
+            {
+                ImGui::Checkbox("Enabled", &m_isEnabled);
+
+                if (m_isEnabled)
+                {
+                    ImGui::DragFloat("Target Frame Time", &m_targetFrameTime, 0.1f, 1.0f, 100.0f, "%.2f ms");
+                    ImGui::SliderFloat("Min Scale", &m_minScale, MIN_RENDER_SCALE, m_maxScale, "%.2f");
+                    ImGui::SliderFloat("Max Scale", &m_maxScale, m_minScale, MAX_RENDER_SCALE, "%.2f");
+
+                    m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+                }
+                else
+                {
+                    ImGui::SliderFloat("Scale", &m_scale, MIN_RENDER_SCALE, MAX_RENDER_SCALE, "%.2f");
+                }
+
+                ImGui::Separator();
+
+                ImGui::Text("Render Scale | %.2f", m_scale);
+                ImGui::Text("GPU Time     | %.4f ms", m_gpuTime);
+
+                ImGui::EndMenu();
+            }
+
+            ImGui::EndMainMenuBar();
+        }
+    }
+
+    void DynamicResolution::Destroy(VkDevice device)
+    {
+        for (const auto queryPool : m_queryPools)
+        {
+            vkDestroyQueryPool(device, queryPool, nullptr);
+        }
+    }
+}
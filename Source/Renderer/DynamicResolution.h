@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDERER_DYNAMIC_RESOLUTION_H
+#define RENDERER_DYNAMIC_RESOLUTION_H
+
+#include <array>
+
+#include "Vulkan/Context.h"
+#include "Vulkan/CommandBuffer.h"
+#include "Vulkan/Constants.h"
+#include "Util/Types.h"
+
+namespace Renderer
+{
+    // Picks the internal render scale each frame from the GPU frame time, framebuffers stay at full size
+    class DynamicResolution
+    {
+    public:
+        explicit DynamicResolution(const Vk::Context& context);
+
+        // Reads the timings of this slot's previous frame and updates the render scale
+        void BeginFrame(usize FIF, const Vk::CommandBuffer& cmdBuffer);
+        void EndFrame(usize FIF, const Vk::CommandBuffer& cmdBuffer);
+
+        [[nodiscard]] VkExtent2D GetRenderExtent(VkExtent2D extent, f32 baseScale) const;
+
+        void ImGuiDisplay();
+
+        void Destroy(VkDevice device);
+    private:
+        void UpdateScale();
+
+        bool m_isEnabled       = false;
+        f32  m_scale           = 1.0f;
+        f32  m_minScale        = 0.5f;
+        f32  m_maxScale        = 1.0f;
+        f32  m_targetFrameTime = 1000.0f / 60.0f;
+
+        std::array<VkQueryPool, Vk::FRAMES_IN_FLIGHT> m_queryPools      = {};
+        std::array<bool, Vk::FRAMES_IN_FLIGHT>        m_hasTimestamps   = {};
+        VkDevice                                      m_device          = VK_NULL_HANDLE;
+        f32                                           m_timestampPeriod = 0.0f;
+        f64                                           m_gpuTime         = 0.0;
+    };
+}
+
+#endif
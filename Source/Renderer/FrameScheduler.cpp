@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameScheduler.h"
+
+#include <algorithm>
+
+#include "Vulkan/Util.h"
+#include "Util/Log.h"
+
+namespace Renderer
+{
+    namespace
+    {
+        // Timeline semaphores only need their highest value waited on or signalled once per submission
+        void AddTimelinePoint
+        (
+            std::vector<VkSemaphoreSubmitInfo>& semaphoreInfos,
+            VkSemaphore semaphore,
+            u64 value,
+            VkPipelineStageFlags2 stageMask
+        )
+        {
+            const auto iter = std::ranges::find_if(semaphoreInfos, [semaphore] (const VkSemaphoreSubmitInfo& semaphoreInfo)
+            {
+                return semaphoreInfo.semaphore == semaphore;
+            });
+
+            if (iter != semaphoreInfos.end())
+            {
+                iter->value      = std::max(iter->value, value);
+                iter->stageMask |= stageMask;
+
+                return;
+            }
+
+            semaphoreInfos.emplace_back(VkSemaphoreSubmitInfo{
+                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext       = nullptr,
+                .semaphore   = semaphore,
+                .value       = value,
+                .stageMask   = stageMask,
+                .deviceIndex = 0
+            });
+        }
+    }
+
+    FramePassHandle FrameScheduler::AddPass(FramePass&& pass)
+    {
+        m_passes.emplace_back(std::move(pass));
+
+        return m_passes.size() - 1;
+    }
+
+    void FrameScheduler::Execute
+    (
+        usize FIF,
+        const Vk::Context& context,
+        Vk::CommandBufferAllocator& graphicsCmdBufferAllocator,
+        std::optional<Vk::CommandBufferAllocator>& computeCmdBufferAllocator
+    )
+    {
+        BuildSubmissions(computeCmdBufferAllocator.has_value());
+
+        for (usize i = 0; i < m_submissions.size(); ++i)
+        {
+            Submit
+            (
+                FIF,
+                context,
+                m_submissions[i].queue == QueueAffinity::AsyncCompute ? *computeCmdBufferAllocator : graphicsCmdBufferAllocator,
+                i
+            );
+        }
+
+        m_passes.clear();
+        m_submissions.clear();
+        m_passSubmissions.clear();
+    }
+
+    void FrameScheduler::BuildSubmissions(bool hasAsyncCompute)
+    {
+        for (usize i = 0; i < m_passes.size(); ++i)
+        {
+            const auto& pass  = m_passes[i];
+            const auto  queue = hasAsyncCompute ? pass.affinity : QueueAffinity::Graphics;
+
+            for (const auto& dependency : pass.dependencies)
+            {
+                if (dependency.pass >= i)
+                {
+                    Logger::Error("Pass depends on a later pass! [Pass={}] [Dependency={}]\n", pass.name, dependency.pass);
+                }
+            }
+
+            // Merging is only safe while every dependency is already inside the submission, the passes' own barriers cover those
+            const bool canMerge = !m_submissions.empty() &&
+                                  m_submissions.back().queue == queue &&
+                                  pass.waits.empty() &&
+                                  std::ranges::all_of(pass.dependencies, [this] (const FramePassDependency& dependency)
+                                  {
+                                      return dependency.pass >= m_submissions.back().first;
+                                  });
+
+            if (canMerge)
+            {
+                m_submissions.back().last = i + 1;
+            }
+            else
+            {
+                m_submissions.emplace_back(Submission{
+                    .queue = queue,
+                    .first = i,
+                    .last  = i + 1
+                });
+            }
+
+            m_passSubmissions.emplace_back(m_submissions.size() - 1);
+        }
+    }
+
+    void FrameScheduler::Submit
+    (
+        usize FIF,
+        const Vk::Context& context,
+        Vk::CommandBufferAllocator& cmdBufferAllocator,
+        usize submissionIndex
+    )
+    {
+        const auto& submission = m_submissions[submissionIndex];
+
+        std::vector<VkSemaphoreSubmitInfo> waitSemaphoreInfos   = m_passes[submission.first].waits;
+        std::vector<VkSemaphoreSubmitInfo> signalSemaphoreInfos = {};
+
+        const auto cmdBuffer = cmdBufferAllocator.AllocateCommandBuffer(FIF, context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        cmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+        for (usize i = submission.first; i < submission.last; ++i)
+        {
+            const auto& pass = m_passes[i];
+
+            for (const auto& dependency : pass.dependencies)
+            {
+                const usize producerSubmission = m_passSubmissions[dependency.pass];
+
+                if (producerSubmission == submissionIndex)
+                {
+                    continue;
+                }
+
+                const auto& producer = m_passes[dependency.pass];
+
+                if (producer.semaphore == VK_NULL_HANDLE)
+                {
+                    Logger::Error("Dependency has no timeline to wait on! [Pass={}] [Dependency={}]\n", pass.name, producer.name);
+                }
+
+                AddTimelinePoint(waitSemaphoreInfos, producer.semaphore, producer.signalValue, dependency.stageMask);
+
+                if (m_submissions[producerSubmission].queue != submission.queue && dependency.Acquire)
+                {
+                    dependency.Acquire(cmdBuffer);
+                }
+            }
+
+            pass.Record(cmdBuffer);
+
+            // Hand resources over to later passes that landed on the other queue
+            for (usize j = i + 1; j < m_passes.size(); ++j)
+            {
+                if (m_submissions[m_passSubmissions[j]].queue == submission.queue)
+                {
+                    continue;
+                }
+
+                for (const auto& dependency : m_passes[j].dependencies)
+                {
+                    if (dependency.pass == i && dependency.Release)
+                    {
+                        dependency.Release(cmdBuffer);
+                    }
+                }
+            }
+
+            if (pass.semaphore != VK_NULL_HANDLE)
+            {
+                AddTimelinePoint(signalSemaphoreInfos, pass.semaphore, pass.signalValue, pass.signalStages);
+            }
+        }
+
+        cmdBuffer.EndRecording();
+
+        const VkCommandBufferSubmitInfo cmdBufferInfo =
+        {
+            .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+            .pNext         = nullptr,
+            .commandBuffer = cmdBuffer.handle,
+            .deviceMask    = 0
+        };
+
+        const VkSubmitInfo2 submitInfo =
+        {
+            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .pNext                    = nullptr,
+            .flags                    = 0,
+            .waitSemaphoreInfoCount   = static_cast<u32>(waitSemaphoreInfos.size()),
+            .pWaitSemaphoreInfos      = waitSemaphoreInfos.data(),
+            .commandBufferInfoCount   = 1,
+            .pCommandBufferInfos      = &cmdBufferInfo,
+            .signalSemaphoreInfoCount = static_cast<u32>(signalSemaphoreInfos.size()),
+            .pSignalSemaphoreInfos    = signalSemaphoreInfos.data()
+        };
+
+        Vk::CheckResult(vkQueueSubmit2(
+            submission.queue == QueueAffinity::AsyncCompute ? context.computeQueue : context.graphicsQueue,
+            1,
+            &submitInfo,
+            VK_NULL_HANDLE),
+            "Failed to submit frame pass!"
+        );
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDERER_FRAME_SCHEDULER_H
+#define RENDERER_FRAME_SCHEDULER_H
+
+#include <vector>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+#include "Vulkan/Context.h"
+#include "Vulkan/CommandBuffer.h"
+#include "Vulkan/CommandBufferAllocator.h"
+#include "Util/Types.h"
+
+namespace Renderer
+{
+    enum class QueueAffinity : u8
+    {
+        Graphics,
+        // Falls back to the graphics queue on devices without a separate compute family
+        AsyncCompute
+    };
+
+    using FramePassHandle = usize;
+    using FramePassRecord = std::function<void(const Vk::CommandBuffer&)>;
+
+    struct FramePassDependency
+    {
+        FramePassHandle       pass      = 0;
+        VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_NONE;
+        // Ownership transfers, only recorded when the two passes end up on different queues
+        FramePassRecord       Release   = {};
+        FramePassRecord       Acquire   = {};
+    };
+
+    struct FramePass
+    {
+        std::string_view                   name         = {};
+        QueueAffinity                      affinity     = QueueAffinity::Graphics;
+        FramePassRecord                    Record       = {};
+        std::vector<FramePassDependency>   dependencies = {};
+        // Waits on work outside the frame, like the swapchain image acquire
+        std::vector<VkSemaphoreSubmitInfo> waits        = {};
+        // Timeline point signalled once the pass completes, required if a pass on another submission depends on it
+        VkSemaphore                        semaphore    = VK_NULL_HANDLE;
+        u64                                signalValue  = 0;
+        VkPipelineStageFlags2              signalStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    };
+
+    // Splits a frame's passes into graphics and async compute submissions. Consecutive passes on the
+    // same queue share a command buffer until one needs a timeline wait
+    class FrameScheduler
+    {
+    public:
+        FramePassHandle AddPass(FramePass&& pass);
+
+        void Execute
+        (
+            usize FIF,
+            const Vk::Context& context,
+            Vk::CommandBufferAllocator& graphicsCmdBufferAllocator,
+            std::optional<Vk::CommandBufferAllocator>& computeCmdBufferAllocator
+        );
+    private:
+        struct Submission
+        {
+            QueueAffinity queue = QueueAffinity::Graphics;
+            usize         first = 0;
+            usize         last  = 0;
+        };
+
+        void BuildSubmissions(bool hasAsyncCompute);
+
+        void Submit
+        (
+            usize FIF,
+            const Vk::Context& context,
+            Vk::CommandBufferAllocator& cmdBufferAllocator,
+            usize submissionIndex
+        );
+
+        std::vector<FramePass>  m_passes          = {};
+        std::vector<Submission> m_submissions     = {};
+        // Index into m_submissions for every pass
+        std::vector<usize>      m_passSubmissions = {};
+    };
+}
+
+#endif
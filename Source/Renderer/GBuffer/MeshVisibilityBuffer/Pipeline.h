@@ -14,31 +14,29 @@
  * limitations under the License.
  */
 
-#ifndef POINT_SHADOW_MAP_GLSL
-#define POINT_SHADOW_MAP_GLSL
+#ifndef GBUFFER_MESH_VISIBILITY_BUFFER_PIPELINE_H
+#define GBUFFER_MESH_VISIBILITY_BUFFER_PIPELINE_H
 
-#include "Lights.h"
+#include "Vulkan/Pipeline.h"
+#include "Vulkan/MegaSet.h"
+#include "Vulkan/FormatHelper.h"
+#include "Vulkan/TextureManager.h"
 
-float CalculatePointShadow
-(
-    uint lightIndex,
-    ShadowedPointLight light,
-    vec3 fragPosition,
-    textureCubeArray pointShadowMap,
-    sampler pointShadowSampler
-)
+namespace Renderer::GBuffer::MeshVisibilityBuffer
 {
-    vec3  fragToLight     = fragPosition - light.position;
-    float currentDistance = length(fragToLight);
+    class Pipeline : public Vk::Pipeline
+    {
+    public:
+        Pipeline
+        (
+            const Vk::Context& context,
+            const Vk::FormatHelper& formatHelper,
+            Vk::MegaSet& megaSet,
+            Vk::TextureManager& textureManager
+        );
 
-    float shadow = texture
-    (
-        samplerCubeArrayShadow(pointShadowMap, pointShadowSampler),
-        vec4(fragToLight, lightIndex),
-        currentDistance - POINT_SHADOW_BIAS
-    );
-
-    return shadow;
+        Vk::SamplerID pointSamplerID = 0;
+    };
 }
 
-#endif
\ No newline at end of file
+#endif
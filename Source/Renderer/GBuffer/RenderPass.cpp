@@ -16,12 +16,25 @@
 
 #include "RenderPass.h"
 
+#include <algorithm>
+
 #include "Util/Log.h"
 #include "Vulkan/DebugUtils.h"
+#include "Vulkan/Util.h"
+#include "Externals/ImGui.h"
 #include "Deferred/GBuffer.h"
+#include "Deferred/VisibilityBuffer/Raster.h"
+#include "Deferred/VisibilityBuffer/Resolve.h"
 
 namespace Renderer::GBuffer
 {
+    // Albedo + reflectance, packed normal + roughness + metallic, RGB9E5 emmisive and motion vectors
+    constexpr u32 G_BUFFER_BYTES_WRITTEN = 4 + 4 + 4 + 4;
+    // Lighting reads every target but motion vectors, VBGTAO and RT shadows read normals, TAA reads motion vectors
+    constexpr u32 G_BUFFER_BYTES_READ = (4 + 4 + 4) + 4 + 4 + 4;
+    // Visibility buffer mode also writes and resolves the visibility buffer
+    constexpr u32 VISIBILITY_BUFFER_BYTES = 4 + 4;
+
     RenderPass::RenderPass
     (
         const Vk::Context& context,
@@ -31,60 +44,91 @@ namespace Renderer::GBuffer
         Vk::TextureManager& textureManager
     )
         : m_singleSidedPipeline(context, formatHelper, megaSet, textureManager),
-          m_doubleSidedPipeline(context, formatHelper, megaSet, textureManager)
+          m_doubleSidedPipeline(context, formatHelper, megaSet, textureManager),
+          m_resolvePipeline(context, megaSet, textureManager),
+          m_device(context.device),
+          m_timestampPeriod(context.physicalDeviceLimits.timestampPeriod)
     {
-        framebufferManager.AddFramebuffer
-        (
-            "GAlbedoReflectance",
-            Vk::FramebufferType::ColorRGBA_UNorm8,
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
-            [] (const VkExtent2D& extent) -> Vk::FramebufferSize
-            {
-                return
-                {
-                    .width       = extent.width,
-                    .height      = extent.height,
-                    .mipLevels   = 1,
-                    .arrayLayers = 1
-                };
-            },
-            Vk::FramebufferInitialState{
-                .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            }
-        );
+        if (context.isMeshShaderSupported)
+        {
+            m_meshSingleSidedPipeline.emplace(context, formatHelper, megaSet, textureManager);
+            m_meshDoubleSidedPipeline.emplace(context, formatHelper, megaSet, textureManager);
+        }
 
-        framebufferManager.AddFramebuffer
-        (
-            "GNormal",
-            Vk::FramebufferType::ColorRG_Unorm16,
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | Vk::FramebufferUsage::TransferSource,
-            [] (const VkExtent2D& extent) -> Vk::FramebufferSize
+        constexpr std::array G_BUFFER_FORMATS =
+        {
+            VK_FORMAT_R8G8B8A8_UNORM,
+            VK_FORMAT_R32_UINT,
+            VK_FORMAT_R16G16_SFLOAT
+        };
+
+        const bool hasStorageFormats = std::all_of(G_BUFFER_FORMATS.begin(), G_BUFFER_FORMATS.end(), [&context] (VkFormat format)
+        {
+            return Vk::FormatHelper::IsFormatSupported
+            (
+                context.physicalDevice,
+                format,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT
+            );
+        });
+
+        if (!hasStorageFormats)
+        {
+            Logger::Warning("{}\n", "GBuffer formats do not support storage writes, visibility buffer mode disabled!");
+        }
+
+        if (!context.isGeometryShaderSupported)
+        {
+            Logger::Warning("{}\n", "Geometry shaders are not supported, visibility buffer mode disabled!");
+        }
+
+        m_isVisibilityBufferSupported = hasStorageFormats && context.isGeometryShaderSupported;
+
+        if (m_isVisibilityBufferSupported)
+        {
+            m_visibilityBufferPipeline.emplace(context, formatHelper);
+
+            if (context.isMeshShaderSupported)
             {
-                return
-                {
-                    .width       = extent.width,
-                    .height      = extent.height,
-                    .mipLevels   = 1,
-                    .arrayLayers = 1
-                };
-            },
-            Vk::FramebufferInitialState{
-                .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                m_meshVisibilityBufferPipeline.emplace(context, formatHelper, megaSet, textureManager);
             }
-        );
+        }
+
+        const auto storageUsage = m_isVisibilityBufferSupported ? Vk::FramebufferUsage::Storage : Vk::FramebufferUsage::None;
+
+        // VBGTAO samples the normals on the async compute queue while ray dispatch reads them on the graphics queue
+        const auto queueFamilies = context.queueFamilies.GetUniqueFamilies();
+
+        const VkQueryPoolCreateInfo queryPoolInfo =
+        {
+            .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .pNext              = nullptr,
+            .flags              = 0,
+            .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount         = 2,
+            .pipelineStatistics = 0
+        };
+
+        for (usize i = 0; i < m_queryPools.size(); ++i)
+        {
+            Vk::CheckResult(vkCreateQueryPool(
+                context.device,
+                &queryPoolInfo,
+                nullptr,
+                &m_queryPools[i]),
+                "Failed to create query pool!"
+            );
+
+            Vk::SetDebugName(context.device, m_queryPools[i], fmt::format("GBuffer/TimestampQueryPool/{}", i));
+        }
 
         framebufferManager.AddFramebuffer
         (
-            "GNormalAsyncCompute",
-            Vk::FramebufferType::ColorRG_Unorm16,
+            "GAlbedoReflectance",
+            Vk::FramebufferType::ColorRGBA_UNorm8,
             Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Sampled | Vk::FramebufferUsage::TransferDestination,
+            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | storageUsage,
             [] (const VkExtent2D& extent) -> Vk::FramebufferSize
             {
                 return
@@ -102,12 +146,13 @@ namespace Renderer::GBuffer
             }
         );
 
+        // Octahedral normal, roughness and metallic, see PackNormalRoughnessMetallic
         framebufferManager.AddFramebuffer
         (
-            "GRoughnessMetallic",
-            Vk::FramebufferType::ColorRG_Unorm8,
+            "GNormal",
+            Vk::FramebufferType::ColorR_Uint32,
             Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
+            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | storageUsage,
             [] (const VkExtent2D& extent) -> Vk::FramebufferSize
             {
                 return
@@ -122,15 +167,17 @@ namespace Renderer::GBuffer
                 .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
                 .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
                 .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            }
+            },
+            queueFamilies.values()
         );
 
+        // Shared exponent RGB9E5
         framebufferManager.AddFramebuffer
         (
             "GEmmisive",
-            Vk::FramebufferType::ColorBGR_SFloat_10_11_11,
+            Vk::FramebufferType::ColorR_Uint32,
             Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
+            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | storageUsage,
             [] (const VkExtent2D& extent) -> Vk::FramebufferSize
             {
                 return
@@ -153,7 +200,7 @@ namespace Renderer::GBuffer
             "GMotionVectors",
             Vk::FramebufferType::ColorRG_SFloat16,
             Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
+            Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled | storageUsage,
             [] (const VkExtent2D& extent) -> Vk::FramebufferSize
             {
                 return
@@ -197,32 +244,6 @@ namespace Renderer::GBuffer
             }
         );
 
-        framebufferManager.AddFramebufferView
-        (
-            "GNormalAsyncCompute",
-            "GNormalAsyncComputeView",
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferViewSize{
-                .baseMipLevel   = 0,
-                .levelCount     = 1,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            }
-        );
-
-        framebufferManager.AddFramebufferView
-        (
-            "GRoughnessMetallic",
-            "GRoughnessMetallicView",
-            Vk::FramebufferImageType::Single2D,
-            Vk::FramebufferViewSize{
-                .baseMipLevel   = 0,
-                .levelCount     = 1,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            }
-        );
-
         framebufferManager.AddFramebufferView
         (
             "GEmmisive",
@@ -248,6 +269,45 @@ namespace Renderer::GBuffer
                 .layerCount     = 1
             }
         );
+
+        if (m_isVisibilityBufferSupported)
+        {
+            framebufferManager.AddFramebuffer
+            (
+                "VisibilityBuffer",
+                Vk::FramebufferType::ColorRG_Uint32,
+                Vk::FramebufferImageType::Single2D,
+                Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
+                [] (const VkExtent2D& extent) -> Vk::FramebufferSize
+                {
+                    return
+                    {
+                        .width       = extent.width,
+                        .height      = extent.height,
+                        .mipLevels   = 1,
+                        .arrayLayers = 1
+                    };
+                },
+                Vk::FramebufferInitialState{
+                    .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    .initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                }
+            );
+
+            framebufferManager.AddFramebufferView
+            (
+                "VisibilityBuffer",
+                "VisibilityBufferView",
+                Vk::FramebufferImageType::Single2D,
+                Vk::FramebufferViewSize{
+                    .baseMipLevel   = 0,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                }
+            );
+        }
     }
 
     void RenderPass::Render
@@ -260,21 +320,104 @@ namespace Renderer::GBuffer
         const Models::ModelManager& modelManager,
         const Buffers::SceneBuffer& sceneBuffer,
         const Buffers::MeshBuffer& meshBuffer,
-        const Buffers::IndirectBuffer& indirectBuffer
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Culling::Dispatch& culling
+    )
+    {
+        m_pixelCount = static_cast<u64>(sceneBuffer.renderExtent.width) * sceneBuffer.renderExtent.height;
+
+        // This slot's previous frame has already been waited on, so its timestamps are available
+        if (m_hasTimestamps[FIF])
+        {
+            std::array<u64, 2> timestamps = {};
+
+            const VkResult result = vkGetQueryPoolResults
+            (
+                m_device,
+                m_queryPools[FIF],
+                0,
+                timestamps.size(),
+                timestamps.size() * sizeof(u64),
+                timestamps.data(),
+                sizeof(u64),
+                VK_QUERY_RESULT_64_BIT
+            );
+
+            if (result == VK_SUCCESS)
+            {
+                m_gpuTime = static_cast<f64>(timestamps[1] - timestamps[0]) * m_timestampPeriod / 1e6;
+            }
+        }
+
+        vkCmdResetQueryPool(cmdBuffer.handle, m_queryPools[FIF], 0, 2);
+        vkCmdWriteTimestamp2(cmdBuffer.handle, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[FIF], 0);
+
+        if (m_mode == Mode::VisibilityBuffer && m_isVisibilityBufferSupported)
+        {
+            RenderVisibilityBuffer
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culling
+            );
+        }
+        else
+        {
+            RenderGBuffer
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culling
+            );
+        }
+
+        vkCmdWriteTimestamp2(cmdBuffer.handle, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_queryPools[FIF], 1);
+
+        m_hasTimestamps[FIF] = true;
+    }
+
+    void RenderPass::RenderGBuffer
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Culling::Dispatch& culling
     )
     {
         Vk::BeginLabel(cmdBuffer, "GBuffer Generation", glm::vec4(0.5098f, 0.1243f, 0.4549f, 1.0f));
 
+        // Reuses the camera buckets from the depth pre-pass, these are cluster draws when cluster culling ran
+        const auto& culledBuffers = culling.GetCulledBuffers();
+        const bool  isMeshShaded  = culling.IsMeshShadingEnabled();
+
         const auto& gAlbedoView        = framebufferManager.GetFramebufferView("GAlbedoReflectanceView");
         const auto& gNormalView        = framebufferManager.GetFramebufferView("GNormalView");
-        const auto& gRghMtlView        = framebufferManager.GetFramebufferView("GRoughnessMetallicView");
         const auto& gEmmisiveView      = framebufferManager.GetFramebufferView("GEmmisiveView");
         const auto& gMotionVectorsView = framebufferManager.GetFramebufferView("GMotionVectorsView");
         const auto& sceneDepthView     = framebufferManager.GetFramebufferView("SceneDepthView");
 
         const auto& gAlbedo        = framebufferManager.GetFramebuffer(gAlbedoView.framebuffer);
         const auto& gNormal        = framebufferManager.GetFramebuffer(gNormalView.framebuffer);
-        const auto& gRghMtl        = framebufferManager.GetFramebuffer(gRghMtlView.framebuffer);
         const auto& gEmmisive      = framebufferManager.GetFramebuffer(gEmmisiveView.framebuffer);
         const auto& gMotionVectors = framebufferManager.GetFramebuffer(gMotionVectorsView.framebuffer);
         const auto& sceneDepth     = framebufferManager.GetFramebuffer(sceneDepthView.framebuffer);
@@ -316,23 +459,6 @@ namespace Renderer::GBuffer
                 .layerCount     = gNormal.image.arrayLayers
             }
         )
-        .WriteImageBarrier(
-            gRghMtl.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = gRghMtl.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gRghMtl.image.arrayLayers
-            }
-        )
         .WriteImageBarrier(
             gEmmisive.image,
             Vk::ImageBarrier{
@@ -397,20 +523,6 @@ namespace Renderer::GBuffer
             .clearValue         = {{{0.0f, 0.0f, 0.0f, 0.0f}}}
         };
 
-        const VkRenderingAttachmentInfo gRghMtlInfo =
-        {
-            .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-            .pNext              = nullptr,
-            .imageView          = gRghMtlView.view.handle,
-            .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            .resolveMode        = VK_RESOLVE_MODE_NONE,
-            .resolveImageView   = VK_NULL_HANDLE,
-            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR,
-            .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-            .clearValue         = {{{0.0f, 0.0f, 0.0f, 0.0f}}}
-        };
-
         const VkRenderingAttachmentInfo gEmmisiveInfo =
         {
             .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
@@ -457,7 +569,6 @@ namespace Renderer::GBuffer
         {
             gAlbedoInfo,
             gNormalInfo,
-            gRghMtlInfo,
             gEmmisiveInfo,
             gMotionVectorsInfo
         };
@@ -479,14 +590,19 @@ namespace Renderer::GBuffer
             .pStencilAttachment   = nullptr
         };
 
+        if (isMeshShaded)
+        {
+            culling.PreMeshShading(cmdBuffer, culledBuffers, culledBuffers);
+        }
+
         vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
 
         const VkViewport viewport =
         {
             .x        = 0.0f,
             .y        = 0.0f,
-            .width    = static_cast<f32>(gAlbedo.image.width),
-            .height   = static_cast<f32>(gAlbedo.image.height),
+            .width    = static_cast<f32>(sceneBuffer.renderExtent.width),
+            .height   = static_cast<f32>(sceneBuffer.renderExtent.height),
             .minDepth = 0.0f,
             .maxDepth = 1.0f
         };
@@ -496,183 +612,215 @@ namespace Renderer::GBuffer
         const VkRect2D scissor =
         {
             .offset = {0, 0},
-            .extent = {gAlbedo.image.width, gAlbedo.image.height}
+            .extent = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height}
         };
 
         vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
 
-        modelManager.geometryBuffer.Bind(cmdBuffer);
-
-        // Single Sided
+        if (isMeshShaded)
         {
-            Vk::BeginLabel(cmdBuffer, "Single Sided", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
-
-            m_singleSidedPipeline.Bind(cmdBuffer);
-
-            const std::array descriptorSets = {megaSet.descriptorSet};
-            m_singleSidedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
-
-            // Opaque
-            {
-                Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
-
-                const auto constants = GBuffer::Constants
-                {
-                    .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .CurrentMeshes       = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .PreviousMeshes      = meshBuffer.GetPreviousBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
-                    .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                    .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                    .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_singleSidedPipeline.textureSamplerID).descriptorID
-                };
-
-                m_singleSidedPipeline.PushConstants
-                (
-                    cmdBuffer,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    constants
-                );
-
-                vkCmdDrawIndexedIndirectCount
-                (
-                    cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
-                    sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
-                    0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                    sizeof(VkDrawIndexedIndirectCommand)
-                );
-
-                Vk::EndLabel(cmdBuffer);
-            }
-
-            // Alpha Masked
-            {
-                Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
-
-                const auto constants = GBuffer::Constants
-                {
-                    .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .CurrentMeshes       = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .PreviousMeshes      = meshBuffer.GetPreviousBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
-                    .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                    .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                    .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_singleSidedPipeline.textureSamplerID).descriptorID
-                };
-
-                m_singleSidedPipeline.PushConstants
-                (
-                    cmdBuffer,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    constants
-                );
-
-                vkCmdDrawIndexedIndirectCount
-                (
-                    cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
-                    sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
-                    0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                    sizeof(VkDrawIndexedIndirectCommand)
-                );
-
-                Vk::EndLabel(cmdBuffer);
-            }
-
-            Vk::EndLabel(cmdBuffer);
+            RenderMeshTasks
+            (
+                FIF,
+                frameIndex,
+                cmdBuffer,
+                framebufferManager,
+                megaSet,
+                modelManager,
+                sceneBuffer,
+                meshBuffer,
+                indirectBuffer,
+                culling
+            );
         }
-
-        // Double Sided
+        else
         {
-            Vk::BeginLabel(cmdBuffer, "Double Sided", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
-
-            m_doubleSidedPipeline.Bind(cmdBuffer);
-
-            const std::array descriptorSets = {megaSet.descriptorSet};
-            m_doubleSidedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+            modelManager.geometryBuffer.Bind(cmdBuffer);
 
-            // Opaque
+            // Single Sided
             {
-                Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
+                Vk::BeginLabel(cmdBuffer, "Single Sided", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
 
-                const auto constants = GBuffer::Constants
-                {
-                    .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .CurrentMeshes       = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .PreviousMeshes      = meshBuffer.GetPreviousBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
-                    .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                    .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                    .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_doubleSidedPipeline.textureSamplerID).descriptorID
-                };
+                m_singleSidedPipeline.Bind(cmdBuffer);
 
-                m_doubleSidedPipeline.PushConstants
-                (
-                    cmdBuffer,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    constants
-                );
+                const std::array descriptorSets = {megaSet.descriptorSet};
+                m_singleSidedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
 
-                vkCmdDrawIndexedIndirectCount
-                (
-                    cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
-                    sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
-                    0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                    sizeof(VkDrawIndexedIndirectCommand)
-                );
+                // Opaque
+                {
+                    Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
+
+                    const auto constants = GBuffer::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .CurrentTransforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .PreviousTransforms  = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = culledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_singleSidedPipeline.textureSamplerID).descriptorID
+                    };
+
+                    m_singleSidedPipeline.PushConstants
+                    (
+                        cmdBuffer,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        constants
+                    );
+
+                    vkCmdDrawIndexedIndirectCount
+                    (
+                        cmdBuffer.handle,
+                        culledBuffers.opaqueBuffer.drawCallBuffer.handle,
+                        sizeof(u32),
+                        culledBuffers.opaqueBuffer.drawCallBuffer.handle,
+                        0,
+                        culledBuffers.opaqueBuffer.capacity,
+                        sizeof(VkDrawIndexedIndirectCommand)
+                    );
+
+                    Vk::EndLabel(cmdBuffer);
+                }
+
+                // Alpha Masked
+                {
+                    Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
+
+                    const auto constants = GBuffer::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .CurrentTransforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .PreviousTransforms  = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = culledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_singleSidedPipeline.textureSamplerID).descriptorID
+                    };
+
+                    m_singleSidedPipeline.PushConstants
+                    (
+                        cmdBuffer,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        constants
+                    );
+
+                    vkCmdDrawIndexedIndirectCount
+                    (
+                        cmdBuffer.handle,
+                        culledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+                        sizeof(u32),
+                        culledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
+                        0,
+                        culledBuffers.alphaMaskedBuffer.capacity,
+                        sizeof(VkDrawIndexedIndirectCommand)
+                    );
+
+                    Vk::EndLabel(cmdBuffer);
+                }
 
                 Vk::EndLabel(cmdBuffer);
             }
 
-            // Alpha Masked
+            // Double Sided
             {
-                Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
+                Vk::BeginLabel(cmdBuffer, "Double Sided", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
 
-                const auto constants = GBuffer::Constants
-                {
-                    .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                    .CurrentMeshes       = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                    .PreviousMeshes      = meshBuffer.GetPreviousBuffer(frameIndex).deviceAddress,
-                    .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
-                    .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                    .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                    .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_doubleSidedPipeline.textureSamplerID).descriptorID
-                };
+                m_doubleSidedPipeline.Bind(cmdBuffer);
 
-                m_doubleSidedPipeline.PushConstants
-                (
-                    cmdBuffer,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    constants
-                );
+                const std::array descriptorSets = {megaSet.descriptorSet};
+                m_doubleSidedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
 
-                vkCmdDrawIndexedIndirectCount
-                (
-                    cmdBuffer.handle,
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
-                    sizeof(u32),
-                    indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
-                    0,
-                    indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                    sizeof(VkDrawIndexedIndirectCommand)
-                );
+                // Opaque
+                {
+                    Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
+
+                    const auto constants = GBuffer::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .CurrentTransforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .PreviousTransforms  = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = culledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_doubleSidedPipeline.textureSamplerID).descriptorID
+                    };
+
+                    m_doubleSidedPipeline.PushConstants
+                    (
+                        cmdBuffer,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        constants
+                    );
+
+                    vkCmdDrawIndexedIndirectCount
+                    (
+                        cmdBuffer.handle,
+                        culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+                        sizeof(u32),
+                        culledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
+                        0,
+                        culledBuffers.opaqueDoubleSidedBuffer.capacity,
+                        sizeof(VkDrawIndexedIndirectCommand)
+                    );
+
+                    Vk::EndLabel(cmdBuffer);
+                }
+
+                // Alpha Masked
+                {
+                    Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
+
+                    const auto constants = GBuffer::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .CurrentTransforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .PreviousTransforms  = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = culledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_doubleSidedPipeline.textureSamplerID).descriptorID
+                    };
+
+                    m_doubleSidedPipeline.PushConstants
+                    (
+                        cmdBuffer,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        constants
+                    );
+
+                    vkCmdDrawIndexedIndirectCount
+                    (
+                        cmdBuffer.handle,
+                        culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+                        sizeof(u32),
+                        culledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
+                        0,
+                        culledBuffers.alphaMaskedDoubleSidedBuffer.capacity,
+                        sizeof(VkDrawIndexedIndirectCommand)
+                    );
+
+                    Vk::EndLabel(cmdBuffer);
+                }
 
                 Vk::EndLabel(cmdBuffer);
             }
-
-            Vk::EndLabel(cmdBuffer);
         }
 
         vkCmdEndRendering(cmdBuffer.handle);
 
+        if (isMeshShaded)
+        {
+            culling.PostMeshShading(cmdBuffer, culledBuffers, culledBuffers);
+        }
+
         barrierWriter
         .WriteImageBarrier(
             gAlbedo.image,
@@ -709,7 +857,7 @@ namespace Renderer::GBuffer
             }
         )
         .WriteImageBarrier(
-            gRghMtl.image,
+            gEmmisive.image,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
@@ -720,13 +868,13 @@ namespace Renderer::GBuffer
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = gRghMtl.image.mipLevels,
+                .levelCount     = gEmmisive.image.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = gRghMtl.image.arrayLayers
+                .layerCount     = gEmmisive.image.arrayLayers
             }
         )
         .WriteImageBarrier(
-            gEmmisive.image,
+            gMotionVectors.image,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
@@ -737,26 +885,295 @@ namespace Renderer::GBuffer
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = gEmmisive.image.mipLevels,
+                .levelCount     = gMotionVectors.image.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = gEmmisive.image.arrayLayers
+                .layerCount     = gMotionVectors.image.arrayLayers
             }
         )
         .WriteImageBarrier(
-            gMotionVectors.image,
+            sceneDepth.image,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                .srcAccessMask  = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = sceneDepth.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = sceneDepth.image.arrayLayers
+            }
+        )
+        .Execute(cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+    }
+
+    void RenderPass::RenderVisibilityBuffer
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Culling::Dispatch& culling
+    )
+    {
+        Vk::BeginLabel(cmdBuffer, "Visibility Buffer Generation", glm::vec4(0.5098f, 0.1243f, 0.4549f, 1.0f));
+
+        const auto& culledBuffers = culling.GetCulledBuffers();
+        const bool  isMeshShaded  = culling.IsMeshShadingEnabled();
+
+        const auto& visibilityBufferView = framebufferManager.GetFramebufferView("VisibilityBufferView");
+        const auto& gAlbedoView          = framebufferManager.GetFramebufferView("GAlbedoReflectanceView");
+        const auto& gNormalView          = framebufferManager.GetFramebufferView("GNormalView");
+        const auto& gEmmisiveView        = framebufferManager.GetFramebufferView("GEmmisiveView");
+        const auto& gMotionVectorsView   = framebufferManager.GetFramebufferView("GMotionVectorsView");
+        const auto& sceneDepthView       = framebufferManager.GetFramebufferView("SceneDepthView");
+
+        const auto& visibilityBuffer = framebufferManager.GetFramebuffer(visibilityBufferView.framebuffer);
+        const auto& sceneDepth       = framebufferManager.GetFramebuffer(sceneDepthView.framebuffer);
+
+        const std::array gBufferImages =
+        {
+            &framebufferManager.GetFramebuffer(gAlbedoView.framebuffer).image,
+            &framebufferManager.GetFramebuffer(gNormalView.framebuffer).image,
+            &framebufferManager.GetFramebuffer(gEmmisiveView.framebuffer).image,
+            &framebufferManager.GetFramebuffer(gMotionVectorsView.framebuffer).image
+        };
+
+        Vk::BarrierWriter barrierWriter = {};
+
+        for (const auto image : gBufferImages)
+        {
+            barrierWriter.WriteImageBarrier(
+                *image,
+                Vk::ImageBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .newLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .baseMipLevel   = 0,
+                    .levelCount     = image->mipLevels,
+                    .baseArrayLayer = 0,
+                    .layerCount     = image->arrayLayers
+                }
+            );
+        }
+
+        barrierWriter
+        .WriteImageBarrier(
+            visibilityBuffer.image,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = visibilityBuffer.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = visibilityBuffer.image.arrayLayers
+            }
+        )
+        .Execute(cmdBuffer);
+
+        // Rasterize
+        {
+            Vk::BeginLabel(cmdBuffer, "Rasterize", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
+
+            const VkRenderingAttachmentInfo visibilityBufferInfo =
+            {
+                .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+                .pNext              = nullptr,
+                .imageView          = visibilityBufferView.view.handle,
+                .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .resolveMode        = VK_RESOLVE_MODE_NONE,
+                .resolveImageView   = VK_NULL_HANDLE,
+                .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
+                .clearValue         = {.color = {.uint32 = {VisibilityBuffer::VISIBILITY_EMPTY, 0, 0, 0}}}
+            };
+
+            const VkRenderingAttachmentInfo sceneDepthInfo =
+            {
+                .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+                .pNext              = nullptr,
+                .imageView          = sceneDepthView.view.handle,
+                .imageLayout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .resolveMode        = VK_RESOLVE_MODE_NONE,
+                .resolveImageView   = VK_NULL_HANDLE,
+                .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .loadOp             = VK_ATTACHMENT_LOAD_OP_LOAD,
+                .storeOp            = VK_ATTACHMENT_STORE_OP_NONE,
+                .clearValue         = {}
+            };
+
+            const VkRenderingInfo renderInfo =
+            {
+                .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
+                .pNext                = nullptr,
+                .flags                = 0,
+                .renderArea           = {
+                    .offset = {0, 0},
+                    .extent = {visibilityBuffer.image.width, visibilityBuffer.image.height}
+                },
+                .layerCount           = 1,
+                .viewMask             = 0,
+                .colorAttachmentCount = 1,
+                .pColorAttachments    = &visibilityBufferInfo,
+                .pDepthAttachment     = &sceneDepthInfo,
+                .pStencilAttachment   = nullptr
+            };
+
+            if (isMeshShaded)
+            {
+                culling.PreMeshShading(cmdBuffer, culledBuffers, culledBuffers);
+            }
+
+            vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
+
+            const VkViewport viewport =
+            {
+                .x        = 0.0f,
+                .y        = 0.0f,
+                .width    = static_cast<f32>(sceneBuffer.renderExtent.width),
+                .height   = static_cast<f32>(sceneBuffer.renderExtent.height),
+                .minDepth = 0.0f,
+                .maxDepth = 1.0f
+            };
+
+            vkCmdSetViewportWithCount(cmdBuffer.handle, 1, &viewport);
+
+            const VkRect2D scissor =
+            {
+                .offset = {0, 0},
+                .extent = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height}
+            };
+
+            vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
+
+            if (isMeshShaded)
+            {
+                const std::array descriptorSets = {megaSet.descriptorSet};
+
+                m_meshVisibilityBufferPipeline->Bind(cmdBuffer);
+                m_meshVisibilityBufferPipeline->BindDescriptors(cmdBuffer, 0, descriptorSets);
+            }
+            else
+            {
+                modelManager.geometryBuffer.Bind(cmdBuffer);
+
+                m_visibilityBufferPipeline->Bind(cmdBuffer);
+            }
+
+            // Alpha masked draws need no alpha test, the equal depth test only passes where the pre-pass kept the texel
+            const std::array<std::pair<const Buffers::DrawCallBuffer*, VkCullModeFlags>, 4> buckets =
+            {{
+                {&culledBuffers.opaqueBuffer,                 VK_CULL_MODE_BACK_BIT},
+                {&culledBuffers.alphaMaskedBuffer,            VK_CULL_MODE_BACK_BIT},
+                {&culledBuffers.opaqueDoubleSidedBuffer,      VK_CULL_MODE_NONE},
+                {&culledBuffers.alphaMaskedDoubleSidedBuffer, VK_CULL_MODE_NONE}
+            }};
+
+            for (const auto& [drawCallBuffer, cullMode] : buckets)
+            {
+                vkCmdSetCullMode(cmdBuffer.handle, cullMode);
+
+                const auto constants = VisibilityBuffer::Constants
+                {
+                    .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
+                    .Meshes      = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                    .Transforms  = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                    .MeshIndices = drawCallBuffer->meshIndexBuffer->deviceAddress,
+                    .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                    .DrawCalls   = drawCallBuffer->drawCallBuffer.deviceAddress
+                };
+
+                if (isMeshShaded)
+                {
+                    auto meshConstants = constants;
+
+                    meshConstants.Clusters          = modelManager.geometryBuffer.GetClusterBuffer().deviceAddress;
+                    meshConstants.Indices           = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress;
+                    meshConstants.ViewportSize      = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height};
+                    meshConstants.PointSamplerIndex = modelManager.textureManager.GetSampler(m_meshVisibilityBufferPipeline->pointSamplerID).descriptorID;
+                    meshConstants.HiZIndex          = framebufferManager.GetFramebufferView("Culling/HiZView").sampledImageID;
+                    meshConstants.TestOcclusion     = culling.IsOcclusionCullingEnabled() ? 1u : 0u;
+                    meshConstants.CullBackFaces     = cullMode == VK_CULL_MODE_NONE ? 0u : 1u;
+
+                    m_meshVisibilityBufferPipeline->PushConstants
+                    (
+                        cmdBuffer,
+                        VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        meshConstants
+                    );
+
+                    culling.DrawMeshTasks(FIF, cmdBuffer, indirectBuffer);
+
+                    continue;
+                }
+
+                m_visibilityBufferPipeline->PushConstants
+                (
+                    cmdBuffer,
+                    VK_SHADER_STAGE_VERTEX_BIT,
+                    constants
+                );
+
+                vkCmdDrawIndexedIndirectCount
+                (
+                    cmdBuffer.handle,
+                    drawCallBuffer->drawCallBuffer.handle,
+                    sizeof(u32),
+                    drawCallBuffer->drawCallBuffer.handle,
+                    0,
+                    drawCallBuffer->capacity,
+                    sizeof(VkDrawIndexedIndirectCommand)
+                );
+            }
+
+            vkCmdEndRendering(cmdBuffer.handle);
+
+            if (isMeshShaded)
+            {
+                culling.PostMeshShading(cmdBuffer, culledBuffers, culledBuffers);
+            }
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        barrierWriter
+        .WriteImageBarrier(
+            visibilityBuffer.image,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
                 .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
                 .oldLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
                 .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = gMotionVectors.image.mipLevels,
+                .levelCount     = visibilityBuffer.image.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = gMotionVectors.image.arrayLayers
+                .layerCount     = visibilityBuffer.image.arrayLayers
             }
         )
         .WriteImageBarrier(
@@ -778,12 +1195,236 @@ namespace Renderer::GBuffer
         )
         .Execute(cmdBuffer);
 
+        // Resolve
+        {
+            Vk::BeginLabel(cmdBuffer, "Resolve", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
+
+            m_resolvePipeline.Bind(cmdBuffer);
+
+            const auto constants = Resolve::Constants
+            {
+                .Scene                     = sceneBuffer.buffers[FIF].deviceAddress,
+                .Meshes                    = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                .CurrentTransforms         = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                .PreviousTransforms        = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                .Materials                 = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                .Indices                   = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress,
+                .Positions                 = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                .Vertices                  = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                .ViewportSize              = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+                .TextureSamplerIndex       = modelManager.textureManager.GetSampler(m_resolvePipeline.textureSamplerID).descriptorID,
+                .PointSamplerIndex         = modelManager.textureManager.GetSampler(m_resolvePipeline.pointSamplerID).descriptorID,
+                .VisibilityBufferIndex     = visibilityBufferView.sampledImageID,
+                .OutAlbedoReflectanceIndex = gAlbedoView.storageImageID,
+                .OutNormalIndex            = gNormalView.storageImageID,
+                .OutEmmisiveIndex          = gEmmisiveView.storageImageID,
+                .OutMotionVectorsIndex     = gMotionVectorsView.storageImageID
+            };
+
+            m_resolvePipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                constants
+            );
+
+            const std::array descriptorSets = {megaSet.descriptorSet};
+            m_resolvePipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            vkCmdDispatch
+            (
+                cmdBuffer.handle,
+                (sceneBuffer.renderExtent.width  + 8 - 1) / 8,
+                (sceneBuffer.renderExtent.height + 8 - 1) / 8,
+                1
+            );
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        for (const auto image : gBufferImages)
+        {
+            barrierWriter.WriteImageBarrier(
+                *image,
+                Vk::ImageBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                    .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .baseMipLevel   = 0,
+                    .levelCount     = image->mipLevels,
+                    .baseArrayLayer = 0,
+                    .layerCount     = image->arrayLayers
+                }
+            );
+        }
+
+        barrierWriter.Execute(cmdBuffer);
+
         Vk::EndLabel(cmdBuffer);
     }
 
+    void RenderPass::RenderMeshTasks
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const Culling::Dispatch& culling
+    )
+    {
+        const auto& culledBuffers = culling.GetCulledBuffers();
+
+        const std::array descriptorSets = {megaSet.descriptorSet};
+
+        const auto hiZIndex = framebufferManager.GetFramebufferView("Culling/HiZView").sampledImageID;
+
+        const auto DrawBucket = [&] (const auto& pipeline, const Buffers::DrawCallBuffer& bucket, bool isDoubleSided)
+        {
+            const auto constants = GBuffer::Constants
+            {
+                .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                .CurrentTransforms   = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                .PreviousTransforms  = meshBuffer.GetPreviousStreams(frameIndex).transforms.deviceAddress,
+                .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                .MeshIndices         = bucket.meshIndexBuffer->deviceAddress,
+                .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                .DrawCalls           = bucket.drawCallBuffer.deviceAddress,
+                .Clusters            = modelManager.geometryBuffer.GetClusterBuffer().deviceAddress,
+                .Indices             = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress,
+                .TextureSamplerIndex = modelManager.textureManager.GetSampler(pipeline.textureSamplerID).descriptorID,
+                .ViewportSize        = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height},
+                .PointSamplerIndex   = modelManager.textureManager.GetSampler(pipeline.pointSamplerID).descriptorID,
+                .HiZIndex            = hiZIndex,
+                .TestOcclusion       = culling.IsOcclusionCullingEnabled() ? 1u : 0u,
+                .CullBackFaces       = isDoubleSided ? 0u : 1u
+            };
+
+            pipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                constants
+            );
+
+            culling.DrawMeshTasks(FIF, cmdBuffer, indirectBuffer);
+        };
+
+        // Single Sided
+        {
+            Vk::BeginLabel(cmdBuffer, "Single Sided", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
+
+            const auto& pipeline = *m_meshSingleSidedPipeline;
+
+            pipeline.Bind(cmdBuffer);
+            pipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            DrawBucket(pipeline, culledBuffers.opaqueBuffer,      false);
+            DrawBucket(pipeline, culledBuffers.alphaMaskedBuffer, false);
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        // Double Sided
+        {
+            Vk::BeginLabel(cmdBuffer, "Double Sided", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
+
+            const auto& pipeline = *m_meshDoubleSidedPipeline;
+
+            pipeline.Bind(cmdBuffer);
+            pipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            DrawBucket(pipeline, culledBuffers.opaqueDoubleSidedBuffer,      true);
+            DrawBucket(pipeline, culledBuffers.alphaMaskedDoubleSidedBuffer, true);
+
+            Vk::EndLabel(cmdBuffer);
+        }
+    }
+
+    void RenderPass::ImGuiDisplay()
+    {
+        if (ImGui::BeginMainMenuBar())
+        {
+            if (ImGui::BeginMenu("GBuffer"))
+            {
+                constexpr std::array MODE_NAMES = {"GBuffer", "Visibility Buffer"};
+
+                s32 mode = static_cast<s32>(m_mode);
+
+                ImGui::BeginDisabled(!m_isVisibilityBufferSupported);
+
+                if (ImGui::Combo("Mode", &mode, MODE_NAMES.data(), static_cast<s32>(MODE_NAMES.size())))
+                {
+                    m_mode = static_cast<Mode>(mode);
+                }
+
+                ImGui::EndDisabled();
+
+                ImGui::Separator();
+
+                ImGui::Text("GPU Time | %.4f ms", m_gpuTime);
+
+                ImGui::Separator();
+
+                const bool isVisibilityBuffer = m_mode == Mode::VisibilityBuffer && m_isVisibilityBufferSupported;
+                const u32  bytesWritten       = G_BUFFER_BYTES_WRITTEN + (isVisibilityBuffer ? VISIBILITY_BUFFER_BYTES : 0);
+                const u32  bytesRead          = G_BUFFER_BYTES_READ    + (isVisibilityBuffer ? VISIBILITY_BUFFER_BYTES : 0);
+
+                const auto ToMiB = [this] (u32 bytesPerPixel)
+                {
+                    return static_cast<f64>(bytesPerPixel * m_pixelCount) / (1024.0 * 1024.0);
+                };
+
+                ImGui::Text("Written  | %u B/px | %.2f MiB/frame", bytesWritten, ToMiB(bytesWritten));
+                ImGui::Text("Read     | %u B/px | %.2f MiB/frame", bytesRead,    ToMiB(bytesRead));
+
+                ImGui::EndMenu();
+            }
+
+            ImGui::EndMainMenuBar();
+        }
+    }
+
     void RenderPass::Destroy(VkDevice device)
     {
+        for (const auto queryPool : m_queryPools)
+        {
+            vkDestroyQueryPool(device, queryPool, nullptr);
+        }
+
         m_singleSidedPipeline.Destroy(device);
         m_doubleSidedPipeline.Destroy(device);
+        m_resolvePipeline.Destroy(device);
+
+        if (m_visibilityBufferPipeline.has_value())
+        {
+            m_visibilityBufferPipeline->Destroy(device);
+        }
+
+        if (m_meshSingleSidedPipeline.has_value())
+        {
+            m_meshSingleSidedPipeline->Destroy(device);
+        }
+
+        if (m_meshDoubleSidedPipeline.has_value())
+        {
+            m_meshDoubleSidedPipeline->Destroy(device);
+        }
+
+        if (m_meshVisibilityBufferPipeline.has_value())
+        {
+            m_meshVisibilityBufferPipeline->Destroy(device);
+        }
     }
 }
\ No newline at end of file
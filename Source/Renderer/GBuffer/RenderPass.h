@@ -19,6 +19,11 @@
 
 #include "SingleSided/Pipeline.h"
 #include "DoubleSided/Pipeline.h"
+#include "VisibilityBuffer/Pipeline.h"
+#include "Resolve/Pipeline.h"
+#include "MeshSingleSided/Pipeline.h"
+#include "MeshDoubleSided/Pipeline.h"
+#include "MeshVisibilityBuffer/Pipeline.h"
 #include "Vulkan/CommandBuffer.h"
 #include "Vulkan/GeometryBuffer.h"
 #include "Vulkan/MegaSet.h"
@@ -26,9 +31,16 @@
 #include "Renderer/Buffers/IndirectBuffer.h"
 #include "Renderer/Buffers/MeshBuffer.h"
 #include "Renderer/Buffers/SceneBuffer.h"
+#include "Renderer/Culling/Dispatch.h"
 
 namespace Renderer::GBuffer
 {
+    enum class Mode : u8
+    {
+        GBuffer,
+        VisibilityBuffer
+    };
+
     class RenderPass
     {
     public:
@@ -43,6 +55,8 @@ namespace Renderer::GBuffer
 
         void Destroy(VkDevice device);
 
+        void ImGuiDisplay();
+
         void Render
         (
             usize FIF,
@@ -53,11 +67,74 @@ namespace Renderer::GBuffer
             const Models::ModelManager& modelManager,
             const Buffers::SceneBuffer& sceneBuffer,
             const Buffers::MeshBuffer& meshBuffer,
-            const Buffers::IndirectBuffer& indirectBuffer
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Culling::Dispatch& culling
         );
     private:
+        void RenderGBuffer
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Culling::Dispatch& culling
+        );
+
+        void RenderMeshTasks
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Culling::Dispatch& culling
+        );
+
+        void RenderVisibilityBuffer
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const Culling::Dispatch& culling
+        );
+
         SingleSided::Pipeline m_singleSidedPipeline;
         DoubleSided::Pipeline m_doubleSidedPipeline;
+        Resolve::Pipeline     m_resolvePipeline;
+
+        std::optional<VisibilityBuffer::Pipeline> m_visibilityBufferPipeline = std::nullopt;
+
+        std::optional<MeshSingleSided::Pipeline>      m_meshSingleSidedPipeline      = std::nullopt;
+        std::optional<MeshDoubleSided::Pipeline>      m_meshDoubleSidedPipeline      = std::nullopt;
+        std::optional<MeshVisibilityBuffer::Pipeline> m_meshVisibilityBufferPipeline = std::nullopt;
+
+        Mode m_mode = Mode::GBuffer;
+        // Every GBuffer target needs formatless storage writes for the resolve pass, and rasterizing needs gl_PrimitiveID
+        bool m_isVisibilityBufferSupported = false;
+
+        std::array<VkQueryPool, Vk::FRAMES_IN_FLIGHT> m_queryPools      = {};
+        std::array<bool, Vk::FRAMES_IN_FLIGHT>        m_hasTimestamps   = {};
+        VkDevice                                      m_device          = VK_NULL_HANDLE;
+        f32                                           m_timestampPeriod = 0.0f;
+        f64                                           m_gpuTime         = 0.0;
+
+        // For the bandwidth estimate
+        u64 m_pixelCount = 0;
     };
 }
 
@@ -35,9 +35,8 @@ namespace Renderer::GBuffer::SingleSided
         constexpr std::array COLOR_FORMATS =
         {
             VK_FORMAT_R8G8B8A8_UNORM,
-            VK_FORMAT_R16G16_UNORM,
-            VK_FORMAT_R8G8_UNORM,
-            VK_FORMAT_B10G11R11_UFLOAT_PACK32,
+            VK_FORMAT_R32_UINT,
+            VK_FORMAT_R32_UINT,
             VK_FORMAT_R16G16_SFLOAT
         };
 
@@ -102,19 +101,6 @@ namespace Renderer::GBuffer::SingleSided
                 VK_COLOR_COMPONENT_B_BIT |
                 VK_COLOR_COMPONENT_A_BIT
             )
-            .AddBlendAttachment(
-                VK_FALSE,
-                VK_BLEND_FACTOR_ONE,
-                VK_BLEND_FACTOR_ZERO,
-                VK_BLEND_OP_ADD,
-                VK_BLEND_FACTOR_ONE,
-                VK_BLEND_FACTOR_ZERO,
-                VK_BLEND_OP_ADD,
-                VK_COLOR_COMPONENT_R_BIT |
-                VK_COLOR_COMPONENT_G_BIT |
-                VK_COLOR_COMPONENT_B_BIT |
-                VK_COLOR_COMPONENT_A_BIT
-            )
             .AddPushConstant(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(GBuffer::Constants))
             .AddDescriptorLayout(megaSet.descriptorLayout)
             .Build();
@@ -19,7 +19,6 @@
 
 #include "Vulkan/Pipeline.h"
 #include "Vulkan/Context.h"
-#include "Vulkan/FormatHelper.h"
 #include "Vulkan/MegaSet.h"
 #include "Vulkan/TextureManager.h"
 
@@ -31,7 +30,6 @@ namespace Renderer::IBL::Converter
         Pipeline
         (
             const Vk::Context& context,
-            const Vk::FormatHelper& formatHelper,
             Vk::MegaSet& megaSet,
             Vk::TextureManager& textureManager
         );
@@ -17,7 +17,6 @@
 #include "Pipeline.h"
 
 #include "Vulkan/PipelineBuilder.h"
-#include "Util/Log.h"
 #include "Vulkan/DebugUtils.h"
 #include "IBL/Convolution.h"
 
@@ -26,37 +25,14 @@ namespace Renderer::IBL::Convolution
     Pipeline::Pipeline
     (
         const Vk::Context& context,
-        const Vk::FormatHelper& formatHelper,
         Vk::MegaSet& megaSet,
         Vk::TextureManager& textureManager
     )
     {
-        constexpr std::array DYNAMIC_STATES = {VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT, VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT};
-
-        const std::array colorFormats = {formatHelper.colorAttachmentFormatHDR};
-
         std::tie(handle, layout, bindPoint) = Vk::PipelineBuilder(context)
-            .SetPipelineType(VK_PIPELINE_BIND_POINT_GRAPHICS)
-            .SetRenderingInfo(0b00111111, colorFormats, VK_FORMAT_UNDEFINED)
-            .AttachShader("IBL/Convolution.vert", VK_SHADER_STAGE_VERTEX_BIT)
-            .AttachShader("IBL/Convolution.frag", VK_SHADER_STAGE_FRAGMENT_BIT)
-            .SetDynamicStates(DYNAMIC_STATES)
-            .SetIAState(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
-            .SetRasterizerState(VK_FALSE, VK_CULL_MODE_FRONT_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE, VK_POLYGON_MODE_FILL)
-            .AddBlendAttachment(
-                VK_FALSE,
-                VK_BLEND_FACTOR_ONE,
-                VK_BLEND_FACTOR_ZERO,
-                VK_BLEND_OP_ADD,
-                VK_BLEND_FACTOR_ONE,
-                VK_BLEND_FACTOR_ZERO,
-                VK_BLEND_OP_ADD,
-                VK_COLOR_COMPONENT_R_BIT |
-                VK_COLOR_COMPONENT_G_BIT |
-                VK_COLOR_COMPONENT_B_BIT |
-                VK_COLOR_COMPONENT_A_BIT
-            )
-            .AddPushConstant(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(Convolution::Constants))
+            .SetPipelineType(VK_PIPELINE_BIND_POINT_COMPUTE)
+            .AttachShader("IBL/Convolution.comp", VK_SHADER_STAGE_COMPUTE_BIT)
+            .AddPushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(Convolution::Constants))
             .AddDescriptorLayout(megaSet.descriptorLayout)
             .Build();
 
@@ -17,75 +17,44 @@
 #include "Generator.h"
 
 #include "Vulkan/DebugUtils.h"
+#include "Vulkan/Util.h"
 #include "Util/Log.h"
 #include "Externals/GLM.h"
 #include "IBL/Converter.h"
+#include "IBL/Downsample.h"
 #include "IBL/Convolution.h"
 #include "IBL/PreFilter.h"
 
 namespace Renderer::IBL
 {
-    constexpr glm::uvec2 SKYBOX_SIZE     = {2048, 2048};
-    constexpr glm::uvec2 IRRADIANCE_SIZE = {128,  128};
-    constexpr glm::uvec2 PRE_FILTER_SIZE = {1024, 1024};
-    constexpr glm::uvec2 BRDF_LUT_SIZE   = {1024, 1024};
+    constexpr glm::uvec2 SKYBOX_SIZE      = {2048, 2048};
+    constexpr glm::uvec2 IRRADIANCE_SIZE  = {128,  128};
+    constexpr glm::uvec2 PRE_FILTER_SIZE  = {1024, 1024};
+    constexpr glm::uvec2 BRDF_LUT_SIZE    = {1024, 1024};
+    constexpr glm::uvec2 DEFAULT_MAP_SIZE = {16,   16};
 
     constexpr u32 PREFILTER_SAMPLE_COUNT = 512;
-    
+
+    // Flat grey environment used until the real maps are ready
+    constexpr VkClearColorValue DEFAULT_ENVIRONMENT_COLOR = {.float32 = {0.1f, 0.1f, 0.1f, 1.0f}};
+
     Generator::Generator
     (
         const Vk::Context& context,
-        const Vk::FormatHelper& formatHelper,
         Vk::MegaSet& megaSet,
         Vk::TextureManager& textureManager
     )
-        : m_converterPipeline(context, formatHelper, megaSet, textureManager),
-          m_convolutionPipeline(context, formatHelper, megaSet, textureManager),
-          m_preFilterPipeline(context, formatHelper, megaSet, textureManager),
+        : m_converterPipeline(context, megaSet, textureManager),
+          m_downsamplePipeline(context, megaSet, textureManager),
+          m_convolutionPipeline(context, megaSet, textureManager),
+          m_preFilterPipeline(context, megaSet, textureManager),
           m_brdfLutPipeline(context)
     {
-        const auto projection = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
-
-        const std::array matrices =
+        if (context.queueFamilies.HasAllFamilies())
         {
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f)),
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f)),
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
-            projection * glm::lookAtRH(glm::vec3(0.0f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
-        };
-
-        m_matrixBuffer = Vk::Buffer
-        (
-            context.allocator,
-            matrices.size() * sizeof(glm::mat4),
-            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-            VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT,
-            VMA_MEMORY_USAGE_AUTO
-        );
-
-        std::memcpy
-        (
-            m_matrixBuffer.allocationInfo.pMappedData,
-            matrices.data(),
-            matrices.size() * sizeof(glm::mat4)
-        );
-
-        m_matrixBuffer.GetDeviceAddress(context.device);
-
-        Vk::SetDebugName(context.device, m_matrixBuffer.handle, "IBLMaps/MatrixBuffer");
+            m_asyncTimeline = Vk::ComputeTimeline(context.device);
 
-        if (!(m_matrixBuffer.memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
-        {
-            Vk::CheckResult(vmaFlushAllocation(
-                context.allocator,
-                m_matrixBuffer.allocation,
-                0,
-                matrices.size() * sizeof(glm::mat4)),
-                "Failed to flush allocation!"
-            );
+            Vk::SetDebugName(context.device, m_asyncTimeline->semaphore, "IBL/TimelineSemaphore");
         }
     }
 
@@ -112,17 +81,121 @@ namespace Renderer::IBL
             hdrMapAssetPath
         );
 
+        if (m_asyncTimeline.has_value())
+        {
+            CancelAsync
+            (
+                context,
+                modelManager.textureManager,
+                megaSet,
+                deletionQueue
+            );
+
+            // Hand the HDR map over to the compute queue, the rest happens in SubmitAsync()
+            modelManager.textureManager.GetTexture(hdrMapID).image.Barrier
+            (
+                cmdBuffer,
+                Vk::ImageBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_NONE,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                    .dstAccessMask  = VK_ACCESS_2_NONE,
+                    .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .srcQueueFamily = *context.queueFamilies.graphicsFamily,
+                    .dstQueueFamily = *context.queueFamilies.computeFamily,
+                    .baseMipLevel   = 0,
+                    .levelCount     = modelManager.textureManager.GetTexture(hdrMapID).image.mipLevels,
+                    .baseArrayLayer = 0,
+                    .layerCount     = modelManager.textureManager.GetTexture(hdrMapID).image.arrayLayers
+                }
+            );
+
+            m_asyncGeneration = AsyncGeneration{.hdrMapID = hdrMapID};
+
+            const auto defaultMaps = GenerateDefault
+            (
+                cmdBuffer,
+                context,
+                formatHelper,
+                modelManager.textureManager,
+                megaSet
+            );
+
+            Vk::EndLabel(cmdBuffer);
+
+            return defaultMaps;
+        }
+
+        std::vector<TransientView> transientViews = {};
+
         const auto skyboxID = GenerateSkybox
         (
             cmdBuffer,
             hdrMapID,
             context,
             formatHelper,
-            modelManager,
+            modelManager.textureManager,
             megaSet,
-            deletionQueue
+            transientViews
         );
 
+        const auto irradianceMapID = GenerateIrradianceMap
+        (
+            cmdBuffer,
+            skyboxID,
+            context,
+            formatHelper,
+            modelManager.textureManager,
+            megaSet,
+            transientViews
+        );
+
+        const auto preFilterMapID = GeneratePreFilterMap
+        (
+            cmdBuffer,
+            skyboxID,
+            context,
+            formatHelper,
+            modelManager.textureManager,
+            megaSet,
+            transientViews
+        );
+
+        const auto brdfLutID = GenerateBRDFLUT
+        (
+            cmdBuffer,
+            context,
+            modelManager.textureManager,
+            megaSet
+        );
+
+        const auto iblMaps = IBL::IBLMaps
+        {
+            .skyboxID        = skyboxID,
+            .irradianceMapID = irradianceMapID,
+            .preFilterMapID  = preFilterMapID,
+            .brdfLutID       = brdfLutID,
+        };
+
+        WriteMapBarriers
+        (
+            modelManager.textureManager,
+            iblMaps,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED
+            }
+        );
+
+        m_barrierWriter.Execute(cmdBuffer);
+
         modelManager.textureManager.DestroyTexture
         (
             hdrMapID,
@@ -132,48 +205,334 @@ namespace Renderer::IBL
             deletionQueue
         );
 
+        deletionQueue.PushDeletor([&megaSet, device = context.device, transientViews] () mutable
+        {
+            for (const auto& [view, descriptorID, isStorage] : transientViews)
+            {
+                if (isStorage)
+                {
+                    megaSet.FreeStorageImage(descriptorID);
+                }
+                else
+                {
+                    megaSet.FreeSampledImage(descriptorID);
+                }
+
+                view.Destroy(device);
+            }
+        });
+
         megaSet.Update(context.device);
 
-        const auto irradianceMapID = GenerateIrradianceMap
+        Vk::EndLabel(cmdBuffer);
+
+        return iblMaps;
+    }
+
+    void Generator::SubmitAsync
+    (
+        usize frameIndex,
+        const Vk::Context& context,
+        const Vk::FormatHelper& formatHelper,
+        const Vk::GraphicsTimeline& graphicsTimeline,
+        Vk::CommandBufferAllocator& computeCmdBufferAllocator,
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet
+    )
+    {
+        if (!m_asyncGeneration.has_value() || m_asyncGeneration->isSubmitted)
+        {
+            return;
+        }
+
+        // Global command buffers outlive the per-FIF pool resets, which async generation can span
+        if (m_asyncCmdBuffer.handle == VK_NULL_HANDLE)
+        {
+            m_asyncCmdBuffer = computeCmdBufferAllocator.AllocateGlobalCommandBuffer(context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        }
+
+        auto& [hdrMapID, iblMaps, transientViews, isSubmitted] = *m_asyncGeneration;
+
+        const auto& cmdBuffer = m_asyncCmdBuffer;
+
+        cmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+        Vk::BeginLabel(cmdBuffer, "Async IBL Map Generation", {0.9215f, 0.8470f, 0.0274f, 1.0f});
+
+        textureManager.GetTexture(hdrMapID).image.Barrier
         (
             cmdBuffer,
-            skyboxID,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = *context.queueFamilies.graphicsFamily,
+                .dstQueueFamily = *context.queueFamilies.computeFamily,
+                .baseMipLevel   = 0,
+                .levelCount     = textureManager.GetTexture(hdrMapID).image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = textureManager.GetTexture(hdrMapID).image.arrayLayers
+            }
+        );
+
+        iblMaps.skyboxID = GenerateSkybox
+        (
+            cmdBuffer,
+            hdrMapID,
             context,
             formatHelper,
-            modelManager,
-            megaSet
+            textureManager,
+            megaSet,
+            transientViews
         );
 
-        const auto preFilterMapID = GeneratePreFilterMap
+        iblMaps.irradianceMapID = GenerateIrradianceMap
         (
             cmdBuffer,
-            skyboxID,
+            iblMaps.skyboxID,
             context,
             formatHelper,
-            modelManager,
+            textureManager,
             megaSet,
-            deletionQueue
+            transientViews
         );
 
-        const auto brdfLutID = GenerateBRDFLUT
+        iblMaps.preFilterMapID = GeneratePreFilterMap
         (
             cmdBuffer,
+            iblMaps.skyboxID,
             context,
-            modelManager.textureManager,
-            megaSet
+            formatHelper,
+            textureManager,
+            megaSet,
+            transientViews
         );
 
-        megaSet.Update(context.device);
+        // BRDF LUT is generated alongside the default maps
+        iblMaps.brdfLutID = m_brdfLutID.value();
+
+        WriteMapBarriers
+        (
+            textureManager,
+            iblMaps,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .dstAccessMask  = VK_ACCESS_2_NONE,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = *context.queueFamilies.computeFamily,
+                .dstQueueFamily = *context.queueFamilies.graphicsFamily
+            }
+        );
+
+        m_barrierWriter.Execute(cmdBuffer);
 
         Vk::EndLabel(cmdBuffer);
 
-        return IBL::IBLMaps
+        cmdBuffer.EndRecording();
+
+        megaSet.Update(context.device);
+
+        // The HDR map was uploaded during this frame's GBuffer generation submit
+        const VkSemaphoreSubmitInfo waitSemaphoreInfo =
         {
-            .skyboxID        = skyboxID,
-            .irradianceMapID = irradianceMapID,
-            .preFilterMapID  = preFilterMapID,
-            .brdfLutID       = brdfLutID,
+            .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .pNext       = nullptr,
+            .semaphore   = graphicsTimeline.semaphore,
+            .value       = graphicsTimeline.GetTimelineValue(frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_GBUFFER_GENERATION_COMPLETE),
+            .stageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .deviceIndex = 0
+        };
+
+        const VkCommandBufferSubmitInfo cmdBufferInfo =
+        {
+            .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+            .pNext         = nullptr,
+            .commandBuffer = cmdBuffer.handle,
+            .deviceMask    = 0
+        };
+
+        const VkSemaphoreSubmitInfo signalSemaphoreInfo =
+        {
+            .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .pNext       = nullptr,
+            .semaphore   = m_asyncTimeline->semaphore,
+            .value       = m_asyncTimeline->GetTimelineValue(m_asyncGenerationIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED),
+            .stageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .deviceIndex = 0
         };
+
+        const VkSubmitInfo2 submitInfo =
+        {
+            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .pNext                    = nullptr,
+            .flags                    = 0,
+            .waitSemaphoreInfoCount   = 1,
+            .pWaitSemaphoreInfos      = &waitSemaphoreInfo,
+            .commandBufferInfoCount   = 1,
+            .pCommandBufferInfos      = &cmdBufferInfo,
+            .signalSemaphoreInfoCount = 1,
+            .pSignalSemaphoreInfos    = &signalSemaphoreInfo
+        };
+
+        Vk::CheckResult(vkQueueSubmit2(
+            context.computeQueue,
+            1,
+            &submitInfo,
+            VK_NULL_HANDLE),
+            "Failed to submit to compute queue!"
+        );
+
+        isSubmitted = true;
+    }
+
+    void Generator::Update
+    (
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::Context& context,
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue,
+        IBL::IBLMaps& iblMaps
+    )
+    {
+        if (!m_asyncGeneration.has_value() || !m_asyncGeneration->isSubmitted)
+        {
+            return;
+        }
+
+        if (!m_asyncTimeline->IsAtOrPastState(m_asyncGenerationIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED, context.device))
+        {
+            return;
+        }
+
+        auto& [hdrMapID, generatedMaps, transientViews, _] = *m_asyncGeneration;
+
+        Vk::BeginLabel(cmdBuffer, "IBL Map Swap", {0.9215f, 0.8470f, 0.0274f, 1.0f});
+
+        WriteMapBarriers
+        (
+            textureManager,
+            generatedMaps,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = *context.queueFamilies.computeFamily,
+                .dstQueueFamily = *context.queueFamilies.graphicsFamily
+            }
+        );
+
+        m_barrierWriter.Execute(cmdBuffer);
+
+        Vk::EndLabel(cmdBuffer);
+
+        // Frames still in flight may be using the default maps
+        iblMaps.Destroy
+        (
+            context,
+            textureManager,
+            megaSet,
+            deletionQueue
+        );
+
+        iblMaps = generatedMaps;
+
+        textureManager.DestroyTexture
+        (
+            hdrMapID,
+            context.device,
+            context.allocator,
+            megaSet,
+            deletionQueue
+        );
+
+        deletionQueue.PushDeletor([&megaSet, device = context.device, transientViews] () mutable
+        {
+            for (const auto& [view, descriptorID, isStorage] : transientViews)
+            {
+                if (isStorage)
+                {
+                    megaSet.FreeStorageImage(descriptorID);
+                }
+                else
+                {
+                    megaSet.FreeSampledImage(descriptorID);
+                }
+
+                view.Destroy(device);
+            }
+        });
+
+        m_asyncGeneration = std::nullopt;
+
+        ++m_asyncGenerationIndex;
+
+        Logger::Info("{}\n", "Swapped in asynchronously generated IBL maps!");
+    }
+
+    void Generator::CancelAsync
+    (
+        const Vk::Context& context,
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet,
+        Util::DeletionQueue& deletionQueue
+    )
+    {
+        if (!m_asyncGeneration.has_value())
+        {
+            return;
+        }
+
+        auto& [hdrMapID, iblMaps, transientViews, isSubmitted] = *m_asyncGeneration;
+
+        if (isSubmitted)
+        {
+            m_asyncTimeline->WaitForStage(m_asyncGenerationIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED, context.device);
+
+            iblMaps.Destroy
+            (
+                context,
+                textureManager,
+                megaSet,
+                deletionQueue
+            );
+
+            ++m_asyncGenerationIndex;
+        }
+
+        textureManager.DestroyTexture
+        (
+            hdrMapID,
+            context.device,
+            context.allocator,
+            megaSet,
+            deletionQueue
+        );
+
+        for (const auto& [view, descriptorID, isStorage] : transientViews)
+        {
+            if (isStorage)
+            {
+                megaSet.FreeStorageImage(descriptorID);
+            }
+            else
+            {
+                megaSet.FreeSampledImage(descriptorID);
+            }
+
+            view.Destroy(context.device);
+        }
+
+        m_asyncGeneration = std::nullopt;
     }
 
     Vk::TextureID Generator::LoadHDRMap
@@ -230,20 +589,44 @@ namespace Renderer::IBL
         return hdrMapID;
     }
 
-    Vk::TextureID Generator::GenerateSkybox
+    IBL::IBLMaps Generator::GenerateDefault
     (
         const Vk::CommandBuffer& cmdBuffer,
-        Vk::TextureID hdrMapID,
         const Vk::Context& context,
         const Vk::FormatHelper& formatHelper,
-        Models::ModelManager& modelManager,
-        Vk::MegaSet& megaSet,
-        Util::DeletionQueue& deletionQueue
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet
     )
     {
-        Vk::BeginLabel(cmdBuffer, "Equirectangular To Cubemap Conversion", {0.2588f, 0.5294f, 0.9607f, 1.0f});
+        Vk::BeginLabel(cmdBuffer, "Default IBL Maps", {0.7215f, 0.8410f, 0.6274f, 1.0f});
 
-        const auto skybox = Vk::Image
+        const auto iblMaps = IBL::IBLMaps
+        {
+            .skyboxID        = CreateDefaultCubemap(cmdBuffer, context, formatHelper, textureManager, megaSet, "IBL/Default/Skybox",     1),
+            .irradianceMapID = CreateDefaultCubemap(cmdBuffer, context, formatHelper, textureManager, megaSet, "IBL/Default/Irradiance", 1),
+            .preFilterMapID  = CreateDefaultCubemap(cmdBuffer, context, formatHelper, textureManager, megaSet, "IBL/Default/PreFilter",  PREFILTER_MIPMAP_LEVELS),
+            .brdfLutID       = GenerateBRDFLUT(cmdBuffer, context, textureManager, megaSet)
+        };
+
+        megaSet.Update(context.device);
+
+        Vk::EndLabel(cmdBuffer);
+
+        return iblMaps;
+    }
+
+    Vk::TextureID Generator::CreateDefaultCubemap
+    (
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::Context& context,
+        const Vk::FormatHelper& formatHelper,
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet,
+        const std::string_view name,
+        u32 mipLevels
+    )
+    {
+        const auto cubemap = Vk::Image
         (
             context.allocator,
             {
@@ -251,13 +634,13 @@ namespace Renderer::IBL
                 .pNext                 = nullptr,
                 .flags                 = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
                 .imageType             = VK_IMAGE_TYPE_2D,
-                .format                = formatHelper.colorAttachmentFormatHDR,
-                .extent                = {SKYBOX_SIZE.x, SKYBOX_SIZE.y, 1},
-                .mipLevels             = static_cast<u32>(std::floor(std::log2(std::max(SKYBOX_SIZE.x, SKYBOX_SIZE.y)))) + 1,
+                .format                = formatHelper.storageFormatHDR,
+                .extent                = {DEFAULT_MAP_SIZE.x, DEFAULT_MAP_SIZE.y, 1},
+                .mipLevels             = mipLevels,
                 .arrayLayers           = 6,
                 .samples               = VK_SAMPLE_COUNT_1_BIT,
                 .tiling                = VK_IMAGE_TILING_OPTIMAL,
-                .usage                 = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .usage                 = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
                 .queueFamilyIndexCount = 0,
                 .pQueueFamilyIndices   = nullptr,
@@ -266,151 +649,258 @@ namespace Renderer::IBL
             VK_IMAGE_ASPECT_COLOR_BIT
         );
 
-        skybox.Barrier
+        cubemap.Barrier
         (
             cmdBuffer,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
                 .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .dstAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
                 .oldLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
-                .newLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = skybox.mipLevels,
+                .levelCount     = cubemap.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = skybox.arrayLayers
+                .layerCount     = cubemap.arrayLayers
             }
         );
 
-        const auto skyboxRenderView = Vk::ImageView
+        const VkImageSubresourceRange subresourceRange =
+        {
+            .aspectMask     = cubemap.aspect,
+            .baseMipLevel   = 0,
+            .levelCount     = cubemap.mipLevels,
+            .baseArrayLayer = 0,
+            .layerCount     = cubemap.arrayLayers
+        };
+
+        vkCmdClearColorImage
+        (
+            cmdBuffer.handle,
+            cubemap.handle,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            &DEFAULT_ENVIRONMENT_COLOR,
+            1,
+            &subresourceRange
+        );
+
+        cubemap.Barrier
+        (
+            cmdBuffer,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_CLEAR_BIT,
+                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = cubemap.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = cubemap.arrayLayers
+            }
+        );
+
+        const auto cubemapView = Vk::ImageView
         (
             context.device,
-            skybox,
+            cubemap,
             VK_IMAGE_VIEW_TYPE_CUBE,
+            subresourceRange
+        );
+
+        return textureManager.AddTexture
+        (
+            megaSet,
+            context.device,
+            name,
+            cubemap,
+            cubemapView
+        );
+    }
+
+    Vk::TextureID Generator::GenerateSkybox
+    (
+        const Vk::CommandBuffer& cmdBuffer,
+        Vk::TextureID hdrMapID,
+        const Vk::Context& context,
+        const Vk::FormatHelper& formatHelper,
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet,
+        std::vector<TransientView>& transientViews
+    )
+    {
+        Vk::BeginLabel(cmdBuffer, "Equirectangular To Cubemap Conversion", {0.2588f, 0.5294f, 0.9607f, 1.0f});
+
+        const auto skybox = Vk::Image
+        (
+            context.allocator,
             {
-                .aspectMask     = skybox.aspect,
+                .sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                .pNext                 = nullptr,
+                .flags                 = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+                .imageType             = VK_IMAGE_TYPE_2D,
+                .format                = formatHelper.storageFormatHDR,
+                .extent                = {SKYBOX_SIZE.x, SKYBOX_SIZE.y, 1},
+                .mipLevels             = static_cast<u32>(std::floor(std::log2(std::max(SKYBOX_SIZE.x, SKYBOX_SIZE.y)))) + 1,
+                .arrayLayers           = 6,
+                .samples               = VK_SAMPLE_COUNT_1_BIT,
+                .tiling                = VK_IMAGE_TILING_OPTIMAL,
+                .usage                 = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+                .queueFamilyIndexCount = 0,
+                .pQueueFamilyIndices   = nullptr,
+                .initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED
+            },
+            VK_IMAGE_ASPECT_COLOR_BIT
+        );
+
+        skybox.Barrier
+        (
+            cmdBuffer,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = 1,
+                .levelCount     = skybox.mipLevels,
                 .baseArrayLayer = 0,
                 .layerCount     = skybox.arrayLayers
             }
         );
 
-        const VkRenderingAttachmentInfo colorAttachmentInfo =
-        {
-            .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-            .pNext              = nullptr,
-            .imageView          = skyboxRenderView.handle,
-            .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            .resolveMode        = VK_RESOLVE_MODE_NONE,
-            .resolveImageView   = VK_NULL_HANDLE,
-            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .loadOp             = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-            .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-            .clearValue         = {}
-        };
+        std::vector<TransientView> storageViews = {};
+        std::vector<TransientView> sampledViews = {};
 
-        const VkRenderingInfo renderInfo =
+        for (u32 mip = 0; mip < skybox.mipLevels; ++mip)
         {
-            .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
-            .pNext                = nullptr,
-            .flags                = 0,
-            .renderArea           = {
-                .offset = {0, 0},
-                .extent = {skybox.width, skybox.height}
-            },
-            .layerCount           = 1,
-            .viewMask             = 0b00111111,
-            .colorAttachmentCount = 1,
-            .pColorAttachments    = &colorAttachmentInfo,
-            .pDepthAttachment     = nullptr,
-            .pStencilAttachment   = nullptr
-        };
-
-        vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
+            storageViews.emplace_back(CreateTransientView(context.device, megaSet, skybox, VK_IMAGE_VIEW_TYPE_2D_ARRAY, mip, true));
 
-        m_converterPipeline.Bind(cmdBuffer);
-
-        const VkViewport viewport =
-        {
-            .x        = 0.0f,
-            .y        = 0.0f,
-            .width    = static_cast<f32>(skybox.width),
-            .height   = static_cast<f32>(skybox.height),
-            .minDepth = 0.0f,
-            .maxDepth = 1.0f
-        };
+            // The last mip is never downsampled from
+            if (mip + 1 < skybox.mipLevels)
+            {
+                sampledViews.emplace_back(CreateTransientView(context.device, megaSet, skybox, VK_IMAGE_VIEW_TYPE_CUBE, mip, false));
+            }
+        }
 
-        vkCmdSetViewportWithCount(cmdBuffer.handle, 1, &viewport);
+        megaSet.Update(context.device);
 
-        const VkRect2D scissor =
-        {
-            .offset = {0, 0},
-            .extent = {skybox.width, skybox.height}
-        };
+        const std::array descriptorSets = {megaSet.descriptorSet};
 
-        vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
+        m_converterPipeline.Bind(cmdBuffer);
 
         const auto constants = Converter::Constants
         {
-            .Vertices     = modelManager.geometryBuffer.cubeBuffer.deviceAddress,
-            .Matrices     = m_matrixBuffer.deviceAddress,
-            .SamplerIndex = modelManager.textureManager.GetSampler(m_converterPipeline.samplerID).descriptorID,
-            .TextureIndex = modelManager.textureManager.GetTexture(hdrMapID).descriptorID
+            .SamplerIndex = textureManager.GetSampler(m_converterPipeline.samplerID).descriptorID,
+            .TextureIndex = textureManager.GetTexture(hdrMapID).descriptorID,
+            .OutputIndex  = storageViews[0].descriptorID
         };
 
         m_converterPipeline.PushConstants
         (
             cmdBuffer,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            VK_SHADER_STAGE_COMPUTE_BIT,
             constants
         );
 
-        // Mega set
-        const std::array descriptorSets = {megaSet.descriptorSet};
         m_converterPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
 
-        vkCmdDraw
-        (
-            cmdBuffer.handle,
-            36,
-            1,
-            0,
-            0
-        );
+        vkCmdDispatch
+        (
+            cmdBuffer.handle,
+            (skybox.width  + 8 - 1) / 8,
+            (skybox.height + 8 - 1) / 8,
+            skybox.arrayLayers
+        );
+
+        Vk::BeginLabel(cmdBuffer, "Skybox Mipmap Generation", {0.4588f, 0.1294f, 0.9207f, 1.0f});
+
+        m_downsamplePipeline.Bind(cmdBuffer);
+        m_downsamplePipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+        for (u32 mip = 1; mip < skybox.mipLevels; ++mip)
+        {
+            skybox.Barrier
+            (
+                cmdBuffer,
+                Vk::ImageBarrier{
+                    .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                    .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                    .baseMipLevel   = mip - 1,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = skybox.arrayLayers
+                }
+            );
+
+            const auto downsampleConstants = Downsample::Constants
+            {
+                .SamplerIndex = textureManager.GetSampler(m_downsamplePipeline.samplerID).descriptorID,
+                .CubemapIndex = sampledViews[mip - 1].descriptorID,
+                .OutputIndex  = storageViews[mip].descriptorID
+            };
+
+            m_downsamplePipeline.PushConstants
+            (
+                cmdBuffer,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                downsampleConstants
+            );
 
-        vkCmdEndRendering(cmdBuffer.handle);
+            const u32 mipWidth  = std::max(skybox.width  >> mip, 1u);
+            const u32 mipHeight = std::max(skybox.height >> mip, 1u);
 
-        Vk::BeginLabel(cmdBuffer, "Skybox Mipmap Generation", {0.4588f, 0.1294f, 0.9207f, 1.0f});
+            vkCmdDispatch
+            (
+                cmdBuffer.handle,
+                (mipWidth  + 8 - 1) / 8,
+                (mipHeight + 8 - 1) / 8,
+                skybox.arrayLayers
+            );
+        }
 
         skybox.Barrier
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask    = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .srcAccessMask   = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .dstStageMask    = VK_PIPELINE_STAGE_2_BLIT_BIT,
-                .dstAccessMask   = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .oldLayout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .newLayout       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .srcQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel    = 0,
-                .levelCount      = skybox.mipLevels,
-                .baseArrayLayer  = 0,
-                .layerCount      = skybox.arrayLayers
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = skybox.mipLevels - 1,
+                .levelCount     = 1,
+                .baseArrayLayer = 0,
+                .layerCount     = skybox.arrayLayers
             }
         );
 
-        skybox.GenerateMipmaps(cmdBuffer);
-
         Vk::EndLabel(cmdBuffer);
 
         Vk::EndLabel(cmdBuffer);
 
+        transientViews.insert(transientViews.end(), storageViews.begin(), storageViews.end());
+        transientViews.insert(transientViews.end(), sampledViews.begin(), sampledViews.end());
+
         const auto skyboxView = Vk::ImageView
         (
             context.device,
@@ -425,7 +915,7 @@ namespace Renderer::IBL
             }
         );
 
-        const auto skyboxID = modelManager.textureManager.AddTexture
+        return textureManager.AddTexture
         (
             megaSet,
             context.device,
@@ -433,13 +923,6 @@ namespace Renderer::IBL
             skybox,
             skyboxView
         );
-
-        deletionQueue.PushDeletor([device = context.device, skyboxRenderView] () mutable
-        {
-            skyboxRenderView.Destroy(device);
-        });
-
-        return skyboxID;
     }
 
     Vk::TextureID Generator::GenerateIrradianceMap
@@ -448,8 +931,9 @@ namespace Renderer::IBL
         Vk::TextureID skyboxID,
         const Vk::Context& context,
         const Vk::FormatHelper& formatHelper,
-        Models::ModelManager& modelManager,
-        Vk::MegaSet& megaSet
+        Vk::TextureManager& textureManager,
+        Vk::MegaSet& megaSet,
+        std::vector<TransientView>& transientViews
     )
     {
         Vk::BeginLabel(cmdBuffer, "Irradiance Map Generation", {0.2988f, 0.2294f, 0.6607f, 1.0f});
@@ -462,13 +946,13 @@ namespace Renderer::IBL
                 .pNext                 = nullptr,
                 .flags                 = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
                 .imageType             = VK_IMAGE_TYPE_2D,
-                .format                = formatHelper.colorAttachmentFormatHDR,
+                .format                = formatHelper.storageFormatHDR,
                 .extent                = {IRRADIANCE_SIZE.x, IRRADIANCE_SIZE.y, 1},
                 .mipLevels             = 1,
                 .arrayLayers           = 6,
                 .samples               = VK_SAMPLE_COUNT_1_BIT,
                 .tiling                = VK_IMAGE_TILING_OPTIMAL,
-                .usage                 = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .usage                 = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
                 .queueFamilyIndexCount = 0,
                 .pQueueFamilyIndices   = nullptr,
@@ -481,28 +965,14 @@ namespace Renderer::IBL
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask    = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask   = VK_ACCESS_2_NONE,
-                .dstStageMask    = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .dstAccessMask   = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .oldLayout       = VK_IMAGE_LAYOUT_UNDEFINED,
-                .newLayout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .srcQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel    = 0,
-                .levelCount      = irradianceMap.mipLevels,
-                .baseArrayLayer  = 0,
-                .layerCount      = irradianceMap.arrayLayers
-            }
-        );
-
-        const auto irradianceView = Vk::ImageView
-        (
-            context.device,
-            irradianceMap,
-            VK_IMAGE_VIEW_TYPE_CUBE,
-            {
-                .aspectMask     = irradianceMap.aspect,
+                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
                 .levelCount     = irradianceMap.mipLevels,
                 .baseArrayLayer = 0,
@@ -510,113 +980,73 @@ namespace Renderer::IBL
             }
         );
 
-        const VkRenderingAttachmentInfo colorAttachmentInfo =
-        {
-            .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-            .pNext              = nullptr,
-            .imageView          = irradianceView.handle,
-            .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            .resolveMode        = VK_RESOLVE_MODE_NONE,
-            .resolveImageView   = VK_NULL_HANDLE,
-            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .loadOp             = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-            .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-            .clearValue         = {}
-        };
-
-        const VkRenderingInfo renderInfo =
-        {
-            .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
-            .pNext                = nullptr,
-            .flags                = 0,
-            .renderArea           = {
-                .offset = {0, 0},
-                .extent = {irradianceMap.width, irradianceMap.height}
-            },
-            .layerCount           = 1,
-            .viewMask             = 0b00111111,
-            .colorAttachmentCount = 1,
-            .pColorAttachments    = &colorAttachmentInfo,
-            .pDepthAttachment     = nullptr,
-            .pStencilAttachment   = nullptr
-        };
+        const auto& storageView = transientViews.emplace_back(CreateTransientView(context.device, megaSet, irradianceMap, VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, true));
 
-        vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
+        megaSet.Update(context.device);
 
         m_convolutionPipeline.Bind(cmdBuffer);
 
-        const VkViewport viewport =
-        {
-            .x        = 0.0f,
-            .y        = 0.0f,
-            .width    = static_cast<f32>(irradianceMap.width),
-            .height   = static_cast<f32>(irradianceMap.height),
-            .minDepth = 0.0f,
-            .maxDepth = 1.0f
-        };
-
-        vkCmdSetViewportWithCount(cmdBuffer.handle, 1, &viewport);
-
-        const VkRect2D scissor =
-        {
-            .offset = {0, 0},
-            .extent = {irradianceMap.width, irradianceMap.height}
-        };
-
-        vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
-
         const auto constants = Convolution::Constants
         {
-            .Vertices     = modelManager.geometryBuffer.cubeBuffer.deviceAddress,
-            .Matrices     = m_matrixBuffer.deviceAddress,
-            .SamplerIndex = modelManager.textureManager.GetSampler(m_convolutionPipeline.samplerID).descriptorID,
-            .EnvMapIndex  = modelManager.textureManager.GetTexture(skyboxID).descriptorID
+            .SamplerIndex = textureManager.GetSampler(m_convolutionPipeline.samplerID).descriptorID,
+            .EnvMapIndex  = textureManager.GetTexture(skyboxID).descriptorID,
+            .OutputIndex  = storageView.descriptorID
         };
 
         m_convolutionPipeline.PushConstants
         (
             cmdBuffer,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            VK_SHADER_STAGE_COMPUTE_BIT,
             constants
         );
 
-        // Mega set
         const std::array descriptorSets = {megaSet.descriptorSet};
         m_convolutionPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
 
-        vkCmdDraw
+        vkCmdDispatch
         (
             cmdBuffer.handle,
-            36,
-            1,
-            0,
-            0
+            (irradianceMap.width  + 8 - 1) / 8,
+            (irradianceMap.height + 8 - 1) / 8,
+            irradianceMap.arrayLayers
         );
 
-        vkCmdEndRendering(cmdBuffer.handle);
-
         irradianceMap.Barrier
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask    = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .srcAccessMask   = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .dstStageMask    = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask   = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel    = 0,
-                .levelCount      = irradianceMap.mipLevels,
-                .baseArrayLayer  = 0,
-                .layerCount      = irradianceMap.arrayLayers
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = irradianceMap.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = irradianceMap.arrayLayers
             }
         );
 
         Vk::EndLabel(cmdBuffer);
 
-        return modelManager.textureManager.AddTexture
+        const auto irradianceView = Vk::ImageView
+        (
+            context.device,
+            irradianceMap,
+            VK_IMAGE_VIEW_TYPE_CUBE,
+            {
+                .aspectMask     = irradianceMap.aspect,
+                .baseMipLevel   = 0,
+                .levelCount     = irradianceMap.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = irradianceMap.arrayLayers
+            }
+        );
+
+        return textureManager.AddTexture
         (
             megaSet,
             context.device,
@@ -626,15 +1056,15 @@ namespace Renderer::IBL
         );
     }
 
-    [[nodiscard]] Vk::TextureID Generator::GeneratePreFilterMap
+    Vk::TextureID Generator::GeneratePreFilterMap
     (
         const Vk::CommandBuffer& cmdBuffer,
         Vk::TextureID skyboxID,
         const Vk::Context& context,
         const Vk::FormatHelper& formatHelper,
-        Models::ModelManager& modelManager,
+        Vk::TextureManager& textureManager,
         Vk::MegaSet& megaSet,
-        Util::DeletionQueue& deletionQueue
+        std::vector<TransientView>& transientViews
     )
     {
         Vk::BeginLabel(cmdBuffer, "PreFilter Map Generation", {0.2928f, 0.4794f, 0.6607f, 1.0f});
@@ -647,13 +1077,13 @@ namespace Renderer::IBL
                 .pNext                 = nullptr,
                 .flags                 = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
                 .imageType             = VK_IMAGE_TYPE_2D,
-                .format                = formatHelper.colorAttachmentFormatHDR,
+                .format                = formatHelper.storageFormatHDR,
                 .extent                = {PRE_FILTER_SIZE.x, PRE_FILTER_SIZE.y, 1},
                 .mipLevels             = PREFILTER_MIPMAP_LEVELS,
                 .arrayLayers           = 6,
                 .samples               = VK_SAMPLE_COUNT_1_BIT,
                 .tiling                = VK_IMAGE_TILING_OPTIMAL,
-                .usage                 = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .usage                 = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
                 .queueFamilyIndexCount = 0,
                 .pQueueFamilyIndices   = nullptr,
@@ -666,108 +1096,50 @@ namespace Renderer::IBL
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask    = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask   = VK_ACCESS_2_NONE,
-                .dstStageMask    = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .dstAccessMask   = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .oldLayout       = VK_IMAGE_LAYOUT_UNDEFINED,
-                .newLayout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .srcQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel    = 0,
-                .levelCount      = preFilterMap.mipLevels,
-                .baseArrayLayer  = 0,
-                .layerCount      = preFilterMap.arrayLayers
+                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = preFilterMap.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = preFilterMap.arrayLayers
             }
         );
 
-        std::array<Vk::ImageView, PREFILTER_MIPMAP_LEVELS> preFilterRenderViews = {};
+        std::array<TransientView, PREFILTER_MIPMAP_LEVELS> storageViews = {};
 
-        for (usize mip = 0; mip < preFilterRenderViews.size(); ++mip)
+        for (u32 mip = 0; mip < storageViews.size(); ++mip)
         {
-            Vk::BeginLabel(cmdBuffer, fmt::format("Mip #{}", mip), {0.5882f, 0.9294f, 0.2117f, 1.0f});
-
-            const auto mipWidth  = static_cast<u32>(preFilterMap.width  * std::pow(0.5f, mip));
-            const auto mipHeight = static_cast<u32>(preFilterMap.height * std::pow(0.5f, mip));
-
-            const auto roughness = static_cast<f32>(mip) / static_cast<f32>(preFilterMap.mipLevels - 1);
-            const auto sampleCount    = static_cast<u32>(std::floor(std::pow(2, (roughness * std::log2(PREFILTER_SAMPLE_COUNT)))));
-
-            preFilterRenderViews[mip] = Vk::ImageView
-            (
-                context.device,
-                preFilterMap,
-                VK_IMAGE_VIEW_TYPE_CUBE,
-                {
-                    .aspectMask     = preFilterMap.aspect,
-                    .baseMipLevel   = static_cast<u32>(mip),
-                    .levelCount     = 1,
-                    .baseArrayLayer = 0,
-                    .layerCount     = preFilterMap.arrayLayers
-                }
-            );
-
-            const VkRenderingAttachmentInfo colorAttachmentInfo =
-            {
-                .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-                .pNext              = nullptr,
-                .imageView          = preFilterRenderViews[mip].handle,
-                .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .resolveMode        = VK_RESOLVE_MODE_NONE,
-                .resolveImageView   = VK_NULL_HANDLE,
-                .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-                .loadOp             = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-                .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-                .clearValue         = {}
-            };
-
-            const VkRenderingInfo renderInfo =
-            {
-                .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
-                .pNext                = nullptr,
-                .flags                = 0,
-                .renderArea           = {
-                    .offset = {0, 0},
-                    .extent = {mipWidth, mipHeight}
-                },
-                .layerCount           = 1,
-                .viewMask             = 0b00111111,
-                .colorAttachmentCount = 1,
-                .pColorAttachments    = &colorAttachmentInfo,
-                .pDepthAttachment     = nullptr,
-                .pStencilAttachment   = nullptr
-            };
+            storageViews[mip] = CreateTransientView(context.device, megaSet, preFilterMap, VK_IMAGE_VIEW_TYPE_2D_ARRAY, mip, true);
+        }
 
-            vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
+        megaSet.Update(context.device);
 
-            m_preFilterPipeline.Bind(cmdBuffer);
+        m_preFilterPipeline.Bind(cmdBuffer);
 
-            const VkViewport viewport =
-            {
-                .x        = 0.0f,
-                .y        = 0.0f,
-                .width    = static_cast<f32>(mipWidth),
-                .height   = static_cast<f32>(mipHeight),
-                .minDepth = 0.0f,
-                .maxDepth = 1.0f
-            };
+        const std::array descriptorSets = {megaSet.descriptorSet};
+        m_preFilterPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
 
-            vkCmdSetViewportWithCount(cmdBuffer.handle, 1, &viewport);
+        for (u32 mip = 0; mip < storageViews.size(); ++mip)
+        {
+            Vk::BeginLabel(cmdBuffer, fmt::format("Mip #{}", mip), {0.5882f, 0.9294f, 0.2117f, 1.0f});
 
-            const VkRect2D scissor =
-            {
-                .offset = {0, 0},
-                .extent = {mipWidth, mipHeight}
-            };
+            const u32 mipWidth  = std::max(preFilterMap.width  >> mip, 1u);
+            const u32 mipHeight = std::max(preFilterMap.height >> mip, 1u);
 
-            vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
+            const auto roughness   = static_cast<f32>(mip) / static_cast<f32>(preFilterMap.mipLevels - 1);
+            const auto sampleCount = static_cast<u32>(std::floor(std::pow(2, (roughness * std::log2(PREFILTER_SAMPLE_COUNT)))));
 
             const auto constants = PreFilter::Constants
             {
-                .Vertices     = modelManager.geometryBuffer.cubeBuffer.deviceAddress,
-                .Matrices     = m_matrixBuffer.deviceAddress,
-                .SamplerIndex = modelManager.textureManager.GetSampler(m_preFilterPipeline.samplerID).descriptorID,
-                .EnvMapIndex  = modelManager.textureManager.GetTexture(skyboxID).descriptorID ,
+                .SamplerIndex = textureManager.GetSampler(m_preFilterPipeline.samplerID).descriptorID,
+                .EnvMapIndex  = textureManager.GetTexture(skyboxID).descriptorID,
+                .OutputIndex  = storageViews[mip].descriptorID,
                 .Roughness    = roughness,
                 .SampleCount  = sampleCount
             };
@@ -775,25 +1147,18 @@ namespace Renderer::IBL
             m_preFilterPipeline.PushConstants
             (
                 cmdBuffer,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                VK_SHADER_STAGE_COMPUTE_BIT,
                 constants
             );
 
-            // Mega set
-            const std::array descriptorSets = {megaSet.descriptorSet};
-            m_preFilterPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
-
-            vkCmdDraw
+            vkCmdDispatch
             (
                 cmdBuffer.handle,
-                36,
-                1,
-                0,
-                0
+                (mipWidth  + 8 - 1) / 8,
+                (mipHeight + 8 - 1) / 8,
+                preFilterMap.arrayLayers
             );
 
-            vkCmdEndRendering(cmdBuffer.handle);
-
             Vk::EndLabel(cmdBuffer);
         }
 
@@ -801,23 +1166,25 @@ namespace Renderer::IBL
         (
             cmdBuffer,
             Vk::ImageBarrier{
-                .srcStageMask    = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .srcAccessMask   = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                .dstStageMask    = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask   = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                .newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily  = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel    = 0,
-                .levelCount      = preFilterMap.mipLevels,
-                .baseArrayLayer  = 0,
-                .layerCount      = preFilterMap.arrayLayers
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = preFilterMap.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = preFilterMap.arrayLayers
             }
         );
 
         Vk::EndLabel(cmdBuffer);
 
+        transientViews.insert(transientViews.end(), storageViews.begin(), storageViews.end());
+
         const auto preFilterView = Vk::ImageView
         (
             context.device,
@@ -832,7 +1199,7 @@ namespace Renderer::IBL
             }
         );
 
-        const auto preFilterID = modelManager.textureManager.AddTexture
+        return textureManager.AddTexture
         (
             megaSet,
             context.device,
@@ -840,16 +1207,6 @@ namespace Renderer::IBL
             preFilterMap,
             preFilterView
         );
-
-        deletionQueue.PushDeletor([device = context.device, preFilterRenderViews] () mutable
-        {
-            for (const auto& view : preFilterRenderViews)
-            {
-                view.Destroy(device);
-            }
-        });
-
-        return preFilterID;
     }
 
     [[nodiscard]] Vk::TextureID Generator::GenerateBRDFLUT
@@ -1022,13 +1379,79 @@ namespace Renderer::IBL
         return m_brdfLutID.value();
     }
 
-    void Generator::Destroy(VkDevice device, VmaAllocator allocator)
+    Generator::TransientView Generator::CreateTransientView
+    (
+        VkDevice device,
+        Vk::MegaSet& megaSet,
+        const Vk::Image& image,
+        VkImageViewType viewType,
+        u32 mipLevel,
+        bool isStorage
+    )
+    {
+        const auto view = Vk::ImageView
+        (
+            device,
+            image,
+            viewType,
+            {
+                .aspectMask     = image.aspect,
+                .baseMipLevel   = mipLevel,
+                .levelCount     = 1,
+                .baseArrayLayer = 0,
+                .layerCount     = image.arrayLayers
+            }
+        );
+
+        return TransientView
+        {
+            .view         = view,
+            .descriptorID = isStorage ? megaSet.WriteStorageImage(view) : megaSet.WriteSampledImage(view),
+            .isStorage    = isStorage
+        };
+    }
+
+    void Generator::WriteMapBarriers
+    (
+        const Vk::TextureManager& textureManager,
+        const IBL::IBLMaps& iblMaps,
+        const Vk::ImageBarrier& barrier
+    )
+    {
+        for (const auto id : {iblMaps.skyboxID, iblMaps.irradianceMapID, iblMaps.preFilterMapID})
+        {
+            const auto& image = textureManager.GetTexture(id).image;
+
+            auto imageBarrier = barrier;
+
+            imageBarrier.baseMipLevel   = 0;
+            imageBarrier.levelCount     = image.mipLevels;
+            imageBarrier.baseArrayLayer = 0;
+            imageBarrier.layerCount     = image.arrayLayers;
+
+            m_barrierWriter.WriteImageBarrier(image, imageBarrier);
+        }
+    }
+
+    void Generator::Destroy(VkDevice device)
     {
+        if (m_asyncGeneration.has_value())
+        {
+            for (const auto& transientView : m_asyncGeneration->transientViews)
+            {
+                transientView.view.Destroy(device);
+            }
+        }
+
+        if (m_asyncTimeline.has_value())
+        {
+            m_asyncTimeline->Destroy(device);
+        }
+
         m_converterPipeline.Destroy(device);
+        m_downsamplePipeline.Destroy(device);
         m_convolutionPipeline.Destroy(device);
         m_preFilterPipeline.Destroy(device);
         m_brdfLutPipeline.Destroy(device);
-
-        m_matrixBuffer.Destroy(allocator);
     }
 }
\ No newline at end of file
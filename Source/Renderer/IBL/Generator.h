@@ -21,7 +21,12 @@
 #include "Convolution/Pipeline.h"
 #include "BRDF/Pipeline.h"
 #include "Converter/Pipeline.h"
+#include "Downsample/Pipeline.h"
 #include "PreFilter/Pipeline.h"
+#include "Vulkan/GraphicsTimeline.h"
+#include "Vulkan/ComputeTimeline.h"
+#include "Vulkan/CommandBufferAllocator.h"
+#include "Vulkan/BarrierWriter.h"
 #include "Models/ModelManager.h"
 
 namespace Renderer::IBL
@@ -32,11 +37,12 @@ namespace Renderer::IBL
         Generator
         (
             const Vk::Context& context,
-            const Vk::FormatHelper& formatHelper,
             Vk::MegaSet& megaSet,
             Vk::TextureManager& textureManager
         );
 
+        // With an async compute queue this returns a default environment,
+        // the actual maps are generated by SubmitAsync() and swapped in by Update()
         IBL::IBLMaps Generate
         (
             const Vk::CommandBuffer& cmdBuffer,
@@ -48,8 +54,44 @@ namespace Renderer::IBL
             const std::string_view hdrMapAssetPath
         );
 
-        void Destroy(VkDevice device, VmaAllocator allocator);
+        void SubmitAsync
+        (
+            usize frameIndex,
+            const Vk::Context& context,
+            const Vk::FormatHelper& formatHelper,
+            const Vk::GraphicsTimeline& graphicsTimeline,
+            Vk::CommandBufferAllocator& computeCmdBufferAllocator,
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet
+        );
+
+        void Update
+        (
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::Context& context,
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue,
+            IBL::IBLMaps& iblMaps
+        );
+
+        void Destroy(VkDevice device);
     private:
+        struct TransientView
+        {
+            Vk::ImageView    view         = {};
+            Vk::DescriptorID descriptorID = 0;
+            bool             isStorage    = false;
+        };
+
+        struct AsyncGeneration
+        {
+            Vk::TextureID              hdrMapID       = 0;
+            IBL::IBLMaps               iblMaps        = {};
+            std::vector<TransientView> transientViews = {};
+            bool                       isSubmitted    = false;
+        };
+
         [[nodiscard]] Vk::TextureID LoadHDRMap
         (
             const Vk::CommandBuffer& cmdBuffer,
@@ -60,15 +102,35 @@ namespace Renderer::IBL
             const std::string_view hdrMapAssetPath
         );
 
+        [[nodiscard]] IBL::IBLMaps GenerateDefault
+        (
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::Context& context,
+            const Vk::FormatHelper& formatHelper,
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet
+        );
+
+        [[nodiscard]] Vk::TextureID CreateDefaultCubemap
+        (
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::Context& context,
+            const Vk::FormatHelper& formatHelper,
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet,
+            const std::string_view name,
+            u32 mipLevels
+        );
+
         [[nodiscard]] Vk::TextureID GenerateSkybox
         (
             const Vk::CommandBuffer& cmdBuffer,
             Vk::TextureID hdrMapID,
             const Vk::Context& context,
             const Vk::FormatHelper& formatHelper,
-            Models::ModelManager& modelManager,
+            Vk::TextureManager& textureManager,
             Vk::MegaSet& megaSet,
-            Util::DeletionQueue& deletionQueue
+            std::vector<TransientView>& transientViews
         );
 
         [[nodiscard]] Vk::TextureID GenerateIrradianceMap
@@ -77,8 +139,9 @@ namespace Renderer::IBL
             Vk::TextureID skyboxID,
             const Vk::Context& context,
             const Vk::FormatHelper& formatHelper,
-            Models::ModelManager& modelManager,
-            Vk::MegaSet& megaSet
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet,
+            std::vector<TransientView>& transientViews
         );
 
         [[nodiscard]] Vk::TextureID GeneratePreFilterMap
@@ -87,9 +150,9 @@ namespace Renderer::IBL
             Vk::TextureID skyboxID,
             const Vk::Context& context,
             const Vk::FormatHelper& formatHelper,
-            Models::ModelManager& modelManager,
+            Vk::TextureManager& textureManager,
             Vk::MegaSet& megaSet,
-            Util::DeletionQueue& deletionQueue
+            std::vector<TransientView>& transientViews
         );
 
         [[nodiscard]] Vk::TextureID GenerateBRDFLUT
@@ -100,15 +163,48 @@ namespace Renderer::IBL
             Vk::MegaSet& megaSet
         );
 
+        [[nodiscard]] static TransientView CreateTransientView
+        (
+            VkDevice device,
+            Vk::MegaSet& megaSet,
+            const Vk::Image& image,
+            VkImageViewType viewType,
+            u32 mipLevel,
+            bool isStorage
+        );
+
+        void WriteMapBarriers
+        (
+            const Vk::TextureManager& textureManager,
+            const IBL::IBLMaps& iblMaps,
+            const Vk::ImageBarrier& barrier
+        );
+
+        void CancelAsync
+        (
+            const Vk::Context& context,
+            Vk::TextureManager& textureManager,
+            Vk::MegaSet& megaSet,
+            Util::DeletionQueue& deletionQueue
+        );
+
         Converter::Pipeline   m_converterPipeline;
+        Downsample::Pipeline  m_downsamplePipeline;
         Convolution::Pipeline m_convolutionPipeline;
         PreFilter::Pipeline   m_preFilterPipeline;
         BRDF::Pipeline        m_brdfLutPipeline;
 
-        Vk::Buffer m_matrixBuffer;
+        Vk::BarrierWriter m_barrierWriter = {};
 
         // Cache BRDF LUT
         std::optional<Vk::TextureID> m_brdfLutID = std::nullopt;
+
+        // Only present if we have a dedicated compute queue
+        std::optional<Vk::ComputeTimeline> m_asyncTimeline   = std::nullopt;
+        std::optional<AsyncGeneration>     m_asyncGeneration = std::nullopt;
+
+        usize             m_asyncGenerationIndex = 0;
+        Vk::CommandBuffer m_asyncCmdBuffer       = {};
     };
 }
 
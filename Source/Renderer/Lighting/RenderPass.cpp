@@ -22,6 +22,7 @@
 #include "Renderer/Depth/RenderPass.h"
 #include "Vulkan/DebugUtils.h"
 #include "Deferred/Lighting.h"
+#include "Deferred/LightCulling.h"
 
 namespace Renderer::Lighting
 {
@@ -33,8 +34,42 @@ namespace Renderer::Lighting
         Vk::MegaSet& megaSet,
         Vk::TextureManager& textureManager
     )
-        : m_pipeline(context, formatHelper, megaSet, textureManager)
+        : m_pipeline(context, formatHelper, megaSet, textureManager),
+          m_cullingPipeline(context)
     {
+        m_lightGridBuffer = Vk::Buffer
+        (
+            context.allocator,
+            GPU::LIGHT_GRID_CLUSTER_COUNT * sizeof(GPU::LightCluster),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE
+        );
+
+        m_lightGridBuffer.GetDeviceAddress(context.device);
+
+        Vk::SetDebugName(context.device, m_lightGridBuffer.handle, "Lighting/LightGridBuffer");
+
+        for (usize i = 0; i < m_overflowBuffers.size(); ++i)
+        {
+            m_overflowBuffers[i] = Vk::Buffer
+            (
+                context.allocator,
+                sizeof(u32),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+                VMA_MEMORY_USAGE_AUTO
+            );
+
+            m_overflowBuffers[i].GetDeviceAddress(context.device);
+
+            *static_cast<u32*>(m_overflowBuffers[i].allocationInfo.pMappedData) = 0;
+
+            Vk::SetDebugName(context.device, m_overflowBuffers[i].handle, fmt::format("Lighting/LightGridOverflowBuffer/{}", i));
+        }
+
         framebufferManager.AddFramebuffer
         (
             "SceneColor",
@@ -85,6 +120,8 @@ namespace Renderer::Lighting
     {
         Vk::BeginLabel(cmdBuffer, "Lighting", glm::vec4(0.6098f, 0.1843f, 0.7549f, 1.0f));
 
+        CullLights(FIF, cmdBuffer, sceneBuffer);
+
         const auto& colorAttachmentView = framebufferManager.GetFramebufferView("SceneColorView");
         const auto& colorAttachment     = framebufferManager.GetFramebuffer(colorAttachmentView.framebuffer);
 
@@ -146,8 +183,8 @@ namespace Renderer::Lighting
         {
             .x        = 0.0f,
             .y        = 0.0f,
-            .width    = static_cast<f32>(colorAttachment.image.width),
-            .height   = static_cast<f32>(colorAttachment.image.height),
+            .width    = static_cast<f32>(sceneBuffer.renderExtent.width),
+            .height   = static_cast<f32>(sceneBuffer.renderExtent.height),
             .minDepth = 0.0f,
             .maxDepth = 1.0f
         };
@@ -157,7 +194,7 @@ namespace Renderer::Lighting
         const VkRect2D scissor =
         {
             .offset = {0, 0},
-            .extent = {colorAttachment.image.width, colorAttachment.image.height}
+            .extent = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height}
         };
 
         vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
@@ -165,19 +202,19 @@ namespace Renderer::Lighting
         const auto constants = Lighting::Constants
         {
             .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+            .LightGrid           = m_lightGridBuffer.deviceAddress,
             .GBufferSamplerIndex = textureManager.GetSampler(m_pipeline.gBufferSamplerID).descriptorID,
             .IBLSamplerIndex     = textureManager.GetSampler(m_pipeline.iblSamplerID).descriptorID,
             .ShadowSamplerIndex  = textureManager.GetSampler(m_pipeline.shadowSamplerID).descriptorID,
             .GAlbedoIndex        = framebufferManager.GetFramebufferView("GAlbedoReflectanceView").sampledImageID,
             .GNormalIndex        = framebufferManager.GetFramebufferView("GNormalView").sampledImageID,
-            .GRghMtlIndex        = framebufferManager.GetFramebufferView("GRoughnessMetallicView").sampledImageID,
             .GEmmisiveIndex      = framebufferManager.GetFramebufferView("GEmmisiveView").sampledImageID,
             .SceneDepthIndex     = framebufferManager.GetFramebufferView("SceneDepthView").sampledImageID,
             .IrradianceIndex     = textureManager.GetTexture(iblMaps.irradianceMapID).descriptorID,
             .PreFilterIndex      = textureManager.GetTexture(iblMaps.preFilterMapID).descriptorID,
             .BRDFLUTIndex        = textureManager.GetTexture(iblMaps.brdfLutID).descriptorID,
             .ShadowMapIndex      = framebufferManager.GetFramebufferView("ShadowRTView").sampledImageID,
-            .PointShadowMapIndex = framebufferManager.GetFramebufferView("PointShadowMapView").sampledImageID,
+            .ShadowAtlasIndex    = framebufferManager.GetFramebufferView("ShadowAtlasView").sampledImageID,
             .AOIndex             = framebufferManager.GetFramebufferView("VBGTAO/OcclusionView").sampledImageID
         };
 
@@ -205,8 +242,108 @@ namespace Renderer::Lighting
         Vk::EndLabel(cmdBuffer);
     }
 
-    void RenderPass::Destroy(VkDevice device)
+    void RenderPass::CullLights
+    (
+        usize FIF,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Buffers::SceneBuffer& sceneBuffer
+    )
+    {
+        Vk::BeginLabel(cmdBuffer, "Light Culling", glm::vec4(0.4098f, 0.2843f, 0.7549f, 1.0f));
+
+        // Written the last time this frame in flight was recorded, its fence has been waited on since
+        auto& overflowCount = *static_cast<u32*>(m_overflowBuffers[FIF].allocationInfo.pMappedData);
+
+        if (overflowCount > 0 && !m_hasOverflowed)
+        {
+            Logger::Warning
+            (
+                "Light clusters overflowed, some lights will not be shaded! [Clusters={}] [MaxLightsPerCluster={}]\n",
+                overflowCount,
+                GPU::MAX_LIGHTS_PER_CLUSTER
+            );
+        }
+
+        m_hasOverflowed = overflowCount > 0;
+        overflowCount   = 0;
+
+        // Previous frame's lighting reads
+        m_lightGridBuffer.Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_NONE,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        );
+
+        m_cullingPipeline.Bind(cmdBuffer);
+
+        const auto constants = Culling::Constants
+        {
+            .Scene     = sceneBuffer.buffers[FIF].deviceAddress,
+            .LightGrid = m_lightGridBuffer.deviceAddress,
+            .Overflow  = m_overflowBuffers[FIF].deviceAddress
+        };
+
+        m_cullingPipeline.PushConstants
+        (
+            cmdBuffer,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            constants
+        );
+
+        vkCmdDispatch(cmdBuffer.handle, (GPU::LIGHT_GRID_CLUSTER_COUNT + 63) / 64, 1, 1);
+
+        m_lightGridBuffer.Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        );
+
+        m_overflowBuffers[FIF].Barrier
+        (
+            cmdBuffer,
+            Vk::BufferBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .srcAccessMask  = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_HOST_BIT,
+                .dstAccessMask  = VK_ACCESS_2_HOST_READ_BIT,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .offset         = 0,
+                .size           = VK_WHOLE_SIZE
+            }
+        );
+
+        Vk::EndLabel(cmdBuffer);
+    }
+
+    void RenderPass::Destroy(VkDevice device, VmaAllocator allocator)
     {
+        m_lightGridBuffer.Destroy(allocator);
+
+        for (auto& buffer : m_overflowBuffers)
+        {
+            buffer.Destroy(allocator);
+        }
+
         m_pipeline.Destroy(device);
+        m_cullingPipeline.Destroy(device);
     }
 }
@@ -17,7 +17,11 @@
 #ifndef LIGHTING_PASS_H
 #define LIGHTING_PASS_H
 
+#include <array>
+
 #include "Pipeline.h"
+#include "Culling/Pipeline.h"
+#include "Vulkan/Constants.h"
 #include "Vulkan/CommandBuffer.h"
 #include "Vulkan/MegaSet.h"
 #include "Vulkan/FramebufferManager.h"
@@ -38,7 +42,7 @@ namespace Renderer::Lighting
             Vk::TextureManager& textureManager
         );
 
-        void Destroy(VkDevice device);
+        void Destroy(VkDevice device, VmaAllocator allocator);
 
         void Render
         (
@@ -51,7 +55,22 @@ namespace Renderer::Lighting
             const IBL::IBLMaps& iblMaps
         );
     private:
-        Lighting::Pipeline m_pipeline;
+        void CullLights
+        (
+            usize FIF,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Buffers::SceneBuffer& sceneBuffer
+        );
+
+        Lighting::Pipeline          m_pipeline;
+        Lighting::Culling::Pipeline m_cullingPipeline;
+
+        // Per cluster light lists, rebuilt every frame
+        Vk::Buffer m_lightGridBuffer;
+
+        // Host visible, counts clusters that dropped lights
+        std::array<Vk::Buffer, Vk::FRAMES_IN_FLIGHT> m_overflowBuffers = {};
+        bool                                         m_hasOverflowed   = false;
     };
 }
 
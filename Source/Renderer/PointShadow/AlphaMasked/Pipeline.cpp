@@ -26,7 +26,8 @@ namespace Renderer::PointShadow::AlphaMasked
         const Vk::Context& context,
         const Vk::FormatHelper& formatHelper,
         Vk::MegaSet& megaSet,
-        Vk::TextureManager& textureManager
+        Vk::TextureManager& textureManager,
+        bool isMultiFace
     )
     {
         constexpr std::array DYNAMIC_STATES =
@@ -41,7 +42,7 @@ namespace Renderer::PointShadow::AlphaMasked
         std::tie(handle, layout, bindPoint) = Vk::PipelineBuilder(context)
             .SetPipelineType(VK_PIPELINE_BIND_POINT_GRAPHICS)
             .SetRenderingInfo(0, COLOR_FORMATS, formatHelper.depthFormat)
-            .AttachShader("Shadows/PointShadow/AlphaMasked.vert", VK_SHADER_STAGE_VERTEX_BIT)
+            .AttachShader(isMultiFace ? "Shadows/PointShadow/AlphaMaskedMultiFace.vert" : "Shadows/PointShadow/AlphaMasked.vert", VK_SHADER_STAGE_VERTEX_BIT)
             .AttachShader("Shadows/PointShadow/AlphaMasked.frag", VK_SHADER_STAGE_FRAGMENT_BIT)
             .SetDynamicStates(DYNAMIC_STATES)
             .SetIAState(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
@@ -94,7 +95,7 @@ namespace Renderer::PointShadow::AlphaMasked
 
         megaSet.Update(context.device);
 
-        Vk::SetDebugName(context.device, handle, "PointShadow/AlphaMasked/Pipeline");
-        Vk::SetDebugName(context.device, layout, "PointShadow/AlphaMasked/Pipeline/Layout");
+        Vk::SetDebugName(context.device, handle, isMultiFace ? "PointShadow/AlphaMaskedMultiFace/Pipeline"        : "PointShadow/AlphaMasked/Pipeline");
+        Vk::SetDebugName(context.device, layout, isMultiFace ? "PointShadow/AlphaMaskedMultiFace/Pipeline/Layout" : "PointShadow/AlphaMasked/Pipeline/Layout");
     }
 }
\ No newline at end of file
@@ -27,12 +27,14 @@ namespace Renderer::PointShadow::AlphaMasked
     class Pipeline : public Vk::Pipeline
     {
     public:
+        // Multi-face pipelines route each instance to its face's viewport, they need Context::isViewportIndexSupported
         Pipeline
         (
             const Vk::Context& context,
             const Vk::FormatHelper& formatHelper,
             Vk::MegaSet& megaSet,
-            Vk::TextureManager& textureManager
+            Vk::TextureManager& textureManager,
+            bool isMultiFace
         );
 
         Vk::SamplerID textureSamplerID = 0;
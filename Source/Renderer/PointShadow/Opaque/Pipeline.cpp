@@ -21,7 +21,7 @@
 
 namespace Renderer::PointShadow::Opaque
 {
-    Pipeline::Pipeline(const Vk::Context& context, const Vk::FormatHelper& formatHelper)
+    Pipeline::Pipeline(const Vk::Context& context, const Vk::FormatHelper& formatHelper, bool isMultiFace)
     {
         constexpr std::array DYNAMIC_STATES =
         {
@@ -35,7 +35,7 @@ namespace Renderer::PointShadow::Opaque
         std::tie(handle, layout, bindPoint) = Vk::PipelineBuilder(context)
             .SetPipelineType(VK_PIPELINE_BIND_POINT_GRAPHICS)
             .SetRenderingInfo(0, COLOR_FORMATS, formatHelper.depthFormat)
-            .AttachShader("Shadows/PointShadow/Opaque.vert", VK_SHADER_STAGE_VERTEX_BIT)
+            .AttachShader(isMultiFace ? "Shadows/PointShadow/OpaqueMultiFace.vert" : "Shadows/PointShadow/Opaque.vert", VK_SHADER_STAGE_VERTEX_BIT)
             .AttachShader("Shadows/PointShadow/Opaque.frag", VK_SHADER_STAGE_FRAGMENT_BIT)
             .SetDynamicStates(DYNAMIC_STATES)
             .SetIAState(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
@@ -57,7 +57,7 @@ namespace Renderer::PointShadow::Opaque
             .AddPushConstant(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(Opaque::Constants))
             .Build();
 
-        Vk::SetDebugName(context.device, handle, "PointShadow/Opaque/Pipeline");
-        Vk::SetDebugName(context.device, layout, "PointShadow/Opaque/Pipeline/Layout");
+        Vk::SetDebugName(context.device, handle, isMultiFace ? "PointShadow/OpaqueMultiFace/Pipeline"        : "PointShadow/Opaque/Pipeline");
+        Vk::SetDebugName(context.device, layout, isMultiFace ? "PointShadow/OpaqueMultiFace/Pipeline/Layout" : "PointShadow/Opaque/Pipeline/Layout");
     }
 }
\ No newline at end of file
@@ -25,7 +25,8 @@ namespace Renderer::PointShadow::Opaque
     class Pipeline : public Vk::Pipeline
     {
     public:
-        Pipeline(const Vk::Context& context, const Vk::FormatHelper& formatHelper);
+        // Multi-face pipelines route each instance to its face's viewport, they need Context::isViewportIndexSupported
+        Pipeline(const Vk::Context& context, const Vk::FormatHelper& formatHelper, bool isMultiFace);
     };
 }
 
@@ -18,8 +18,10 @@
 
 #include "Vulkan/DebugUtils.h"
 #include "Util/Log.h"
+#include "Util/Hash.h"
 #include "Shadows/PointShadow/Opaque.h"
 #include "Shadows/PointShadow/AlphaMasked.h"
+#include "Culling/MultiViewLayout.h"
 
 namespace Renderer::PointShadow
 {
@@ -31,20 +33,26 @@ namespace Renderer::PointShadow
         Vk::MegaSet& megaSet,
         Vk::TextureManager& textureManager
     )
-        : m_opaquePipeline(context, formatHelper),
-          m_alphaMaskedPipeline(context, formatHelper, megaSet, textureManager)
+        : m_opaquePipeline(context, formatHelper, false),
+          m_alphaMaskedPipeline(context, formatHelper, megaSet, textureManager, false)
     {
+        if (context.isViewportIndexSupported)
+        {
+            m_opaqueMultiFacePipeline.emplace(context, formatHelper, true);
+            m_alphaMaskedMultiFacePipeline.emplace(context, formatHelper, megaSet, textureManager, true);
+        }
+
         framebufferManager.AddFramebuffer
         (
-            "PointShadowMap",
+            "ShadowAtlas",
             Vk::FramebufferType::ColorR_SFloat32,
-            Vk::FramebufferImageType::ArrayCube,
+            Vk::FramebufferImageType::Single2D,
             Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
             Vk::FramebufferSize{
-                .width       = GPU::POINT_SHADOW_DIMENSIONS.x,
-                .height      = GPU::POINT_SHADOW_DIMENSIONS.y,
+                .width       = GPU::SHADOW_ATLAS_SIZE,
+                .height      = GPU::SHADOW_ATLAS_SIZE,
                 .mipLevels   = 1,
-                .arrayLayers = 6 * GPU::MAX_SHADOWED_POINT_LIGHT_COUNT
+                .arrayLayers = 1
             },
             Vk::FramebufferInitialState{
                 .dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
@@ -55,13 +63,13 @@ namespace Renderer::PointShadow
 
         framebufferManager.AddFramebuffer
         (
-            "PointShadowDepth",
+            "ShadowAtlasDepth",
             Vk::FramebufferType::Depth,
             Vk::FramebufferImageType::Single2D,
             Vk::FramebufferUsage::Attachment | Vk::FramebufferUsage::Sampled,
             Vk::FramebufferSize{
-                .width       = GPU::POINT_SHADOW_DIMENSIONS.x,
-                .height      = GPU::POINT_SHADOW_DIMENSIONS.y,
+                .width       = GPU::SHADOW_ATLAS_SIZE,
+                .height      = GPU::SHADOW_ATLAS_SIZE,
                 .mipLevels   = 1,
                 .arrayLayers = 1
             },
@@ -74,40 +82,21 @@ namespace Renderer::PointShadow
 
         framebufferManager.AddFramebufferView
         (
-            "PointShadowMap",
-            "PointShadowMapView",
-            Vk::FramebufferImageType::ArrayCube,
+            "ShadowAtlas",
+            "ShadowAtlasView",
+            Vk::FramebufferImageType::Single2D,
             Vk::FramebufferViewSize{
                 .baseMipLevel   = 0,
                 .levelCount     = 1,
                 .baseArrayLayer = 0,
-                .layerCount     = 6 * GPU::MAX_SHADOWED_POINT_LIGHT_COUNT,
+                .layerCount     = 1,
             }
         );
 
-        for (usize i = 0; i < GPU::MAX_SHADOWED_POINT_LIGHT_COUNT; ++i)
-        {
-            for (usize j = 0; j < 6; ++j)
-            {
-                framebufferManager.AddFramebufferView
-                (
-                    "PointShadowMap",
-                    fmt::format("PointShadowMapView/Light{}/{}", i, j),
-                    Vk::FramebufferImageType::Single2D,
-                    Vk::FramebufferViewSize{
-                        .baseMipLevel   = 0,
-                        .levelCount     = 1,
-                        .baseArrayLayer = static_cast<u32>(6 * i + j),
-                        .layerCount     = 1,
-                    }
-                );
-            }
-        }
-
         framebufferManager.AddFramebufferView
         (
-            "PointShadowDepth",
-            "PointShadowDepthView",
+            "ShadowAtlasDepth",
+            "ShadowAtlasDepthView",
             Vk::FramebufferImageType::Single2D,
             Vk::FramebufferViewSize{
                 .baseMipLevel   = 0,
@@ -129,27 +118,144 @@ namespace Renderer::PointShadow
         const Buffers::SceneBuffer& sceneBuffer,
         const Buffers::MeshBuffer& meshBuffer,
         const Buffers::IndirectBuffer& indirectBuffer,
+        const std::span<const Renderer::RenderObject> renderObjects,
+        const Culling::BVH& bvh,
         Culling::Dispatch& culling
-    ) const
+    )
     {
-        if (sceneBuffer.lightsBuffer.shadowedPointLights.empty())
+        const auto lightViews = GetLightViews(sceneBuffer.lightsBuffer);
+
+        // A repack can hand any tile to another light, nothing drawn before it can be trusted
+        if (const u64 atlasGeneration = sceneBuffer.lightsBuffer.GetShadowAtlasGeneration(); atlasGeneration != m_atlasGeneration)
+        {
+            m_faceHashes.fill({});
+
+            m_atlasGeneration = atlasGeneration;
+        }
+
+        // Slots without a light this frame lose their cache, their tiles may be drawn over before the light returns
+        std::array<bool, GPU::MAX_SHADOWED_POINT_LIGHT_COUNT + GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT> isSlotUsed = {};
+
+        for (const auto& light : lightViews)
+        {
+            isSlotUsed[light.cacheSlot] = true;
+        }
+
+        for (usize slot = 0; slot < m_faceHashes.size(); ++slot)
+        {
+            if (!isSlotUsed[slot])
+            {
+                m_faceHashes[slot].fill(std::nullopt);
+            }
+        }
+
+        if (lightViews.empty())
         {
             return;
         }
 
-        Vk::BeginLabel(cmdBuffer, "Point Light Shadows", glm::vec4(0.4196f, 0.6488f, 0.9588f, 1.0f));
+        const auto& shadowAtlas = framebufferManager.GetFramebuffer("ShadowAtlas");
+        const auto& depth       = framebufferManager.GetFramebuffer("ShadowAtlasDepth");
+
+        constexpr u32 NO_VIEW = std::numeric_limits<u32>::max();
+        constexpr u32 CACHED  = std::numeric_limits<u32>::max() - 1;
+
+        std::vector<std::array<u32, 6>> faceViews(lightViews.size());
+
+        std::vector<glm::mat4> projectionViews = {};
+        projectionViews.reserve(Culling::MultiView::MAX_CULLING_VIEWS);
+
+        std::vector<Culling::MultiView::ViewInfo> viewInfos = {};
+        viewInfos.reserve(Culling::MultiView::MAX_CULLING_VIEWS);
+
+        // Point lights draw all their faces at once when each instance can pick its face's viewport
+        const auto IsMultiFace = [this] (const LightViews& light)
+        {
+            return m_opaqueMultiFacePipeline.has_value() && (light.lightIndex & GPU::SHADOW_LIGHT_INDEX_SPOT_BIT) == 0;
+        };
+
+        bool hasDirtyFaces = false;
+
+        for (usize i = 0; i < lightViews.size(); ++i)
+        {
+            const auto& light = lightViews[i];
+
+            const bool isMultiFace = IsMultiFace(light);
+            const u32  firstView   = static_cast<u32>(projectionViews.size());
+
+            std::vector<GPU::FrustumBuffer> faceFrustums = {};
+            faceFrustums.reserve(light.matrices.size());
 
-        const auto& depthView = framebufferManager.GetFramebufferView("PointShadowDepthView");
+            for (const auto& matrix : light.matrices)
+            {
+                faceFrustums.emplace_back(matrix);
+            }
+
+            // Coarse pass over the scene BVH, faces without any casters are only cleared
+            std::array<std::vector<u32>, 6> faceCasters = {};
+            bvh.QueryFrustums(faceFrustums, std::span(faceCasters.data(), light.matrices.size()));
+
+            for (usize face = 0; face < light.matrices.size(); ++face)
+            {
+                const usize hash = HashFace
+                (
+                    shadowAtlas.image.handle,
+                    light.matrices[face],
+                    light.atlasRects[face],
+                    faceCasters[face],
+                    renderObjects
+                );
+
+                if (m_faceHashes[light.cacheSlot][face] == hash)
+                {
+                    faceViews[i][face] = CACHED;
+
+                    continue;
+                }
+
+                m_faceHashes[light.cacheSlot][face] = hash;
+                hasDirtyFaces                       = true;
+
+                if (faceCasters[face].empty())
+                {
+                    faceViews[i][face] = NO_VIEW;
+
+                    continue;
+                }
+
+                faceViews[i][face] = static_cast<u32>(projectionViews.size());
+                projectionViews.emplace_back(light.matrices[face]);
+
+                viewInfos.emplace_back(Culling::MultiView::ViewInfo{
+                    .groupView = isMultiFace ? firstView : faceViews[i][face],
+                    .groupSize = 1,
+                    .tag       = isMultiFace ? static_cast<u32>(face) : 0
+                });
+            }
+
+            // The light's faces are culled as one group, its first view holds the draws of every face
+            if (isMultiFace)
+            {
+                for (usize view = firstView; view < viewInfos.size(); ++view)
+                {
+                    viewInfos[view].groupSize = static_cast<u32>(viewInfos.size()) - firstView;
+                }
+            }
+        }
 
-        const auto& shadowMap = framebufferManager.GetFramebuffer("PointShadowMap");
-        const auto& depth     = framebufferManager.GetFramebuffer(depthView.framebuffer);
+        if (!hasDirtyFaces)
+        {
+            return;
+        }
+
+        Vk::BeginLabel(cmdBuffer, "Shadow Atlas", glm::vec4(0.4196f, 0.6488f, 0.9588f, 1.0f));
 
         Vk::BarrierWriter barrierWriter = {};
 
         barrierWriter
         .WriteImageBarrier
         (
-            shadowMap.image,
+            shadowAtlas.image,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
                 .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
@@ -160,9 +266,9 @@ namespace Renderer::PointShadow
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = shadowMap.image.mipLevels,
+                .levelCount     = shadowAtlas.image.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = 6 * static_cast<u32>(sceneBuffer.lightsBuffer.shadowedPointLights.size())
+                .layerCount     = shadowAtlas.image.arrayLayers
             }
         )
         .WriteImageBarrier
@@ -185,271 +291,113 @@ namespace Renderer::PointShadow
         )
         .Execute(cmdBuffer);
 
-        for (usize i = 0; i < sceneBuffer.lightsBuffer.shadowedPointLights.size(); ++i)
-        {
-            Vk::BeginLabel(cmdBuffer, fmt::format("Light #{}", i), glm::vec4(0.7146f, 0.2488f, 0.9388f, 1.0f));
-
-            for (usize face = 0; face < 6; ++face)
-            {
-                Vk::BeginLabel(cmdBuffer, fmt::format("Face #{}", face), glm::vec4(0.6146f, 0.8488f, 0.3388f, 1.0f));
-
-                culling.Frustum
-                (
-                    FIF,
-                    frameIndex,
-                    sceneBuffer.lightsBuffer.shadowedPointLights[i].matrices[face],
-                    cmdBuffer,
-                    meshBuffer,
-                    indirectBuffer
-                );
-
-                const auto shadowMapView = framebufferManager.GetFramebufferView(fmt::format("PointShadowMapView/Light{}/{}", i, face));
+        // Every face with casters is culled at once, otherwise each face is culled right before it is drawn
+        const bool isMultiView = culling.MultiView
+        (
+            FIF,
+            frameIndex,
+            projectionViews,
+            viewInfos,
+            cmdBuffer,
+            meshBuffer,
+            indirectBuffer
+        );
 
-                const VkRenderingAttachmentInfo colorAttachmentInfo =
-                {
-                    .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-                    .pNext              = nullptr,
-                    .imageView          = shadowMapView.view.handle,
-                    .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    .resolveMode        = VK_RESOLVE_MODE_NONE,
-                    .resolveImageView   = VK_NULL_HANDLE,
-                    .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-                    .loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR,
-                    .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-                    .clearValue         = {.color = {.float32 = {0.0f, 0.0f, 0.0f, 0.0f}}}
-                };
-
-                const VkRenderingAttachmentInfo depthAttachmentInfo =
-                {
-                    .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-                    .pNext              = nullptr,
-                    .imageView          = depthView.view.handle,
-                    .imageLayout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                    .resolveMode        = VK_RESOLVE_MODE_NONE,
-                    .resolveImageView   = VK_NULL_HANDLE,
-                    .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-                    .loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR,
-                    .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
-                    .clearValue         = {.depthStencil = {0.0f, 0x0}}
-                };
-
-                const VkRenderingInfo renderInfo =
-                {
-                    .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
-                    .pNext                = nullptr,
-                    .flags                = 0,
-                    .renderArea           = {
-                        .offset = {0, 0},
-                        .extent = {shadowMap.image.width, shadowMap.image.height}
-                    },
-                    .layerCount           = 1,
-                    .viewMask             = 0,
-                    .colorAttachmentCount = 1,
-                    .pColorAttachments    = &colorAttachmentInfo,
-                    .pDepthAttachment     = &depthAttachmentInfo,
-                    .pStencilAttachment   = nullptr
-                };
-
-                vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
-
-                const VkViewport viewport =
-                {
-                    .x        = 0.0f,
-                    .y        = 0.0f,
-                    .width    = static_cast<f32>(shadowMap.image.width),
-                    .height   = static_cast<f32>(shadowMap.image.height),
-                    .minDepth = 0.0f,
-                    .maxDepth = 1.0f
-                };
+        for (usize i = 0; i < lightViews.size(); ++i)
+        {
+            const auto& light = lightViews[i];
 
-                vkCmdSetViewportWithCount(cmdBuffer.handle, 1, &viewport);
+            std::vector<FaceDraw> faceDraws = {};
 
-                const VkRect2D scissor =
+            for (usize face = 0; face < light.matrices.size(); ++face)
+            {
+                if (faceViews[i][face] == CACHED)
                 {
-                    .offset = {0, 0},
-                    .extent = {shadowMap.image.width, shadowMap.image.height}
-                };
-
-                vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
+                    continue;
+                }
 
-                modelManager.geometryBuffer.Bind(cmdBuffer);
+                faceDraws.emplace_back(FaceDraw{
+                    .face       = static_cast<u32>(face),
+                    .hasCasters = faceViews[i][face] != NO_VIEW,
+                    .drawLists  = {}
+                });
 
-                // Opaque
+                if (isMultiView && faceDraws.back().hasCasters)
                 {
-                    Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
-
-                    m_opaquePipeline.Bind(cmdBuffer);
-
-                    // Single Sided
-                    {
-                        Vk::BeginLabel(cmdBuffer, "Single Sided", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
-
-                        vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_BACK_BIT);
-
-                        const auto constants = Opaque::Constants
-                        {
-                            .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
-                            .Meshes      = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                            .MeshIndices = indirectBuffer.frustumCulledBuffers.opaqueBuffer.meshIndexBuffer->deviceAddress,
-                            .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                            .LightIndex  = static_cast<u32>(i),
-                            .FaceIndex   = static_cast<u32>(face)
-                        };
-
-                        m_opaquePipeline.PushConstants
-                        (
-                           cmdBuffer,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                           constants
-                        );
-
-                        vkCmdDrawIndexedIndirectCount
-                        (
-                            cmdBuffer.handle,
-                            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
-                            sizeof(u32),
-                            indirectBuffer.frustumCulledBuffers.opaqueBuffer.drawCallBuffer.handle,
-                            0,
-                            indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                            sizeof(VkDrawIndexedIndirectCommand)
-                        );
-
-                        Vk::EndLabel(cmdBuffer);
-                    }
-
-                    // Double Sided
-                    {
-                        Vk::BeginLabel(cmdBuffer, "Double Sided", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
-
-                        vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_NONE);
-
-                        const auto constants = Opaque::Constants
-                        {
-                            .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
-                            .Meshes      = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                            .MeshIndices = indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
-                            .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                            .LightIndex  = static_cast<u32>(i),
-                            .FaceIndex   = static_cast<u32>(face)
-                        };
-
-                        m_opaquePipeline.PushConstants
-                        (
-                           cmdBuffer,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                           constants
-                        );
-
-                        vkCmdDrawIndexedIndirectCount
-                        (
-                            cmdBuffer.handle,
-                            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
-                            sizeof(u32),
-                            indirectBuffer.frustumCulledBuffers.opaqueDoubleSidedBuffer.drawCallBuffer.handle,
-                            0,
-                            indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                            sizeof(VkDrawIndexedIndirectCommand)
-                        );
-
-                        Vk::EndLabel(cmdBuffer);
-                    }
-
-                    Vk::EndLabel(cmdBuffer);
+                    faceDraws.back().drawLists = GetDrawLists(viewInfos[faceViews[i][face]].groupView, indirectBuffer);
                 }
+            }
 
-                // Alpha Masked
-                {
-                    Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
-
-                    m_alphaMaskedPipeline.Bind(cmdBuffer);
-
-                    const std::array descriptorSets = {megaSet.descriptorSet};
-                    m_alphaMaskedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
-
-                    // Single Sided
-                    {
-                        Vk::BeginLabel(cmdBuffer, "Single Sided", glm::vec4(0.3091f, 0.7243f, 0.2549f, 1.0f));
-
-                        vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_BACK_BIT);
-
-                        const auto constants = AlphaMasked::Constants
-                        {
-                            .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                            .Meshes              = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                            .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.meshIndexBuffer->deviceAddress,
-                            .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                            .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                            .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_alphaMaskedPipeline.textureSamplerID).descriptorID,
-                            .LightIndex          = static_cast<u32>(i),
-                            .FaceIndex           = static_cast<u32>(face)
-                        };
-
-                        m_alphaMaskedPipeline.PushConstants
-                        (
-                           cmdBuffer,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                           constants
-                        );
+            if (faceDraws.empty())
+            {
+                continue;
+            }
 
-                        vkCmdDrawIndexedIndirectCount
-                        (
-                            cmdBuffer.handle,
-                            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
-                            sizeof(u32),
-                            indirectBuffer.frustumCulledBuffers.alphaMaskedBuffer.drawCallBuffer.handle,
-                            0,
-                            indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                            sizeof(VkDrawIndexedIndirectCommand)
-                        );
+            const bool isSpotLight = (light.lightIndex & GPU::SHADOW_LIGHT_INDEX_SPOT_BIT) != 0;
 
-                        Vk::EndLabel(cmdBuffer);
-                    }
+            Vk::BeginLabel
+            (
+                cmdBuffer,
+                isSpotLight ?
+                fmt::format("Spot Light #{}", light.lightIndex & ~GPU::SHADOW_LIGHT_INDEX_SPOT_BIT) :
+                fmt::format("Point Light #{}", light.lightIndex),
+                glm::vec4(0.7146f, 0.2488f, 0.9388f, 1.0f)
+            );
 
-                    // Double Sided
+            if (isMultiView)
+            {
+                RenderLight
+                (
+                    FIF,
+                    frameIndex,
+                    cmdBuffer,
+                    framebufferManager,
+                    megaSet,
+                    modelManager,
+                    sceneBuffer,
+                    meshBuffer,
+                    indirectBuffer,
+                    light,
+                    faceDraws,
+                    IsMultiFace(light)
+                );
+            }
+            else
+            {
+                // The culled buffers are shared between faces, so each face gets its own pass right after being culled
+                for (auto& faceDraw : faceDraws)
+                {
+                    if (faceDraw.hasCasters)
                     {
-                        Vk::BeginLabel(cmdBuffer, "Double Sided", glm::vec4(0.6091f, 0.2213f, 0.2549f, 1.0f));
-
-                        vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_NONE);
-
-                        const auto constants = AlphaMasked::Constants
-                        {
-                            .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-                            .Meshes              = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
-                            .MeshIndices         = indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.meshIndexBuffer->deviceAddress,
-                            .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
-                            .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
-                            .TextureSamplerIndex = modelManager.textureManager.GetSampler(m_alphaMaskedPipeline.textureSamplerID).descriptorID,
-                            .LightIndex          = static_cast<u32>(i),
-                            .FaceIndex           = static_cast<u32>(face)
-                        };
-
-                        m_alphaMaskedPipeline.PushConstants
+                        const auto& culledBuffers = culling.Frustum
                         (
-                           cmdBuffer,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                           constants
+                            FIF,
+                            frameIndex,
+                            light.matrices[faceDraw.face],
+                            cmdBuffer,
+                            meshBuffer,
+                            indirectBuffer
                         );
 
-                        vkCmdDrawIndexedIndirectCount
-                        (
-                            cmdBuffer.handle,
-                            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
-                            sizeof(u32),
-                            indirectBuffer.frustumCulledBuffers.alphaMaskedDoubleSidedBuffer.drawCallBuffer.handle,
-                            0,
-                            indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
-                            sizeof(VkDrawIndexedIndirectCommand)
-                        );
-
-                        Vk::EndLabel(cmdBuffer);
+                        faceDraw.drawLists = GetDrawLists(culledBuffers);
                     }
 
-                    Vk::EndLabel(cmdBuffer);
+                    RenderLight
+                    (
+                        FIF,
+                        frameIndex,
+                        cmdBuffer,
+                        framebufferManager,
+                        megaSet,
+                        modelManager,
+                        sceneBuffer,
+                        meshBuffer,
+                        indirectBuffer,
+                        light,
+                        std::span(&faceDraw, 1),
+                        false
+                    );
                 }
-
-                vkCmdEndRendering(cmdBuffer.handle);
-
-                Vk::EndLabel(cmdBuffer);
             }
 
             Vk::EndLabel(cmdBuffer);
@@ -458,7 +406,7 @@ namespace Renderer::PointShadow
         barrierWriter
         .WriteImageBarrier
         (
-            shadowMap.image,
+            shadowAtlas.image,
             Vk::ImageBarrier{
                 .srcStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
                 .srcAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
@@ -469,9 +417,9 @@ namespace Renderer::PointShadow
                 .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
                 .baseMipLevel   = 0,
-                .levelCount     = shadowMap.image.mipLevels,
+                .levelCount     = shadowAtlas.image.mipLevels,
                 .baseArrayLayer = 0,
-                .layerCount     = 6 * static_cast<u32>(sceneBuffer.lightsBuffer.shadowedPointLights.size())
+                .layerCount     = shadowAtlas.image.arrayLayers
             }
         )
         .WriteImageBarrier
@@ -497,9 +445,510 @@ namespace Renderer::PointShadow
         Vk::EndLabel(cmdBuffer);
     }
 
+    void RenderPass::RenderLight
+    (
+        usize FIF,
+        usize frameIndex,
+        const Vk::CommandBuffer& cmdBuffer,
+        const Vk::FramebufferManager& framebufferManager,
+        const Vk::MegaSet& megaSet,
+        const Models::ModelManager& modelManager,
+        const Buffers::SceneBuffer& sceneBuffer,
+        const Buffers::MeshBuffer& meshBuffer,
+        const Buffers::IndirectBuffer& indirectBuffer,
+        const LightViews& lightViews,
+        const std::span<const FaceDraw> faceDraws,
+        bool isMultiFace
+    ) const
+    {
+        const auto& shadowAtlasView = framebufferManager.GetFramebufferView("ShadowAtlasView");
+        const auto& depthView       = framebufferManager.GetFramebufferView("ShadowAtlasDepthView");
+
+        const auto& shadowAtlas = framebufferManager.GetFramebuffer(shadowAtlasView.framebuffer);
+        const auto& depth       = framebufferManager.GetFramebuffer(depthView.framebuffer);
+
+        // Passes before this one may still be writing to the atlas, tiles never overlap but the attachments are shared
+        Vk::BarrierWriter barrierWriter = {};
+
+        barrierWriter
+        .WriteImageBarrier
+        (
+            shadowAtlas.image,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .srcAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .dstAccessMask  = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = shadowAtlas.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = shadowAtlas.image.arrayLayers
+            }
+        )
+        .WriteImageBarrier
+        (
+            depth.image,
+            Vk::ImageBarrier{
+                .srcStageMask   = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                .srcAccessMask  = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstStageMask   = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
+                .dstAccessMask  = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .oldLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .newLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
+                .baseMipLevel   = 0,
+                .levelCount     = depth.image.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount     = depth.image.arrayLayers
+            }
+        )
+        .Execute(cmdBuffer);
+
+        // Cached tiles share the attachments, so only the tiles being rendered are cleared
+        const VkRenderingAttachmentInfo colorAttachmentInfo =
+        {
+            .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+            .pNext              = nullptr,
+            .imageView          = shadowAtlasView.view.handle,
+            .imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .resolveMode        = VK_RESOLVE_MODE_NONE,
+            .resolveImageView   = VK_NULL_HANDLE,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp             = VK_ATTACHMENT_LOAD_OP_LOAD,
+            .storeOp            = VK_ATTACHMENT_STORE_OP_STORE,
+            .clearValue         = {}
+        };
+
+        const VkRenderingAttachmentInfo depthAttachmentInfo =
+        {
+            .sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+            .pNext              = nullptr,
+            .imageView          = depthView.view.handle,
+            .imageLayout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            .resolveMode        = VK_RESOLVE_MODE_NONE,
+            .resolveImageView   = VK_NULL_HANDLE,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp             = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .storeOp            = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .clearValue         = {}
+        };
+
+        const VkRenderingInfo renderInfo =
+        {
+            .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO,
+            .pNext                = nullptr,
+            .flags                = 0,
+            .renderArea           = {
+                .offset = {0, 0},
+                .extent = {shadowAtlas.image.width, shadowAtlas.image.height}
+            },
+            .layerCount           = 1,
+            .viewMask             = 0,
+            .colorAttachmentCount = 1,
+            .pColorAttachments    = &colorAttachmentInfo,
+            .pDepthAttachment     = &depthAttachmentInfo,
+            .pStencilAttachment   = nullptr
+        };
+
+        vkCmdBeginRendering(cmdBuffer.handle, &renderInfo);
+
+        // Clear
+        {
+            const std::array clearAttachments =
+            {
+                VkClearAttachment{
+                    .aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .colorAttachment = 0,
+                    .clearValue      = {.color = {.float32 = {0.0f, 0.0f, 0.0f, 0.0f}}}
+                },
+                VkClearAttachment{
+                    .aspectMask      = VK_IMAGE_ASPECT_DEPTH_BIT,
+                    .colorAttachment = 0,
+                    .clearValue      = {.depthStencil = {0.0f, 0x0}}
+                }
+            };
+
+            std::vector<VkClearRect> clearRects = {};
+            clearRects.reserve(faceDraws.size());
+
+            for (const auto& faceDraw : faceDraws)
+            {
+                clearRects.emplace_back(VkClearRect{
+                    .rect           = GetTileRect(lightViews.atlasRects[faceDraw.face]),
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                });
+            }
+
+            vkCmdClearAttachments
+            (
+                cmdBuffer.handle,
+                static_cast<u32>(clearAttachments.size()),
+                clearAttachments.data(),
+                static_cast<u32>(clearRects.size()),
+                clearRects.data()
+            );
+        }
+
+        modelManager.geometryBuffer.Bind(cmdBuffer);
+
+        // Each face only covers its own tile, multi-face draws get every face's tile indexed by face
+        const auto SetFaceViewports = [&cmdBuffer, &lightViews, isMultiFace] (u32 face)
+        {
+            const usize firstFace = isMultiFace ? 0 : face;
+            const usize faceCount = isMultiFace ? lightViews.atlasRects.size() : 1;
+
+            std::vector<VkViewport> viewports = {};
+            std::vector<VkRect2D>   scissors  = {};
+
+            viewports.reserve(faceCount);
+            scissors.reserve(faceCount);
+
+            for (usize i = firstFace; i < firstFace + faceCount; ++i)
+            {
+                const auto tileRect = GetTileRect(lightViews.atlasRects[i]);
+
+                viewports.emplace_back(VkViewport{
+                    .x        = static_cast<f32>(tileRect.offset.x),
+                    .y        = static_cast<f32>(tileRect.offset.y),
+                    .width    = static_cast<f32>(tileRect.extent.width),
+                    .height   = static_cast<f32>(tileRect.extent.height),
+                    .minDepth = 0.0f,
+                    .maxDepth = 1.0f
+                });
+
+                scissors.emplace_back(tileRect);
+            }
+
+            vkCmdSetViewportWithCount(cmdBuffer.handle, static_cast<u32>(viewports.size()), viewports.data());
+            vkCmdSetScissorWithCount(cmdBuffer.handle, static_cast<u32>(scissors.size()), scissors.data());
+        };
+
+        const auto DrawIndirect = [&cmdBuffer, &indirectBuffer, FIF] (const DrawList& drawList)
+        {
+            vkCmdDrawIndexedIndirectCount
+            (
+                cmdBuffer.handle,
+                drawList.buffer,
+                drawList.offset,
+                drawList.buffer,
+                drawList.countOffset,
+                indirectBuffer.writtenDrawCallBuffers[FIF].writtenDrawCount,
+                sizeof(VkDrawIndexedIndirectCommand)
+            );
+        };
+
+        // Opaque
+        {
+            Vk::BeginLabel(cmdBuffer, "Opaque", glm::vec4(0.6091f, 0.7243f, 0.2549f, 1.0f));
+
+            const auto& opaquePipeline = isMultiFace ? *m_opaqueMultiFacePipeline : m_opaquePipeline;
+
+            opaquePipeline.Bind(cmdBuffer);
+
+            for (const auto& faceDraw : faceDraws)
+            {
+                if (!faceDraw.hasCasters)
+                {
+                    continue;
+                }
+
+                SetFaceViewports(faceDraw.face);
+
+                // Single Sided
+                {
+                    vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_BACK_BIT);
+
+                    const auto constants = Opaque::Constants
+                    {
+                        .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Transforms  = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .MeshIndices = faceDraw.drawLists.opaque.meshIndices,
+                        .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .LightIndex  = lightViews.lightIndex,
+                        .FaceIndex   = faceDraw.face
+                    };
+
+                    opaquePipeline.PushConstants
+                    (
+                       cmdBuffer,
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       constants
+                    );
+
+                    DrawIndirect(faceDraw.drawLists.opaque);
+                }
+
+                // Double Sided
+                {
+                    vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_NONE);
+
+                    const auto constants = Opaque::Constants
+                    {
+                        .Scene       = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Transforms  = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .MeshIndices = faceDraw.drawLists.opaqueDoubleSided.meshIndices,
+                        .Positions   = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .LightIndex  = lightViews.lightIndex,
+                        .FaceIndex   = faceDraw.face
+                    };
+
+                    opaquePipeline.PushConstants
+                    (
+                       cmdBuffer,
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       constants
+                    );
+
+                    DrawIndirect(faceDraw.drawLists.opaqueDoubleSided);
+                }
+
+                // Every face was drawn by the first one
+                if (isMultiFace)
+                {
+                    break;
+                }
+            }
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        // Alpha Masked
+        {
+            Vk::BeginLabel(cmdBuffer, "Alpha Masked", glm::vec4(0.9091f, 0.2243f, 0.6549f, 1.0f));
+
+            const auto& alphaMaskedPipeline = isMultiFace ? *m_alphaMaskedMultiFacePipeline : m_alphaMaskedPipeline;
+
+            alphaMaskedPipeline.Bind(cmdBuffer);
+
+            const std::array descriptorSets = {megaSet.descriptorSet};
+            alphaMaskedPipeline.BindDescriptors(cmdBuffer, 0, descriptorSets);
+
+            for (const auto& faceDraw : faceDraws)
+            {
+                if (!faceDraw.hasCasters)
+                {
+                    continue;
+                }
+
+                SetFaceViewports(faceDraw.face);
+
+                // Single Sided
+                {
+                    vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_BACK_BIT);
+
+                    const auto constants = AlphaMasked::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .Transforms          = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = faceDraw.drawLists.alphaMasked.meshIndices,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(alphaMaskedPipeline.textureSamplerID).descriptorID,
+                        .LightIndex          = lightViews.lightIndex,
+                        .FaceIndex           = faceDraw.face
+                    };
+
+                    alphaMaskedPipeline.PushConstants
+                    (
+                       cmdBuffer,
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       constants
+                    );
+
+                    DrawIndirect(faceDraw.drawLists.alphaMasked);
+                }
+
+                // Double Sided
+                {
+                    vkCmdSetCullMode(cmdBuffer.handle, VK_CULL_MODE_NONE);
+
+                    const auto constants = AlphaMasked::Constants
+                    {
+                        .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
+                        .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+                        .Transforms          = meshBuffer.GetCurrentStreams(frameIndex).transforms.deviceAddress,
+                        .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
+                        .MeshIndices         = faceDraw.drawLists.alphaMaskedDoubleSided.meshIndices,
+                        .Positions           = modelManager.geometryBuffer.GetPositionBuffer().deviceAddress,
+                        .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
+                        .TextureSamplerIndex = modelManager.textureManager.GetSampler(alphaMaskedPipeline.textureSamplerID).descriptorID,
+                        .LightIndex          = lightViews.lightIndex,
+                        .FaceIndex           = faceDraw.face
+                    };
+
+                    alphaMaskedPipeline.PushConstants
+                    (
+                       cmdBuffer,
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       constants
+                    );
+
+                    DrawIndirect(faceDraw.drawLists.alphaMaskedDoubleSided);
+                }
+
+                if (isMultiFace)
+                {
+                    break;
+                }
+            }
+
+            Vk::EndLabel(cmdBuffer);
+        }
+
+        vkCmdEndRendering(cmdBuffer.handle);
+    }
+
+    RenderPass::DrawLists RenderPass::GetDrawLists(const Buffers::IndirectBuffer::CulledBuffers& culledBuffers)
+    {
+        const auto GetDrawList = [] (const Buffers::DrawCallBuffer& buffer)
+        {
+            return DrawList{
+                .buffer      = buffer.drawCallBuffer.handle,
+                .offset      = sizeof(u32),
+                .countOffset = 0,
+                .meshIndices = buffer.meshIndexBuffer->deviceAddress
+            };
+        };
+
+        return DrawLists{
+            .opaque                 = GetDrawList(culledBuffers.opaqueBuffer),
+            .opaqueDoubleSided      = GetDrawList(culledBuffers.opaqueDoubleSidedBuffer),
+            .alphaMasked            = GetDrawList(culledBuffers.alphaMaskedBuffer),
+            .alphaMaskedDoubleSided = GetDrawList(culledBuffers.alphaMaskedDoubleSidedBuffer)
+        };
+    }
+
+    RenderPass::DrawLists RenderPass::GetDrawLists(u32 view, const Buffers::IndirectBuffer& indirectBuffer)
+    {
+        const auto& viewCulledBuffers = indirectBuffer.viewCulledBuffers;
+
+        // Compacted draws already carry the view offset in firstInstance
+        const auto GetDrawList = [&viewCulledBuffers, view] (Culling::MultiView::Bucket bucket)
+        {
+            return DrawList{
+                .buffer      = viewCulledBuffers.drawCallBuffer.handle,
+                .offset      = viewCulledBuffers.GetDrawCallOffset(view, static_cast<u32>(bucket)),
+                .countOffset = viewCulledBuffers.GetCountOffset(view, static_cast<u32>(bucket)),
+                .meshIndices = viewCulledBuffers.meshIndexBuffer.deviceAddress
+            };
+        };
+
+        return DrawLists{
+            .opaque                 = GetDrawList(Culling::MultiView::Bucket::Opaque),
+            .opaqueDoubleSided      = GetDrawList(Culling::MultiView::Bucket::OpaqueDoubleSided),
+            .alphaMasked            = GetDrawList(Culling::MultiView::Bucket::AlphaMasked),
+            .alphaMaskedDoubleSided = GetDrawList(Culling::MultiView::Bucket::AlphaMaskedDoubleSided)
+        };
+    }
+
+    std::vector<RenderPass::LightViews> RenderPass::GetLightViews(const Buffers::LightsBuffer& lightsBuffer)
+    {
+        std::vector<LightViews> lightViews = {};
+        lightViews.reserve(lightsBuffer.shadowedPointLights.size() + lightsBuffer.shadowedSpotLights.size());
+
+        for (usize i = 0; i < lightsBuffer.shadowedPointLights.size(); ++i)
+        {
+            const auto& light = lightsBuffer.shadowedPointLights[i];
+
+            lightViews.emplace_back(LightViews{
+                .lightIndex = static_cast<u32>(i),
+                .cacheSlot  = i,
+                .matrices   = std::vector<glm::mat4>(std::begin(light.matrices), std::end(light.matrices)),
+                .atlasRects = std::vector<glm::vec4>(std::begin(light.atlasRects), std::end(light.atlasRects))
+            });
+        }
+
+        for (usize i = 0; i < lightsBuffer.shadowedSpotLights.size(); ++i)
+        {
+            const auto& light = lightsBuffer.shadowedSpotLights[i];
+
+            lightViews.emplace_back(LightViews{
+                .lightIndex = static_cast<u32>(i) | GPU::SHADOW_LIGHT_INDEX_SPOT_BIT,
+                .cacheSlot  = GPU::MAX_SHADOWED_POINT_LIGHT_COUNT + i,
+                .matrices   = {light.matrix},
+                .atlasRects = {light.atlasRect}
+            });
+        }
+
+        return lightViews;
+    }
+
+    VkRect2D RenderPass::GetTileRect(const glm::vec4& atlasRect)
+    {
+        // Tiles are whole texels, so this is exact
+        const auto tileRect = glm::uvec4(atlasRect * static_cast<f32>(GPU::SHADOW_ATLAS_SIZE));
+
+        return VkRect2D{
+            .offset = {static_cast<s32>(tileRect.x), static_cast<s32>(tileRect.y)},
+            .extent = {tileRect.z, tileRect.w}
+        };
+    }
+
+    usize RenderPass::HashFace
+    (
+        VkImage shadowAtlas,
+        const glm::mat4& matrix,
+        const glm::vec4& atlasRect,
+        const std::span<const u32> casters,
+        const std::span<const Renderer::RenderObject> renderObjects
+    )
+    {
+        // A recreated atlas has lost its contents
+        usize hash = std::hash<VkImage>{}(shadowAtlas);
+
+        // The matrix covers the light's position and direction, a moved tile has to be rendered again
+        for (glm::length_t column = 0; column < 4; ++column)
+        {
+            for (glm::length_t row = 0; row < 4; ++row)
+            {
+                hash = Util::HashCombine(hash, matrix[column][row]);
+            }
+        }
+
+        for (glm::length_t i = 0; i < 4; ++i)
+        {
+            hash = Util::HashCombine(hash, atlasRect[i]);
+        }
+
+        for (const u32 objectIndex : casters)
+        {
+            const auto& renderObject = renderObjects[objectIndex];
+
+            hash = Util::HashCombine(hash, objectIndex);
+            hash = Util::HashCombine(hash, renderObject.modelID);
+
+            for (const auto& vector : {renderObject.position, renderObject.rotation, renderObject.scale})
+            {
+                hash = Util::HashCombine(hash, vector.x);
+                hash = Util::HashCombine(hash, vector.y);
+                hash = Util::HashCombine(hash, vector.z);
+            }
+        }
+
+        return hash;
+    }
+
     void RenderPass::Destroy(VkDevice device)
     {
         m_opaquePipeline.Destroy(device);
         m_alphaMaskedPipeline.Destroy(device);
+
+        if (m_opaqueMultiFacePipeline.has_value())
+        {
+            m_opaqueMultiFacePipeline->Destroy(device);
+        }
+
+        if (m_alphaMaskedMultiFacePipeline.has_value())
+        {
+            m_alphaMaskedMultiFacePipeline->Destroy(device);
+        }
     }
 }
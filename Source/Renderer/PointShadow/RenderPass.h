@@ -25,6 +25,8 @@
 #include "Renderer/Buffers/MeshBuffer.h"
 #include "Renderer/Buffers/SceneBuffer.h"
 #include "Renderer/Culling/Dispatch.h"
+#include "Renderer/Culling/BVH.h"
+#include "Culling/MultiViewLayout.h"
 
 namespace Renderer::PointShadow
 {
@@ -51,13 +53,91 @@ namespace Renderer::PointShadow
             const Buffers::SceneBuffer& sceneBuffer,
             const Buffers::MeshBuffer& meshBuffer,
             const Buffers::IndirectBuffer& indirectBuffer,
+            const std::span<const Renderer::RenderObject> renderObjects,
+            const Culling::BVH& bvh,
             Culling::Dispatch& culling
-        ) const;
+        );
 
         void Destroy(VkDevice device);
     private:
+        // Where one bucket's draws and their count live
+        struct DrawList
+        {
+            VkBuffer        buffer      = VK_NULL_HANDLE;
+            VkDeviceSize    offset      = 0;
+            VkDeviceSize    countOffset = 0;
+            VkDeviceAddress meshIndices = 0;
+        };
+
+        struct DrawLists
+        {
+            DrawList opaque;
+            DrawList opaqueDoubleSided;
+            DrawList alphaMasked;
+            DrawList alphaMaskedDoubleSided;
+        };
+
+        struct FaceDraw
+        {
+            u32       face       = 0;
+            bool      hasCasters = false;
+            DrawLists drawLists  = {};
+        };
+
+        // A light's views into the shadow atlas, six for point lights and one for spot lights
+        struct LightViews
+        {
+            // Spot lights are tagged with SHADOW_LIGHT_INDEX_SPOT_BIT
+            u32                    lightIndex = 0;
+            usize                  cacheSlot  = 0;
+            std::vector<glm::mat4> matrices   = {};
+            std::vector<glm::vec4> atlasRects = {};
+        };
+
+        // Renders the given faces of one light in a single pass, each face with its tile as the viewport
+        // Multi-face draws share the first face's draw lists and cover every face at once, one viewport per face
+        void RenderLight
+        (
+            usize FIF,
+            usize frameIndex,
+            const Vk::CommandBuffer& cmdBuffer,
+            const Vk::FramebufferManager& framebufferManager,
+            const Vk::MegaSet& megaSet,
+            const Models::ModelManager& modelManager,
+            const Buffers::SceneBuffer& sceneBuffer,
+            const Buffers::MeshBuffer& meshBuffer,
+            const Buffers::IndirectBuffer& indirectBuffer,
+            const LightViews& lightViews,
+            const std::span<const FaceDraw> faceDraws,
+            bool isMultiFace
+        ) const;
+
+        [[nodiscard]] static std::vector<LightViews> GetLightViews(const Buffers::LightsBuffer& lightsBuffer);
+        [[nodiscard]] static VkRect2D GetTileRect(const glm::vec4& atlasRect);
+
+        [[nodiscard]] static DrawLists GetDrawLists(const Buffers::IndirectBuffer::CulledBuffers& culledBuffers);
+        [[nodiscard]] static DrawLists GetDrawLists(u32 view, const Buffers::IndirectBuffer& indirectBuffer);
+
+        [[nodiscard]] static usize HashFace
+        (
+            VkImage shadowAtlas,
+            const glm::mat4& matrix,
+            const glm::vec4& atlasRect,
+            const std::span<const u32> casters,
+            const std::span<const Renderer::RenderObject> renderObjects
+        );
+
         Opaque::Pipeline      m_opaquePipeline;
         AlphaMasked::Pipeline m_alphaMaskedPipeline;
+
+        // Only created when vertex shaders can write gl_ViewportIndex
+        std::optional<Opaque::Pipeline>      m_opaqueMultiFacePipeline      = std::nullopt;
+        std::optional<AlphaMasked::Pipeline> m_alphaMaskedMultiFacePipeline = std::nullopt;
+
+        // Faces are only re-rendered when their light, their tile or any caster inside them changes
+        std::array<std::array<std::optional<usize>, 6>, GPU::MAX_SHADOWED_POINT_LIGHT_COUNT + GPU::MAX_SHADOWED_SPOT_LIGHT_COUNT> m_faceHashes = {};
+        // Atlas layout the hashes were recorded against
+        u64 m_atlasGeneration = 0;
     };
 }
 
@@ -45,9 +45,10 @@ namespace Renderer
           m_lighting(m_context, m_formatHelper, m_framebufferManager, m_megaSet, m_modelManager.textureManager),
           m_shadowRT(m_context, m_graphicsCmdBufferAllocator, m_framebufferManager, m_megaSet, m_modelManager.textureManager),
           m_taa(m_context, m_formatHelper, m_framebufferManager, m_megaSet, m_modelManager.textureManager),
-          m_culling(m_context),
+          m_culling(m_context, m_framebufferManager, m_megaSet, m_modelManager.textureManager),
           m_vbgtao(m_context, m_framebufferManager, m_megaSet, m_modelManager.textureManager),
-          m_iblGenerator(m_context, m_formatHelper, m_megaSet, m_modelManager.textureManager),
+          m_iblGenerator(m_context, m_megaSet, m_modelManager.textureManager),
+          m_dynamicResolution(m_context),
           m_meshBuffer(m_context.device, m_context.allocator),
           m_indirectBuffer(m_context.device, m_context.allocator),
           m_sceneBuffer(m_context.device, m_context.allocator)
@@ -70,12 +71,13 @@ namespace Renderer
             m_indirectBuffer.Destroy(m_context.allocator);
             m_meshBuffer.Destroy(m_context.allocator);
 
-            m_iblGenerator.Destroy(m_context.device, m_context.allocator);
+            m_dynamicResolution.Destroy(m_context.device);
+            m_iblGenerator.Destroy(m_context.device);
             m_vbgtao.Destroy(m_context.device);
             m_culling.Destroy(m_context.device, m_context.allocator);
             m_taa.Destroy(m_context.device);
             m_shadowRT.Destroy(m_context.device, m_context.allocator);
-            m_lighting.Destroy(m_context.device);
+            m_lighting.Destroy(m_context.device, m_context.allocator);
             m_gBuffer.Destroy(m_context.device);
             m_pointShadow.Destroy(m_context.device);
             m_bloom.Destroy(m_context.device);
@@ -122,19 +124,22 @@ namespace Renderer
             return;
         }
 
-        AcquireSwapchainImage();
-        BeginFrame();
-
-        if (m_context.queueFamilies.HasAllFamilies())
-        {
-            RenderMultiQueue();
-        }
-        else if (m_context.queueFamilies.HasRequiredFamilies())
         {
-            RenderGraphicsQueueOnly();
+            const auto frameTimer = m_benchmark.Measure(Benchmark::Stage::Frame);
+
+            AcquireSwapchainImage();
+            BeginFrame();
+
+            if (m_context.queueFamilies.HasRequiredFamilies())
+            {
+                RenderFrame();
+            }
+
+            EndFrame();
         }
 
-        EndFrame();
+        m_benchmark.Record(Benchmark::Stage::Culling, m_culling.GetCPUTime());
+        m_benchmark.EndFrame(m_meshBuffer.GetMeshes().size());
     }
 
     void RenderManager::WaitForTimeline()
@@ -187,324 +192,132 @@ namespace Renderer
         }
     }
 
-    void RenderManager::RenderGraphicsQueueOnly()
+    void RenderManager::RenderFrame()
     {
-        const auto cmdBuffer = m_graphicsCmdBufferAllocator.AllocateCommandBuffer(m_FIF, m_context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-        cmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-            GBufferGeneration(cmdBuffer);
-            Occlusion(cmdBuffer, m_sceneBuffer, "SceneDepthView", "GNormalView");
-            TraceRays(cmdBuffer);
-            Lighting(cmdBuffer);
-        cmdBuffer.EndRecording();
-
-        const VkSemaphoreSubmitInfo waitSemaphoreInfo =
-        {
-            .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-            .pNext       = nullptr,
-            .semaphore   = m_graphicsTimeline.semaphore,
-            .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_SWAPCHAIN_IMAGE_ACQUIRED),
-            .stageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-            .deviceIndex = 0
-        };
-
-        const VkSemaphoreSubmitInfo signalSemaphoreInfo =
-        {
-            .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-            .pNext       = nullptr,
-            .semaphore   = m_graphicsTimeline.semaphore,
-            .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RENDER_FINISHED),
-            .stageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-            .deviceIndex = 0
-        };
-
-        const VkCommandBufferSubmitInfo cmdBufferInfo =
-        {
-            .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-            .pNext         = nullptr,
-            .commandBuffer = cmdBuffer.handle,
-            .deviceMask    = 0
-        };
+        const bool hasAsyncCompute = m_computeCmdBufferAllocator.has_value();
 
-        const VkSubmitInfo2 submitInfo =
-        {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .pNext                    = nullptr,
-            .flags                    = 0,
-            .waitSemaphoreInfoCount   = 1,
-            .pWaitSemaphoreInfos      = &waitSemaphoreInfo,
-            .commandBufferInfoCount   = 1,
-            .pCommandBufferInfos      = &cmdBufferInfo,
-            .signalSemaphoreInfoCount = 1,
-            .pSignalSemaphoreInfos    = &signalSemaphoreInfo
-        };
-
-        Vk::CheckResult(vkQueueSubmit2(
-            m_context.graphicsQueue,
-            1,
-            &submitInfo,
-            VK_NULL_HANDLE),
-            "Failed to submit queue!"
-        );
-    }
-
-    void RenderManager::RenderMultiQueue()
-    {
-        // GBuffer Generation Submit
-        {
-            const auto gBufferGenerationCmdBuffer = m_graphicsCmdBufferAllocator.AllocateCommandBuffer(m_FIF, m_context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-            gBufferGenerationCmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-                GBufferGeneration(gBufferGenerationCmdBuffer);
-                GraphicsToAsyncComputeRelease(gBufferGenerationCmdBuffer);
-            gBufferGenerationCmdBuffer.EndRecording();
-
-            const VkSemaphoreSubmitInfo swapchainImageAcquireWaitSemaphoreInfo =
+        const auto gBufferGeneration = m_frameScheduler.AddPass(FramePass{
+            .name         = "GBuffer Generation",
+            .affinity     = QueueAffinity::Graphics,
+            .Record       = [this] (const Vk::CommandBuffer& cmdBuffer)
             {
+                GBufferGeneration(cmdBuffer);
+            },
+            .dependencies = {},
+            .waits        = {VkSemaphoreSubmitInfo{
                 .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
                 .pNext       = nullptr,
                 .semaphore   = m_graphicsTimeline.semaphore,
                 .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_SWAPCHAIN_IMAGE_ACQUIRED),
                 .stageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
                 .deviceIndex = 0
-            };
-
-            const VkCommandBufferSubmitInfo gBufferGenerationCmdBufferInfo =
-            {
-                .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .pNext         = nullptr,
-                .commandBuffer = gBufferGenerationCmdBuffer.handle,
-                .deviceMask    = 0
-            };
-
-            const VkSemaphoreSubmitInfo gBufferGenerationSignalSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_GBUFFER_GENERATION_COMPLETE),
-                .stageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .deviceIndex = 0
-            };
-
-            const VkSubmitInfo2 gBufferGenerationSubmitInfo =
-            {
-                .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-                .pNext                    = nullptr,
-                .flags                    = 0,
-                .waitSemaphoreInfoCount   = 1,
-                .pWaitSemaphoreInfos      = &swapchainImageAcquireWaitSemaphoreInfo,
-                .commandBufferInfoCount   = 1,
-                .pCommandBufferInfos      = &gBufferGenerationCmdBufferInfo,
-                .signalSemaphoreInfoCount = 1,
-                .pSignalSemaphoreInfos    = &gBufferGenerationSignalSemaphoreInfo
-            };
-
-            Vk::CheckResult(vkQueueSubmit2(
-                m_context.graphicsQueue,
-                1,
-                &gBufferGenerationSubmitInfo,
-                VK_NULL_HANDLE),
-                "Failed to submit to graphics queue!"
-            );
-        }
-
-        // Async Compute Submit
-        {
-            const auto asyncComputeCmdBuffer = m_computeCmdBufferAllocator->AllocateCommandBuffer(m_FIF, m_context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-            asyncComputeCmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-                GraphicsToAsyncComputeAcquire(asyncComputeCmdBuffer);
-                Occlusion(asyncComputeCmdBuffer, *m_sceneBufferCompute, "SceneDepthAsyncComputeView", "GNormalAsyncComputeView");
-                AsyncComputeToGraphicsRelease(asyncComputeCmdBuffer);
-            asyncComputeCmdBuffer.EndRecording();
-
-            const VkSemaphoreSubmitInfo gBufferGenerationAsyncComputeWaitSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_GBUFFER_GENERATION_COMPLETE),
-                .stageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .deviceIndex = 0
-            };
-
-            const VkCommandBufferSubmitInfo asyncComputeCmdBufferInfo =
-            {
-                .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .pNext         = nullptr,
-                .commandBuffer = asyncComputeCmdBuffer.handle,
-                .deviceMask    = 0
-            };
-
-            const VkSemaphoreSubmitInfo asyncComputeSignalSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_computeTimeline->semaphore,
-                .value       = m_computeTimeline->GetTimelineValue(m_frameIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED),
-                .stageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .deviceIndex = 0
-            };
-
-            const VkSubmitInfo2 asyncComputeSubmitInfo =
-            {
-                .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-                .pNext                    = nullptr,
-                .flags                    = 0,
-                .waitSemaphoreInfoCount   = 1,
-                .pWaitSemaphoreInfos      = &gBufferGenerationAsyncComputeWaitSemaphoreInfo,
-                .commandBufferInfoCount   = 1,
-                .pCommandBufferInfos      = &asyncComputeCmdBufferInfo,
-                .signalSemaphoreInfoCount = 1,
-                .pSignalSemaphoreInfos    = &asyncComputeSignalSemaphoreInfo
-            };
-
-            Vk::CheckResult(vkQueueSubmit2(
-                m_context.computeQueue,
-                1,
-                &asyncComputeSubmitInfo,
-                VK_NULL_HANDLE),
-                "Failed to submit to compute queue!"
-            );
-        }
-
-        // Ray Dispatch Submit
-        {
-            const auto rayDispatchCmdBuffer = m_graphicsCmdBufferAllocator.AllocateCommandBuffer(m_FIF, m_context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-            rayDispatchCmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-                TraceRays(rayDispatchCmdBuffer);
-            rayDispatchCmdBuffer.EndRecording();
+            }},
+            .semaphore    = m_graphicsTimeline.semaphore,
+            .signalValue  = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_GBUFFER_GENERATION_COMPLETE),
+            // Covers the final depth and normal layout transitions, the compute queue reads those images without an ownership transfer
+            .signalStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT
+        });
 
-            const VkSemaphoreSubmitInfo gBufferGenerationWaitSemaphoreInfo =
+        const auto occlusion = m_frameScheduler.AddPass(FramePass{
+            .name         = "Occlusion",
+            .affinity     = QueueAffinity::AsyncCompute,
+            .Record       = [this, hasAsyncCompute] (const Vk::CommandBuffer& cmdBuffer)
             {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_GBUFFER_GENERATION_COMPLETE),
-                .stageMask   = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
-                .deviceIndex = 0
-            };
+                Occlusion(cmdBuffer, hasAsyncCompute ? *m_sceneBufferCompute : m_sceneBuffer, "SceneDepthView", "GNormalView");
+            },
+            .dependencies = {FramePassDependency{
+                .pass      = gBufferGeneration,
+                .stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                .Release   = [this] (const Vk::CommandBuffer& cmdBuffer) { GraphicsToAsyncComputeRelease(cmdBuffer); },
+                .Acquire   = [this] (const Vk::CommandBuffer& cmdBuffer) { GraphicsToAsyncComputeAcquire(cmdBuffer); }
+            }},
+            .waits        = {},
+            .semaphore    = hasAsyncCompute ? m_computeTimeline->semaphore : VK_NULL_HANDLE,
+            .signalValue  = hasAsyncCompute ? m_computeTimeline->GetTimelineValue(m_frameIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED) : 0,
+            .signalStages = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+        });
 
-            const VkCommandBufferSubmitInfo rayDispatchCmdBufferInfo =
+        const auto rayDispatch = m_frameScheduler.AddPass(FramePass{
+            .name         = "Ray Dispatch",
+            .affinity     = QueueAffinity::Graphics,
+            .Record       = [this] (const Vk::CommandBuffer& cmdBuffer)
             {
-                .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .pNext         = nullptr,
-                .commandBuffer = rayDispatchCmdBuffer.handle,
-                .deviceMask    = 0
-            };
+                TraceRays(cmdBuffer);
+            },
+            .dependencies = {FramePassDependency{
+                .pass      = gBufferGeneration,
+                .stageMask = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                .Release   = {},
+                .Acquire   = {}
+            }},
+            .waits        = {},
+            .semaphore    = m_graphicsTimeline.semaphore,
+            .signalValue  = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RAY_DISPATCH),
+            .signalStages = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+        });
 
-            const VkSemaphoreSubmitInfo rayDispatchSignalSemaphoreInfo =
+        m_frameScheduler.AddPass(FramePass{
+            .name         = "Lighting",
+            .affinity     = QueueAffinity::Graphics,
+            .Record       = [this] (const Vk::CommandBuffer& cmdBuffer)
             {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RAY_DISPATCH),
-                .stageMask   = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
-                .deviceIndex = 0
-            };
+                Lighting(cmdBuffer);
+            },
+            .dependencies = {
+                FramePassDependency{
+                    .pass      = occlusion,
+                    .stageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                    .Release   = [this] (const Vk::CommandBuffer& cmdBuffer) { AsyncComputeToGraphicsRelease(cmdBuffer); },
+                    .Acquire   = [this] (const Vk::CommandBuffer& cmdBuffer) { AsyncComputeToGraphicsAcquire(cmdBuffer); }
+                },
+                FramePassDependency{
+                    .pass      = rayDispatch,
+                    .stageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                    .Release   = {},
+                    .Acquire   = {}
+                }
+            },
+            .waits        = {},
+            .semaphore    = m_graphicsTimeline.semaphore,
+            .signalValue  = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RENDER_FINISHED),
+            .signalStages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT
+        });
 
-            const VkSubmitInfo2 rayDispatchSubmitInfo =
-            {
-                .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-                .pNext                    = nullptr,
-                .flags                    = 0,
-                .waitSemaphoreInfoCount   = 1,
-                .pWaitSemaphoreInfos      = &gBufferGenerationWaitSemaphoreInfo,
-                .commandBufferInfoCount   = 1,
-                .pCommandBufferInfos      = &rayDispatchCmdBufferInfo,
-                .signalSemaphoreInfoCount = 1,
-                .pSignalSemaphoreInfos    = &rayDispatchSignalSemaphoreInfo
-            };
-
-            Vk::CheckResult(vkQueueSubmit2(
-                m_context.graphicsQueue,
-                1,
-                &rayDispatchSubmitInfo,
-                VK_NULL_HANDLE),
-                "Failed to submit to graphics queue!"
-            );
-        }
+        m_frameScheduler.Execute
+        (
+            m_FIF,
+            m_context,
+            m_graphicsCmdBufferAllocator,
+            m_computeCmdBufferAllocator
+        );
 
-        // Lighting Submit
+        // Waits on GBuffer generation, which has been submitted by now
+        if (hasAsyncCompute)
         {
-            const auto lightingCmdBuffer = m_graphicsCmdBufferAllocator.AllocateCommandBuffer(m_FIF, m_context.device, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-            lightingCmdBuffer.BeginRecording(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-                AsyncComputeToGraphicsAcquire(lightingCmdBuffer);
-                Lighting(lightingCmdBuffer);
-            lightingCmdBuffer.EndRecording();
-
-            const VkSemaphoreSubmitInfo asyncComputeWaitSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_computeTimeline->semaphore,
-                .value       = m_computeTimeline->GetTimelineValue(m_frameIndex, Vk::ComputeTimeline::COMPUTE_TIMELINE_STAGE_ASYNC_COMPUTE_FINISHED),
-                .stageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .deviceIndex = 0
-            };
-
-            const VkSemaphoreSubmitInfo rayDispatchWaitSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RAY_DISPATCH),
-                .stageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .deviceIndex = 0
-            };
-
-            const std::array lightingWaitSemaphoreInfos = {asyncComputeWaitSemaphoreInfo, rayDispatchWaitSemaphoreInfo};
-
-            const VkCommandBufferSubmitInfo lightingCmdBufferInfo =
-            {
-                .sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .pNext         = nullptr,
-                .commandBuffer = lightingCmdBuffer.handle,
-                .deviceMask    = 0
-            };
-
-            const VkSemaphoreSubmitInfo renderFinishedSignalSemaphoreInfo =
-            {
-                .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-                .pNext       = nullptr,
-                .semaphore   = m_graphicsTimeline.semaphore,
-                .value       = m_graphicsTimeline.GetTimelineValue(m_frameIndex, Vk::GraphicsTimeline::GRAPHICS_TIMELINE_STAGE_RENDER_FINISHED),
-                .stageMask   = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                .deviceIndex = 0
-            };
-
-            const VkSubmitInfo2 lightingSubmitInfo =
-            {
-                .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-                .pNext                    = nullptr,
-                .flags                    = 0,
-                .waitSemaphoreInfoCount   = static_cast<u32>(lightingWaitSemaphoreInfos.size()),
-                .pWaitSemaphoreInfos      = lightingWaitSemaphoreInfos.data(),
-                .commandBufferInfoCount   = 1,
-                .pCommandBufferInfos      = &lightingCmdBufferInfo,
-                .signalSemaphoreInfoCount = 1,
-                .pSignalSemaphoreInfos    = &renderFinishedSignalSemaphoreInfo
-            };
-
-            Vk::CheckResult(vkQueueSubmit2(
-                m_context.graphicsQueue,
-                1,
-                &lightingSubmitInfo,
-                VK_NULL_HANDLE),
-                "Failed to submit to graphics queue!"
+            m_iblGenerator.SubmitAsync
+            (
+                m_frameIndex,
+                m_context,
+                m_formatHelper,
+                m_graphicsTimeline,
+                *m_computeCmdBufferAllocator,
+                m_modelManager.textureManager,
+                m_megaSet
             );
         }
     }
 
     void RenderManager::GBufferGeneration(const Vk::CommandBuffer& cmdBuffer)
     {
+        // Picks this frame's render scale, so it has to run before the scene buffer is written
+        m_dynamicResolution.BeginFrame(m_FIF, cmdBuffer);
+
         Update(cmdBuffer);
 
         if (m_scene->haveRenderObjectsChanged)
         {
+            const auto blasTimer = m_benchmark.Measure(Benchmark::Stage::BottomLevelAS);
+
             m_deletionQueues[m_FIF].PushDeletor([device = m_context.device, allocator = m_context.allocator, as = m_accelerationStructure] () mutable
             {
                 as.Destroy(device, allocator);
@@ -535,16 +348,20 @@ namespace Renderer
             m_deletionQueues[m_FIF]
         );
 
-        m_accelerationStructure.BuildTopLevelAS
-        (
-            m_FIF,
-            cmdBuffer,
-            m_context.device,
-            m_context.allocator,
-            m_modelManager,
-            m_scene->renderObjects,
-            m_deletionQueues[m_FIF]
-        );
+        {
+            const auto tlasTimer = m_benchmark.Measure(Benchmark::Stage::TopLevelAS);
+
+            m_accelerationStructure.BuildTopLevelAS
+            (
+                m_FIF,
+                cmdBuffer,
+                m_context.device,
+                m_context.allocator,
+                m_modelManager,
+                m_scene->renderObjects,
+                m_deletionQueues[m_FIF]
+            );
+        }
 
         m_pointShadow.Render
         (
@@ -557,6 +374,8 @@ namespace Renderer
             m_sceneBuffer,
             m_meshBuffer,
             m_indirectBuffer,
+            m_scene->renderObjects,
+            m_scene->bvh,
             m_culling
         );
 
@@ -584,7 +403,8 @@ namespace Renderer
             m_modelManager,
             m_sceneBuffer,
             m_meshBuffer,
-            m_indirectBuffer
+            m_indirectBuffer,
+            m_culling
         );
     }
 
@@ -652,11 +472,13 @@ namespace Renderer
 
         m_taa.Render
         (
+            m_FIF,
             m_frameIndex,
             cmdBuffer,
             m_framebufferManager,
             m_megaSet,
-            m_modelManager.textureManager
+            m_modelManager.textureManager,
+            m_sceneBuffer
         );
 
         m_bloom.Render
@@ -689,268 +511,21 @@ namespace Renderer
             m_swapchain,
             m_deletionQueues[m_FIF]
         );
+
+        m_dynamicResolution.EndFrame(m_FIF, cmdBuffer);
     }
 
     void RenderManager::GraphicsToAsyncComputeRelease(const Vk::CommandBuffer& cmdBuffer)
     {
         Vk::BeginLabel(cmdBuffer, "Graphics -> Async Compute | Release", {0.6726f, 0.6538f, 0.4518f, 1.0f});
 
-        const auto& sceneDepth             = m_framebufferManager.GetFramebuffer("SceneDepth");
-        const auto& sceneDepthAsyncCompute = m_framebufferManager.GetFramebuffer("SceneDepthAsyncCompute");
-        const auto& gNormal                = m_framebufferManager.GetFramebuffer("GNormal");
-        const auto& gNormalAsyncCompute    = m_framebufferManager.GetFramebuffer("GNormalAsyncCompute");
-        const auto& depthMipChain          = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
-        const auto& depthDifferences       = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
-        const auto& noisyAO                = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
-        const auto& occlusion              = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
-        const auto& hilbertLUT             = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
-
-        Vk::BarrierWriter barrierWriter = {};
-
-        barrierWriter
-        .WriteImageBarrier(
-            sceneDepth.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepth.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepth.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormal.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormal.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormal.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .dstAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
-        .Execute(cmdBuffer);
-
-        const VkImageCopy2 depthCopyRegion =
-        {
-            .sType          = VK_STRUCTURE_TYPE_IMAGE_COPY_2,
-            .pNext          = nullptr,
-            .srcSubresource = {
-                .aspectMask     = sceneDepth.image.aspect,
-                .mipLevel       = 0,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            },
-            .srcOffset      = {0, 0, 0},
-            .dstSubresource = {
-                .aspectMask     = sceneDepthAsyncCompute.image.aspect,
-                .mipLevel       = 0,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            },
-            .dstOffset      = {0, 0, 0},
-            .extent         = {sceneDepth.image.width, sceneDepth.image.height, 1}
-        };
+        const auto& depthMipChain    = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
+        const auto& depthDifferences = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
+        const auto& noisyAO          = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
+        const auto& occlusion        = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
+        const auto& hilbertLUT       = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
 
-        const VkCopyImageInfo2 depthCopyInfo =
-        {
-            .sType          = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2,
-            .pNext          = nullptr,
-            .srcImage       = sceneDepth.image.handle,
-            .srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            .dstImage       = sceneDepthAsyncCompute.image.handle,
-            .dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            .regionCount    = 1,
-            .pRegions       = &depthCopyRegion
-        };
-
-        vkCmdCopyImage2(cmdBuffer.handle, &depthCopyInfo);
-
-        const VkImageCopy2 normalCopyRegion =
-        {
-            .sType          = VK_STRUCTURE_TYPE_IMAGE_COPY_2,
-            .pNext          = nullptr,
-            .srcSubresource = {
-                .aspectMask     = gNormal.image.aspect,
-                .mipLevel       = 0,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            },
-            .srcOffset      = {0, 0, 0},
-            .dstSubresource = {
-                .aspectMask     = gNormalAsyncCompute.image.aspect,
-                .mipLevel       = 0,
-                .baseArrayLayer = 0,
-                .layerCount     = 1
-            },
-            .dstOffset      = {0, 0, 0},
-            .extent         = {gNormal.image.width, gNormal.image.height, 1}
-        };
-
-        const VkCopyImageInfo2 normalCopyInfo =
-        {
-            .sType          = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2,
-            .pNext          = nullptr,
-            .srcImage       = gNormal.image.handle,
-            .srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            .dstImage       = gNormalAsyncCompute.image.handle,
-            .dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            .regionCount    = 1,
-            .pRegions       = &normalCopyRegion
-        };
-
-        vkCmdCopyImage2(cmdBuffer.handle, &normalCopyInfo);
-
-        barrierWriter
-        .WriteImageBarrier(
-            sceneDepth.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .srcAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepth.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepth.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .dstQueueFamily = *m_context.queueFamilies.computeFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormal.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .srcAccessMask  = VK_ACCESS_2_TRANSFER_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormal.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormal.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COPY_BIT,
-                .srcAccessMask  = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamily = VK_QUEUE_FAMILY_IGNORED,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .dstQueueFamily = *m_context.queueFamilies.computeFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
+        Vk::BarrierWriter{}
         .WriteImageBarrier(
             depthMipChain.image,
             Vk::ImageBarrier{
@@ -1045,49 +620,13 @@ namespace Renderer
     {
         Vk::BeginLabel(cmdBuffer, "Graphics -> Async Compute | Acquire", {0.6726f, 0.6538f, 0.4518f, 1.0f});
 
-        const auto& sceneDepthAsyncCompute = m_framebufferManager.GetFramebuffer("SceneDepthAsyncCompute");
-        const auto& gNormalAsyncCompute    = m_framebufferManager.GetFramebuffer("GNormalAsyncCompute");
-        const auto& depthMipChain          = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
-        const auto& depthDifferences       = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
-        const auto& noisyAO                = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
-        const auto& occlusion              = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
-        const auto& hilbertLUT             = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
+        const auto& depthMipChain    = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
+        const auto& depthDifferences = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
+        const auto& noisyAO          = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
+        const auto& occlusion        = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
+        const auto& hilbertLUT       = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
 
         Vk::BarrierWriter{}
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .dstQueueFamily = *m_context.queueFamilies.computeFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .dstQueueFamily = *m_context.queueFamilies.computeFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
         .WriteImageBarrier(
             depthMipChain.image,
             Vk::ImageBarrier{
@@ -1182,49 +721,13 @@ namespace Renderer
     {
         Vk::BeginLabel(cmdBuffer, "Async Compute -> Graphics | Release", {0.6726f, 0.6538f, 0.4518f, 1.0f});
 
-        const auto& sceneDepthAsyncCompute = m_framebufferManager.GetFramebuffer("SceneDepthAsyncCompute");
-        const auto& gNormalAsyncCompute    = m_framebufferManager.GetFramebuffer("GNormalAsyncCompute");
-        const auto& depthMipChain          = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
-        const auto& depthDifferences       = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
-        const auto& noisyAO                = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
-        const auto& occlusion              = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
-        const auto& hilbertLUT             = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
+        const auto& depthMipChain    = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
+        const auto& depthDifferences = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
+        const auto& noisyAO          = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
+        const auto& occlusion        = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
+        const auto& hilbertLUT       = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
 
         Vk::BarrierWriter{}
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.computeFamily,
-                .dstQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                .srcAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .dstAccessMask  = VK_ACCESS_2_NONE,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.computeFamily,
-                .dstQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
         .WriteImageBarrier(
             depthMipChain.image,
             Vk::ImageBarrier{
@@ -1319,49 +822,13 @@ namespace Renderer
     {
         Vk::BeginLabel(cmdBuffer, "Async Compute -> Graphics | Acquire", {0.6726f, 0.6538f, 0.4518f, 1.0f});
 
-        const auto& sceneDepthAsyncCompute = m_framebufferManager.GetFramebuffer("SceneDepthAsyncCompute");
-        const auto& gNormalAsyncCompute    = m_framebufferManager.GetFramebuffer("GNormalAsyncCompute");
-        const auto& depthMipChain          = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
-        const auto& depthDifferences       = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
-        const auto& noisyAO                = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
-        const auto& occlusion              = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
-        const auto& hilbertLUT             = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
+        const auto& depthMipChain    = m_framebufferManager.GetFramebuffer("VBGTAO/DepthMipChain");
+        const auto& depthDifferences = m_framebufferManager.GetFramebuffer("VBGTAO/DepthDifferences");
+        const auto& noisyAO          = m_framebufferManager.GetFramebuffer("VBGTAO/NoisyAO");
+        const auto& occlusion        = m_framebufferManager.GetFramebuffer("VBGTAO/Occlusion");
+        const auto& hilbertLUT       = m_modelManager.textureManager.GetTexture(m_vbgtao.hilbertLUT);
 
         Vk::BarrierWriter{}
-        .WriteImageBarrier(
-            sceneDepthAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.computeFamily,
-                .dstQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = sceneDepthAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = sceneDepthAsyncCompute.image.arrayLayers
-            }
-        )
-        .WriteImageBarrier(
-            gNormalAsyncCompute.image,
-            Vk::ImageBarrier{
-                .srcStageMask   = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask  = VK_ACCESS_2_NONE,
-                .dstStageMask   = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-                .dstAccessMask  = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
-                .oldLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .newLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamily = *m_context.queueFamilies.computeFamily,
-                .dstQueueFamily = *m_context.queueFamilies.graphicsFamily,
-                .baseMipLevel   = 0,
-                .levelCount     = gNormalAsyncCompute.image.mipLevels,
-                .baseArrayLayer = 0,
-                .layerCount     = gNormalAsyncCompute.image.arrayLayers
-            }
-        )
         .WriteImageBarrier(
             depthMipChain.image,
             Vk::ImageBarrier{
@@ -1571,17 +1038,46 @@ namespace Renderer
             m_deletionQueues[m_FIF]
         );
 
-        m_scene->Update
+        if (const auto instanceCount = m_benchmark.BeginFrame(); instanceCount.has_value())
+        {
+            const usize generatedCount = m_scene->generator.Generate
+            (
+                *m_scene,
+                m_context,
+                m_modelManager,
+                m_megaSet,
+                m_deletionQueues[m_FIF],
+                *instanceCount
+            );
+
+            m_benchmark.SetGeneratedCount(generatedCount);
+        }
+
+        {
+            const auto sceneTimer = m_benchmark.Measure(Benchmark::Stage::SceneUpdate);
+
+            m_scene->Update
+            (
+                cmdBuffer,
+                m_frameCounter,
+                m_window.inputs,
+                m_context,
+                m_formatHelper,
+                m_modelManager,
+                m_megaSet,
+                m_iblGenerator,
+                m_deletionQueues[m_FIF]
+            );
+        }
+
+        m_iblGenerator.Update
         (
             cmdBuffer,
-            m_frameCounter,
-            m_window.inputs,
             m_context,
-            m_formatHelper,
-            m_modelManager,
+            m_modelManager.textureManager,
             m_megaSet,
-            m_iblGenerator,
-            m_deletionQueues[m_FIF]
+            m_deletionQueues[m_FIF],
+            m_scene->iblMaps
         );
 
         m_modelManager.Update
@@ -1595,12 +1091,16 @@ namespace Renderer
 
         m_megaSet.Update(m_context.device);
 
+        const auto renderExtent = m_dynamicResolution.GetRenderExtent(m_swapchain.extent, m_taa.GetRenderScale());
+
         m_sceneBuffer.WriteScene
         (
             m_FIF,
             m_frameIndex,
+            m_context.device,
             m_context.allocator,
             m_swapchain.extent,
+            renderExtent,
             *m_scene
         );
 
@@ -1610,27 +1110,42 @@ namespace Renderer
             (
                 m_FIF,
                 m_frameIndex,
+                m_context.device,
                 m_context.allocator,
                 m_swapchain.extent,
+                renderExtent,
                 *m_scene
             );
         }
 
-        m_meshBuffer.LoadMeshes
-        (
-            m_frameIndex,
-            m_context.allocator,
-            m_modelManager,
-            m_scene->renderObjects
-        );
+        {
+            const auto meshBufferTimer = m_benchmark.Measure(Benchmark::Stage::MeshBuffer);
 
-        m_indirectBuffer.WriteDrawCalls
-        (
-            m_FIF,
-            m_context.allocator,
-            m_modelManager,
-            m_scene->renderObjects
-        );
+            m_meshBuffer.LoadMeshes
+            (
+                m_frameIndex,
+                m_context.allocator,
+                m_modelManager,
+                m_scene->renderObjects,
+                m_scene->dirtyRenderObjects,
+                m_scene->haveRenderObjectsChanged
+            );
+        }
+
+        m_scene->dirtyRenderObjects.clear();
+
+        {
+            const auto drawCallTimer = m_benchmark.Measure(Benchmark::Stage::DrawCalls);
+
+            m_indirectBuffer.WriteDrawCalls
+            (
+                m_FIF,
+                m_context.allocator,
+                m_modelManager,
+                m_scene->renderObjects,
+                m_scene->haveRenderObjectsChanged
+            );
+        }
 
         ImGuiDisplay();
     }
@@ -1641,6 +1156,10 @@ namespace Renderer
         m_modelManager.ImGuiDisplay();
         m_framebufferManager.ImGuiDisplay();
         m_megaSet.ImGuiDisplay();
+        m_culling.ImGuiDisplay();
+        m_gBuffer.ImGuiDisplay();
+        m_dynamicResolution.ImGuiDisplay();
+        m_benchmark.ImGuiDisplay();
 
         if (ImGui::BeginMainMenuBar())
         {
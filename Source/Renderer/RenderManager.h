@@ -31,6 +31,9 @@
 #include "AO/VBGTAO/Dispatch.h"
 #include "ShadowRT/RayDispatch.h"
 #include "TAA/RenderPass.h"
+#include "Benchmark.h"
+#include "DynamicResolution.h"
+#include "FrameScheduler.h"
 #include "Culling/Dispatch.h"
 #include "IBL/Generator.h"
 #include "Vulkan/Context.h"
@@ -62,8 +65,8 @@ namespace Renderer
         void AcquireSwapchainImage();
         void BeginFrame();
 
-        void RenderGraphicsQueueOnly();
-        void RenderMultiQueue();
+        // Declares this frame's passes, the scheduler decides how they are split across queues
+        void RenderFrame();
 
         void GBufferGeneration(const Vk::CommandBuffer& cmdBuffer);
 
@@ -98,6 +101,7 @@ namespace Renderer
         usize m_frameIndex = 0;
 
         Util::FrameCounter m_frameCounter = {};
+        Benchmark          m_benchmark    = {};
 
         Util::DeletionQueue                                   m_globalDeletionQueue = {};
         std::array<Util::DeletionQueue, Vk::FRAMES_IN_FLIGHT> m_deletionQueues      = {};
@@ -113,6 +117,8 @@ namespace Renderer
         Vk::GraphicsTimeline               m_graphicsTimeline;
         std::optional<Vk::ComputeTimeline> m_computeTimeline = std::nullopt;
 
+        FrameScheduler m_frameScheduler = {};
+
         Vk::FormatHelper m_formatHelper;
 
         Vk::MegaSet               m_megaSet;
@@ -136,6 +142,8 @@ namespace Renderer
 
         IBL::Generator m_iblGenerator;
 
+        DynamicResolution m_dynamicResolution;
+
         Buffers::MeshBuffer     m_meshBuffer;
         Buffers::IndirectBuffer m_indirectBuffer;
 
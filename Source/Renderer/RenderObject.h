@@ -17,11 +17,21 @@
 #ifndef RENDER_OBJECT_H
 #define RENDER_OBJECT_H
 
+#include <optional>
+
 #include "Externals/GLM.h"
 #include "Models/ModelManager.h"
 
 namespace Renderer
 {
+    // Which system added a render object or light, layered content is removed by owner instead of by position
+    enum class ContentOwner : u8
+    {
+        Scene,
+        Generator,
+        Streamer
+    };
+
     struct RenderObject
     {
         void Destroy
@@ -37,6 +47,10 @@ namespace Renderer
         glm::vec3       position = {};
         glm::vec3       rotation = {};
         glm::vec3       scale    = {1.0f, 1.0f, 1.0f};
+
+        ContentOwner owner = ContentOwner::Scene;
+        // Streaming cell that owns this object, only set for streamed objects
+        std::optional<u32> cell = std::nullopt;
     };
 }
 
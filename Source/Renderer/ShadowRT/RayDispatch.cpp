@@ -181,7 +181,8 @@ namespace Renderer::ShadowRT
         {
             .TLAS                = accelerationStructure.topLevelASes[FIF].deviceAddress,
             .Scene               = sceneBuffer.buffers[FIF].deviceAddress,
-            .Meshes              = meshBuffer.GetCurrentBuffer(frameIndex).deviceAddress,
+            .Meshes              = meshBuffer.GetCurrentStreams(frameIndex).meshes.deviceAddress,
+            .Materials           = meshBuffer.GetCurrentStreams(frameIndex).materials.deviceAddress,
             .Indices             = modelManager.geometryBuffer.GetIndexBuffer().deviceAddress,
             .Vertices            = modelManager.geometryBuffer.GetVertexBuffer().deviceAddress,
             .GBufferSamplerIndex = modelManager.textureManager.GetSampler(m_pipeline.gBufferSamplerID).descriptorID,
@@ -211,8 +212,8 @@ namespace Renderer::ShadowRT
             &m_shaderBindingTable.missRegion,
             &m_shaderBindingTable.hitRegion,
             &emptyCallableRegion,
-            shadowMap.image.width,
-            shadowMap.image.height,
+            sceneBuffer.renderExtent.width,
+            sceneBuffer.renderExtent.height,
             1
         );
 
@@ -125,8 +125,8 @@ namespace Renderer::Skybox
         {
             .x        = 0.0f,
             .y        = 0.0f,
-            .width    = static_cast<f32>(colorAttachment.image.width),
-            .height   = static_cast<f32>(colorAttachment.image.height),
+            .width    = static_cast<f32>(sceneBuffer.renderExtent.width),
+            .height   = static_cast<f32>(sceneBuffer.renderExtent.height),
             .minDepth = 0.0f,
             .maxDepth = 0.0f
         };
@@ -136,7 +136,7 @@ namespace Renderer::Skybox
         const VkRect2D scissor =
         {
             .offset = {0, 0},
-            .extent = {colorAttachment.image.width, colorAttachment.image.height}
+            .extent = {sceneBuffer.renderExtent.width, sceneBuffer.renderExtent.height}
         };
 
         vkCmdSetScissorWithCount(cmdBuffer.handle, 1, &scissor);
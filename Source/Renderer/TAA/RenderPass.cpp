@@ -115,11 +115,13 @@ namespace Renderer::TAA
 
     void RenderPass::Render
     (
+        usize FIF,
         usize frameIndex,
         const Vk::CommandBuffer& cmdBuffer,
         const Vk::FramebufferManager& framebufferManager,
         const Vk::MegaSet& megaSet,
-        const Vk::TextureManager& textureManager
+        const Vk::TextureManager& textureManager,
+        const Buffers::SceneBuffer& sceneBuffer
     )
     {
         Vk::BeginLabel(cmdBuffer, "TAA", glm::vec4(0.6098f, 0.7843f, 0.7549f, 1.0f));
@@ -128,6 +130,23 @@ namespace Renderer::TAA
         {
             if (ImGui::BeginMenu("TAA"))
             {
+                constexpr std::array MODE_NAMES = {"Native", "Temporal Upsampling"};
+
+                s32 mode = static_cast<s32>(m_mode);
+
+                if (ImGui::Combo("Mode", &mode, MODE_NAMES.data(), static_cast<s32>(MODE_NAMES.size())))
+                {
+                    m_mode              = static_cast<TAA::Mode>(mode);
+                    m_hasToResetHistory = true;
+                }
+
+                if (m_mode == TAA::Mode::Upsample)
+                {
+                    ImGui::SliderFloat("Upsampling Ratio", &m_upsampleRatio, 0.5f, 1.0f, "%.2f");
+                }
+
+                ImGui::Separator();
+
                 if (ImGui::Button("Reset History"))
                 {
                     m_hasToResetHistory = true;
@@ -326,12 +345,14 @@ namespace Renderer::TAA
 
         const auto constants = TAA::Constants
         {
+            .Scene              = sceneBuffer.buffers[FIF].deviceAddress,
             .PointSamplerIndex  = textureManager.GetSampler(m_pipeline.pointSamplerID).descriptorID,
             .LinearSamplerIndex = textureManager.GetSampler(m_pipeline.linearSamplerID).descriptorID,
             .CurrentColorIndex  = framebufferManager.GetFramebufferView("SceneColorView").sampledImageID,
             .HistoryBufferIndex = framebufferManager.GetFramebufferView(fmt::format("TAABufferView/{}", previousIndex)).sampledImageID,
             .VelocityIndex      = framebufferManager.GetFramebufferView("GMotionVectorsView").sampledImageID,
-            .SceneDepthIndex    = framebufferManager.GetFramebufferView("SceneDepthView").sampledImageID
+            .SceneDepthIndex    = framebufferManager.GetFramebufferView("SceneDepthView").sampledImageID,
+            .CurrentMode        = m_mode
         };
 
         m_pipeline.PushConstants
@@ -400,6 +421,11 @@ namespace Renderer::TAA
         m_hasToResetHistory = true;
     }
 
+    f32 RenderPass::GetRenderScale() const
+    {
+        return m_mode == TAA::Mode::Upsample ? m_upsampleRatio : 1.0f;
+    }
+
     void RenderPass::Destroy(VkDevice device)
     {
         m_pipeline.Destroy(device);
@@ -21,6 +21,8 @@
 #include "Vulkan/CommandBuffer.h"
 #include "Vulkan/MegaSet.h"
 #include "Vulkan/FramebufferManager.h"
+#include "Renderer/Buffers/SceneBuffer.h"
+#include "Misc/TAA.h"
 
 namespace Renderer::TAA
 {
@@ -40,18 +42,25 @@ namespace Renderer::TAA
 
         void Render
         (
+            usize FIF,
             usize frameIndex,
             const Vk::CommandBuffer& cmdBuffer,
             const Vk::FramebufferManager& framebufferManager,
             const Vk::MegaSet& megaSet,
-            const Vk::TextureManager& textureManager
+            const Vk::TextureManager& textureManager,
+            const Buffers::SceneBuffer& sceneBuffer
         );
 
         void ResetHistory();
+
+        [[nodiscard]] f32 GetRenderScale() const;
     private:
         TAA::Pipeline m_pipeline;
 
         bool m_hasToResetHistory = true;
+
+        TAA::Mode m_mode          = TAA::Mode::Native;
+        f32       m_upsampleRatio = 0.7071f; // Half the pixels
     };
 }
 
@@ -16,8 +16,145 @@
 
 #include "Maths.h"
 
+#include <immintrin.h>
+#include <numbers>
+
+#include "Parallel.h"
+
 namespace Maths
 {
+    constexpr usize TRANSFORM_SIMD_WIDTH  = 8;
+    constexpr usize TRANSFORM_GROUP_BATCH = 32;
+
+    namespace
+    {
+        __m256 MulAdd(__m256 a, __m256 b, __m256 c)
+        {
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+        }
+
+        // Taylor series after reducing to [-pi/2, pi/2], accurate to a few ulps
+        void SinCos(__m256 angle, __m256& sine, __m256& cosine)
+        {
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            const __m256 pi       = _mm256_set1_ps(std::numbers::pi_v<f32>);
+            const __m256 halfPi   = _mm256_set1_ps(std::numbers::pi_v<f32> / 2.0f);
+
+            // Two part 2 * pi keeps the reduction accurate for a few turns
+            const __m256 turns = _mm256_round_ps
+            (
+                _mm256_mul_ps(angle, _mm256_set1_ps(std::numbers::inv_pi_v<f32> / 2.0f)),
+                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+            );
+
+            __m256 x = _mm256_sub_ps(angle, _mm256_mul_ps(turns, _mm256_set1_ps(6.28318548202514648f)));
+            x        = _mm256_sub_ps(x,     _mm256_mul_ps(turns, _mm256_set1_ps(-1.7484556e-7f)));
+
+            // Fold into [-pi/2, pi/2], sine is symmetric about pi/2 and cosine flips sign
+            const __m256 sign      = _mm256_and_ps(x, signMask);
+            const __m256 reflect   = _mm256_cmp_ps(_mm256_andnot_ps(signMask, x), halfPi, _CMP_GT_OQ);
+            const __m256 reflected = _mm256_sub_ps(_mm256_or_ps(pi, sign), x);
+
+            x = _mm256_blendv_ps(x, reflected, reflect);
+
+            const __m256 x2 = _mm256_mul_ps(x, x);
+
+            __m256 s = _mm256_set1_ps(-1.0f / 39916800.0f);
+            s        = MulAdd(s, x2, _mm256_set1_ps( 1.0f / 362880.0f));
+            s        = MulAdd(s, x2, _mm256_set1_ps(-1.0f / 5040.0f));
+            s        = MulAdd(s, x2, _mm256_set1_ps( 1.0f / 120.0f));
+            s        = MulAdd(s, x2, _mm256_set1_ps(-1.0f / 6.0f));
+            s        = MulAdd(s, x2, _mm256_set1_ps( 1.0f));
+
+            __m256 c = _mm256_set1_ps(1.0f / 479001600.0f);
+            c        = MulAdd(c, x2, _mm256_set1_ps(-1.0f / 3628800.0f));
+            c        = MulAdd(c, x2, _mm256_set1_ps( 1.0f / 40320.0f));
+            c        = MulAdd(c, x2, _mm256_set1_ps(-1.0f / 720.0f));
+            c        = MulAdd(c, x2, _mm256_set1_ps( 1.0f / 24.0f));
+            c        = MulAdd(c, x2, _mm256_set1_ps(-1.0f / 2.0f));
+            c        = MulAdd(c, x2, _mm256_set1_ps( 1.0f));
+
+            sine   = _mm256_mul_ps(s, x);
+            cosine = _mm256_xor_ps(c, _mm256_and_ps(reflect, signMask));
+        }
+
+        void TransformGroup
+        (
+            const TransformBatch& batch,
+            usize first,
+            glm::mat4* __restrict__ transforms,
+            glm::mat3* __restrict__ normalMatrices
+        )
+        {
+            __m256 sinX, cosX, sinY, cosY, sinZ, cosZ;
+
+            SinCos(_mm256_loadu_ps(batch.rotationX.data() + first), sinX, cosX);
+            SinCos(_mm256_loadu_ps(batch.rotationY.data() + first), sinY, cosY);
+            SinCos(_mm256_loadu_ps(batch.rotationZ.data() + first), sinZ, cosZ);
+
+            const __m256 scaleX = _mm256_loadu_ps(batch.scaleX.data() + first);
+            const __m256 scaleY = _mm256_loadu_ps(batch.scaleY.data() + first);
+            const __m256 scaleZ = _mm256_loadu_ps(batch.scaleZ.data() + first);
+
+            // Columns of Rx * Ry * Rz, matching the glm::rotate chain in TransformMatrix
+            const __m256 sinXsinY = _mm256_mul_ps(sinX, sinY);
+            const __m256 cosXsinY = _mm256_mul_ps(cosX, sinY);
+
+            const std::array<__m256, 9> rotation =
+            {
+                _mm256_mul_ps(cosY, cosZ),
+                MulAdd(sinXsinY, cosZ, _mm256_mul_ps(cosX, sinZ)),
+                _mm256_sub_ps(_mm256_mul_ps(sinX, sinZ), _mm256_mul_ps(cosXsinY, cosZ)),
+
+                _mm256_xor_ps(_mm256_mul_ps(cosY, sinZ), _mm256_set1_ps(-0.0f)),
+                _mm256_sub_ps(_mm256_mul_ps(cosX, cosZ), _mm256_mul_ps(sinXsinY, sinZ)),
+                MulAdd(cosXsinY, sinZ, _mm256_mul_ps(sinX, cosZ)),
+
+                sinY,
+                _mm256_xor_ps(_mm256_mul_ps(sinX, cosY), _mm256_set1_ps(-0.0f)),
+                _mm256_mul_ps(cosX, cosY)
+            };
+
+            // Cofactor of R * S is R * diag(sy * sz, sx * sz, sx * sy)
+            const std::array<__m256, 3> columnScales = {scaleX, scaleY, scaleZ};
+            const std::array<__m256, 3> normalScales =
+            {
+                _mm256_mul_ps(scaleY, scaleZ),
+                _mm256_mul_ps(scaleX, scaleZ),
+                _mm256_mul_ps(scaleX, scaleY)
+            };
+
+            alignas(32) f32 matrixLanes[9][TRANSFORM_SIMD_WIDTH];
+            alignas(32) f32 normalLanes[9][TRANSFORM_SIMD_WIDTH];
+
+            for (usize i = 0; i < rotation.size(); ++i)
+            {
+                _mm256_store_ps(matrixLanes[i], _mm256_mul_ps(rotation[i], columnScales[i / 3]));
+                _mm256_store_ps(normalLanes[i], _mm256_mul_ps(rotation[i], normalScales[i / 3]));
+            }
+
+            for (usize lane = 0; lane < TRANSFORM_SIMD_WIDTH; ++lane)
+            {
+                const usize index = first + lane;
+
+                transforms[index] = glm::mat4
+                (
+                    matrixLanes[0][lane], matrixLanes[1][lane], matrixLanes[2][lane], 0.0f,
+                    matrixLanes[3][lane], matrixLanes[4][lane], matrixLanes[5][lane], 0.0f,
+                    matrixLanes[6][lane], matrixLanes[7][lane], matrixLanes[8][lane], 0.0f,
+                    batch.translationX[index], batch.translationY[index], batch.translationZ[index], 1.0f
+                );
+
+                normalMatrices[index] = glm::mat3
+                (
+                    normalLanes[0][lane], normalLanes[1][lane], normalLanes[2][lane],
+                    normalLanes[3][lane], normalLanes[4][lane], normalLanes[5][lane],
+                    normalLanes[6][lane], normalLanes[7][lane], normalLanes[8][lane]
+                );
+            }
+        }
+    }
+
     glm::mat4 TransformMatrix(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
     {
         auto matrix = glm::identity<glm::mat4>();
@@ -69,4 +206,66 @@ namespace Maths
             glm::cross(glm::vec3(transform[0]), glm::vec3(transform[1]))
         };
     }
+
+    void TransformBatch::Resize(usize count)
+    {
+        translationX.resize(count);
+        translationY.resize(count);
+        translationZ.resize(count);
+        rotationX.resize(count);
+        rotationY.resize(count);
+        rotationZ.resize(count);
+        scaleX.resize(count);
+        scaleY.resize(count);
+        scaleZ.resize(count);
+    }
+
+    void TransformBatch::Set(usize index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+    {
+        translationX[index] = translation.x;
+        translationY[index] = translation.y;
+        translationZ[index] = translation.z;
+        rotationX[index]    = rotation.x;
+        rotationY[index]    = rotation.y;
+        rotationZ[index]    = rotation.z;
+        scaleX[index]       = scale.x;
+        scaleY[index]       = scale.y;
+        scaleZ[index]       = scale.z;
+    }
+
+    usize TransformBatch::Size() const
+    {
+        return translationX.size();
+    }
+
+    void TransformMatrices
+    (
+        const TransformBatch& batch,
+        glm::mat4* __restrict__ transforms,
+        glm::mat3* __restrict__ normalMatrices
+    )
+    {
+        const usize count      = batch.Size();
+        const usize groupCount = count / TRANSFORM_SIMD_WIDTH;
+
+        Util::ParallelFor(groupCount, TRANSFORM_GROUP_BATCH, [&] (usize begin, usize end)
+        {
+            for (usize group = begin; group < end; ++group)
+            {
+                TransformGroup(batch, group * TRANSFORM_SIMD_WIDTH, transforms, normalMatrices);
+            }
+        });
+
+        for (usize i = groupCount * TRANSFORM_SIMD_WIDTH; i < count; ++i)
+        {
+            transforms[i] = TransformMatrix
+            (
+                {batch.translationX[i], batch.translationY[i], batch.translationZ[i]},
+                {batch.rotationX[i],    batch.rotationY[i],    batch.rotationZ[i]},
+                {batch.scaleX[i],       batch.scaleY[i],       batch.scaleZ[i]}
+            );
+
+            normalMatrices[i] = NormalMatrix(transforms[i]);
+        }
+    }
 }
\ No newline at end of file
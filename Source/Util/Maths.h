@@ -17,6 +17,8 @@
 #ifndef MATHS_H
 #define MATHS_H
 
+#include <vector>
+
 #include "Types.h"
 #include "Externals/GLM.h"
 
@@ -27,6 +29,36 @@ namespace Maths
     glm::mat4 InfiniteProjectionReverseZ(f32 FOV, f32 aspectRatio, f32 nearPlane);
     glm::mat3 NormalMatrix(const glm::mat4& transform);
 
+    // Translation, rotation and scale in SoA form, one entry per transform
+    struct TransformBatch
+    {
+        void Resize(usize count);
+
+        void Set(usize index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+
+        [[nodiscard]] usize Size() const;
+
+        std::vector<f32> translationX = {};
+        std::vector<f32> translationY = {};
+        std::vector<f32> translationZ = {};
+        std::vector<f32> rotationX    = {};
+        std::vector<f32> rotationY    = {};
+        std::vector<f32> rotationZ    = {};
+        std::vector<f32> scaleX       = {};
+        std::vector<f32> scaleY       = {};
+        std::vector<f32> scaleZ       = {};
+    };
+
+    // Same results as TransformMatrix and NormalMatrix, 8 transforms at a time across the shared executor
+    // `transforms` and `normalMatrices` must hold at least `batch.Size()` entries
+    // Requires AVX2
+    void TransformMatrices
+    (
+        const TransformBatch& batch,
+        glm::mat4* __restrict__ transforms,
+        glm::mat3* __restrict__ normalMatrices
+    );
+
     constexpr f32 Halton(usize index, usize base)
     {
         f64 result = 0.0;
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace Util
+{
+    tf::Executor& GetExecutor()
+    {
+        static tf::Executor executor;
+
+        return executor;
+    }
+
+    void ParallelFor(usize count, usize batchSize, const ParallelJob& job)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        batchSize = std::max<usize>(batchSize, 1);
+
+        // Not worth waking anyone up
+        if (count <= batchSize)
+        {
+            job(0, count);
+            return;
+        }
+
+        const usize batchCount = (count + batchSize - 1) / batchSize;
+
+        tf::Taskflow taskflow;
+
+        taskflow.for_each_index(usize{0}, batchCount, usize{1}, [count, batchSize, &job] (usize batch)
+        {
+            const usize begin = batch * batchSize;
+            const usize end   = std::min(begin + batchSize, count);
+
+            job(begin, end);
+        });
+
+        GetExecutor().run(taskflow).wait();
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2023 - 2025 Rachit
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+#include "Types.h"
+#include "Externals/Taskflow.h"
+
+namespace Util
+{
+    // Range job, called with [begin, end)
+    using ParallelJob = std::function<void(usize, usize)>;
+
+    // Process wide executor, shared by every CPU side job so pools never oversubscribe the CPU
+    [[nodiscard]] tf::Executor& GetExecutor();
+
+    // Splits [0, count) into batches on the shared executor and blocks until every batch is done
+    void ParallelFor(usize count, usize batchSize, const ParallelJob& job);
+}
+
+#endif
@@ -55,6 +55,11 @@ namespace Vk
         #endif
     };
 
+    constexpr std::array MESH_SHADER_DEVICE_EXTENSIONS =
+    {
+        VK_EXT_MESH_SHADER_EXTENSION_NAME
+    };
+
     Context::Context(SDL_Window* window)
     {
         Vk::CheckResult(volkInitialize(), "Failed to initialize volk!");
@@ -162,15 +167,25 @@ namespace Vk
         auto vk11Properties       = ankerl::unordered_dense::map<VkPhysicalDevice, VkPhysicalDeviceVulkan11Properties>(deviceCount);
         auto vk12Properties       = ankerl::unordered_dense::map<VkPhysicalDevice, VkPhysicalDeviceVulkan12Properties>(deviceCount);
         auto rtPipelineProperties = ankerl::unordered_dense::map<VkPhysicalDevice, VkPhysicalDeviceRayTracingPipelinePropertiesKHR>(deviceCount);
+        auto meshShaderProperties = ankerl::unordered_dense::map<VkPhysicalDevice, VkPhysicalDeviceMeshShaderPropertiesEXT>(deviceCount);
+        auto meshShaderSupport    = ankerl::unordered_dense::map<VkPhysicalDevice, bool>(deviceCount);
+        auto viewportIndexSupport = ankerl::unordered_dense::map<VkPhysicalDevice, bool>(deviceCount);
 
         auto features = ankerl::unordered_dense::map<VkPhysicalDevice, VkPhysicalDeviceFeatures2>(deviceCount);
         auto scores   = ankerl::unordered_dense::map<VkPhysicalDevice, usize>{};
 
         for (const auto& currentDevice : devices)
         {
+            // Only chain the mesh shader structures when the device knows about them
+            const bool hasMeshShaderExtension = Vk::CheckDeviceExtensionSupport(currentDevice, MESH_SHADER_DEVICE_EXTENSIONS);
+
+            VkPhysicalDeviceMeshShaderPropertiesEXT meshShaderPropertySet = {};
+            meshShaderPropertySet.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+            meshShaderPropertySet.pNext = nullptr;
+
             VkPhysicalDeviceRayTracingPipelinePropertiesKHR rtPipelinePropertySet = {};
             rtPipelinePropertySet.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
-            rtPipelinePropertySet.pNext = nullptr;
+            rtPipelinePropertySet.pNext = hasMeshShaderExtension ? &meshShaderPropertySet : nullptr;
 
             VkPhysicalDeviceVulkan12Properties vk12PropertySet = {};
             vk12PropertySet.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
@@ -222,9 +237,13 @@ namespace Vk
             vk13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
             vk13Features.pNext = &vk12Features;
 
+            VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = {};
+            meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+            meshShaderFeatures.pNext = &vk13Features;
+
             VkPhysicalDeviceFeatures2 featureSet = {};
             featureSet.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-            featureSet.pNext = &vk13Features;
+            featureSet.pNext = hasMeshShaderExtension ? static_cast<void*>(&meshShaderFeatures) : &vk13Features;
 
             vkGetPhysicalDeviceProperties2(currentDevice, &propertySet);
             vkGetPhysicalDeviceFeatures2(currentDevice, &featureSet);
@@ -233,6 +252,10 @@ namespace Vk
             vk11Properties.emplace(currentDevice, vk11PropertySet);
             vk12Properties.emplace(currentDevice, vk12PropertySet);
             rtPipelineProperties.emplace(currentDevice, rtPipelinePropertySet);
+            meshShaderProperties.emplace(currentDevice, meshShaderPropertySet);
+
+            meshShaderSupport.emplace(currentDevice, hasMeshShaderExtension && meshShaderFeatures.taskShader && meshShaderFeatures.meshShader);
+            viewportIndexSupport.emplace(currentDevice, featureSet.features.multiViewport && vk12Features.shaderOutputViewportIndex);
 
             features.emplace(currentDevice, featureSet);
             scores.emplace(currentDevice, CalculateScore(currentDevice, propertySet, featureSet));
@@ -260,8 +283,20 @@ namespace Vk
         physicalDeviceLimits                       = properties[physicalDevice].properties.limits;
         physicalDeviceRayTracingPipelineProperties = rtPipelineProperties[physicalDevice];
         physicalDeviceVulkan12Properties           = vk12Properties[physicalDevice];
+        physicalDeviceMeshShaderProperties         = meshShaderProperties[physicalDevice];
 
-        Logger::Info("Selected GPU! [GPU={}]\n", properties[physicalDevice].properties.deviceName);
+        isMeshShaderSupported     = meshShaderSupport[physicalDevice];
+        isGeometryShaderSupported = features[physicalDevice].features.geometryShader;
+        isViewportIndexSupported  = viewportIndexSupport[physicalDevice];
+
+        Logger::Info
+        (
+            "Selected GPU! [GPU={}] [MeshShaders={}] [GeometryShaders={}] [ViewportIndex={}]\n",
+            properties[physicalDevice].properties.deviceName,
+            isMeshShaderSupported,
+            isGeometryShaderSupported,
+            isViewportIndexSupported
+        );
     }
 
     usize Context::CalculateScore
@@ -461,6 +496,7 @@ namespace Vk
         vk12Features.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
         vk12Features.drawIndirectCount                            = VK_TRUE;
         vk12Features.timelineSemaphore                            = VK_TRUE;
+        vk12Features.shaderOutputViewportIndex                    = isViewportIndexSupported;
 
         VkPhysicalDeviceVulkan13Features vk13Features = {};
         vk13Features.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
@@ -469,9 +505,15 @@ namespace Vk
         vk13Features.dynamicRendering = VK_TRUE;
         vk13Features.maintenance4     = VK_TRUE;
 
+        VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = {};
+        meshShaderFeatures.sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        meshShaderFeatures.pNext      = &vk13Features;
+        meshShaderFeatures.taskShader = VK_TRUE;
+        meshShaderFeatures.meshShader = VK_TRUE;
+
         VkPhysicalDeviceFeatures2 deviceFeatures = {};
         deviceFeatures.sType                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-        deviceFeatures.pNext                         = &vk13Features;
+        deviceFeatures.pNext                         = isMeshShaderSupported ? static_cast<void*>(&meshShaderFeatures) : &vk13Features;
         deviceFeatures.features.samplerAnisotropy    = VK_TRUE;
         deviceFeatures.features.multiDrawIndirect    = VK_TRUE;
         deviceFeatures.features.textureCompressionBC = VK_TRUE;
@@ -479,6 +521,15 @@ namespace Vk
         deviceFeatures.features.depthClamp           = VK_TRUE;
         deviceFeatures.features.shaderInt64          = VK_TRUE;
         deviceFeatures.features.fullDrawIndexUint32  = VK_TRUE;
+        deviceFeatures.features.geometryShader       = isGeometryShaderSupported;
+        deviceFeatures.features.multiViewport        = isViewportIndexSupported;
+
+        auto extensions = std::vector<const char*>(REQUIRED_DEVICE_EXTENSIONS.begin(), REQUIRED_DEVICE_EXTENSIONS.end());
+
+        if (isMeshShaderSupported)
+        {
+            extensions.insert(extensions.end(), MESH_SHADER_DEVICE_EXTENSIONS.begin(), MESH_SHADER_DEVICE_EXTENSIONS.end());
+        }
 
         const VkDeviceCreateInfo createInfo =
         {
@@ -489,8 +540,8 @@ namespace Vk
             .pQueueCreateInfos       = queueCreateInfos.data(),
             .enabledLayerCount       = 0,
             .ppEnabledLayerNames     = nullptr,
-            .enabledExtensionCount   = static_cast<u32>(REQUIRED_DEVICE_EXTENSIONS.size()),
-            .ppEnabledExtensionNames = REQUIRED_DEVICE_EXTENSIONS.data(),
+            .enabledExtensionCount   = static_cast<u32>(extensions.size()),
+            .ppEnabledExtensionNames = extensions.data(),
             .pEnabledFeatures        = nullptr
         };
 
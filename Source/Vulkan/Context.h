@@ -42,6 +42,15 @@ namespace Vk
         VkPhysicalDeviceLimits                          physicalDeviceLimits                       = {};
         VkPhysicalDeviceVulkan12Properties              physicalDeviceVulkan12Properties           = {};
         VkPhysicalDeviceRayTracingPipelinePropertiesKHR physicalDeviceRayTracingPipelineProperties = {};
+        VkPhysicalDeviceMeshShaderPropertiesEXT         physicalDeviceMeshShaderProperties         = {};
+
+        // Optional, geometry passes fall back to indexed draws without it
+        bool isMeshShaderSupported = false;
+        // Optional, gl_PrimitiveID in fragment shaders, the visibility buffer is disabled without it
+        bool isGeometryShaderSupported = false;
+        // Optional, gl_ViewportIndex from vertex shaders, point shadows draw each face separately without it
+        bool isViewportIndexSupported = false;
+
         // Logical device
         VkDevice device = VK_NULL_HANDLE;
 
@@ -66,6 +66,24 @@ namespace Vk
             VK_FORMAT_FEATURE_2_SAMPLED_IMAGE_FILTER_LINEAR_BIT
         );
 
+        storageFormatHDR = FindSupportedFormat
+        (
+            physicalDevice,
+            std::array
+            {
+                VK_FORMAT_B10G11R11_UFLOAT_PACK32,
+                VK_FORMAT_R16G16B16A16_SFLOAT,
+                VK_FORMAT_R32G32B32A32_SFLOAT,
+                VK_FORMAT_R64G64B64A64_SFLOAT
+            },
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT |
+            VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT |
+            VK_FORMAT_FEATURE_2_TRANSFER_DST_BIT |
+            VK_FORMAT_FEATURE_2_SAMPLED_IMAGE_BIT |
+            VK_FORMAT_FEATURE_2_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+        );
+
         depthFormat = FindSupportedFormat
         (
             physicalDevice,
@@ -94,20 +112,7 @@ namespace Vk
     {
         for (const auto format : candidates)
         {
-            VkFormatProperties3 properties3 = {};
-            properties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3;
-            properties3.pNext = nullptr;
-
-            VkFormatProperties2 properties2 = {};
-            properties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
-            properties2.pNext = &properties3;
-
-            vkGetPhysicalDeviceFormatProperties2(physicalDevice, format, &properties2);
-
-            const bool isValidLinear  = (tiling == VK_IMAGE_TILING_LINEAR)  && ((properties3.linearTilingFeatures  & features) == features);
-            const bool isValidOptimal = (tiling == VK_IMAGE_TILING_OPTIMAL) && ((properties3.optimalTilingFeatures & features) == features);
-
-            if (isValidLinear || isValidOptimal)
+            if (IsFormatSupported(physicalDevice, format, tiling, features))
             {
                 return format;
             }
@@ -122,4 +127,28 @@ namespace Vk
             string_VkFormatFeatureFlags(features)
         );
     }
+
+    bool FormatHelper::IsFormatSupported
+    (
+        VkPhysicalDevice physicalDevice,
+        VkFormat format,
+        VkImageTiling tiling,
+        VkFormatFeatureFlags2 features
+    )
+    {
+        VkFormatProperties3 properties3 = {};
+        properties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3;
+        properties3.pNext = nullptr;
+
+        VkFormatProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+        properties2.pNext = &properties3;
+
+        vkGetPhysicalDeviceFormatProperties2(physicalDevice, format, &properties2);
+
+        const bool isValidLinear  = (tiling == VK_IMAGE_TILING_LINEAR)  && ((properties3.linearTilingFeatures  & features) == features);
+        const bool isValidOptimal = (tiling == VK_IMAGE_TILING_OPTIMAL) && ((properties3.optimalTilingFeatures & features) == features);
+
+        return isValidLinear || isValidOptimal;
+    }
 }
@@ -34,10 +34,20 @@ namespace Vk
            VkFormatFeatureFlags2 features
         );
 
+        [[nodiscard]] static bool IsFormatSupported
+        (
+           VkPhysicalDevice physicalDevice,
+           VkFormat format,
+           VkImageTiling tiling,
+           VkFormatFeatureFlags2 features
+        );
+
         VkFormat colorAttachmentFormatLDR          = VK_FORMAT_UNDEFINED;
         VkFormat colorAttachmentFormatHDR          = VK_FORMAT_UNDEFINED;
         VkFormat colorAttachmentFormatHDRWithAlpha = VK_FORMAT_UNDEFINED;
 
+        VkFormat storageFormatHDR = VK_FORMAT_UNDEFINED;
+
         VkFormat depthFormat = VK_FORMAT_UNDEFINED;
     };
 }
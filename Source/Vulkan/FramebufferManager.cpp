@@ -29,7 +29,8 @@ namespace Vk
         FramebufferImageType imageType,
         FramebufferUsage usage,
         const FramebufferSizeData& sizeData,
-        const FramebufferInitialState& initialState
+        const FramebufferInitialState& initialState,
+        const std::span<const u32> queueFamilies
     )
     {
         if (m_framebuffers.contains(name.data()))
@@ -38,12 +39,13 @@ namespace Vk
         }
 
         m_framebuffers.emplace(name, Framebuffer{
-            .type         = type,
-            .imageType    = imageType,
-            .usage        = usage,
-            .sizeData     = sizeData,
-            .initialState = initialState,
-            .image        = {}
+            .type          = type,
+            .imageType     = imageType,
+            .usage         = usage,
+            .sizeData      = sizeData,
+            .initialState  = initialState,
+            .queueFamilies = {queueFamilies.begin(), queueFamilies.end()},
+            .image         = {}
         });
     }
 
@@ -134,6 +136,13 @@ namespace Vk
                 createInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
             }
 
+            if (framebuffer.queueFamilies.size() > 1)
+            {
+                createInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+                createInfo.queueFamilyIndexCount = static_cast<u32>(framebuffer.queueFamilies.size());
+                createInfo.pQueueFamilyIndices   = framebuffer.queueFamilies.data();
+            }
+
             VkImageAspectFlags aspect = VK_IMAGE_ASPECT_NONE;
 
             switch (framebuffer.type)
@@ -186,6 +195,12 @@ namespace Vk
                 aspect = VK_IMAGE_ASPECT_COLOR_BIT;
                 break;
 
+            case FramebufferType::ColorRG_Uint32:
+                createInfo.format = VK_FORMAT_R32G32_UINT;
+
+                aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+                break;
+
             case FramebufferType::ColorRGBA_UNorm8:
                 createInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
 
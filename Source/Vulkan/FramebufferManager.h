@@ -17,6 +17,9 @@
 #ifndef FRAME_BUFFER_MANAGER_H
 #define FRAME_BUFFER_MANAGER_H
 
+#include <vector>
+#include <span>
+
 #include "Image.h"
 #include "ImageView.h"
 #include "FormatHelper.h"
@@ -38,6 +41,7 @@ namespace Vk
         ColorRG_Unorm8,
         ColorRG_Unorm16,
         ColorRG_SFloat16,
+        ColorRG_Uint32,
         ColorRGBA_UNorm8,
         ColorBGR_SFloat_10_11_11,
         // Regular Color Formats
@@ -113,12 +117,14 @@ namespace Vk
 
     struct Framebuffer
     {
-        FramebufferType         type         = FramebufferType::ColorLDR;
-        FramebufferImageType    imageType    = FramebufferImageType::Single2D;
-        FramebufferUsage        usage        = FramebufferUsage::None;
-        FramebufferSizeData     sizeData     = {};
-        FramebufferInitialState initialState = {};
-        Vk::Image               image        = {};
+        FramebufferType         type          = FramebufferType::ColorLDR;
+        FramebufferImageType    imageType     = FramebufferImageType::Single2D;
+        FramebufferUsage        usage         = FramebufferUsage::None;
+        FramebufferSizeData     sizeData      = {};
+        FramebufferInitialState initialState  = {};
+        // Concurrently shared between these queue families, exclusive when there are fewer than two
+        std::vector<u32>        queueFamilies = {};
+        Vk::Image               image         = {};
     };
 
     class FramebufferManager
@@ -131,7 +137,8 @@ namespace Vk
             FramebufferImageType imageType,
             FramebufferUsage usage,
             const FramebufferSizeData& sizeData,
-            const FramebufferInitialState& initialState
+            const FramebufferInitialState& initialState,
+            const std::span<const u32> queueFamilies = {}
         );
 
         void AddFramebufferView
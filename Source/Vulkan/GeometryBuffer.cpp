@@ -101,6 +101,18 @@ namespace Vk
 
         Vk::EndLabel(cmdBuffer);
 
+        Vk::BeginLabel(cmdBuffer, "Cluster Transfer", {0.2117f, 0.5549f, 0.8901f, 1.0f});
+
+        clusterBuffer.FlushUploads
+        (
+            cmdBuffer,
+            device,
+            allocator,
+            deletionQueue
+        );
+
+        Vk::EndLabel(cmdBuffer);
+
         if (m_pendingCubeUpload.has_value())
         {
             Vk::BeginLabel(cmdBuffer, "Cube Transfer", {0.5117f, 0.0749f, 0.3901f, 1.0f});
@@ -151,6 +163,7 @@ namespace Vk
         Vk::SetDebugName(device, GetIndexBuffer().handle,    "GeometryBuffer/IndexBuffer"   );
         Vk::SetDebugName(device, GetPositionBuffer().handle, "GeometryBuffer/PositionBuffer");
         Vk::SetDebugName(device, GetVertexBuffer().handle,   "GeometryBuffer/VertexBuffer"  );
+        Vk::SetDebugName(device, GetClusterBuffer().handle,  "GeometryBuffer/ClusterBuffer" );
 
         if (m_pendingCubeUpload.has_value())
         {
@@ -170,6 +183,7 @@ namespace Vk
             indexBuffer.Free(info.indexInfo);
             positionBuffer.Free(info.positionInfo);
             vertexBuffer.Free(info.vertexInfo);
+            clusterBuffer.Free(info.clusterInfo);
         });
     }
 
@@ -271,6 +285,15 @@ namespace Vk
                     GetVertexBuffer().allocationInfo.size
                 );
 
+                ImGui::Text
+                (
+                    "Cluster Buffer  | %u | %llu/%llu/%llu",
+                    clusterBuffer.count,
+                    clusterBuffer.count * sizeof(GPU::Cluster),
+                    GetClusterBuffer().allocationInfo.size - (clusterBuffer.count * sizeof(GPU::Cluster)),
+                    GetClusterBuffer().allocationInfo.size
+                );
+
                 ImGui::EndMenu();
             }
 
@@ -280,8 +303,9 @@ namespace Vk
 
     bool GeometryBuffer::HasPendingUploads() const
     {
-        return indexBuffer.HasPendingUploads()  || vertexBuffer.HasPendingUploads() ||
-               vertexBuffer.HasPendingUploads() || m_pendingCubeUpload.has_value();
+        return indexBuffer.HasPendingUploads()  || positionBuffer.HasPendingUploads() ||
+               vertexBuffer.HasPendingUploads() || clusterBuffer.HasPendingUploads()  ||
+               m_pendingCubeUpload.has_value();
     }
 
     const Vk::Buffer& GeometryBuffer::GetIndexBuffer() const
@@ -299,11 +323,17 @@ namespace Vk
         return vertexBuffer.GetBuffer();
     }
 
+    const Vk::Buffer& GeometryBuffer::GetClusterBuffer() const
+    {
+        return clusterBuffer.GetBuffer();
+    }
+
     void GeometryBuffer::Destroy(VmaAllocator allocator)
     {
         indexBuffer.Destroy(allocator);
         positionBuffer.Destroy(allocator);
         vertexBuffer.Destroy(allocator);
+        clusterBuffer.Destroy(allocator);
         cubeBuffer.Destroy(allocator);
 
         if (m_pendingCubeUpload.has_value())
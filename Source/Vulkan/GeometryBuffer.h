@@ -54,10 +54,12 @@ namespace Vk
         [[nodiscard]] const Vk::Buffer& GetIndexBuffer()    const;
         [[nodiscard]] const Vk::Buffer& GetPositionBuffer() const;
         [[nodiscard]] const Vk::Buffer& GetVertexBuffer()   const;
+        [[nodiscard]] const Vk::Buffer& GetClusterBuffer()  const;
 
         Vk::VertexBuffer<GPU::Index>    indexBuffer;
         Vk::VertexBuffer<GPU::Position> positionBuffer;
         Vk::VertexBuffer<GPU::Vertex>   vertexBuffer;
+        Vk::VertexBuffer<GPU::Cluster>  clusterBuffer;
 
         Vk::Buffer cubeBuffer;
     private:
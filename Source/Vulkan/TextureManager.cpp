@@ -22,6 +22,7 @@
 #include "Util/Log.h"
 #include "Util/Types.h"
 #include "Util/Visitor.h"
+#include "Util/Parallel.h"
 
 namespace Vk
 {
@@ -58,7 +59,7 @@ namespace Vk
             return id;
         }
 
-        m_futuresMap.emplace(id, m_executor.async([this, allocator, &deletionQueue, upload] ()
+        m_futuresMap.emplace(id, Util::GetExecutor().async([this, allocator, &deletionQueue, upload] ()
         {
             return m_imageUploader.LoadImage(allocator, deletionQueue, upload);
         }));
@@ -154,7 +155,14 @@ namespace Vk
             return;
         }
 
-        m_executor.wait_for_all();
+        // The executor is shared, so only wait on this manager's own uploads
+        for (auto& [id, future] : m_futuresMap)
+        {
+            if (future.valid())
+            {
+                future.wait();
+            }
+        }
 
         for (auto& [id, info] : m_textureMap)
         {
@@ -91,7 +91,6 @@ namespace Vk
 
         Vk::ImageUploader m_imageUploader;
 
-        tf::Executor                                                        m_executor;
         ankerl::unordered_dense::map<Vk::TextureID, std::future<Vk::Image>> m_futuresMap;
     };
 }
@@ -227,4 +227,5 @@ namespace Vk
     template class Vk::VertexBuffer<GPU::Index>;
     template class Vk::VertexBuffer<GPU::Position>;
     template class Vk::VertexBuffer<GPU::Vertex>;
+    template class Vk::VertexBuffer<GPU::Cluster>;
 }
\ No newline at end of file
@@ -59,7 +59,8 @@ namespace Vk
                                    VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
                                    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
 
-                bufferInfo.stageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                // All graphics stages also cover task and mesh shaders, on devices that enable them
+                bufferInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT |
                                        VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR |
                                        VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
 
@@ -73,7 +74,7 @@ namespace Vk
                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
                                    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
 
-                bufferInfo.stageMask  = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+                bufferInfo.stageMask  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
                 bufferInfo.accessMask = VK_ACCESS_2_SHADER_READ_BIT;
             }
             else if constexpr (std::is_same_v<T, GPU::Vertex>)
@@ -83,7 +84,17 @@ namespace Vk
                                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 
-                bufferInfo.stageMask  = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+                bufferInfo.stageMask  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+                bufferInfo.accessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+            }
+            else if constexpr (std::is_same_v<T, GPU::Cluster>)
+            {
+                bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                   VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+                bufferInfo.stageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT;
                 bufferInfo.accessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
             }
             else